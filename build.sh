@@ -22,7 +22,7 @@
 
 CFLAGS="-Ideps -D__DARWIN_C_LEVEL=900000 -D_XOPEN_SOURCE=700 -D_BSD_SOURCE -std=c11 -Werror -Wall -Wextra -pedantic -Wno-missing-field-initializers"
 #CFLAGS="-Ideps -std=c11 -Werror -Wall -Wextra -pedantic -Wno-missing-field-initializers"
-LINKFLAGS="-lrt"
+LINKFLAGS="-lrt -lpthread"
 
 CAKECONFIG=$(build/cake/cake-config-chooser)
 build/cake/cake tests/libchaste_test.c --config=build/cake/$CAKECONFIG --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@ --begintests  tests/*.c --endtests
@@ -32,6 +32,14 @@ build/cake/cake chaste.c --config=build/cake/$CAKECONFIG --static-library --appe
 
 build/cake/cake demos/demo_options.c --config=build/cake/$CAKECONFIG --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@
 build/cake/cake demos/demo_logger.c --config=build/cake/$CAKECONFIG --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@
+build/cake/cake demos/bench_sort.c --config=build/cake/$CAKECONFIG --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@
+build/cake/cake demos/bench_sort_parallel.c --config=build/cake/$CAKECONFIG --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@
+build/cake/cake demos/bench_search.c --config=build/cake/$CAKECONFIG --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@
+build/cake/cake demos/bench_bintree.c --config=build/cake/$CAKECONFIG --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@
+build/cake/cake demos/bench_heap.c --config=build/cake/$CAKECONFIG --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@
+build/cake/cake demos/bench_bitset.c --config=build/cake/$CAKECONFIG --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@
+build/cake/cake demos/bench_cbq.c --config=build/cake/$CAKECONFIG --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@
+build/cake/cake demos/bench_mpmcq.c --config=build/cake/$CAKECONFIG --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@
 #Something broken about this build :-(
 #build/cake/cake chaste.c --dynamic-library --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@
 
@@ -31,6 +31,14 @@ cake chaste.c  --static-library --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAG
 
 cake demos/demo_options.c --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@
 cake demos/demo_logger.c  --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@
+cake demos/bench_sort.c   --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@
+cake demos/bench_sort_parallel.c --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@
+cake demos/bench_search.c --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@
+cake demos/bench_bintree.c --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@
+cake demos/bench_heap.c --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@
+cake demos/bench_bitset.c --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@
+cake demos/bench_cbq.c --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@
+cake demos/bench_mpmcq.c --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@
 #Something broken about this build :-(
 #build/cake/cake chaste.c --dynamic-library --append-CFLAGS="$CFLAGS" --LINKFLAGS="$LINKFLAGS" $@
 
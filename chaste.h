@@ -20,7 +20,19 @@
 #include "data_structs/array/array_std.h"
 #include "data_structs/vector/vector_std.h"
 #include "data_structs/linked_list/linked_list_std.h"
+#include "data_structs/linked_list/intrusive_list.h"
+#include "data_structs/unrolled_list/unrolled_list.h"
+#include "data_structs/skip_list/skip_list.h"
+#include "data_structs/binary_tree/binary_tree.h"
+#include "data_structs/heap/heap_std.h"
+#include "data_structs/bitset/bitset.h"
 #include "data_structs/hash_map/hash_map.h"
 #include "data_structs/function_hash_map/function_hash_map.h"
+#include "data_structs/eytzinger/eytzinger.h"
+#include "data_structs/soa_vector/soa_vector_typed_define_template.h"
+#include "data_structs/small_vector/small_vector_typed_define_template.h"
+#include "data_structs/deque/deque_typed_define_template.h"
+#include "data_structs/mpmc_queue/mpmc_queue.h"
+#include "hash_functions/hash.h"
 
 #endif /* LIBM6_H_ */
@@ -1,12 +1,29 @@
+//For mremap()
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
 #include "array.h"
 #include "../../utils/util.h"
 #include "../../types/types.h"
 
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <limits.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+    #define MAP_ANONYMOUS MAP_ANON
+#endif
+#ifndef MAP_NORESERVE
+    #define MAP_NORESERVE 0
+#endif
 
 
 #define _LAST ( _array_forward_unsafe(this,this->_array_backing, this->_array_backing_size -1))
@@ -59,10 +76,184 @@ void* array_prev(ch_array_t* this, void* ptr)
 
 
 
+//Map bytes of anonymous memory aligned to alignment. Over-map, then trim off the unaligned head and the unused tail.
+static void* _backing_mmap(ch_word bytes, ch_word alignment)
+{
+    const ch_word page_size = sysconf(_SC_PAGE_SIZE);
+    const ch_word slack     = alignment > page_size ? alignment : 0;
+
+    ch_byte* mem = mmap(NULL, bytes + slack, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(mem == MAP_FAILED){
+        return NULL;
+    }
+
+    ch_byte* aligned = (ch_byte*)(((uintptr_t)mem + alignment - 1) & ~(uintptr_t)(alignment - 1));
+    if(aligned > mem){
+        munmap(mem, aligned - mem);
+    }
+    if(aligned + bytes < mem + bytes + slack){
+        munmap(aligned + bytes, (mem + bytes + slack) - (aligned + bytes));
+    }
+
+    return aligned;
+}
+
+
+//Allocate at least bytes of backing memory with the given alignment, honouring the CH_ARRAY_HUGE_PAGES flag. Huge pages
+//are tried first with MAP_HUGETLB, which needs pages reserved by the administrator, then with transparent huge pages,
+//and finally plain heap memory. Returns the memory, and how it was allocated in type and backing_bytes.
+static void* _backing_alloc(ch_word bytes, ch_word alignment, ch_word flags, ch_array_backing_e* type,
+                            ch_word* backing_bytes)
+{
+    void* mem = NULL;
+
+    if(flags & CH_ARRAY_HUGE_PAGES){
+        const ch_word huge_bytes = round_up(bytes, CH_ARRAY_HUGE_PAGE_SIZE);
+
+        #ifdef MAP_HUGETLB
+        if(alignment <= CH_ARRAY_HUGE_PAGE_SIZE){
+            mem = mmap(NULL, huge_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if(mem != MAP_FAILED){
+                *type          = CH_ARRAY_BACKING_HUGETLB;
+                *backing_bytes = huge_bytes;
+                return mem;
+            }
+        }
+        #endif
+
+        mem = _backing_mmap(huge_bytes, MAX(alignment, CH_ARRAY_HUGE_PAGE_SIZE));
+        if(mem){
+            #ifdef MADV_HUGEPAGE
+            madvise(mem, huge_bytes, MADV_HUGEPAGE);
+            #endif
+            *type          = CH_ARRAY_BACKING_MMAP;
+            *backing_bytes = huge_bytes;
+            return mem;
+        }
+    }
+
+    if(bytes >= CH_ARRAY_MMAP_THRESHOLD){
+        const ch_word map_bytes = round_up(bytes, (ch_word)sysconf(_SC_PAGE_SIZE));
+        mem = _backing_mmap(map_bytes, alignment);
+        if(mem){
+            *type          = CH_ARRAY_BACKING_MMAP;
+            *backing_bytes = map_bytes;
+            return mem;
+        }
+    }
+
+    const ch_word heap_bytes = next_pow2(bytes);
+    if(posix_memalign(&mem, alignment, heap_bytes) || !mem){
+        return NULL;
+    }
+
+    *type          = CH_ARRAY_BACKING_HEAP;
+    *backing_bytes = heap_bytes;
+    return mem;
+}
+
+
+static void _backing_free(void* mem, ch_word backing_bytes, ch_array_backing_e type)
+{
+    switch(type){
+        case CH_ARRAY_BACKING_NONE:
+            return;
+        case CH_ARRAY_BACKING_HEAP:
+            free(mem);
+            return;
+        case CH_ARRAY_BACKING_MMAP:
+        case CH_ARRAY_BACKING_HUGETLB:
+        case CH_ARRAY_BACKING_RESERVED:
+        case CH_ARRAY_BACKING_FILE:
+            if(mem){
+                munmap(mem, backing_bytes);
+            }
+            return;
+    }
+}
+
+
+//Resize the backing memory to hold at least new_bytes, keeping the contents and the alignment
+static ch_word _backing_resize(ch_array_t* this, ch_word new_bytes)
+{
+    if(new_bytes == 0 && this->_backing_type != CH_ARRAY_BACKING_RESERVED){
+        _backing_free(this->_array_backing, this->_backing_bytes, this->_backing_type);
+        this->_array_backing = NULL;
+        this->_backing_bytes = 0;
+        this->_backing_type  = CH_ARRAY_BACKING_NONE;
+        return 0;
+    }
+
+    const ch_word page_size = sysconf(_SC_PAGE_SIZE);
+
+    #ifdef MREMAP_MAYMOVE
+    //Let the kernel move the pages rather than copying them. Huge page mappings and alignments bigger than a page
+    //would not survive the move. Reserved arrays only need this once they grow beyond their reservation.
+    const ch_bool remap = (this->_backing_type == CH_ARRAY_BACKING_MMAP ||
+                          (this->_backing_type == CH_ARRAY_BACKING_RESERVED && new_bytes > this->_backing_bytes))
+                        && !(this->_flags & CH_ARRAY_HUGE_PAGES) && this->_alignment <= page_size;
+    if(remap){
+        const ch_word map_bytes = round_up(new_bytes, page_size);
+        void* mem = mremap(this->_array_backing, this->_backing_bytes, map_bytes, MREMAP_MAYMOVE);
+        if(mem != MAP_FAILED){
+            this->_array_backing = mem;
+            this->_backing_bytes = map_bytes;
+            return 0;
+        }
+    }
+    #endif
+
+    //Mapped memory is page granular, so there is often room to grow in place
+    if(this->_backing_type != CH_ARRAY_BACKING_HEAP && new_bytes <= this->_backing_bytes){
+        //Give the memory beyond the new size back, it will be committed again if the array grows into it
+        const ch_word keep_bytes = round_up(new_bytes, page_size);
+        if(this->_backing_type == CH_ARRAY_BACKING_RESERVED && keep_bytes < this->_backing_bytes){
+            madvise((ch_byte*)this->_array_backing + keep_bytes, this->_backing_bytes - keep_bytes, MADV_DONTNEED);
+        }
+        return 0;
+    }
+
+    //realloc is the fastest way to grow heap memory, but only keeps malloc's own alignment. For anything stricter (like
+    //the default page alignment) a realloc would usually have to be copied again, so go straight to a fresh allocation
+    if(this->_backing_type == CH_ARRAY_BACKING_HEAP && !(this->_flags & CH_ARRAY_HUGE_PAGES) &&
+       new_bytes < CH_ARRAY_MMAP_THRESHOLD && this->_alignment <= (ch_word)_Alignof(max_align_t)){
+        void* mem = realloc(this->_array_backing, new_bytes);
+        if(!mem){
+            return -1;
+        }
+
+        this->_array_backing = mem;
+        this->_backing_bytes = new_bytes;
+        return 0;
+    }
+
+    ch_array_backing_e type;
+    ch_word backing_bytes;
+    void* mem = _backing_alloc(new_bytes, this->_alignment, this->_flags, &type, &backing_bytes);
+    if(!mem){
+        return -1;
+    }
+
+    if(this->_array_backing){
+        memcpy(mem, this->_array_backing, MIN(new_bytes, this->_array_backing_size * this->_element_size));
+    }
+    _backing_free(this->_array_backing, this->_backing_bytes, this->_backing_type);
+
+    this->_array_backing = mem;
+    this->_backing_bytes = backing_bytes;
+    this->_backing_type  = type;
+    return 0;
+}
+
+
 void array_resize(ch_array_t* this, ch_word new_size)
 {
-    this->_array_backing = (ch_byte*)realloc(this->_array_backing, new_size * this->_element_size);
-    if(!this->_array_backing){
+    if(this->_backing_type == CH_ARRAY_BACKING_FILE){
+        printf("Cannot resize a file backed array\n");
+        return;
+    }
+
+    if(_backing_resize(this, new_size * this->_element_size)){
         printf("Could not allocate memory for backing store\n");
         return;
     }
@@ -180,6 +371,76 @@ int array_get_idx(ch_array_t* this, void* value)
 }
 
 
+//Branchless binary search. The range halves with a conditional move rather than a branch, and both of the possible
+//next midpoints are prefetched while the comparison for this step completes.
+void* ch_lower_bound_carray(void* carray, ch_word count, ch_word element_size, cmp_void_f cmp, const void* value)
+{
+    if(count <= 0){
+        return carray;
+    }
+
+    ch_byte* base = carray;
+    while(count > 1){
+        const ch_word half = count / 2;
+        count -= half;
+        __builtin_prefetch(base + (count / 2) * element_size);
+        __builtin_prefetch(base + (half + count / 2) * element_size);
+        base = cmp(base + half * element_size, value) < 0 ? base + half * element_size : base;
+    }
+
+    return base + (cmp(base, value) < 0 ? element_size : 0);
+}
+
+
+void* ch_upper_bound_carray(void* carray, ch_word count, ch_word element_size, cmp_void_f cmp, const void* value)
+{
+    if(count <= 0){
+        return carray;
+    }
+
+    ch_byte* base = carray;
+    while(count > 1){
+        const ch_word half = count / 2;
+        count -= half;
+        __builtin_prefetch(base + (count / 2) * element_size);
+        __builtin_prefetch(base + (half + count / 2) * element_size);
+        base = cmp(value, base + half * element_size) < 0 ? base : base + half * element_size;
+    }
+
+    return base + (cmp(value, base) < 0 ? 0 : element_size);
+}
+
+
+void* array_lower_bound(ch_array_t* this, void* value)
+{
+    if(unlikely(!this->_cmp)){
+        printf("The comparator function is empty. Cannot search\n");
+        return NULL;
+    }
+
+    return ch_lower_bound_carray(this->first, this->size, this->_element_size, this->_cmp, value);
+}
+
+
+void* array_upper_bound(ch_array_t* this, void* value)
+{
+    if(unlikely(!this->_cmp)){
+        printf("The comparator function is empty. Cannot search\n");
+        return NULL;
+    }
+
+    return ch_upper_bound_carray(this->first, this->size, this->_element_size, this->_cmp, value);
+}
+
+
+void array_equal_range(ch_array_t* this, void* value, void** lower, void** upper)
+{
+    *lower = array_lower_bound(this, value);
+    *upper = *lower ? ch_upper_bound_carray(*lower, ((ch_byte*)this->end - (ch_byte*)*lower) / this->_element_size,
+                                            this->_element_size, this->_cmp, value) : NULL;
+}
+
+
 //Sort into order given the comparator function
 void array_sort(ch_array_t* this)
 {
@@ -188,12 +449,131 @@ void array_sort(ch_array_t* this)
 
 
 
-void array_delete(ch_array_t* this)
+//Load the key_size byte key at ptr and map it to an unsigned value with the same ordering
+static inline u64 _radix_key(const ch_byte* ptr, ch_word key_size, ch_radix_key_e key_type)
 {
-    if(this->_array_backing){
-        free(this->_array_backing);
+    u64 bits = 0;
+    switch(key_size){
+        case 1: { u8  v; memcpy(&v, ptr, sizeof(v)); bits = v; break; }
+        case 2: { u16 v; memcpy(&v, ptr, sizeof(v)); bits = v; break; }
+        case 4: { u32 v; memcpy(&v, ptr, sizeof(v)); bits = v; break; }
+        default:{ u64 v; memcpy(&v, ptr, sizeof(v)); bits = v; break; }
+    }
+
+    const u64 top  = 1ULL << (key_size * 8 - 1);
+    const u64 mask = top | (top - 1);
+    switch(key_type){
+        case CH_RADIX_SIGNED:   return bits ^ top;
+        case CH_RADIX_FLOAT:    return (bits & top) ? ~bits & mask : bits | top;
+        case CH_RADIX_UNSIGNED: break;
+    }
+    return bits;
+}
+
+
+typedef struct {
+    u64 key;
+    ch_word idx;
+} radix_pair_t;
+
+
+//Sort (key, index) pairs rather than whole elements, then move each element exactly once at the end. This keeps the
+//cost of each pass independent of the element size.
+ch_word ch_radix_sort_carray(void* carray, ch_word count, ch_word element_size, ch_word key_offset, ch_word key_size,
+                             ch_radix_key_e key_type)
+{
+    if(unlikely(key_size != 1 && key_size != 2 && key_size != 4 && key_size != 8)){
+        printf("Radix sort keys must be 1, 2, 4 or 8 bytes, not %lli\n", key_size);
+        return -1;
     }
 
+    if(unlikely(key_type == CH_RADIX_FLOAT && key_size != 4 && key_size != 8)){
+        printf("Radix sort floating point keys must be 4 or 8 bytes, not %lli\n", key_size);
+        return -1;
+    }
+
+    if(unlikely(key_offset < 0 || key_offset + key_size > element_size)){
+        printf("Radix sort key at offset %lli does not fit in a %lli byte element\n", key_offset, element_size);
+        return -1;
+    }
+
+    if(count < 2){
+        return 0;
+    }
+
+    radix_pair_t* pairs = (radix_pair_t*)malloc(2 * count * sizeof(radix_pair_t));
+    ch_byte* sorted     = (ch_byte*)malloc(count * element_size);
+    if(!pairs || !sorted){
+        printf("Could not allocate radix sort scratch space\n");
+        free(pairs);
+        free(sorted);
+        return -1;
+    }
+
+    ch_byte* elements = (ch_byte*)carray;
+    ch_word hist[8][256];
+    memset(hist, 0, sizeof(hist));
+    for(ch_word i = 0; i < count; i++){
+        const u64 key = _radix_key(elements + i * element_size + key_offset, key_size, key_type);
+        pairs[i].key = key;
+        pairs[i].idx = i;
+        for(ch_word byte = 0; byte < key_size; byte++){
+            hist[byte][(key >> (8 * byte)) & 0xFF]++;
+        }
+    }
+
+    radix_pair_t* src = pairs;
+    radix_pair_t* dst = pairs + count;
+    for(ch_word byte = 0; byte < key_size; byte++){
+        ch_word* offsets = hist[byte];
+        const ch_word shift = 8 * byte;
+
+        //Every key has the same value in this byte, so this pass would not move anything
+        if(offsets[(src[0].key >> shift) & 0xFF] == count){
+            continue;
+        }
+
+        for(ch_word digit = 0, total = 0; digit < 256; digit++){
+            const ch_word digit_count = offsets[digit];
+            offsets[digit] = total;
+            total += digit_count;
+        }
+
+        for(ch_word i = 0; i < count; i++){
+            dst[offsets[(src[i].key >> shift) & 0xFF]++] = src[i];
+        }
+
+        radix_pair_t* tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    //The gather is a random read of the elements, so prefetch a little way ahead of it
+    for(ch_word i = 0; i < count; i++){
+        if(i + 8 < count){
+            __builtin_prefetch(elements + src[i + 8].idx * element_size);
+        }
+        memcpy(sorted + i * element_size, elements + src[i].idx * element_size, element_size);
+    }
+    memcpy(elements, sorted, count * element_size);
+
+    free(pairs);
+    free(sorted);
+    return 0;
+}
+
+
+ch_word array_sort_radix(ch_array_t* this, ch_word key_offset, ch_word key_size, ch_radix_key_e key_type)
+{
+    return ch_radix_sort_carray(this->first, this->size, this->_element_size, key_offset, key_size, key_type);
+}
+
+
+
+void array_delete(ch_array_t* this)
+{
+    _backing_free(this->_array_backing, this->_backing_bytes, this->_backing_type);
+
     free(this);
 }
 
@@ -208,8 +588,17 @@ void* array_from_carray(ch_array_t* this, void* carray, ch_word count)
 }
 
 
-ch_array_t* ch_array_new(ch_word element_count, ch_word element_size, cmp_void_f cmp)
+ch_array_t* ch_array_new_aligned(ch_word element_count, ch_word element_size, cmp_void_f cmp, ch_word alignment,
+                                 ch_word flags)
 {
+    if(alignment == 0){
+        alignment = sysconf(_SC_PAGE_SIZE); //Page size aligned, which will also be "cache" aligned
+    }
+    if(alignment & (alignment - 1)){
+        printf("Alignment (%lli) must be a power of 2. Giving up\n", alignment);
+        return NULL;
+    }
+    alignment = MAX(alignment, (ch_word)sizeof(void*));
 
     ch_array_t* result = (ch_array_t*)calloc(1,sizeof(ch_array_t));
     if(!result){
@@ -217,24 +606,23 @@ ch_array_t* ch_array_new(ch_word element_count, ch_word element_size, cmp_void_f
         return NULL;
     }
 
-    const ch_word page_size             = sysconf(_SC_PAGE_SIZE);
-    const ch_word alignment             = page_size; //Make everything page size aligned, which will also be "cache" aligned
-    //const ch_word aligned_element_size  = ((element_size + alignment -1) / alignment ) * alignment;
-    const ch_word aligned_array_bytes   = next_pow2( element_size * element_count);
-    //const ch_word aligned_element_count = aligned_array_bytes / aligned_element_size;
-
-    //printf("\nRequested %li elements of %li bytes each -- ", element_count, element_size);
-    //printf("Allocating %li elements of %li bytes each, for a total of %li MBytes\n", element_count, element_size, aligned_array_bytes / 1024 / 1024 );
+    result->_alignment    = alignment;
+    result->_flags        = flags;
+    result->_backing_type = CH_ARRAY_BACKING_NONE;
 
     if(element_count > 0){
-
-        int error = posix_memalign(&result->_array_backing, alignment, aligned_array_bytes);
-        if( error || !result->_array_backing){
+        result->_array_backing = _backing_alloc(element_size * element_count, alignment, flags,
+                                                &result->_backing_type, &result->_backing_bytes);
+        if(!result->_array_backing){
             printf("Could not allocate memory for new array backing. Giving up\n");
             free(result);
             return NULL;
         }
-        memset(result->_array_backing,0,aligned_array_bytes);
+
+        //Anonymous mappings come zeroed already
+        if(result->_backing_type == CH_ARRAY_BACKING_HEAP){
+            memset(result->_array_backing,0,result->_backing_bytes);
+        }
     }
     else{
         result->_array_backing = NULL;
@@ -251,3 +639,124 @@ ch_array_t* ch_array_new(ch_word element_count, ch_word element_size, cmp_void_f
 
     return result;
 }
+
+
+ch_array_t* ch_array_new(ch_word element_count, ch_word element_size, cmp_void_f cmp)
+{
+    return ch_array_new_aligned(element_count, element_size, cmp, 0, 0);
+}
+
+
+ch_array_t* ch_array_new_reserved(ch_word element_count, ch_word max_count, ch_word element_size, cmp_void_f cmp)
+{
+    ch_array_t* result = ch_array_new_aligned(0, element_size, cmp, 0, 0);
+    if(!result){
+        return NULL;
+    }
+
+    const ch_word reserve_bytes = round_up(MAX(element_count, max_count) * element_size, (ch_word)sysconf(_SC_PAGE_SIZE));
+    if(reserve_bytes > 0){
+        void* mem = mmap(NULL, reserve_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                         -1, 0);
+        if(mem == MAP_FAILED){
+            printf("Could not reserve memory for new array backing. Giving up\n");
+            free(result);
+            return NULL;
+        }
+
+        result->_array_backing = mem;
+        result->_backing_bytes = reserve_bytes;
+        result->_backing_type  = CH_ARRAY_BACKING_RESERVED;
+    }
+
+    array_resize(result, element_count);
+    return result;
+}
+
+
+ch_word array_reserved(ch_array_t* this)
+{
+    if(this->_backing_type != CH_ARRAY_BACKING_RESERVED){
+        return 0;
+    }
+
+    return this->_backing_bytes / this->_element_size;
+}
+
+
+ch_array_t* ch_array_map_file(const char* path, ch_word element_size, ch_word mode, cmp_void_f cmp)
+{
+    if(element_size <= 0){
+        printf("Element size (%lli) must be greater than 0. Giving up\n", element_size);
+        return NULL;
+    }
+
+    const ch_bool rdwr = (mode & CH_ARRAY_MAP_RDWR) != 0;
+    const int fd = open(path, rdwr ? O_RDWR : O_RDONLY);
+    if(fd < 0){
+        printf("Could not open file \"%s\". Giving up\n", path);
+        return NULL;
+    }
+
+    struct stat st;
+    if(fstat(fd, &st)){
+        printf("Could not find the size of file \"%s\". Giving up\n", path);
+        close(fd);
+        return NULL;
+    }
+
+    ch_array_t* result = ch_array_new_aligned(0, element_size, cmp, 0, 0);
+    if(!result){
+        close(fd);
+        return NULL;
+    }
+
+    const ch_word count = (ch_word)st.st_size / element_size;
+    if(count > 0){
+        const ch_word bytes = count * element_size;
+        void* mem = mmap(NULL, bytes, PROT_READ | (rdwr ? PROT_WRITE : 0), MAP_SHARED, fd, 0);
+        if(mem == MAP_FAILED){
+            printf("Could not map file \"%s\". Giving up\n", path);
+            close(fd);
+            free(result);
+            return NULL;
+        }
+
+        if(mode & CH_ARRAY_MAP_SEQUENTIAL){
+            madvise(mem, bytes, MADV_SEQUENTIAL);
+        }
+        else if(mode & CH_ARRAY_MAP_RANDOM){
+            madvise(mem, bytes, MADV_RANDOM);
+        }
+
+        result->_array_backing      = mem;
+        result->_backing_bytes      = bytes;
+        result->_array_backing_size = count;
+        result->size                = count;
+        result->first               = mem;
+        result->last                = _array_forward_unsafe(result, mem, count - 1);
+        result->end                 = _array_next_unsafe(result, result->last);
+    }
+
+    //Even with nothing mapped, the array stays tied to the file, so it can't be resized away from it
+    result->_backing_type = CH_ARRAY_BACKING_FILE;
+
+    //The mapping holds its own reference to the file
+    close(fd);
+    return result;
+}
+
+
+ch_word array_sync(ch_array_t* this)
+{
+    if(this->_backing_type != CH_ARRAY_BACKING_FILE || !this->_array_backing){
+        return 0;
+    }
+
+    if(msync(this->_array_backing, this->_backing_bytes, MS_SYNC)){
+        printf("Could not write file backed array back to the file\n");
+        return -1;
+    }
+
+    return 0;
+}
@@ -10,6 +10,47 @@
 struct ch_array;
 typedef struct ch_array ch_array_t;
 
+//How to interpret the key field for radix sorting
+typedef enum {
+    CH_RADIX_UNSIGNED,  //Unsigned integer, 1, 2, 4 or 8 bytes
+    CH_RADIX_SIGNED,    //Two's complement signed integer, 1, 2, 4 or 8 bytes
+    CH_RADIX_FLOAT,     //IEEE-754 float (4 bytes) or double (8 bytes). -0.0 sorts before 0.0, NaNs sort to the ends
+} ch_radix_key_e;
+
+//Options for ch_array_new_aligned()
+typedef enum {
+    CH_ARRAY_HUGE_PAGES = (1 << 0), //Back the array with huge pages (MAP_HUGETLB), falling back to transparent huge pages
+                                    //(MADV_HUGEPAGE), then to normal pages
+} ch_array_flags_e;
+
+//Size of a cache line, use as the alignment to stop elements straddling cache lines
+#define CH_ARRAY_ALIGN_CACHE_LINE 64
+
+//Size of a huge page. Huge page backed arrays are rounded up to a multiple of this.
+#define CH_ARRAY_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+//Arrays of at least this many bytes are backed by anonymous mmap() rather than the heap. On Linux they are grown with
+//mremap(), which moves the pages rather than copying them, so growing a huge array never needs twice the memory.
+#define CH_ARRAY_MMAP_THRESHOLD (64 * 1024 * 1024)
+
+//Options for ch_array_map_file(). Choose one of RDONLY or RDWR, and optionally an access pattern hint.
+typedef enum {
+    CH_ARRAY_MAP_RDONLY     = 0,        //Map the file read only. The array must not be written to, and so not sorted
+    CH_ARRAY_MAP_RDWR       = (1 << 0), //Map the file read/write. Changes are written back to the file, see array_sync()
+    CH_ARRAY_MAP_SEQUENTIAL = (1 << 1), //The array will be scanned in order, read ahead aggressively
+    CH_ARRAY_MAP_RANDOM     = (1 << 2), //The array will be accessed randomly (e.g. searched), do not read ahead
+} ch_array_map_e;
+
+//Where the backing memory came from, so that it can be resized and freed the right way
+typedef enum {
+    CH_ARRAY_BACKING_NONE,      //No backing memory
+    CH_ARRAY_BACKING_HEAP,      //posix_memalign()
+    CH_ARRAY_BACKING_MMAP,      //Anonymous mmap()
+    CH_ARRAY_BACKING_HUGETLB,   //Anonymous mmap() with MAP_HUGETLB
+    CH_ARRAY_BACKING_RESERVED,  //Anonymous mmap() of address space only (MAP_NORESERVE), memory is committed on first touch
+    CH_ARRAY_BACKING_FILE,      //Shared mmap() of a file, see ch_array_map_file()
+} ch_array_backing_e;
+
 
 struct ch_array{
     ch_word size;  //Return the max number number of elements in the array list
@@ -23,6 +64,10 @@ struct ch_array{
     void* _array_backing; //Actual array storage
     ch_word _array_backing_size; //Number of elements allocated in the given array
     ch_word _element_size;
+    ch_word _alignment; //Alignment of the backing memory in bytes
+    ch_word _flags; //ch_array_flags_e options given at construction
+    ch_array_backing_e _backing_type; //How the backing memory was allocated
+    ch_word _backing_bytes; //Number of bytes of backing memory allocated, may be more than size * element_size
 
 };
 
@@ -54,12 +99,32 @@ void* array_find(ch_array_t* this, void* begin, void* end, void* value);
 //return the offset/index of the given item
 int array_get_idx(ch_array_t* this, void* value);
 
+//The array must be sorted by the comparator function for the following:
+//Return the first element that is not less than value, or end if there is none
+void* array_lower_bound(ch_array_t* this, void* value);
+//Return the first element that is greater than value, or end if there is none
+void* array_upper_bound(ch_array_t* this, void* value);
+//Set lower and upper to the range [lower, upper) of elements equal to value. The range is empty if there are none.
+void array_equal_range(ch_array_t* this, void* value, void** lower, void** upper);
+
+//As above, but for a raw C array of count elements. Return carray + count if there is no such element.
+void* ch_lower_bound_carray(void* carray, ch_word count, ch_word element_size, cmp_void_f cmp, const void* value);
+void* ch_upper_bound_carray(void* carray, ch_word count, ch_word element_size, cmp_void_f cmp, const void* value);
+
 //sort into order given the comparitor function
 void array_sort(ch_array_t* this);
 
 //sort into reverse order given the comparitor function
 void array_sort_reverse(ch_array_t* this);
 
+//sort into ascending order of an integer or floating point key found key_offset bytes into each element, using a stable
+//LSD radix sort. The rest of each element is carried along as payload. Returns 0 on success, -1 on failure.
+ch_word array_sort_radix(ch_array_t* this, ch_word key_offset, ch_word key_size, ch_radix_key_e key_type);
+
+//As above, but for a raw C array of count elements. Useful for building other containers.
+ch_word ch_radix_sort_carray(void* carray, ch_word count, ch_word element_size, ch_word key_offset, ch_word key_size,
+                             ch_radix_key_e key_type);
+
 //Free the resources associated with this array, assumes that individual items have been freed
 void array_delete(ch_array_t* this);
 
@@ -69,4 +134,27 @@ void* array_from_carray(ch_array_t* this, void* carray, ch_word count);
 
 ch_array_t* ch_array_new(ch_word size, ch_word element_size, int(*cmp)(const void* lhs, const void* rhs));
 
+//As above, but with the backing memory aligned to alignment bytes (a power of 2, or 0 for the default of page
+//alignment). The alignment is kept when the array is resized. flags are ch_array_flags_e options.
+ch_array_t* ch_array_new_aligned(ch_word size, ch_word element_size, int(*cmp)(const void* lhs, const void* rhs),
+                                 ch_word alignment, ch_word flags);
+
+//As above, but reserve address space for up to max_size elements up front. Memory is only committed as it is touched,
+//so resizing anywhere up to max_size never moves or copies the array. The array can still grow beyond max_size.
+ch_array_t* ch_array_new_reserved(ch_word size, ch_word max_size, ch_word element_size,
+                                  int(*cmp)(const void* lhs, const void* rhs));
+
+//Expose the contents of the file at path as an array of element_size byte elements, without reading it in. Pages are
+//read from the file as they are touched, so the file may be much bigger than memory. Any trailing partial element is
+//ignored. mode is a combination of ch_array_map_e options. File backed arrays cannot be resized.
+ch_array_t* ch_array_map_file(const char* path, ch_word element_size, ch_word mode,
+                              int(*cmp)(const void* lhs, const void* rhs));
+
+//Write any changes to a file backed array back to the file and wait for them to complete. Returns 0 on success, -1 on
+//failure. Changes are also written back when the array is deleted, but without waiting.
+ch_word array_sync(ch_array_t* this);
+
+//Return the number of elements that the array can be resized to without moving. 0 unless the array is reserved.
+ch_word array_reserved(ch_array_t* this);
+
 #endif //ARRAY_H_
@@ -0,0 +1,110 @@
+/*
+ * array_radix_template.h
+ *
+ * Type specialised LSD radix sort. Each element is mapped to an unsigned key whose natural order matches the order of
+ * the element, then the keys are sorted one byte at a time from least to most significant with a stable counting sort.
+ * All of the byte histograms are built in a single read pass, and passes where every key has the same byte are skipped,
+ * so (for example) small values in a u64 array only cost as many passes as they have significant bytes.
+ *
+ * Usage:
+ *     define_ch_radix_sort(my_prefix, TYPE, UTYPE, KEY)
+ * generates
+ *     static ch_word my_prefix_radix_sort(TYPE* carray, ch_word count);
+ * where UTYPE is the unsigned integer type of the same width as TYPE and KEY(bits,UTYPE) is one of the CH_RADIX_KEY_*
+ * macros below. Returns 0 on success, or -1 if the scratch buffer could not be allocated.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef ARRAY_RADIX_TEMPLATE_H_
+#define ARRAY_RADIX_TEMPLATE_H_
+
+#include "../../types/types.h"
+#include <stdlib.h>
+#include <string.h>
+
+//Arrays smaller than this are cheaper to sort with a comparison sort than to histogram
+#define CH_RADIX_THRESHOLD 64
+
+//How many elements ahead of the current one to prefetch
+#define CH_RADIX_PREFETCH 64
+
+#define CH_RADIX_TOP_BIT(UTYPE)             ( (UTYPE)1 << (sizeof(UTYPE) * 8 - 1) )
+
+//Map the raw bits of a value to an unsigned key with the same ordering
+#define CH_RADIX_KEY_UNSIGNED(bits, UTYPE)  ( (UTYPE)(bits) )
+#define CH_RADIX_KEY_SIGNED(bits, UTYPE)    ( (UTYPE)((bits) ^ CH_RADIX_TOP_BIT(UTYPE)) )
+#define CH_RADIX_KEY_FLOAT(bits, UTYPE)     ( (UTYPE)(((bits) & CH_RADIX_TOP_BIT(UTYPE)) ? ~(bits) : (bits) | CH_RADIX_TOP_BIT(UTYPE)) )
+
+#define define_ch_radix_sort(PREFIX, TYPE, UTYPE, KEY)\
+\
+static inline UTYPE PREFIX##_radix_key(const TYPE* value)\
+{\
+    UTYPE bits;\
+    memcpy(&bits, value, sizeof(bits));\
+    return KEY(bits, UTYPE);\
+}\
+\
+static ch_word PREFIX##_radix_sort(TYPE* carray, ch_word count)\
+{\
+    if(count < 2){\
+        return 0;\
+    }\
+\
+    TYPE* scratch = (TYPE*)malloc(count * sizeof(TYPE));\
+    if(!scratch){\
+        return -1;\
+    }\
+\
+    ch_word hist[sizeof(TYPE)][256];\
+    memset(hist, 0, sizeof(hist));\
+    for(ch_word i = 0; i < count; i++){\
+        if(i + CH_RADIX_PREFETCH < count){\
+            __builtin_prefetch(&carray[i + CH_RADIX_PREFETCH]);\
+        }\
+        const UTYPE key = PREFIX##_radix_key(&carray[i]);\
+        for(ch_word byte = 0; byte < (ch_word)sizeof(TYPE); byte++){\
+            hist[byte][(key >> (8 * byte)) & 0xFF]++;\
+        }\
+    }\
+\
+    TYPE* src = carray;\
+    TYPE* dst = scratch;\
+    for(ch_word byte = 0; byte < (ch_word)sizeof(TYPE); byte++){\
+        ch_word* offsets = hist[byte];\
+        const ch_word shift = 8 * byte;\
+\
+        /*Every key has the same value in this byte, so this pass would not move anything*/\
+        if(offsets[(PREFIX##_radix_key(&src[0]) >> shift) & 0xFF] == count){\
+            continue;\
+        }\
+\
+        for(ch_word digit = 0, total = 0; digit < 256; digit++){\
+            const ch_word digit_count = offsets[digit];\
+            offsets[digit] = total;\
+            total += digit_count;\
+        }\
+\
+        for(ch_word i = 0; i < count; i++){\
+            if(i + CH_RADIX_PREFETCH < count){\
+                __builtin_prefetch(&src[i + CH_RADIX_PREFETCH]);\
+            }\
+            const TYPE value = src[i];\
+            dst[offsets[(PREFIX##_radix_key(&value) >> shift) & 0xFF]++] = value;\
+        }\
+\
+        TYPE* tmp = src;\
+        src = dst;\
+        dst = tmp;\
+    }\
+\
+    if(src != carray){\
+        memcpy(carray, src, count * sizeof(TYPE));\
+    }\
+\
+    free(scratch);\
+    return 0;\
+}
+
+#endif /* ARRAY_RADIX_TEMPLATE_H_ */
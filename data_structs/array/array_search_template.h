@@ -0,0 +1,63 @@
+/*
+ * array_search_template.h
+ *
+ * Type specialised branchless binary search. Each step halves the range with a conditional move instead of a branch,
+ * so there are no mispredictions, and both of the possible next midpoints are prefetched so that the memory access
+ * for the next step is already in flight while this one completes.
+ *
+ * Usage:
+ *     define_ch_bsearch(my_prefix, TYPE, LESS)
+ * generates
+ *     static TYPE* my_prefix_lower_bound(TYPE* carray, ch_word count, TYPE value);
+ *     static TYPE* my_prefix_upper_bound(TYPE* carray, ch_word count, TYPE value);
+ * which return a pointer to the first element not less than (lower) or greater than (upper) value, or carray + count
+ * if there is none. carray must be sorted by LESS(lhs,rhs).
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef ARRAY_SEARCH_TEMPLATE_H_
+#define ARRAY_SEARCH_TEMPLATE_H_
+
+#include "../../types/types.h"
+
+#define define_ch_bsearch(PREFIX, TYPE, LESS)\
+\
+static inline TYPE* PREFIX##_lower_bound(TYPE* carray, ch_word count, TYPE value)\
+{\
+    if(count <= 0){\
+        return carray;\
+    }\
+\
+    TYPE* base = carray;\
+    while(count > 1){\
+        const ch_word half = count / 2;\
+        count -= half;\
+        __builtin_prefetch(base + count / 2);\
+        __builtin_prefetch(base + half + count / 2);\
+        base = LESS(base[half], value) ? base + half : base;\
+    }\
+\
+    return base + (LESS(*base, value) ? 1 : 0);\
+}\
+\
+static inline TYPE* PREFIX##_upper_bound(TYPE* carray, ch_word count, TYPE value)\
+{\
+    if(count <= 0){\
+        return carray;\
+    }\
+\
+    TYPE* base = carray;\
+    while(count > 1){\
+        const ch_word half = count / 2;\
+        count -= half;\
+        __builtin_prefetch(base + count / 2);\
+        __builtin_prefetch(base + half + count / 2);\
+        base = LESS(value, base[half]) ? base : base + half;\
+    }\
+\
+    return base + (LESS(value, *base) ? 0 : 1);\
+}
+
+#endif /* ARRAY_SEARCH_TEMPLATE_H_ */
@@ -0,0 +1,142 @@
+/*
+ * array_sort_template.h
+ *
+ * Type specialised introsort. Unlike qsort(), the comparison is a macro that is expanded in place, so there is no
+ * indirect call per comparison and the compiler is free to inline, unroll and use conditional moves. Quicksort with
+ * median of 3 pivots does the bulk of the work, heapsort bounds the worst case to O(n log n) and a final insertion sort
+ * pass tidies up the small partitions.
+ *
+ * Usage:
+ *     define_ch_introsort(my_prefix, TYPE, LESS)
+ * generates
+ *     static void my_prefix_introsort(TYPE* carray, ch_word count);
+ * where LESS(lhs,rhs) is a macro (or inline function) returning true if lhs should be ordered before rhs.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef ARRAY_SORT_TEMPLATE_H_
+#define ARRAY_SORT_TEMPLATE_H_
+
+#include "../../types/types.h"
+#include <string.h>
+
+//Partitions smaller than this are left for the final insertion sort pass
+#define CH_INTROSORT_THRESHOLD 16
+
+//Comparison macros for the standard instantiations. These match the ch_{array,vector}_cmp_* functions.
+#define CH_SORT_LT(lhs, rhs)          ( (lhs) < (rhs) )
+#define CH_SORT_LT_DEREF(lhs, rhs)    ( *(lhs) < *(rhs) )
+#define CH_SORT_LT_STR(lhs, rhs)      ( strcmp((lhs).cstr, (rhs).cstr) < 0 )
+#define CH_SORT_LT_STRP(lhs, rhs)     ( strcmp((lhs)->cstr, (rhs)->cstr) < 0 )
+#define CH_SORT_LT_CSTR(lhs, rhs)     ( strcmp((lhs), (rhs)) < 0 )
+#define CH_SORT_LT_CSTRP(lhs, rhs)    ( strcmp(*(lhs), *(rhs)) < 0 )
+#define CH_SORT_LT_PTR(lhs, rhs)      ( (uintptr_t)(lhs) < (uintptr_t)(rhs) )
+
+#define define_ch_introsort(PREFIX, TYPE, LESS)\
+\
+static inline void PREFIX##_swap(TYPE* lhs, TYPE* rhs)\
+{\
+    TYPE tmp = *lhs;\
+    *lhs = *rhs;\
+    *rhs = tmp;\
+}\
+\
+static inline void PREFIX##_insertion_sort(TYPE* carray, ch_word count)\
+{\
+    for(ch_word i = 1; i < count; i++){\
+        TYPE tmp = carray[i];\
+        ch_word j = i;\
+        for(; j > 0 && LESS(tmp, carray[j-1]); j--){\
+            carray[j] = carray[j-1];\
+        }\
+        carray[j] = tmp;\
+    }\
+}\
+\
+static void PREFIX##_sift_down(TYPE* carray, ch_word root, ch_word count)\
+{\
+    for(ch_word child = 2 * root + 1; child < count; root = child, child = 2 * root + 1){\
+        if(child + 1 < count && LESS(carray[child], carray[child + 1])){\
+            child++;\
+        }\
+        if(!LESS(carray[root], carray[child])){\
+            return;\
+        }\
+        PREFIX##_swap(&carray[root], &carray[child]);\
+    }\
+}\
+\
+static void PREFIX##_heapsort(TYPE* carray, ch_word count)\
+{\
+    for(ch_word i = count / 2 - 1; i >= 0; i--){\
+        PREFIX##_sift_down(carray, i, count);\
+    }\
+    for(ch_word i = count - 1; i > 0; i--){\
+        PREFIX##_swap(&carray[0], &carray[i]);\
+        PREFIX##_sift_down(carray, 0, i);\
+    }\
+}\
+\
+/*Hoare partition around the median of the first, middle and last elements. Returns p such that [0,p] <= [p+1,count)*/\
+static ch_word PREFIX##_partition(TYPE* carray, ch_word count)\
+{\
+    const ch_word mid = (count - 1) / 2;\
+    if(LESS(carray[mid], carray[0])){\
+        PREFIX##_swap(&carray[mid], &carray[0]);\
+    }\
+    if(LESS(carray[count - 1], carray[mid])){\
+        PREFIX##_swap(&carray[count - 1], &carray[mid]);\
+        if(LESS(carray[mid], carray[0])){\
+            PREFIX##_swap(&carray[mid], &carray[0]);\
+        }\
+    }\
+\
+    const TYPE pivot = carray[mid];\
+    ch_word i = -1;\
+    ch_word j = count;\
+    for(;;){\
+        do { i++; } while(LESS(carray[i], pivot));\
+        do { j--; } while(LESS(pivot, carray[j]));\
+        if(i >= j){\
+            return j;\
+        }\
+        PREFIX##_swap(&carray[i], &carray[j]);\
+    }\
+}\
+\
+static void PREFIX##_introsort_loop(TYPE* carray, ch_word count, ch_word depth)\
+{\
+    while(count > CH_INTROSORT_THRESHOLD){\
+        if(depth-- == 0){\
+            PREFIX##_heapsort(carray, count);\
+            return;\
+        }\
+\
+        /*Recurse into the smaller side and loop on the larger to bound the stack depth to O(log n)*/\
+        const ch_word split = PREFIX##_partition(carray, count) + 1;\
+        if(split < count - split){\
+            PREFIX##_introsort_loop(carray, split, depth);\
+            carray += split;\
+            count  -= split;\
+        }\
+        else{\
+            PREFIX##_introsort_loop(carray + split, count - split, depth);\
+            count = split;\
+        }\
+    }\
+}\
+\
+static inline void PREFIX##_introsort(TYPE* carray, ch_word count)\
+{\
+    if(count < 2){\
+        return;\
+    }\
+\
+    const ch_word depth = 2 * (63 - __builtin_clzll((unsigned long long)count));\
+    PREFIX##_introsort_loop(carray, count, depth);\
+    PREFIX##_insertion_sort(carray, count);\
+}
+
+#endif /* ARRAY_SORT_TEMPLATE_H_ */
@@ -10,40 +10,40 @@
 #include "array_std.h"
 #include "array_typed_define_template.h"
 
-define_array(u8,  u8)
-define_array(u16, u16)
-define_array(u32, u32)
-define_array(u64, u64)
-
-define_array(u8p,  u8*)
-define_array(u16p, u16*)
-define_array(u32p, u32*)
-define_array(u64p, u64*)
-
-define_array(i8,  i8)
-define_array(i16, i16)
-define_array(i32, i32)
-define_array(i64, i64)
-
-define_array(i8p,  i8*)
-define_array(i16p, i16*)
-define_array(i32p, i32*)
-define_array(i64p, i64*)
-
-define_array(machine, ch_machine)
-define_array(word, ch_word)
-define_array(char, ch_char)
-define_array(ch_bool, ch_bool)
-define_array(float, ch_float)
-define_array(string, ch_str)
-
-
-define_array(machinep, ch_machine*)
-define_array(wordp, ch_word*)
-define_array(charp, ch_char*)
+define_array_std_radix(u8,  u8, CH_SORT_LT, u8, CH_RADIX_KEY_UNSIGNED, CH_FIND_EQ_INT)
+define_array_std_radix(u16, u16, CH_SORT_LT, u16, CH_RADIX_KEY_UNSIGNED, CH_FIND_EQ_INT)
+define_array_std_radix(u32, u32, CH_SORT_LT, u32, CH_RADIX_KEY_UNSIGNED, CH_FIND_EQ_INT)
+define_array_std_radix(u64, u64, CH_SORT_LT, u64, CH_RADIX_KEY_UNSIGNED, CH_FIND_EQ_INT)
+
+define_array_std(u8p,  u8*, CH_SORT_LT_DEREF)
+define_array_std(u16p, u16*, CH_SORT_LT_DEREF)
+define_array_std(u32p, u32*, CH_SORT_LT_DEREF)
+define_array_std(u64p, u64*, CH_SORT_LT_DEREF)
+
+define_array_std_radix(i8,  i8, CH_SORT_LT, u8, CH_RADIX_KEY_SIGNED, CH_FIND_EQ_INT)
+define_array_std_radix(i16, i16, CH_SORT_LT, u16, CH_RADIX_KEY_SIGNED, CH_FIND_EQ_INT)
+define_array_std_radix(i32, i32, CH_SORT_LT, u32, CH_RADIX_KEY_SIGNED, CH_FIND_EQ_INT)
+define_array_std_radix(i64, i64, CH_SORT_LT, u64, CH_RADIX_KEY_SIGNED, CH_FIND_EQ_INT)
+
+define_array_std(i8p,  i8*, CH_SORT_LT_DEREF)
+define_array_std(i16p, i16*, CH_SORT_LT_DEREF)
+define_array_std(i32p, i32*, CH_SORT_LT_DEREF)
+define_array_std(i64p, i64*, CH_SORT_LT_DEREF)
+
+define_array_std_radix(machine, ch_machine, CH_SORT_LT, ch_machine, CH_RADIX_KEY_UNSIGNED, CH_FIND_EQ_INT)
+define_array_std_radix(word, ch_word, CH_SORT_LT, u64, CH_RADIX_KEY_SIGNED, CH_FIND_EQ_INT)
+define_array_std_radix(char, ch_char, CH_SORT_LT, u8, CH_RADIX_KEY_SIGNED, CH_FIND_EQ_INT)
+define_array_std(ch_bool, ch_bool, CH_SORT_LT)
+define_array_std_radix(float, ch_float, CH_SORT_LT, u64, CH_RADIX_KEY_FLOAT, CH_FIND_EQ_FLOAT)
+define_array_std(string, ch_str, CH_SORT_LT_STR)
+
+
+define_array_std(machinep, ch_machine*, CH_SORT_LT_DEREF)
+define_array_std(wordp, ch_word*, CH_SORT_LT_DEREF)
+define_array_std(charp, ch_char*, CH_SORT_LT_DEREF)
 define_array(boolp, ch_bool*)
-define_array(floatp, ch_float*)
-define_array(stringp, ch_str*)
+define_array_std(floatp, ch_float*, CH_SORT_LT_DEREF)
+define_array_std(stringp, ch_str*, CH_SORT_LT_STRP)
 
 
 define_array(voidp,  void*)
@@ -11,6 +11,9 @@
 
 #include "../../types/types.h"
 #include "array.h"
+#include "../../utils/util.h"
+
+#include <stdio.h>
 
 #define declare_array(NAME,TYPE)\
 \
@@ -33,8 +36,13 @@ struct ch_array_##NAME{\
     TYPE* (*back)(ch_array_##NAME##_t* this, TYPE* ptr, ch_word amount);  /*Step backwards by amount*/\
 \
     TYPE* (*find)(ch_array_##NAME##_t* this, TYPE* begin, TYPE* end, TYPE value); /*find the given value using the comparator function*/\
+    TYPE* (*lower_bound)(ch_array_##NAME##_t* this, TYPE value); /*in a sorted array, return the first element not less than value, or end*/\
+    TYPE* (*upper_bound)(ch_array_##NAME##_t* this, TYPE value); /*in a sorted array, return the first element greater than value, or end*/\
+    void (*equal_range)(ch_array_##NAME##_t* this, TYPE value, TYPE** lower, TYPE** upper); /*in a sorted array, set [lower,upper) to the elements equal to value*/\
     void (*sort)(ch_array_##NAME##_t* this); /*sort into order given the comparator function*/\
+    void (*sort_radix)(ch_array_##NAME##_t* this); /*sort into ascending order with a radix sort, ignoring the comparator. NULL unless TYPE is an integer or float*/\
 \
+    ch_word (*sync)(ch_array_##NAME##_t* this); /*Write changes to a file backed array back to the file, see array_sync()*/\
     void (*delete)(ch_array_##NAME##_t* this); /*Free the resources associated with this array, assumes that individual items have been freed*/\
 \
     TYPE* (*from_carray)(ch_array_##NAME##_t* this, TYPE* carray, ch_word count); /*Set at most count elements to the value in carray starting at offset in this array*/\
@@ -43,6 +51,40 @@ struct ch_array_##NAME{\
 };\
 \
 ch_array_##NAME##_t* ch_array_##NAME##_new(ch_word size, ch_word (*cmp)(TYPE* lhs, TYPE* rhs) );\
+ch_array_##NAME##_t* ch_array_##NAME##_new_aligned(ch_word size, ch_word (*cmp)(TYPE* lhs, TYPE* rhs), ch_word alignment, ch_word flags);\
+ch_array_##NAME##_t* ch_array_##NAME##_map_file(const char* path, ch_word mode, ch_word (*cmp)(TYPE* lhs, TYPE* rhs) );\
+_declare_array_inline(NAME,TYPE)
+
+//Direct call versions of the hot operations. These are static inline, so unlike calls through the function pointers
+//above, the compiler can inline them at the call site. Bounds checks are compiled out in release (NDEBUG) builds.
+#define _declare_array_inline(NAME,TYPE)\
+\
+/*Return the element at a given offset. Negative offsets count back from the end (the last element)*/\
+static inline TYPE* ch_array_##NAME##_off(ch_array_##NAME##_t* this, ch_word idx)\
+{\
+    idx = idx < 0 ? idx + this->size : idx;\
+    CH_BOUNDS_CHECK(idx >= 0 && idx < this->size, NULL, "Index (%lli) is out of the valid range [%lli,%lli]\n", idx, -1 * this->size, this->size - 1);\
+    return this->first + idx;\
+}\
+\
+/*Step forwards by amount*/\
+static inline TYPE* ch_array_##NAME##_forward(ch_array_##NAME##_t* this, TYPE* ptr, ch_word amount)\
+{\
+    CH_BOUNDS_CHECK(ptr + amount <= this->end, ptr, "Array forward catch\n");\
+    (void)this;\
+    return ptr + amount;\
+}\
+\
+/*Step backwards by amount*/\
+static inline TYPE* ch_array_##NAME##_back(ch_array_##NAME##_t* this, TYPE* ptr, ch_word amount)\
+{\
+    CH_BOUNDS_CHECK(ptr - amount >= this->first, ptr, "Array backward catch\n");\
+    (void)this;\
+    return ptr - amount;\
+}\
+\
+static inline TYPE* ch_array_##NAME##_next(ch_array_##NAME##_t* this, TYPE* ptr) { return ch_array_##NAME##_forward(this, ptr, 1); }\
+static inline TYPE* ch_array_##NAME##_prev(ch_array_##NAME##_t* this, TYPE* ptr) { return ch_array_##NAME##_back(this, ptr, 1); }
 
 
 #define declare_ch_array_cmp(NAME, TYPE) ch_word ch_array_cmp_##NAME(TYPE* lhs, TYPE* rhs);
@@ -10,11 +10,114 @@
 
 
 #include "array.h"
+#include "array_sort_template.h"
+#include "array_radix_template.h"
+#include "array_search_template.h"
+#include "simd_find.h"
 
 #include <stdlib.h>
 #include <stdio.h>
 
+//Generic arrays, sort using the comparator function
 #define define_array(NAME,TYPE)\
+_define_array_base(NAME,TYPE)\
+static void _sort_##NAME(ch_array_##NAME##_t* this)                                     { array_sort(this->_array); _update_##NAME(this); }\
+_define_array_bounds(NAME,TYPE)\
+_define_array_new(NAME,TYPE,_find_##NAME,NULL)
+
+//Arrays of types with a natural order given by LESS(lhs,rhs). If the array is constructed with the standard comparator
+//(CH_ARRAY_CMP(NAME)), sorting uses a type specialised introsort with the comparison inlined, rather than qsort().
+#define define_array_std(NAME,TYPE,LESS)\
+_define_array_std(NAME,TYPE,LESS)\
+_define_array_new(NAME,TYPE,_find_##NAME,NULL)
+
+//As above, for integer and floating point types that can also be radix sorted and searched with SIMD instructions.
+//UTYPE is the unsigned type of the same width as TYPE, KEY is one of CH_RADIX_KEY_{UNSIGNED,SIGNED,FLOAT} and FIND_EQ
+//is one of CH_FIND_EQ_{INT,FLOAT}
+#define define_array_std_radix(NAME,TYPE,LESS,UTYPE,KEY,FIND_EQ)\
+_define_array_std(NAME,TYPE,LESS)\
+_define_array_find_simd(NAME,TYPE,FIND_EQ)\
+define_ch_radix_sort(_ch_array_##NAME, TYPE, UTYPE, KEY)\
+static void _sort_radix_##NAME(ch_array_##NAME##_t* this)\
+{\
+    TYPE* carray = (TYPE*)this->_array->first;\
+    const ch_word count = this->_array->size;\
+    if(count < CH_RADIX_THRESHOLD){\
+        _ch_array_##NAME##_introsort(carray, count);\
+    }\
+    else if(_ch_array_##NAME##_radix_sort(carray, count)){\
+        printf("Could not allocate radix sort scratch space, falling back to introsort\n");\
+        _ch_array_##NAME##_introsort(carray, count);\
+    }\
+    _update_##NAME(this);\
+}\
+_define_array_new(NAME,TYPE,_find_simd_##NAME,_sort_radix_##NAME)
+
+#define _define_array_std(NAME,TYPE,LESS)\
+_define_array_base(NAME,TYPE)\
+_define_array_bounds_std(NAME,TYPE,LESS)\
+define_ch_introsort(_ch_array_##NAME, TYPE, LESS)\
+static void _sort_##NAME(ch_array_##NAME##_t* this)\
+{\
+    if(this->_array->_cmp == (cmp_void_f)ch_array_cmp_##NAME){\
+        _ch_array_##NAME##_introsort((TYPE*)this->_array->first, this->_array->size);\
+    }\
+    else{\
+        array_sort(this->_array);\
+    }\
+    _update_##NAME(this);\
+}
+
+//Binary searches using the comparator function
+#define _define_array_bounds(NAME,TYPE)\
+static TYPE* _lower_bound_##NAME(ch_array_##NAME##_t* this, TYPE value)                  { return (TYPE*)array_lower_bound(this->_array, &value); }\
+static TYPE* _upper_bound_##NAME(ch_array_##NAME##_t* this, TYPE value)                  { return (TYPE*)array_upper_bound(this->_array, &value); }\
+static void _equal_range_##NAME(ch_array_##NAME##_t* this, TYPE value, TYPE** lower, TYPE** upper)\
+{\
+    array_equal_range(this->_array, &value, (void**)lower, (void**)upper);\
+}
+
+//Binary searches with LESS inlined if the array uses the standard comparator
+#define _define_array_bounds_std(NAME,TYPE,LESS)\
+define_ch_bsearch(_ch_array_##NAME, TYPE, LESS)\
+static TYPE* _lower_bound_##NAME(ch_array_##NAME##_t* this, TYPE value)\
+{\
+    if(this->_array->_cmp != (cmp_void_f)ch_array_cmp_##NAME){\
+        return (TYPE*)array_lower_bound(this->_array, &value);\
+    }\
+    return _ch_array_##NAME##_lower_bound((TYPE*)this->_array->first, this->_array->size, value);\
+}\
+\
+static TYPE* _upper_bound_##NAME(ch_array_##NAME##_t* this, TYPE value)\
+{\
+    if(this->_array->_cmp != (cmp_void_f)ch_array_cmp_##NAME){\
+        return (TYPE*)array_upper_bound(this->_array, &value);\
+    }\
+    return _ch_array_##NAME##_upper_bound((TYPE*)this->_array->first, this->_array->size, value);\
+}\
+\
+static void _equal_range_##NAME(ch_array_##NAME##_t* this, TYPE value, TYPE** lower, TYPE** upper)\
+{\
+    *lower = _lower_bound_##NAME(this, value);\
+    *upper = _upper_bound_##NAME(this, value);\
+}
+
+//If the array uses the standard comparator, search with SIMD equality instead of calling the comparator per element.
+//Bad iterators go to the generic find, which reports them.
+#define _define_array_find_simd(NAME,TYPE,FIND_EQ)\
+static TYPE* _find_simd_##NAME(ch_array_##NAME##_t* this, TYPE* begin, TYPE* end, TYPE value)\
+{\
+    TYPE* first = (TYPE*)this->_array->first;\
+    TYPE* last  = (TYPE*)this->_array->end;\
+    if(this->_array->_cmp != (cmp_void_f)ch_array_cmp_##NAME ||\
+       begin < first || begin > last || end < first || end > last){\
+        return _find_##NAME(this, begin, end, value);\
+    }\
+\
+    return (TYPE*)FIND_EQ(begin, end, value);\
+}
+
+#define _define_array_base(NAME,TYPE)\
 \
 static void _update_##NAME(ch_array_##NAME##_t* this)\
 {\
@@ -32,9 +135,13 @@ static TYPE* _back_##NAME(ch_array_##NAME##_t* this, TYPE* ptr, ch_word amount)
 static TYPE* _next_##NAME(ch_array_##NAME##_t* this, TYPE* ptr)                           { TYPE* result = (TYPE*)_forward_##NAME(this, ptr, 1); _update_##NAME(this); return result; }\
 static TYPE* _prev_##NAME(ch_array_##NAME##_t* this, TYPE* ptr)                           { TYPE* result = (TYPE*)_back_##NAME(this, ptr, 1); _update_##NAME(this); return result; }\
 static TYPE* _find_##NAME(ch_array_##NAME##_t* this, TYPE* begin, TYPE* end, TYPE value)    { TYPE* result = (TYPE*) array_find(this->_array, (void*)begin, (void*)end, &value); _update_##NAME(this); return result; }\
-static void _sort_##NAME(ch_array_##NAME##_t* this)                                     { array_sort(this->_array); _update_##NAME(this); }\
 static TYPE* _from_carray_##NAME(ch_array_##NAME##_t* this, TYPE* carray, ch_word count)  { TYPE* result =  array_from_carray(this->_array, (void*)carray, count); _update_##NAME(this); return result; }\
 \
+static ch_word _sync_##NAME(ch_array_##NAME##_t* this)\
+{\
+    return array_sync(this->_array);\
+}\
+\
 static void _delete_##NAME(ch_array_##NAME##_t* this)\
 {\
     if(this->_array){\
@@ -42,19 +149,24 @@ static void _delete_##NAME(ch_array_##NAME##_t* this)\
     }\
 \
     free(this);\
-}\
-\
+}
+
+#define _define_array_new(NAME,TYPE,FIND,SORT_RADIX)\
 \
-ch_array_##NAME##_t* ch_array_##NAME##_new(ch_word size, ch_word (*cmp)(TYPE* lhs, TYPE* rhs) )\
+static ch_array_##NAME##_t* _wrap_##NAME(ch_array_t* array, ch_word (*cmp)(TYPE* lhs, TYPE* rhs) )\
 {\
+    if(!array){\
+        return ((void *)0);\
+    }\
 \
     ch_array_##NAME##_t* result = (ch_array_##NAME##_t*)calloc(1,sizeof(ch_array_##NAME##_t));\
     if(!result){\
         printf("Could not allocate memory for new array structure. Giving upn");\
+        array_delete(array);\
         return ((void *)0);\
     }\
 \
-    result->_array = ch_array_new(size, sizeof(TYPE), (cmp_void_f)cmp );\
+    result->_array = array;\
 \
 \
     /*We have memory to play with, now do all the other assignments*/\
@@ -65,18 +177,38 @@ ch_array_##NAME##_t* ch_array_##NAME##_new(ch_word size, ch_word (*cmp)(TYPE* lh
     result->forward                 = _forward_##NAME;\
     result->back                    = _back_##NAME;\
     result->from_carray             = _from_carray_##NAME;\
+    result->sync                    = _sync_##NAME;\
     result->delete                  = _delete_##NAME;\
+    result->sort_radix              = SORT_RADIX;\
 \
     /*Fail hard and early if the compare function is NULL*/\
     if(cmp){\
         result->eq                      = _eq_##NAME;\
-        result->find                    = _find_##NAME;\
+        result->find                    = FIND;\
         result->sort                    = _sort_##NAME;\
+        result->lower_bound             = _lower_bound_##NAME;\
+        result->upper_bound             = _upper_bound_##NAME;\
+        result->equal_range             = _equal_range_##NAME;\
     }\
 \
     _update_##NAME(result);\
 \
     return result;\
+}\
+\
+ch_array_##NAME##_t* ch_array_##NAME##_new(ch_word size, ch_word (*cmp)(TYPE* lhs, TYPE* rhs) )\
+{\
+    return _wrap_##NAME(ch_array_new(size, sizeof(TYPE), (cmp_void_f)cmp ), cmp);\
+}\
+\
+ch_array_##NAME##_t* ch_array_##NAME##_new_aligned(ch_word size, ch_word (*cmp)(TYPE* lhs, TYPE* rhs), ch_word alignment, ch_word flags)\
+{\
+    return _wrap_##NAME(ch_array_new_aligned(size, sizeof(TYPE), (cmp_void_f)cmp, alignment, flags ), cmp);\
+}\
+\
+ch_array_##NAME##_t* ch_array_##NAME##_map_file(const char* path, ch_word mode, ch_word (*cmp)(TYPE* lhs, TYPE* rhs) )\
+{\
+    return _wrap_##NAME(ch_array_map_file(path, sizeof(TYPE), mode, (cmp_void_f)cmp ), cmp);\
 }
 
 //Regular comparison function
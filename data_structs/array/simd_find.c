@@ -0,0 +1,237 @@
+/*
+ * simd_find.c
+ *
+ * Each vector implementation scans whole vectors only and returns either the first match, or the point where it
+ * stopped. A scalar loop then picks up from there, which both finishes the tail and confirms the match.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include "simd_find.h"
+#include "../../utils/cpu.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+#if defined(CH_ARCH_X86) && defined(__GNUC__)
+    #include <immintrin.h>
+    #define CH_FIND_AVX2 1
+#endif
+
+#if defined(CH_ARCH_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+    #define CH_FIND_NEON 1
+#endif
+
+
+//Set once at startup. Until then, the baseline implementation is used.
+static ch_bool find_use_avx2 = false;
+
+__attribute__((constructor)) static void find_select_impl(void)
+{
+    find_use_avx2 = ch_cpu_has(CH_CPU_AVX | CH_CPU_AVX2);
+}
+
+
+#if defined(__SSE2__)
+
+//SSE2 has no 64bit compare, so compare the 32bit halves and require that both match
+static inline __m128i sse2_cmpeq_epi64(__m128i lhs, __m128i rhs)
+{
+    const __m128i eq = _mm_cmpeq_epi32(lhs, rhs);
+    return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2,3,0,1)));
+}
+
+#define define_sse2_find(BITS, SET1, CMPEQ)\
+static const u##BITS* sse2_find_u##BITS(const u##BITS* ptr, const u##BITS* end, u##BITS value)\
+{\
+    const __m128i needle = SET1;\
+    const ch_word lanes = 16 / sizeof(u##BITS);\
+\
+    /*Four vectors at a time while nothing matches*/\
+    for(; end - ptr >= 4 * lanes; ptr += 4 * lanes){\
+        const __m128i eq0 = CMPEQ(_mm_loadu_si128((const __m128i*)ptr), needle);\
+        const __m128i eq1 = CMPEQ(_mm_loadu_si128((const __m128i*)(ptr + lanes)), needle);\
+        const __m128i eq2 = CMPEQ(_mm_loadu_si128((const __m128i*)(ptr + 2 * lanes)), needle);\
+        const __m128i eq3 = CMPEQ(_mm_loadu_si128((const __m128i*)(ptr + 3 * lanes)), needle);\
+        if(_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(eq0, eq1), _mm_or_si128(eq2, eq3)))){\
+            break;\
+        }\
+    }\
+\
+    for(; end - ptr >= lanes; ptr += lanes){\
+        const unsigned mask = _mm_movemask_epi8(CMPEQ(_mm_loadu_si128((const __m128i*)ptr), needle));\
+        if(mask){\
+            return (const u##BITS*)((const u8*)ptr + __builtin_ctz(mask));\
+        }\
+    }\
+\
+    return ptr;\
+}
+
+define_sse2_find(8,  _mm_set1_epi8((char)value),       _mm_cmpeq_epi8)
+define_sse2_find(16, _mm_set1_epi16((short)value),     _mm_cmpeq_epi16)
+define_sse2_find(32, _mm_set1_epi32((int)value),       _mm_cmpeq_epi32)
+define_sse2_find(64, _mm_set1_epi64x((long long)value), sse2_cmpeq_epi64)
+
+static const ch_float* sse2_find_float(const ch_float* ptr, const ch_float* end, ch_float value)
+{
+    const __m128d needle = _mm_set1_pd(value);
+    for(; end - ptr >= 2; ptr += 2){
+        const unsigned mask = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(ptr), needle));
+        if(mask){
+            return ptr + __builtin_ctz(mask);
+        }
+    }
+
+    return ptr;
+}
+
+#endif
+
+
+#if defined(CH_FIND_AVX2)
+
+#define define_avx2_find(BITS, SET1, CMPEQ)\
+CH_TARGET("avx2")\
+static const u##BITS* avx2_find_u##BITS(const u##BITS* ptr, const u##BITS* end, u##BITS value)\
+{\
+    const __m256i needle = SET1;\
+    const ch_word lanes = 32 / sizeof(u##BITS);\
+\
+    /*Two vectors (64 bytes) at a time while nothing matches*/\
+    for(; end - ptr >= 2 * lanes; ptr += 2 * lanes){\
+        const __m256i eq0 = CMPEQ(_mm256_loadu_si256((const __m256i*)ptr), needle);\
+        const __m256i eq1 = CMPEQ(_mm256_loadu_si256((const __m256i*)(ptr + lanes)), needle);\
+        if(_mm256_movemask_epi8(_mm256_or_si256(eq0, eq1))){\
+            break;\
+        }\
+    }\
+\
+    for(; end - ptr >= lanes; ptr += lanes){\
+        const unsigned mask = _mm256_movemask_epi8(CMPEQ(_mm256_loadu_si256((const __m256i*)ptr), needle));\
+        if(mask){\
+            return (const u##BITS*)((const u8*)ptr + __builtin_ctz(mask));\
+        }\
+    }\
+\
+    return ptr;\
+}
+
+define_avx2_find(8,  _mm256_set1_epi8((char)value),        _mm256_cmpeq_epi8)
+define_avx2_find(16, _mm256_set1_epi16((short)value),      _mm256_cmpeq_epi16)
+define_avx2_find(32, _mm256_set1_epi32((int)value),        _mm256_cmpeq_epi32)
+define_avx2_find(64, _mm256_set1_epi64x((long long)value), _mm256_cmpeq_epi64)
+
+CH_TARGET("avx2")
+static const ch_float* avx2_find_float(const ch_float* ptr, const ch_float* end, ch_float value)
+{
+    const __m256d needle = _mm256_set1_pd(value);
+    for(; end - ptr >= 4; ptr += 4){
+        const unsigned mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(ptr), needle, _CMP_EQ_OQ));
+        if(mask){
+            return ptr + __builtin_ctz(mask);
+        }
+    }
+
+    return ptr;
+}
+
+#endif
+
+
+#if defined(CH_FIND_NEON)
+
+//NEON has no movemask, so stop at the first vector with any match and let the scalar loop find it
+#define define_neon_find(BITS, VEC, DUP, LOAD, CMPEQ, ANY)\
+static const u##BITS* neon_find_u##BITS(const u##BITS* ptr, const u##BITS* end, u##BITS value)\
+{\
+    const VEC needle = DUP(value);\
+    const ch_word lanes = 16 / sizeof(u##BITS);\
+    for(; end - ptr >= lanes; ptr += lanes){\
+        if(ANY(CMPEQ(LOAD(ptr), needle))){\
+            break;\
+        }\
+    }\
+\
+    return ptr;\
+}
+
+#define NEON_ANY_U64(eq) vmaxvq_u32(vreinterpretq_u32_u64(eq))
+
+define_neon_find(8,  uint8x16_t, vdupq_n_u8,  vld1q_u8,  vceqq_u8,  vmaxvq_u8)
+define_neon_find(16, uint16x8_t, vdupq_n_u16, vld1q_u16, vceqq_u16, vmaxvq_u16)
+define_neon_find(32, uint32x4_t, vdupq_n_u32, vld1q_u32, vceqq_u32, vmaxvq_u32)
+define_neon_find(64, uint64x2_t, vdupq_n_u64, vld1q_u64, vceqq_u64, NEON_ANY_U64)
+
+static const ch_float* neon_find_float(const ch_float* ptr, const ch_float* end, ch_float value)
+{
+    const float64x2_t needle = vdupq_n_f64(value);
+    for(; end - ptr >= 2; ptr += 2){
+        if(NEON_ANY_U64(vceqq_f64(vld1q_f64(ptr), needle))){
+            break;
+        }
+    }
+
+    return ptr;
+}
+
+#endif
+
+
+//Pick the best vector implementation for this machine, then finish off with a scalar loop
+#if defined(CH_FIND_AVX2) && defined(__SSE2__)
+    #define FIND_VECTOR(SUFFIX, ptr, end, value) \
+        (find_use_avx2 ? avx2_find_##SUFFIX(ptr, end, value) : sse2_find_##SUFFIX(ptr, end, value))
+#elif defined(CH_FIND_AVX2)
+    #define FIND_VECTOR(SUFFIX, ptr, end, value) (find_use_avx2 ? avx2_find_##SUFFIX(ptr, end, value) : (ptr))
+#elif defined(__SSE2__)
+    #define FIND_VECTOR(SUFFIX, ptr, end, value) sse2_find_##SUFFIX(ptr, end, value)
+#elif defined(CH_FIND_NEON)
+    #define FIND_VECTOR(SUFFIX, ptr, end, value) neon_find_##SUFFIX(ptr, end, value)
+#else
+    #define FIND_VECTOR(SUFFIX, ptr, end, value) (ptr)
+#endif
+
+#define define_find(SUFFIX, TYPE)\
+static TYPE* find_##SUFFIX(const TYPE* ptr, const TYPE* end, TYPE value)\
+{\
+    for(ptr = FIND_VECTOR(SUFFIX, ptr, end, value); ptr < end; ptr++){\
+        if(*ptr == value){\
+            return (TYPE*)ptr;\
+        }\
+    }\
+\
+    return NULL;\
+}
+
+define_find(u8,  u8)
+define_find(u16, u16)
+define_find(u32, u32)
+define_find(u64, u64)
+define_find(float, ch_float)
+
+
+void* ch_simd_find(const void* begin, const void* end, const void* value, ch_word element_size)
+{
+    switch(element_size){
+        case 1: { u8  v; memcpy(&v, value, sizeof(v)); return find_u8(begin, end, v);  }
+        case 2: { u16 v; memcpy(&v, value, sizeof(v)); return find_u16(begin, end, v); }
+        case 4: { u32 v; memcpy(&v, value, sizeof(v)); return find_u32(begin, end, v); }
+        case 8: { u64 v; memcpy(&v, value, sizeof(v)); return find_u64(begin, end, v); }
+    }
+
+    printf("Cannot search for %lli byte elements, only 1, 2, 4 or 8\n", element_size);
+    return NULL;
+}
+
+
+ch_float* ch_simd_find_float(const ch_float* begin, const ch_float* end, ch_float value)
+{
+    return find_float(begin, end, value);
+}
@@ -0,0 +1,29 @@
+/*
+ * simd_find.h
+ *
+ * Vectorised linear search for primitive element types. Instead of calling a comparator per element, 16 (SSE2, NEON)
+ * or 32 (AVX2) bytes of elements are compared against the value with a single instruction. AVX2 is used if the CPU
+ * supports it, otherwise SSE2 on x86 or NEON on AArch64, with a plain scalar loop everywhere else.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef SIMD_FIND_H_
+#define SIMD_FIND_H_
+
+#include "../../types/types.h"
+
+//Return a pointer to the first element in [begin,end) that is bitwise equal to the element_size byte value, or NULL if
+//there is none. element_size must be 1, 2, 4 or 8. Suitable for all integer and pointer types.
+void* ch_simd_find(const void* begin, const void* end, const void* value, ch_word element_size);
+
+//Return a pointer to the first element in [begin,end) that compares equal (==) to value, or NULL if there is none. As
+//with ==, 0.0 matches -0.0 and NaN matches nothing.
+ch_float* ch_simd_find_float(const ch_float* begin, const ch_float* end, ch_float value);
+
+//Find functions for the typed array and vector templates
+#define CH_FIND_EQ_INT(begin, end, value)   ch_simd_find((begin), (end), &(value), sizeof(value))
+#define CH_FIND_EQ_FLOAT(begin, end, value) ch_simd_find_float((begin), (end), (value))
+
+#endif /* SIMD_FIND_H_ */
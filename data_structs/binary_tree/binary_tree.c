@@ -0,0 +1,1028 @@
+/*
+ * binary_tree.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "../../utils/util.h"
+#include "binary_tree.h"
+
+//Leaf elements, or inner node keys, start after the node header, suitably aligned. Inner node children follow the keys
+#define NODE_HEADER_BYTES round_up((ch_word)sizeof(ch_bintree_node_t), (ch_word)_Alignof(max_align_t))
+#define NODE_DATAP(node) ((ch_byte*)(node) + NODE_HEADER_BYTES)
+#define INNER_KEYS_BYTES(this) round_up((this)->_inner_capacity * (this)->_key_size, (ch_word)sizeof(void*))
+
+
+static inline void* _leaf_elem(ch_bintree_t* this, ch_bintree_node_t* leaf, ch_word idx)
+{
+    return NODE_DATAP(leaf) + idx * this->_element_size;
+}
+
+static inline void* _inner_key(ch_bintree_t* this, ch_bintree_node_t* node, ch_word idx)
+{
+    return NODE_DATAP(node) + idx * this->_key_size;
+}
+
+static inline ch_bintree_node_t** _inner_children(ch_bintree_t* this, ch_bintree_node_t* node)
+{
+    return (ch_bintree_node_t**)(NODE_DATAP(node) + INNER_KEYS_BYTES(this));
+}
+
+static inline ch_word _child_idx(ch_bintree_t* this, ch_bintree_node_t* parent, ch_bintree_node_t* child)
+{
+    ch_bintree_node_t** children = _inner_children(this, parent);
+    ch_word i = 0;
+    while(children[i] != child){
+        i++;
+    }
+    return i;
+}
+
+
+static inline ch_bintree_it _bintree_it_end(void)
+{
+    ch_bintree_it result = { 0 };
+    return result;
+}
+
+//An iterator to element idx of leaf, or to the start of the next leaf if idx is one past the end of this one
+static inline ch_bintree_it _bintree_it(ch_bintree_t* this, ch_bintree_node_t* leaf, ch_word idx)
+{
+    if(leaf && idx >= leaf->count){
+        leaf = leaf->next;
+        idx  = 0;
+    }
+
+    if(!leaf){
+        return _bintree_it_end();
+    }
+
+    ch_bintree_it result = { ._leaf = leaf, ._idx = idx, .value = _leaf_elem(this, leaf, idx) };
+    return result;
+}
+
+
+static inline i64 _key_at(const ch_byte* base, ch_word stride, ch_word idx)
+{
+    i64 key;
+    memcpy(&key, base + idx * stride, sizeof(key));
+    return key;
+}
+
+//Count the i64 keys in sorted [base, base + count * stride) that are less than key (or_equal: not greater than)
+static inline ch_word _i64_rank(const ch_byte* base, ch_word stride, ch_word count, i64 key, ch_bool or_equal)
+{
+    //Narrow down to a small block with a branchless binary search...
+    ch_word first = 0;
+    while(count > 16){
+        const ch_word half = count / 2;
+        const i64 probe = _key_at(base, stride, first + half - 1);
+        first += (or_equal ? probe <= key : probe < key) * half;
+        count -= half;
+    }
+
+    //...then count through the block. There are no branches here, so the compiler vectorises it
+    ch_word result = first;
+    if(or_equal){
+        for(ch_word i = 0; i < count; i++){
+            result += _key_at(base, stride, first + i) <= key;
+        }
+    }
+    else{
+        for(ch_word i = 0; i < count; i++){
+            result += _key_at(base, stride, first + i) < key;
+        }
+    }
+
+    return result;
+}
+
+//Count the elements in sorted [base, base + count * stride) that are less than value (or_equal: not greater than)
+static inline ch_word _cmp_rank(cmp_void_f cmp, const ch_byte* base, ch_word stride, ch_word count, const void* value,
+        ch_bool or_equal)
+{
+    ch_word lo = 0;
+    ch_word hi = count;
+    while(lo < hi){
+        const ch_word mid = lo + (hi - lo) / 2;
+        const int c = cmp(base + mid * stride, value);
+        if(c < 0 || (or_equal && c == 0)){
+            lo = mid + 1;
+        }
+        else{
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+static inline ch_word _rank(ch_bintree_t* this, const ch_byte* base, ch_word stride, ch_word count, const void* value,
+        ch_bool or_equal)
+{
+    if(this->_i64_keys){
+        return _i64_rank(base, stride, count, _key_at(value, 0, 0), or_equal);
+    }
+
+    return _cmp_rank(this->_cmp, base, stride, count, value, or_equal);
+}
+
+
+//Find the leaf, and the index in it, where value would go: in front of any equal elements, or with or_equal after them
+static ch_bintree_node_t* _bintree_search(ch_bintree_t* this, const void* value, ch_bool or_equal, ch_word* idx)
+{
+    ch_bintree_node_t* node = this->_root;
+    if(!node){
+        return NULL;
+    }
+
+    while(!node->leaf){
+        const ch_word i = this->_i64_keys ?
+                _i64_rank(NODE_DATAP(node), sizeof(i64), node->count, _key_at(value, 0, 0), or_equal) :
+                _cmp_rank(this->_cmp, NODE_DATAP(node), this->_key_size, node->count, value, or_equal);
+        node = _inner_children(this, node)[i];
+    }
+
+    *idx = _rank(this, NODE_DATAP(node), this->_element_size, node->count, value, or_equal);
+    return node;
+}
+
+
+//Make leaf an empty leaf, and link it in after prev (or as the only leaf if prev is NULL)
+static ch_bintree_node_t* _leaf_init(ch_bintree_t* this, ch_bintree_node_t* leaf, ch_bintree_node_t* prev)
+{
+    leaf->parent = prev ? prev->parent : NULL;
+    leaf->count  = 0;
+    leaf->leaf   = true;
+    leaf->prev   = prev;
+    leaf->next   = prev ? prev->next : NULL;
+
+    if(leaf->next){
+        leaf->next->prev = leaf;
+    }
+    else{
+        this->_last = leaf;
+    }
+
+    if(prev){
+        prev->next = leaf;
+    }
+    else{
+        this->_first = leaf;
+    }
+
+    return leaf;
+}
+
+//Make a new, empty leaf and link it in after prev (or as the only leaf if prev is NULL)
+static ch_bintree_node_t* _leaf_new(ch_bintree_t* this, ch_bintree_node_t* prev)
+{
+    ch_bintree_node_t* leaf = (ch_bintree_node_t*)pool_alloc(this->_leaves);
+    if(!leaf){
+        printf("Could not allocate memory for new bintree node. Giving up\n");
+        return NULL;
+    }
+
+    return _leaf_init(this, leaf, prev);
+}
+
+static ch_bintree_node_t* _inner_new(ch_bintree_t* this)
+{
+    ch_bintree_node_t* node = (ch_bintree_node_t*)pool_alloc(this->_inners);
+    if(!node){
+        printf("Could not allocate memory for new bintree node. Giving up\n");
+        return NULL;
+    }
+
+    memset(node, 0, sizeof(ch_bintree_node_t));
+    return node;
+}
+
+
+//Put key, and the child right after it, into node at key index idx
+static void _inner_insert(ch_bintree_t* this, ch_bintree_node_t* node, ch_word idx, const void* key,
+        ch_bintree_node_t* right)
+{
+    ch_bintree_node_t** children = _inner_children(this, node);
+    memmove(_inner_key(this, node, idx + 1), _inner_key(this, node, idx), (node->count - idx) * this->_key_size);
+    memmove(&children[idx + 2], &children[idx + 1], (node->count - idx) * sizeof(ch_bintree_node_t*));
+
+    memcpy(_inner_key(this, node, idx), key, this->_key_size);
+    children[idx + 1] = right;
+    right->parent = node;
+    node->count++;
+}
+
+//right has just been split off from left. Put it, and the key that separates them, into their parent
+static ch_bool _insert_in_parent(ch_bintree_t* this, ch_bintree_node_t* left, const void* key, ch_bintree_node_t* right)
+{
+    ch_bintree_node_t* parent = left->parent;
+    if(!parent){
+        //left was the root, so grow the tree by one level
+        ch_bintree_node_t* root = _inner_new(this);
+        if(!root){
+            return false;
+        }
+
+        memcpy(_inner_key(this, root, 0), key, this->_key_size);
+        _inner_children(this, root)[0] = left;
+        _inner_children(this, root)[1] = right;
+        root->count   = 1;
+        left->parent  = root;
+        right->parent = root;
+        this->_root   = root;
+        return true;
+    }
+
+    const ch_word idx = _child_idx(this, parent, left);
+    if(parent->count < this->_inner_capacity){
+        _inner_insert(this, parent, idx, key, right);
+        return true;
+    }
+
+    //The parent is full, so move its top half into a new node, and push the middle key up
+    ch_bintree_node_t* upper = _inner_new(this);
+    if(!upper){
+        return false;
+    }
+
+    const ch_word mid = parent->count / 2;
+    upper->count = parent->count - mid - 1;
+    memcpy(NODE_DATAP(upper), _inner_key(this, parent, mid + 1), upper->count * this->_key_size);
+    memcpy(_inner_children(this, upper), &_inner_children(this, parent)[mid + 1],
+            (upper->count + 1) * sizeof(ch_bintree_node_t*));
+    for(ch_word i = 0; i <= upper->count; i++){
+        _inner_children(this, upper)[i]->parent = upper;
+    }
+    parent->count = mid;
+
+    //The middle key is left in place, past the end of parent, until it has been copied up
+    if(!_insert_in_parent(this, parent, _inner_key(this, parent, mid), upper)){
+        return false;
+    }
+
+    if(idx <= mid){
+        _inner_insert(this, parent, idx, key, right);
+    }
+    else{
+        _inner_insert(this, upper, idx - mid - 1, key, right);
+    }
+
+    return true;
+}
+
+
+static void _inner_try_merge(ch_bintree_t* this, ch_bintree_node_t* node);
+
+//Take node (which is empty, or whose contents have been moved elsewhere) out of the tree and free it
+static void _remove_node(ch_bintree_t* this, ch_bintree_node_t* node)
+{
+    ch_bintree_node_t* parent = node->parent;
+
+    if(node->leaf){
+        if(node->prev){
+            node->prev->next = node->next;
+        }
+        else{
+            this->_first = node->next;
+        }
+
+        if(node->next){
+            node->next->prev = node->prev;
+        }
+        else{
+            this->_last = node->prev;
+        }
+    }
+
+    if(!parent){
+        this->_root = NULL;
+        pool_free(node->leaf ? this->_leaves : this->_inners, node);
+        return;
+    }
+
+    //Drop the child, and the key in front of it (or after it, for the first child)
+    const ch_word idx = _child_idx(this, parent, node);
+    pool_free(node->leaf ? this->_leaves : this->_inners, node);
+
+    const ch_word key_idx = idx > 0 ? idx - 1 : 0;
+    ch_bintree_node_t** children = _inner_children(this, parent);
+    if(parent->count > 0){
+        memmove(_inner_key(this, parent, key_idx), _inner_key(this, parent, key_idx + 1),
+                (parent->count - key_idx - 1) * this->_key_size);
+    }
+    memmove(&children[idx], &children[idx + 1], (parent->count - idx) * sizeof(ch_bintree_node_t*));
+    parent->count--;
+
+    if(parent->count < 0){
+        _remove_node(this, parent);
+        return;
+    }
+
+    if(parent->parent){
+        _inner_try_merge(this, parent);
+        return;
+    }
+
+    //Shrink the tree while the root has only one child
+    while(!this->_root->leaf && this->_root->count == 0){
+        ch_bintree_node_t* root = this->_root;
+        this->_root = _inner_children(this, root)[0];
+        this->_root->parent = NULL;
+        pool_free(this->_inners, root);
+    }
+}
+
+//Fold node and a sparse neighbour together
+static void _inner_try_merge(ch_bintree_t* this, ch_bintree_node_t* node)
+{
+    ch_bintree_node_t* parent = node->parent;
+    const ch_word idx = _child_idx(this, parent, node);
+
+    ch_bintree_node_t* left  = node;
+    ch_bintree_node_t* right = NULL;
+    ch_word key_idx = idx;
+    if(idx < parent->count){
+        right = _inner_children(this, parent)[idx + 1];
+    }
+    else if(idx > 0){
+        left    = _inner_children(this, parent)[idx - 1];
+        right   = node;
+        key_idx = idx - 1;
+    }
+
+    if(!right || left->count + right->count + 1 > this->_inner_capacity / 2){
+        return;
+    }
+
+    //Pull the separating key down, then move the keys and children of right across
+    memcpy(_inner_key(this, left, left->count), _inner_key(this, parent, key_idx), this->_key_size);
+    memcpy(_inner_key(this, left, left->count + 1), NODE_DATAP(right), right->count * this->_key_size);
+    ch_bintree_node_t** children = _inner_children(this, left);
+    memcpy(&children[left->count + 1], _inner_children(this, right), (right->count + 1) * sizeof(ch_bintree_node_t*));
+    for(ch_word i = left->count + 1; i <= left->count + right->count + 1; i++){
+        children[i]->parent = left;
+    }
+    left->count += right->count + 1;
+
+    _remove_node(this, right);
+}
+
+
+//The smallest element under node
+static inline void* _node_min(ch_bintree_t* this, ch_bintree_node_t* node)
+{
+    while(!node->leaf){
+        node = _inner_children(this, node)[0];
+    }
+    return NODE_DATAP(node);
+}
+
+//Give back nodes set aside by _reserve()
+static void _unreserve(ch_pool_t* pool, void** spare)
+{
+    while(*spare){
+        void* next = *(void**)*spare;
+        pool_free(pool, *spare);
+        *spare = next;
+    }
+}
+
+//Set aside count nodes from pool, chained through their first word. On failure, give them all back
+static ch_bool _reserve(ch_pool_t* pool, ch_word count, void** spare)
+{
+    *spare = NULL;
+    for(ch_word i = 0; i < count; i++){
+        void* node = pool_alloc(pool);
+        if(!node){
+            printf("Could not allocate memory for new bintree node. Giving up\n");
+            _unreserve(pool, spare);
+            return false;
+        }
+        *(void**)node = *spare;
+        *spare = node;
+    }
+
+    return true;
+}
+
+static void* _take(void** spare)
+{
+    void* node = *spare;
+    *spare = *(void**)node;
+    return node;
+}
+
+//Free the inner nodes under node, and the leaves too if leaves is set
+static void _free_nodes(ch_bintree_t* this, ch_bintree_node_t* node, ch_bool leaves)
+{
+    if(node->leaf){
+        if(leaves){
+            pool_free(this->_leaves, node);
+        }
+        return;
+    }
+
+    ch_bintree_node_t** children = _inner_children(this, node);
+    for(ch_word i = 0; i <= node->count; i++){
+        _free_nodes(this, children[i], leaves);
+    }
+    pool_free(this->_inners, node);
+}
+
+
+//Build the inner levels over the chain of leaves, bottom up, from the spare inner nodes. Each level is chained through
+//the (otherwise unused) next pointers of its nodes while the level above it is built
+static void _bintree_build_levels(ch_bintree_t* this, ch_word leaves, void** spare)
+{
+    ch_bintree_node_t* level = this->_first;
+    ch_word level_count = leaves;
+    const ch_word fanout = this->_inner_capacity + 1;
+
+    while(level_count > 1){
+        ch_bintree_node_t* parents = NULL;
+        ch_bintree_node_t* last_parent = NULL;
+        ch_word parent_count = 0;
+
+        ch_bintree_node_t* child = level;
+        for(ch_word remaining = level_count; remaining > 0; ){
+            //Fill each parent, but leave at least two children for the last one
+            ch_word take = MIN(fanout, remaining);
+            if(remaining - take == 1){
+                take--;
+            }
+            remaining -= take;
+
+            ch_bintree_node_t* parent = (ch_bintree_node_t*)_take(spare);
+            memset(parent, 0, sizeof(ch_bintree_node_t));
+
+            ch_bintree_node_t** children = _inner_children(this, parent);
+            for(ch_word i = 0; i < take; i++){
+                children[i] = child;
+                if(i > 0){
+                    memcpy(_inner_key(this, parent, i - 1), _node_min(this, child), this->_key_size);
+                }
+                child->parent = parent;
+
+                ch_bintree_node_t* next = child->next;
+                if(!child->leaf){
+                    child->next = NULL;
+                }
+                child = next;
+            }
+            parent->count = take - 1;
+
+            if(last_parent){
+                last_parent->next = parent;
+            }
+            else{
+                parents = parent;
+            }
+            last_parent = parent;
+            parent_count++;
+        }
+
+        level = parents;
+        level_count = parent_count;
+    }
+
+    if(level){
+        level->parent = NULL;
+    }
+    this->_root = level;
+}
+
+
+//A sorted run of elements to merge from: either a C array, or the leaves of a tree, which are freed as they are used up
+typedef struct {
+    ch_bintree_t* tree;
+    ch_bintree_node_t* leaf;
+    const ch_byte* next; //The next element, NULL once the run is used up
+    const ch_byte* end; //The end of the current leaf, or of the C array
+} _bintree_run_t;
+
+static void _run_init_leaves(_bintree_run_t* run, ch_bintree_t* tree, ch_bintree_node_t* first)
+{
+    run->tree = tree;
+    run->leaf = first;
+    run->next = first ? NODE_DATAP(first) : NULL;
+    run->end  = first ? NODE_DATAP(first) + first->count * tree->_element_size : NULL;
+}
+
+static void _run_init_carray(_bintree_run_t* run, const void* carray, ch_word count, ch_word element_size)
+{
+    run->tree = NULL;
+    run->leaf = NULL;
+    run->next = count > 0 ? carray : NULL;
+    run->end  = (const ch_byte*)carray + count * element_size;
+}
+
+static inline void _run_step(_bintree_run_t* run, ch_word element_size)
+{
+    run->next += element_size;
+    if(run->next < run->end){
+        return;
+    }
+
+    if(!run->tree){
+        run->next = NULL;
+        return;
+    }
+
+    ch_bintree_node_t* done = run->leaf;
+    _run_init_leaves(run, run->tree, done->next);
+    pool_free(run->tree->_leaves, done);
+}
+
+//Merge the elements of this (or none of them, if replace is set) with the run of count elements, into a new chain of
+//full leaves, and build the levels above them. Equal elements from this go first. Every node of the new tree is set
+//aside before the old one is touched, so on failure both this and the run are left as they were
+static ch_word _bintree_merge_run(ch_bintree_t* this, _bintree_run_t* other, ch_word count, ch_bool replace)
+{
+    const ch_word total = (replace ? 0 : this->count) + count;
+    const ch_word leaves = (total + this->_leaf_capacity - 1) / this->_leaf_capacity;
+    ch_word inners = 0;
+    for(ch_word level = leaves; level > 1; ){
+        level = (level + this->_inner_capacity) / (this->_inner_capacity + 1);
+        inners += level;
+    }
+
+    void* spare_leaves;
+    void* spare_inners;
+    if(!_reserve(this->_leaves, leaves, &spare_leaves)){
+        return -1;
+    }
+    if(!_reserve(this->_inners, inners, &spare_inners)){
+        _unreserve(this->_leaves, &spare_leaves);
+        return -1;
+    }
+
+    //The old leaves of this are recycled as they are used up
+    _bintree_run_t mine;
+    _run_init_leaves(&mine, this, replace ? NULL : this->_first);
+    if(this->_root){
+        _free_nodes(this, this->_root, replace);
+    }
+    this->_root  = NULL;
+    this->_first = NULL;
+    this->_last  = NULL;
+    this->count  = 0;
+
+    while(mine.next || other->next){
+        _bintree_run_t* from = other;
+        if(mine.next && (!other->next || this->_cmp(mine.next, other->next) <= 0)){
+            from = &mine;
+        }
+
+        ch_bintree_node_t* leaf = this->_last;
+        if(!leaf || leaf->count == this->_leaf_capacity){
+            leaf = _leaf_init(this, (ch_bintree_node_t*)_take(&spare_leaves), leaf);
+        }
+
+        memcpy(_leaf_elem(this, leaf, leaf->count), from->next, this->_element_size);
+        leaf->count++;
+        this->count++;
+        _run_step(from, this->_element_size);
+    }
+
+    _bintree_build_levels(this, leaves, &spare_inners);
+    return this->count;
+}
+
+
+//Remove element idx from leaf, return an iterator to the element that followed it
+static ch_bintree_it _bintree_remove_at(ch_bintree_t* this, ch_bintree_node_t* leaf, ch_word idx)
+{
+    ch_byte* slot = _leaf_elem(this, leaf, idx);
+    memmove(slot, slot + this->_element_size, (leaf->count - idx - 1) * this->_element_size);
+    leaf->count--;
+    this->count--;
+
+    if(leaf->count == 0){
+        ch_bintree_node_t* next = leaf->next;
+        _remove_node(this, leaf);
+        return _bintree_it(this, next, 0);
+    }
+
+    //Keep leaves reasonably full by folding a sparse neighbour (with the same parent) into this one, or this into it
+    ch_bintree_node_t* parent = leaf->parent;
+    if(parent){
+        const ch_word i = _child_idx(this, parent, leaf);
+        ch_bintree_node_t* left  = leaf;
+        ch_bintree_node_t* right = NULL;
+        if(i < parent->count){
+            right = leaf->next;
+        }
+        else if(i > 0){
+            left  = leaf->prev;
+            right = leaf;
+        }
+
+        if(right && left->count + right->count <= this->_leaf_capacity / 2){
+            if(left != leaf){
+                idx += left->count;
+                leaf = left;
+            }
+
+            memcpy(_leaf_elem(this, left, left->count), NODE_DATAP(right), right->count * this->_element_size);
+            left->count += right->count;
+            _remove_node(this, right);
+        }
+    }
+
+    return _bintree_it(this, leaf, idx);
+}
+
+
+ch_bintree_it bintree_off(ch_bintree_t* this, ch_word idx)
+{
+    idx = idx < 0 ? idx + this->count : idx;
+    if(idx < 0 || idx >= this->count){
+        printf("Index (%lli) is out of the valid range [%lli,%lli]\n", idx, -1 * this->count, this->count - 1);
+        return _bintree_it_end();
+    }
+
+    //Walk from whichever end is closer
+    if(idx < this->count / 2){
+        ch_bintree_node_t* leaf = this->_first;
+        for(; idx >= leaf->count; leaf = leaf->next){
+            idx -= leaf->count;
+        }
+        return _bintree_it(this, leaf, idx);
+    }
+
+    idx = this->count - 1 - idx;
+    ch_bintree_node_t* leaf = this->_last;
+    for(; idx >= leaf->count; leaf = leaf->prev){
+        idx -= leaf->count;
+    }
+    return _bintree_it(this, leaf, leaf->count - 1 - idx);
+}
+
+
+ch_bintree_it bintree_first(ch_bintree_t* this)
+{
+    return _bintree_it(this, this->_first, 0);
+}
+
+ch_bintree_it bintree_last(ch_bintree_t* this)
+{
+    return this->_last ? _bintree_it(this, this->_last, this->_last->count - 1) : _bintree_it_end();
+}
+
+ch_bintree_it bintree_end(ch_bintree_t* this)
+{
+    (void)this;
+    return _bintree_it_end();
+}
+
+
+void bintree_next(ch_bintree_t* this, ch_bintree_it* it)
+{
+    if(!it->_leaf){
+        return;
+    }
+
+    //Most steps stay in the same leaf
+    if(likely(it->_idx + 1 < it->_leaf->count)){
+        it->_idx++;
+        it->value = (ch_byte*)it->value + this->_element_size;
+        return;
+    }
+
+    *it = _bintree_it(this, it->_leaf->next, 0);
+}
+
+void bintree_prev(ch_bintree_t* this, ch_bintree_it* it)
+{
+    if(!it->_leaf){
+        return;
+    }
+
+    if(likely(it->_idx > 0)){
+        it->_idx--;
+        it->value = (ch_byte*)it->value - this->_element_size;
+        return;
+    }
+
+    ch_bintree_node_t* prev = it->_leaf->prev;
+    *it = prev ? _bintree_it(this, prev, prev->count - 1) : _bintree_it_end();
+}
+
+void bintree_forward(ch_bintree_t* this, ch_bintree_it* it, ch_word amount)
+{
+    ch_bintree_node_t* leaf = it->_leaf;
+    ch_word idx = it->_idx + amount;
+    while(leaf && idx >= leaf->count){
+        idx -= leaf->count;
+        leaf = leaf->next;
+    }
+
+    *it = leaf ? _bintree_it(this, leaf, idx) : _bintree_it_end();
+}
+
+void bintree_back(ch_bintree_t* this, ch_bintree_it* it, ch_word amount)
+{
+    ch_bintree_node_t* leaf = it->_leaf;
+    ch_word idx = it->_idx - amount;
+    while(leaf && idx < 0){
+        leaf = leaf->prev;
+        idx += leaf ? leaf->count : 0;
+    }
+
+    *it = leaf ? _bintree_it(this, leaf, idx) : _bintree_it_end();
+}
+
+
+ch_bintree_it bintree_push(ch_bintree_t* this, const void* value)
+{
+    ch_word idx = 0;
+    ch_bintree_node_t* leaf = _bintree_search(this, value, true, &idx);
+    if(!leaf){
+        leaf = _leaf_new(this, NULL);
+        if(!leaf){
+            return _bintree_it_end();
+        }
+        this->_root = leaf;
+    }
+
+    ch_bintree_node_t* right = NULL;
+    if(leaf->count == this->_leaf_capacity){
+        right = _leaf_new(this, leaf);
+        if(!right){
+            return _bintree_it_end();
+        }
+
+        //Split the leaf in half. Unless this is an append to the last leaf, then leave it full and start the next one
+        if(idx < leaf->count || right->next){
+            const ch_word half = leaf->count / 2;
+            right->count = leaf->count - half;
+            memcpy(NODE_DATAP(right), _leaf_elem(this, leaf, half), right->count * this->_element_size);
+            leaf->count = half;
+        }
+
+        if(idx > leaf->count || leaf->count == this->_leaf_capacity){
+            idx -= leaf->count;
+            leaf = right;
+        }
+    }
+
+    ch_byte* slot = _leaf_elem(this, leaf, idx);
+    memmove(slot + this->_element_size, slot, (leaf->count - idx) * this->_element_size);
+    memcpy(slot, value, this->_element_size);
+    leaf->count++;
+    this->count++;
+
+    if(right && !_insert_in_parent(this, right->prev, NODE_DATAP(right), right)){
+        return _bintree_it_end();
+    }
+
+    return _bintree_it(this, leaf, idx);
+}
+
+
+ch_word bintree_remove(ch_bintree_t* this, const void* value)
+{
+    const ch_bintree_it it = bintree_find(this, value);
+    if(!it.value){
+        return 0;
+    }
+
+    _bintree_remove_at(this, it._leaf, it._idx);
+    return 1;
+}
+
+ch_bintree_it bintree_remove_it(ch_bintree_t* this, ch_bintree_it* it)
+{
+    if(!it || !it->_leaf){
+        return _bintree_it_end();
+    }
+
+    return _bintree_remove_at(this, it->_leaf, it->_idx);
+}
+
+
+void bintree_pop_all(ch_bintree_t* this)
+{
+    pool_clear(this->_leaves);
+    pool_clear(this->_inners);
+    this->_root  = NULL;
+    this->_first = NULL;
+    this->_last  = NULL;
+    this->count  = 0;
+}
+
+void bintree_delete(ch_bintree_t* this)
+{
+    if(!this){
+        return;
+    }
+
+    pool_delete(this->_leaves);
+    pool_delete(this->_inners);
+    free(this);
+}
+
+
+static ch_bool _carray_sorted(ch_bintree_t* this, const void* carray, ch_word count)
+{
+    const ch_byte* ptr = carray;
+    for(ch_word i = 1; i < count; i++){
+        if(this->_cmp(ptr, ptr + this->_element_size) > 0){
+            return false;
+        }
+        ptr += this->_element_size;
+    }
+
+    return true;
+}
+
+ch_word bintree_build_sorted(ch_bintree_t* this, const void* carray, ch_word count)
+{
+    if(!_carray_sorted(this, carray, count)){
+        printf("Error: the C array is not in order\n");
+        return -1;
+    }
+
+    _bintree_run_t run;
+    _run_init_carray(&run, carray, count, this->_element_size);
+    return _bintree_merge_run(this, &run, count, true);
+}
+
+ch_word bintree_merge(ch_bintree_t* this, ch_bintree_t* that)
+{
+    if(this == that || this->_element_size != that->_element_size || this->_cmp != that->_cmp){
+        printf("Error: can only merge two different trees of the same type\n");
+        return -1;
+    }
+
+    _bintree_run_t run;
+    _run_init_leaves(&run, that, that->_first);
+    const ch_word result = _bintree_merge_run(this, &run, that->count, false);
+    if(result < 0){
+        return -1;
+    }
+
+    //The leaves of that have all been freed along the way
+    bintree_pop_all(that);
+    return result;
+}
+
+
+ch_bintree_it bintree_push_back_carray(ch_bintree_t* this, const void* carray, ch_word count)
+{
+    ch_bintree_it result = { 0 };
+
+    //Sorted input that is big enough, compared to what is already here, is merged in rather than pushed
+    if(count > 1 && count * 4 >= this->count && _carray_sorted(this, carray, count)){
+        _bintree_run_t run;
+        _run_init_carray(&run, carray, count, this->_element_size);
+        if(_bintree_merge_run(this, &run, count, false) < 0){
+            return result;
+        }
+
+        //The last one pushed went in after everything equal to it
+        result = bintree_upper_bound(this, (const ch_byte*)carray + (count - 1) * this->_element_size);
+        if(!result.value){
+            return bintree_last(this);
+        }
+        bintree_prev(this, &result);
+        return result;
+    }
+
+    const ch_byte* ptr = carray;
+    for(ch_word i =  0; i < count; i++){
+        result = bintree_push(this, ptr);
+        ptr += this->_element_size;
+    }
+
+    return result;
+}
+
+
+ch_word bintree_eq(ch_bintree_t* this, ch_bintree_t* that)
+{
+    if(this->count != that->count){
+        return 0;
+    }
+
+    ch_bintree_it it1 = bintree_first(this);
+    ch_bintree_it it2 = bintree_first(that);
+    for( ; it1.value && it2.value; bintree_next(this, &it1), bintree_next(that, &it2)){
+        if(this->_cmp(it1.value, it2.value)){
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+
+ch_bintree_it bintree_lower_bound(ch_bintree_t* this, const void* value)
+{
+    ch_word idx = 0;
+    ch_bintree_node_t* leaf = _bintree_search(this, value, false, &idx);
+    return _bintree_it(this, leaf, idx);
+}
+
+ch_bintree_it bintree_upper_bound(ch_bintree_t* this, const void* value)
+{
+    ch_word idx = 0;
+    ch_bintree_node_t* leaf = _bintree_search(this, value, true, &idx);
+    return _bintree_it(this, leaf, idx);
+}
+
+ch_bintree_it bintree_find(ch_bintree_t* this, const void* value)
+{
+    const ch_bintree_it result = bintree_lower_bound(this, value);
+    if(result.value && this->_cmp(result.value, value) == 0){
+        return result;
+    }
+
+    return _bintree_it_end();
+}
+
+ch_word bintree_range(ch_bintree_t* this, const void* lo, const void* hi, ch_bintree_it* begin, ch_bintree_it* end)
+{
+    *begin = bintree_lower_bound(this, lo);
+    *end   = bintree_lower_bound(this, hi);
+
+    //An empty (or backwards) range
+    if(!begin->value || this->_cmp(lo, hi) >= 0){
+        *begin = *end;
+        return 0;
+    }
+
+    //Count whole leaves at a time
+    ch_word count = -begin->_idx;
+    for(ch_bintree_node_t* leaf = begin->_leaf; leaf != end->_leaf; leaf = leaf->next){
+        count += leaf->count;
+    }
+
+    return count + end->_idx;
+}
+
+
+static int _cmp_i64_key(const void* lhs, const void* rhs)
+{
+    const i64 l = _key_at(lhs, 0, 0), r = _key_at(rhs, 0, 0);
+    return l < r ? -1 : l > r;
+}
+
+static ch_bintree_t* _bintree_new(ch_word element_size, cmp_void_f cmp, ch_bool i64_keys)
+{
+    if(element_size <= 0){
+        printf("Error: invalid element size (<=0), must have *some* data\n");
+        return NULL;
+    }
+
+    ch_bintree_t* result = (ch_bintree_t*)calloc(1,sizeof(ch_bintree_t));
+    if(!result){
+        printf("Could not allocate memory for new bintree structure. Giving up\n");
+        return NULL;
+    }
+
+    result->_cmp            = cmp;
+    result->_i64_keys       = i64_keys;
+    result->_element_size   = element_size;
+    result->_key_size       = i64_keys ? (ch_word)sizeof(i64) : element_size;
+    result->_leaf_capacity  = MAX((CH_BINTREE_NODE_BYTES - NODE_HEADER_BYTES) / element_size, CH_BINTREE_NODE_MIN);
+    result->_inner_capacity = MAX((CH_BINTREE_NODE_BYTES - NODE_HEADER_BYTES - (ch_word)sizeof(void*)) /
+                                  (result->_key_size + (ch_word)sizeof(void*)), CH_BINTREE_NODE_MIN);
+
+    result->_leaves = ch_pool_new(NODE_HEADER_BYTES + result->_leaf_capacity * element_size);
+    result->_inners = ch_pool_new(NODE_HEADER_BYTES + INNER_KEYS_BYTES(result) +
+                                  (result->_inner_capacity + 1) * (ch_word)sizeof(ch_bintree_node_t*));
+    if(!result->_leaves || !result->_inners){
+        bintree_delete(result);
+        return NULL;
+    }
+
+    return result;
+}
+
+ch_bintree_t* ch_bintree_new(ch_word element_size, cmp_void_f cmp)
+{
+    if(!cmp){
+        printf("Error: a bintree needs a comparator function\n");
+        return NULL;
+    }
+
+    return _bintree_new(element_size, cmp, false);
+}
+
+ch_bintree_t* ch_bintree_new_i64(ch_word element_size)
+{
+    if(element_size < (ch_word)sizeof(i64)){
+        printf("Error: elements must be big enough to start with an i64 key\n");
+        return NULL;
+    }
+
+    return _bintree_new(element_size, _cmp_i64_key, true);
+}
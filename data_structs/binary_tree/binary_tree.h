@@ -1,6 +1,17 @@
 /*
  * bintree.h
  *
+ * Ordered container, implemented as a B+-tree. Elements live in wide leaf nodes, kept in comparator order and linked
+ * together in both directions, so ordered iteration and range scans walk through contiguous memory. Inner nodes hold
+ * only separator keys and child pointers, so a lookup touches a handful of cache-line sized nodes, rather than one node
+ * (and one likely cache miss) per level as in a pointer-per-node binary tree.
+ *
+ * Trees made by ch_bintree_new_i64() order elements by a leading i64 key. Inner nodes then store bare i64 keys, and
+ * searches within a node are branchless counting loops over them, which the compiler vectorises.
+ *
+ * Equal elements are allowed, and keep their insertion order. NB: inserting or removing invalidates iterators and
+ * element pointers into the node(s) that changed. Use the iterator returned by the insert or remove. Not thread safe.
+ *
  *  Created on: Sep 12, 2013
  *      Author: mgrosvenor
  */
@@ -9,58 +20,118 @@
 #define BINARYTREE_H_
 
 #include "../../types/types.h"
-#include "../array/array.h"
+#include "../pool/pool.h"
+
+//Target size of each node, including its header. Nodes hold at least CH_BINTREE_NODE_MIN elements or keys
+#define CH_BINTREE_NODE_BYTES 1024
+#define CH_BINTREE_NODE_MIN 8
+
+struct ch_bintree_node;
+typedef struct ch_bintree_node ch_bintree_node_t;
+
+struct ch_bintree_node {
+    ch_bintree_node_t* parent;
+    ch_word count; //Elements in a leaf, or keys in an inner node (which has count + 1 children)
+    ch_bool leaf;
+    ch_bintree_node_t* prev; //Neighbouring leaves, for leaves only
+    ch_bintree_node_t* next;
+    //Leaves: the elements follow. Inner nodes: the keys follow, then the child pointers
+};
 
 struct ch_bintree;
 typedef struct ch_bintree ch_bintree_t;
 
-
 struct ch_bintree{
     ch_word count;  //Return the actual number of elements in the bintree
 
-    void* first; //Pointer to the fist valid entry Not valid if first == end
-    void* last; //Pointer to the last valid element Not valid if last == end
-    void* end; //Pointer to the one element beyond the end of the valid elements. Do not dereference!
-
     // Members prefixed with "_" are nominally "private" Don't touch my privates!
-   ch_word (*_cmp)(void* lhs, void* rhs); // Comparator function for find and sort operations
-   ch_array_t* _array; //Actual bintree storage
-   ch_word _array_count; //NUmber of elements currently in the bintree
+    cmp_void_f _cmp; //Comparator function that gives the order
+    ch_bool _i64_keys; //Elements are ordered by a leading i64
+    ch_word _element_size;
+    ch_word _key_size; //Size of the separator keys in inner nodes
+    ch_word _leaf_capacity; //Elements per leaf
+    ch_word _inner_capacity; //Keys per inner node
+    ch_bintree_node_t* _root;
+    ch_bintree_node_t* _first; //First and last leaves
+    ch_bintree_node_t* _last;
+    ch_pool_t* _leaves;
+    ch_pool_t* _inners;
 };
 
+typedef struct {
+    //These state variables are private
+    ch_bintree_node_t* _leaf;
+    ch_word _idx; //Index of the element in _leaf
+
+    //This is public
+    void* value;
+} ch_bintree_it;
+
 
 //Return the element at a given offset, with bounds checking [In general, this is expensive]
-void* bintree_off(ch_bintree_t* this, ch_word idx);
+ch_bintree_it bintree_off(ch_bintree_t* this, ch_word idx);
+
+//Get the first (smallest) entry
+ch_bintree_it bintree_first(ch_bintree_t* this);
+//Get the last (largest) entry
+ch_bintree_it bintree_last(ch_bintree_t* this);
+//Get the end
+ch_bintree_it bintree_end(ch_bintree_t* this);
 
 //Step forwards by one entry
-void* bintree_next (ch_bintree_t* this, void* ptr);
+void bintree_next(ch_bintree_t* this, ch_bintree_it* it);
 //Step backwards by one entry
-void* bintree_prev(ch_bintree_t* this, void* ptr);
+void bintree_prev(ch_bintree_t* this, ch_bintree_it* it);
 //Step forwards by amount
-void* bintree_forward(ch_bintree_t* this, void* ptr, ch_word amount);
+void bintree_forward(ch_bintree_t* this, ch_bintree_it* it, ch_word amount);
 //Step backwards by amount
-void* bintree_back(ch_bintree_t* this, void* ptr, ch_word amount);
+void bintree_back(ch_bintree_t* this, ch_bintree_it* it, ch_word amount);
 
-// Put an element into the tree
-void* bintree_push(ch_bintree_t* this, void* value);
-//Remove the given ptr [WARN: In general this is very expensive]
-void* bintree_remove(ch_bintree_t* this, void* ptr);
+// Put an element into the tree, after any equal elements. Returns an iterator to it, or the end on failure
+ch_bintree_it bintree_push(ch_bintree_t* this, const void* value);
+//Remove the first element equal to value. Returns 1 if there was one to remove, 0 otherwise
+ch_word bintree_remove(ch_bintree_t* this, const void* value);
+//Remove the element given by the iterator, return an iterator to the element that followed it
+ch_bintree_it bintree_remove_it(ch_bintree_t* this, ch_bintree_it* it);
+
+//Remove all elements
+void bintree_pop_all(ch_bintree_t* this);
 
 //Free the resources associated with this bintree, assumes that individual items have been freed
 void bintree_delete(ch_bintree_t* this);
 
-//Push back count elements the C bintree to the back bintree-list
-void* bintree_push_back_carray(ch_bintree_t* this, void* cbintree, ch_word count);
+//Push count elements from the C array into the tree. Returns an iterator to the last one pushed. If the C array is in
+//order, and not much smaller than the tree, it is merged in as with bintree_merge(), and on failure the end is returned
+//and the tree is left as it was
+ch_bintree_it bintree_push_back_carray(ch_bintree_t* this, const void* carray, ch_word count);
+
+//Replace the contents of the tree with count elements from the C array, which must be in order. Full leaves are built
+//straight from the array, then the levels above them, in O(count). Returns the number of elements, or -1 on failure,
+//in which case the tree is left as it was
+ch_word bintree_build_sorted(ch_bintree_t* this, const void* carray, ch_word count);
+//Move every element of that into this, leaving that empty. Equal elements from this go first. The leaves of both are
+//streamed through in order, and rebuilt into full leaves, in O(this->count + that->count). Every node needed is set
+//aside first, so the old and new leaves of this are briefly held together. Returns the new count, or -1 on failure,
+//in which case neither tree is changed
+ch_word bintree_merge(ch_bintree_t* this, ch_bintree_t* that);
 
 //Check for equality
 ch_word bintree_eq(ch_bintree_t* this, ch_bintree_t* that);
-//find the given value using the comparator function
-
-void* bintree_find(ch_bintree_t* this, void* begin, void* end, void* value);
-
-//sort into order given the comparator function
-void bintree_sort(ch_bintree_t* this);
 
-ch_bintree_t* ch_bintree_new(ch_word size, ch_word element_size, ch_word(*cmp)(void* lhs, void* rhs) );
+//Find the first element equal to value, or the end if there is none
+ch_bintree_it bintree_find(ch_bintree_t* this, const void* value);
+//Return the first element that is not less than value, or the end if there is none
+ch_bintree_it bintree_lower_bound(ch_bintree_t* this, const void* value);
+//Return the first element that is greater than value, or the end if there is none
+ch_bintree_it bintree_upper_bound(ch_bintree_t* this, const void* value);
+//Set begin and end so that [begin, end) covers the elements in the range [lo, hi). Returns the number of elements in it
+ch_word bintree_range(ch_bintree_t* this, const void* lo, const void* hi, ch_bintree_it* begin, ch_bintree_it* end);
+
+ch_bintree_t* ch_bintree_new(ch_word element_size, cmp_void_f cmp);
+//Elements start with an i64 key, and are ordered by it
+ch_bintree_t* ch_bintree_new_i64(ch_word element_size);
+
+#define CH_BINTREE_FOREACH(TREE, IT) \
+    for(ch_bintree_it IT = bintree_first(TREE); IT.value; bintree_next(TREE, &IT))
 
 #endif // BINARYTREE_H_
@@ -0,0 +1,533 @@
+/*
+ * bitset.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include "bitset.h"
+#include "../../utils/cpu.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(CH_ARCH_X86) && defined(__GNUC__)
+    #include <immintrin.h>
+    #define CH_BITSET_AVX2 1
+#endif
+
+
+//Set once at startup. Until then, the baseline implementations are used.
+static ch_bool bitset_use_avx2   = false;
+static ch_bool bitset_use_popcnt = false;
+static ch_bool bitset_use_bmi2   = false;
+
+__attribute__((constructor)) static void bitset_select_impl(void)
+{
+    bitset_use_avx2   = ch_cpu_has(CH_CPU_AVX | CH_CPU_AVX2);
+    bitset_use_popcnt = ch_cpu_has(CH_CPU_POPCNT);
+    bitset_use_bmi2   = ch_cpu_has(CH_CPU_BMI2);
+}
+
+
+//Number of words that hold bits
+static inline ch_word _used_words(const ch_bitset_t* this)
+{
+    return (this->size + 63) >> 6;
+}
+
+//Keep the bits past size clear, so that the bulk operations and counts can work on whole words and vectors
+static void _bitset_mask_tail(ch_bitset_t* this)
+{
+    const ch_word used = _used_words(this);
+    if(this->size & 63){
+        this->_words[used - 1] &= (1ULL << (this->size & 63)) - 1;
+    }
+    memset(this->_words + used, 0, (this->_word_count - used) * sizeof(u64));
+}
+
+
+/******************************************************************************************************************
+ * Population counts
+ ******************************************************************************************************************/
+
+//Without the popcnt instruction, the builtin falls back to a (much slower) software routine
+CH_TARGET("popcnt")
+static ch_word popcnt_count(const u64* words, ch_word count)
+{
+    ch_word result = 0;
+    for(ch_word i = 0; i < count; i++){
+        result += __builtin_popcountll(words[i]);
+    }
+    return result;
+}
+
+static ch_word scalar_count(const u64* words, ch_word count)
+{
+    ch_word result = 0;
+    for(ch_word i = 0; i < count; i++){
+        result += __builtin_popcountll(words[i]);
+    }
+    return result;
+}
+
+#if defined(CH_BITSET_AVX2)
+
+//Count the bits in each 64bit lane. Each nibble is counted by looking it up in a 16 entry table with a byte shuffle,
+//then the byte counts are summed with a sum of absolute differences against zero
+CH_TARGET("avx2")
+static inline __m256i avx2_popcount(__m256i v)
+{
+    const __m256i table = _mm256_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4, 0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4);
+    const __m256i low_nibbles = _mm256_set1_epi8(0x0f);
+    const __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low_nibbles));
+    const __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low_nibbles));
+    return _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256());
+}
+
+CH_TARGET("avx2")
+static ch_word avx2_sum(__m256i acc)
+{
+    return _mm256_extract_epi64(acc, 0) + _mm256_extract_epi64(acc, 1) + _mm256_extract_epi64(acc, 2) +
+           _mm256_extract_epi64(acc, 3);
+}
+
+//Whole vectors only, the caller counts the rest
+CH_TARGET("avx2")
+static ch_word avx2_count(const u64* words, ch_word count)
+{
+    __m256i acc = _mm256_setzero_si256();
+    for(ch_word i = 0; i + 4 <= count; i += 4){
+        acc = _mm256_add_epi64(acc, avx2_popcount(_mm256_loadu_si256((const __m256i*)(words + i))));
+    }
+    return avx2_sum(acc);
+}
+
+CH_TARGET("avx2")
+static ch_word avx2_and_count(const u64* lhs, const u64* rhs, ch_word count)
+{
+    __m256i acc = _mm256_setzero_si256();
+    for(ch_word i = 0; i + 4 <= count; i += 4){
+        const __m256i v = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(lhs + i)),
+                                           _mm256_loadu_si256((const __m256i*)(rhs + i)));
+        acc = _mm256_add_epi64(acc, avx2_popcount(v));
+    }
+    return avx2_sum(acc);
+}
+
+#endif
+
+//Count the bits in count words
+static ch_word _count_words(const u64* words, ch_word count)
+{
+    ch_word result = 0;
+#if defined(CH_BITSET_AVX2)
+    if(bitset_use_avx2 && count >= 4){
+        result = avx2_count(words, count);
+        words += count & ~3LL;
+        count &= 3;
+    }
+#endif
+
+    return result + (bitset_use_popcnt ? popcnt_count(words, count) : scalar_count(words, count));
+}
+
+static inline ch_word _popcount(u64 word)
+{
+    return __builtin_popcountll(word);
+}
+
+
+/******************************************************************************************************************
+ * Bulk operations
+ ******************************************************************************************************************/
+
+typedef void (*bitset_op_f)(u64* dst, const u64* src, ch_word count);
+
+#if defined(CH_BITSET_AVX2)
+    #define define_avx2_bitset_op(NAME, OP)\
+    CH_TARGET("avx2")\
+    static void avx2_##NAME(u64* dst, const u64* src, ch_word count)\
+    {\
+        for(ch_word i = 0; i < count; i += 4){\
+            const __m256i lhs = _mm256_loadu_si256((const __m256i*)(dst + i));\
+            const __m256i rhs = _mm256_loadu_si256((const __m256i*)(src + i));\
+            _mm256_storeu_si256((__m256i*)(dst + i), OP);\
+        }\
+    }
+#else
+    #define define_avx2_bitset_op(NAME, OP)
+#endif
+
+//count is always a whole number of vectors
+#define define_bitset_op(NAME, EXPR, OP)\
+static void scalar_##NAME(u64* dst, const u64* src, ch_word count)\
+{\
+    for(ch_word i = 0; i < count; i++){\
+        const u64 lhs = dst[i];\
+        const u64 rhs = src[i];\
+        dst[i] = EXPR;\
+    }\
+}\
+define_avx2_bitset_op(NAME, OP)
+
+define_bitset_op(and,    lhs & rhs,  _mm256_and_si256(lhs, rhs))
+define_bitset_op(or,     lhs | rhs,  _mm256_or_si256(lhs, rhs))
+define_bitset_op(xor,    lhs ^ rhs,  _mm256_xor_si256(lhs, rhs))
+define_bitset_op(andnot, lhs & ~rhs, _mm256_andnot_si256(rhs, lhs))
+
+static ch_word _bitset_apply(ch_bitset_t* this, const ch_bitset_t* that, bitset_op_f scalar_op, bitset_op_f avx2_op)
+{
+    if(this->size != that->size){
+        printf("Error: bitsets are different sizes (%lli vs %lli)\n", this->size, that->size);
+        return -1;
+    }
+
+    (void)avx2_op;
+#if defined(CH_BITSET_AVX2)
+    if(bitset_use_avx2){
+        avx2_op(this->_words, that->_words, this->_word_count);
+        this->_rank_valid = false;
+        return 0;
+    }
+#endif
+
+    scalar_op(this->_words, that->_words, this->_word_count);
+    this->_rank_valid = false;
+    return 0;
+}
+
+#if defined(CH_BITSET_AVX2)
+    #define BITSET_APPLY(NAME) _bitset_apply(this, that, scalar_##NAME, avx2_##NAME)
+#else
+    #define BITSET_APPLY(NAME) _bitset_apply(this, that, scalar_##NAME, NULL)
+#endif
+
+ch_word bitset_and(ch_bitset_t* this, const ch_bitset_t* that)     { return BITSET_APPLY(and); }
+ch_word bitset_or(ch_bitset_t* this, const ch_bitset_t* that)      { return BITSET_APPLY(or); }
+ch_word bitset_xor(ch_bitset_t* this, const ch_bitset_t* that)     { return BITSET_APPLY(xor); }
+ch_word bitset_andnot(ch_bitset_t* this, const ch_bitset_t* that)  { return BITSET_APPLY(andnot); }
+
+
+ch_word bitset_count(const ch_bitset_t* this)
+{
+    return _count_words(this->_words, this->_word_count);
+}
+
+ch_word bitset_and_count(const ch_bitset_t* this, const ch_bitset_t* that)
+{
+    if(this->size != that->size){
+        printf("Error: bitsets are different sizes (%lli vs %lli)\n", this->size, that->size);
+        return -1;
+    }
+
+#if defined(CH_BITSET_AVX2)
+    if(bitset_use_avx2){
+        return avx2_and_count(this->_words, that->_words, this->_word_count);
+    }
+#endif
+
+    ch_word result = 0;
+    for(ch_word i = 0; i < this->_word_count; i++){
+        result += _popcount(this->_words[i] & that->_words[i]);
+    }
+    return result;
+}
+
+ch_word bitset_eq(const ch_bitset_t* this, const ch_bitset_t* that)
+{
+    if(this->size != that->size){
+        return 0;
+    }
+
+    //The padding is always clear in both
+    return memcmp(this->_words, that->_words, this->_word_count * sizeof(u64)) == 0;
+}
+
+
+void bitset_set_all(ch_bitset_t* this)
+{
+    memset(this->_words, 0xff, _used_words(this) * sizeof(u64));
+    _bitset_mask_tail(this);
+    this->_rank_valid = false;
+}
+
+void bitset_clear_all(ch_bitset_t* this)
+{
+    memset(this->_words, 0, this->_word_count * sizeof(u64));
+    this->_rank_valid = false;
+}
+
+ch_word bitset_resize(ch_bitset_t* this, ch_word new_size)
+{
+    if(new_size < 0){
+        printf("Error: invalid bitset size (%lli)\n", new_size);
+        return -1;
+    }
+
+    const ch_word needed = (new_size + 63) >> 6;
+    const ch_word word_count = MAX(round_up(needed, 4), 4);
+    if(word_count != this->_word_count){
+        u64* words = (u64*)realloc(this->_words, word_count * sizeof(u64));
+        if(!words){
+            printf("Could not allocate memory to resize bitset. Giving up\n");
+            return -1;
+        }
+        if(word_count > this->_word_count){
+            memset(words + this->_word_count, 0, (word_count - this->_word_count) * sizeof(u64));
+        }
+        this->_words = words;
+        this->_word_count = word_count;
+    }
+
+    this->size = new_size;
+    _bitset_mask_tail(this);
+    this->_rank_valid = false;
+    return 0;
+}
+
+
+/******************************************************************************************************************
+ * Searching
+ ******************************************************************************************************************/
+
+#if defined(CH_BITSET_AVX2)
+//Skip over whole vectors of zero words, starting at a vector boundary. Returns the first word that may be non-zero
+CH_TARGET("avx2")
+static ch_word avx2_skip_zeros(const u64* words, ch_word word, ch_word count)
+{
+    for(; word + 4 <= count; word += 4){
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(words + word));
+        if(!_mm256_testz_si256(v, v)){
+            break;
+        }
+    }
+    return word;
+}
+#endif
+
+ch_word _bitset_next_set_word(const ch_bitset_t* this, ch_word word)
+{
+    const u64* words = this->_words;
+    const ch_word count = this->_word_count;
+
+#if defined(CH_BITSET_AVX2)
+    //Long runs of empty words are common in sparse sets, so skip them a vector at a time
+    if(bitset_use_avx2){
+        for(; word < count && (word & 3); word++){
+            if(words[word]){
+                return (word << 6) + __builtin_ctzll(words[word]);
+            }
+        }
+        word = avx2_skip_zeros(words, word, count);
+    }
+#endif
+
+    for(; word < count; word++){
+        if(words[word]){
+            return (word << 6) + __builtin_ctzll(words[word]);
+        }
+    }
+
+    return -1;
+}
+
+ch_word bitset_next_clear(const ch_bitset_t* this, ch_word idx)
+{
+    idx = MAX(idx, 0);
+    if(idx >= this->size){
+        return -1;
+    }
+
+    const ch_word used = _used_words(this);
+    ch_word word = idx >> 6;
+    u64 bits = ~this->_words[word] & (~0ULL << (idx & 63));
+    while(!bits){
+        if(++word >= used){
+            return -1;
+        }
+        bits = ~this->_words[word];
+    }
+
+    //The clear bits past the end don't count
+    const ch_word result = (word << 6) + __builtin_ctzll(bits);
+    return result < this->size ? result : -1;
+}
+
+ch_word bitset_to_indices(const ch_bitset_t* this, ch_word idx, ch_word* out, ch_word max)
+{
+    idx = MAX(idx, 0);
+    if(idx >= this->size || max <= 0){
+        return 0;
+    }
+
+    const ch_word used = _used_words(this);
+    ch_word result = 0;
+    ch_word word = idx >> 6;
+    u64 bits = this->_words[word] & (~0ULL << (idx & 63));
+    for(;;){
+        //Peel off the lowest set bit until the word is empty
+        while(bits){
+            out[result++] = (word << 6) + __builtin_ctzll(bits);
+            if(result == max){
+                return result;
+            }
+            bits &= bits - 1;
+        }
+
+        if(++word >= used){
+            return result;
+        }
+        bits = this->_words[word];
+    }
+}
+
+
+/******************************************************************************************************************
+ * Rank and select
+ ******************************************************************************************************************/
+
+ch_word bitset_build_rank(ch_bitset_t* this)
+{
+    const ch_word words_per_block = CH_BITSET_RANK_BLOCK / 64;
+    const ch_word blocks = (this->_word_count + words_per_block - 1) / words_per_block;
+    if(blocks != this->_rank_blocks || !this->_rank){
+        i64* rank = (i64*)realloc(this->_rank, (blocks + 1) * sizeof(i64));
+        if(!rank){
+            printf("Could not allocate memory for bitset rank index. Giving up\n");
+            return -1;
+        }
+        this->_rank = rank;
+        this->_rank_blocks = blocks;
+    }
+
+    i64 total = 0;
+    for(ch_word block = 0; block < blocks; block++){
+        this->_rank[block] = total;
+        const ch_word first = block * words_per_block;
+        total += _count_words(this->_words + first, MIN(words_per_block, this->_word_count - first));
+    }
+    this->_rank[blocks] = total;
+
+    this->_rank_valid = true;
+    return 0;
+}
+
+ch_word bitset_rank(const ch_bitset_t* this, ch_word idx)
+{
+    idx = MIN(MAX(idx, 0), this->size);
+
+    ch_word result = 0;
+    ch_word first = 0;
+    if(this->_rank_valid){
+        const ch_word block = idx / CH_BITSET_RANK_BLOCK;
+        result = this->_rank[block];
+        first = block * (CH_BITSET_RANK_BLOCK / 64);
+    }
+
+    const ch_word word = idx >> 6;
+    result += _count_words(this->_words + first, word - first);
+    if(idx & 63){
+        result += _popcount(this->_words[word] & ((1ULL << (idx & 63)) - 1));
+    }
+
+    return result;
+}
+
+#if defined(CH_BITSET_AVX2)
+//Deposit a single bit into the position of the rank'th set bit
+CH_TARGET("bmi2")
+static ch_word bmi2_select_word(u64 bits, ch_word rank)
+{
+    return __builtin_ctzll(_pdep_u64(1ULL << rank, bits));
+}
+#endif
+
+//Return the position of the rank'th set bit in a word that has more than rank bits set
+static inline ch_word _select_word(u64 bits, ch_word rank)
+{
+#if defined(CH_BITSET_AVX2)
+    if(bitset_use_bmi2){
+        return bmi2_select_word(bits, rank);
+    }
+#endif
+
+    for(; rank; rank--){
+        bits &= bits - 1;
+    }
+    return __builtin_ctzll(bits);
+}
+
+ch_word bitset_select(const ch_bitset_t* this, ch_word rank)
+{
+    if(rank < 0){
+        return -1;
+    }
+
+    ch_word word = 0;
+    if(this->_rank_valid){
+        if(rank >= this->_rank[this->_rank_blocks]){
+            return -1;
+        }
+
+        //Find the last block that starts at or before rank
+        ch_word lo = 0;
+        ch_word hi = this->_rank_blocks - 1;
+        while(lo < hi){
+            const ch_word mid = (lo + hi + 1) / 2;
+            if(this->_rank[mid] <= rank){
+                lo = mid;
+            }
+            else{
+                hi = mid - 1;
+            }
+        }
+
+        rank -= this->_rank[lo];
+        word = lo * (CH_BITSET_RANK_BLOCK / 64);
+    }
+
+    for(; word < this->_word_count; word++){
+        const ch_word count = _popcount(this->_words[word]);
+        if(rank < count){
+            return (word << 6) + _select_word(this->_words[word], rank);
+        }
+        rank -= count;
+    }
+
+    return -1;
+}
+
+
+void bitset_delete(ch_bitset_t* this)
+{
+    if(!this){
+        return;
+    }
+
+    free(this->_rank);
+    free(this->_words);
+    free(this);
+}
+
+ch_bitset_t* ch_bitset_new(ch_word size)
+{
+    if(size < 0){
+        printf("Error: invalid bitset size (%lli)\n", size);
+        return NULL;
+    }
+
+    ch_bitset_t* result = (ch_bitset_t*)calloc(1,sizeof(ch_bitset_t));
+    if(!result){
+        printf("Could not allocate memory for new bitset structure. Giving up\n");
+        return NULL;
+    }
+
+    if(bitset_resize(result, size)){
+        bitset_delete(result);
+        return NULL;
+    }
+
+    return result;
+}
@@ -0,0 +1,133 @@
+/*
+ * bitset.h
+ *
+ * Dense, fixed size set of bits, for membership tests and filters over large id spaces. Bits are packed 64 to a word,
+ * and the words are padded to whole 256 bit vectors, so that the bulk operations (and, or, xor, andnot and popcount)
+ * run over them with AVX2 if the CPU supports it, or with plain word at a time loops otherwise.
+ *
+ * Set bits can be walked with bitset_next_set() or CH_BITSET_FOREACH, or decoded into an array of indices in bulk with
+ * bitset_to_indices(), all of which use tzcnt to jump straight to the next set bit.
+ *
+ * bitset_rank() and bitset_select() work on any bitset, by scanning. Call bitset_build_rank() after the bits are set up
+ * to build a small index (one i64 per 512 bits), which makes rank O(1) and select O(log n). Any change to the bits makes
+ * the index stale, until it is built again. Not thread safe.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef BITSET_H_
+#define BITSET_H_
+
+#include "../../types/types.h"
+#include "../../utils/util.h"
+
+#include <stdio.h>
+
+//Bits in each rank index block
+#define CH_BITSET_RANK_BLOCK 512
+
+struct ch_bitset;
+typedef struct ch_bitset ch_bitset_t;
+
+struct ch_bitset{
+    ch_word size; //Number of bits in the set
+
+    // Members prefixed with "_" are nominally "private" Don't touch my privates!
+    u64* _words; //The bits. Bits past size are always zero
+    ch_word _word_count; //Number of words allocated, a multiple of 4
+    i64* _rank; //Set bits before each rank block, and the total at the end
+    ch_word _rank_blocks;
+    ch_bool _rank_valid; //The rank index is up to date
+};
+
+
+//Set, unset, flip and test a single bit, with bounds checking
+static inline void bitset_set(ch_bitset_t* this, ch_word idx)
+{
+    CH_BOUNDS_CHECK(idx >= 0 && idx < this->size, , "Index (%lli) is out of the valid range [0,%lli]\n", idx, this->size - 1);
+    this->_words[idx >> 6] |= 1ULL << (idx & 63);
+    this->_rank_valid = false;
+}
+
+static inline void bitset_unset(ch_bitset_t* this, ch_word idx)
+{
+    CH_BOUNDS_CHECK(idx >= 0 && idx < this->size, , "Index (%lli) is out of the valid range [0,%lli]\n", idx, this->size - 1);
+    this->_words[idx >> 6] &= ~(1ULL << (idx & 63));
+    this->_rank_valid = false;
+}
+
+static inline void bitset_flip(ch_bitset_t* this, ch_word idx)
+{
+    CH_BOUNDS_CHECK(idx >= 0 && idx < this->size, , "Index (%lli) is out of the valid range [0,%lli]\n", idx, this->size - 1);
+    this->_words[idx >> 6] ^= 1ULL << (idx & 63);
+    this->_rank_valid = false;
+}
+
+static inline ch_bool bitset_test(const ch_bitset_t* this, ch_word idx)
+{
+    CH_BOUNDS_CHECK(idx >= 0 && idx < this->size, false, "Index (%lli) is out of the valid range [0,%lli]\n", idx, this->size - 1);
+    return (this->_words[idx >> 6] >> (idx & 63)) & 1;
+}
+
+//Set or clear every bit
+void bitset_set_all(ch_bitset_t* this);
+void bitset_clear_all(ch_bitset_t* this);
+//Change the number of bits. New bits are clear. Returns 0 on success, -1 on failure
+ch_word bitset_resize(ch_bitset_t* this, ch_word new_size);
+
+//Combine that into this, in place: this &= that, this |= that, this ^= that, and this &= ~that. Both must be the same
+//size. Returns 0 on success, -1 on failure
+ch_word bitset_and(ch_bitset_t* this, const ch_bitset_t* that);
+ch_word bitset_or(ch_bitset_t* this, const ch_bitset_t* that);
+ch_word bitset_xor(ch_bitset_t* this, const ch_bitset_t* that);
+ch_word bitset_andnot(ch_bitset_t* this, const ch_bitset_t* that);
+
+//Return the number of set bits
+ch_word bitset_count(const ch_bitset_t* this);
+//Return the number of bits set in both this and that, without changing either, or -1 if they are not the same size
+ch_word bitset_and_count(const ch_bitset_t* this, const ch_bitset_t* that);
+//Check for equality
+ch_word bitset_eq(const ch_bitset_t* this, const ch_bitset_t* that);
+
+ch_word _bitset_next_set_word(const ch_bitset_t* this, ch_word word);
+//Return the first set bit at or after idx, or -1 if there is none
+static inline ch_word bitset_next_set(const ch_bitset_t* this, ch_word idx)
+{
+    if(unlikely(idx >= this->size)){
+        return -1;
+    }
+
+    //Usually the next bit is in the same word. Otherwise skip over empty words
+    idx = MAX(idx, 0);
+    const u64 bits = this->_words[idx >> 6] & (~0ULL << (idx & 63));
+    if(bits){
+        return (idx & ~63LL) + __builtin_ctzll(bits);
+    }
+
+    return _bitset_next_set_word(this, (idx >> 6) + 1);
+}
+//Return the first clear bit at or after idx, or -1 if there is none
+ch_word bitset_next_clear(const ch_bitset_t* this, ch_word idx);
+
+//Write the indices of up to max set bits, starting from idx, into out. Returns the number written. To carry on, call
+//again from one past the last index written
+ch_word bitset_to_indices(const ch_bitset_t* this, ch_word idx, ch_word* out, ch_word max);
+
+//Build the rank index. Returns 0 on success, -1 on failure
+ch_word bitset_build_rank(ch_bitset_t* this);
+//Return the number of set bits before idx
+ch_word bitset_rank(const ch_bitset_t* this, ch_word idx);
+//Return the index of the set bit with the given rank (0 for the first set bit), or -1 if there are not that many
+ch_word bitset_select(const ch_bitset_t* this, ch_word rank);
+
+//Free the resources associated with this bitset
+void bitset_delete(ch_bitset_t* this);
+
+//Make a new bitset with size bits, all clear
+ch_bitset_t* ch_bitset_new(ch_word size);
+
+#define CH_BITSET_FOREACH(BITSET, IDX) \
+    for(ch_word IDX = bitset_next_set(BITSET, 0); IDX >= 0; IDX = bitset_next_set(BITSET, IDX + 1))
+
+#endif // BITSET_H_
@@ -26,9 +26,140 @@
 
 #include <assert.h>
 
+
+/******************************************************************************************************************
+ * SPSC mode. The indices run freely (they never wrap), so the number of elements is always tail - head, and the slot is
+ * the index masked by size - 1. Each cache line is written by only one of the threads, so the lines only move between
+ * cores when one side has to reload the other side's index.
+ ******************************************************************************************************************/
+struct ch_cbq_spsc{
+    //Written by the producer only
+    ch_word tail; //Index of the next slot to push into
+    ch_word cached_head; //The consumer's head, when the producer last looked
+    ch_byte _pad0[CH_ARRAY_ALIGN_CACHE_LINE - 2 * sizeof(ch_word)];
+
+    //Written by the consumer only
+    ch_word head; //Index of the front element
+    ch_word cached_tail; //The producer's tail, when the consumer last looked
+    ch_word in_use;
+    ch_byte _pad1[CH_ARRAY_ALIGN_CACHE_LINE - 3 * sizeof(ch_word)];
+};
+
+static inline void* _spsc_slot(ch_cbq_t* this, ch_word idx)
+{
+    return (ch_byte*)this->_array->first + (idx & this->_mask) * this->_array->_element_size;
+}
+
+//Return the number of elements the consumer can see, reloading the tail only if the cached copy has run out
+static inline ch_word _spsc_available(struct ch_cbq_spsc* spsc, ch_word wanted)
+{
+    ch_word available = spsc->cached_tail - spsc->head;
+    if(available < wanted){
+        spsc->cached_tail = __atomic_load_n(&spsc->tail, __ATOMIC_ACQUIRE);
+        available = spsc->cached_tail - spsc->head;
+    }
+    return available;
+}
+
+static void* _spsc_push_back_carray(ch_cbq_t* this, void* carray, ch_word* len_io)
+{
+    struct ch_cbq_spsc* spsc = this->_spsc;
+    const ch_word element_size = this->_array->_element_size;
+    const ch_word tail = spsc->tail;
+
+    ch_word len = *len_io;
+    if(len == 0){
+        *len_io = -1;
+        return NULL;
+    }
+
+    //Reload the head, which also makes sure the consumer has finished with the slots, only if they look full
+    ch_word space = this->size - (tail - spsc->cached_head);
+    if(space < len){
+        spsc->cached_head = __atomic_load_n(&spsc->head, __ATOMIC_ACQUIRE);
+        space = this->size - (tail - spsc->cached_head);
+    }
+    len = MIN(len, space);
+    *len_io = len;
+    if(len == 0){
+        return NULL;
+    }
+
+    //Copy items up until the wrap around point, then anything left over
+    void* result = _spsc_slot(this, tail);
+    const ch_word num_b4 = MIN(this->size - (tail & this->_mask), len);
+    memcpy(result, carray, num_b4 * element_size);
+    if(num_b4 < len){
+        memcpy(this->_array->first, (char*)carray + num_b4 * element_size, (len - num_b4) * element_size);
+    }
+
+    //Publish the elements
+    __atomic_store_n(&spsc->tail, tail + len, __ATOMIC_RELEASE);
+    return result;
+}
+
+static void* _spsc_push_back(ch_cbq_t* this, void* value)
+{
+    struct ch_cbq_spsc* spsc = this->_spsc;
+    const ch_word tail = spsc->tail;
+
+    if(tail - spsc->cached_head >= this->size){
+        spsc->cached_head = __atomic_load_n(&spsc->head, __ATOMIC_ACQUIRE);
+        if(tail - spsc->cached_head >= this->size){
+            return NULL; //Full
+        }
+    }
+
+    void* result = _spsc_slot(this, tail);
+    memcpy(result, value, this->_array->_element_size);
+    __atomic_store_n(&spsc->tail, tail + 1, __ATOMIC_RELEASE);
+    return result;
+}
+
+static void* _spsc_peek_front(ch_cbq_t* this)
+{
+    struct ch_cbq_spsc* spsc = this->_spsc;
+    if(_spsc_available(spsc, 1) == 0){
+        return NULL; //Nothing to peek!
+    }
+
+    return _spsc_slot(this, spsc->head);
+}
+
+static int _spsc_pop_front(ch_cbq_t* this)
+{
+    struct ch_cbq_spsc* spsc = this->_spsc;
+    if(_spsc_available(spsc, 1) == 0){
+        return -1; //Nothing to pop!
+    }
+
+    //Hand the slot back to the producer
+    __atomic_store_n(&spsc->head, spsc->head + 1, __ATOMIC_RELEASE);
+    if(spsc->in_use){
+        spsc->in_use--;
+    }
+
+    return 0;
+}
+
+static void* _spsc_use_front(ch_cbq_t* this)
+{
+    struct ch_cbq_spsc* spsc = this->_spsc;
+    if(_spsc_available(spsc, spsc->in_use + 1) <= spsc->in_use){
+        return NULL; //Nothing to use, or everything in use
+    }
+
+    return _spsc_slot(this, spsc->head + spsc->in_use++);
+}
+
+
 //Remove element from the front of the queue.
 int cbq_pop_front(ch_cbq_t* this)
 {
+    if(this->_spsc){
+        return _spsc_pop_front(this);
+    }
+
     if(this->count == 0){//Nothing to pop!
         return -1;
     }
@@ -53,6 +184,10 @@ int cbq_pop_front(ch_cbq_t* this)
 //Return pointer to the front of the buffer do not remove item
 void* cbq_peek_front(ch_cbq_t* this)
 {
+    if(this->_spsc){
+        return _spsc_peek_front(this);
+    }
+
     if(this->count == 0){
         return NULL; //Nothing to peek!
     }
@@ -67,6 +202,10 @@ void* cbq_peek_front(ch_cbq_t* this)
 //Get a pointer to the front of the queue and mark it as "in use".
 void* cbq_use_front(ch_cbq_t* this)
 {
+    if(this->_spsc){
+        return _spsc_use_front(this);
+    }
+
     assert(this->in_use <= this->count);
     assert(this->in_use <= this->size);
     assert(this->in_use >= 0);
@@ -105,6 +244,12 @@ void* cbq_use_front(ch_cbq_t* this)
 //Get a pointer to the front of the queue and mark it as "out of use".
 void cbq_unuse_front(ch_cbq_t* this)
 {
+    if(this->_spsc){
+        if(this->_spsc->in_use){
+            this->_spsc->in_use--;
+        }
+        return;
+    }
 
     assert(this->in_use <= this->count);
     assert(this->in_use <= this->size);
@@ -131,6 +276,9 @@ void cbq_unuse_front(ch_cbq_t* this)
 /*Assign at most size elements from the C cbq*/
 void* cbq_push_back_carray(ch_cbq_t* this, void* carray, ch_word* len_io)
 {
+    if(this->_spsc){
+        return _spsc_push_back_carray(this, carray, len_io);
+    }
 
     ch_word len = *len_io;
     if(len == 0){
@@ -176,6 +324,10 @@ void* cbq_push_back_carray(ch_cbq_t* this, void* carray, ch_word* len_io)
 /* Put an element at the back of the arary values*/
 void* cbq_push_back(ch_cbq_t* this, void* value)
 {
+    if(this->_spsc){
+        return _spsc_push_back(this, value);
+    }
+
     ch_word len = 1; //Throw away value
     void* result = cbq_push_back_carray(this,value,&len);
     if(len != 1){
@@ -204,12 +356,56 @@ ch_cbq_t* ch_cbq_new(ch_word size, ch_word element_size)
 }
 
 
+ch_cbq_t* ch_cbq_new_spsc(ch_word size, ch_word element_size)
+{
+    if(size <= 0){
+        printf("Error: invalid cbq size (%lli)\n", size);
+        return NULL;
+    }
+
+    ch_word pow2 = 1;
+    while(pow2 < size){
+        pow2 <<= 1;
+    }
+
+    ch_cbq_t* result = ch_cbq_new(pow2, element_size);
+    if(!result){
+        return NULL;
+    }
+
+    result->_spsc = (struct ch_cbq_spsc*)aligned_alloc(CH_ARRAY_ALIGN_CACHE_LINE, sizeof(struct ch_cbq_spsc));
+    if(!result->_spsc){
+        printf("Could not allocate memory for new cbq structure. Giving up\n");
+        cbq_delete(result);
+        return NULL;
+    }
+    memset(result->_spsc, 0, sizeof(struct ch_cbq_spsc));
+    result->_mask = pow2 - 1;
+
+    return result;
+}
+
+
+ch_word cbq_count(ch_cbq_t* this)
+{
+    if(!this->_spsc){
+        return this->count;
+    }
+
+    //Read the head first. Both only grow, so the tail can't be seen behind it, but it may have moved on since
+    const ch_word head = __atomic_load_n(&this->_spsc->head, __ATOMIC_ACQUIRE);
+    const ch_word tail = __atomic_load_n(&this->_spsc->tail, __ATOMIC_ACQUIRE);
+    return MIN(tail - head, this->size);
+}
+
+
 void cbq_delete(ch_cbq_t* this)
 {
     if(this->_array){
         array_delete(this->_array);
     }
 
+    free(this->_spsc);
     free(this);
 }
 
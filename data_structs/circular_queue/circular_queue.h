@@ -5,6 +5,10 @@
  * items from the queue. All operations are O(c) time with the size of the queue. The structure also provides the ability to
  * push an array of times on to the queue which is O(n) with the size of the array.
  *
+ * Queues made with ch_cbq_new_spsc() can be shared, without locks, between one producer thread and one consumer thread.
+ * The producer may only call cbq_push_back() and cbq_push_back_carray(). The consumer may only call cbq_peek_front(),
+ * cbq_pop_front(), cbq_use_front() and cbq_unuse_front(). Either may call cbq_count().
+ *
  * cbq.c
  *
  *  Created on: July 22, 2015
@@ -32,6 +36,9 @@ struct ch_cbq{
     ch_word _use_next_index;
 
     ch_array_t* _array; //Actual CBQ storage back end
+
+    ch_word _mask; //size - 1, in SPSC mode only
+    struct ch_cbq_spsc* _spsc; //Head and tail for SPSC mode, or NULL
 };
 
 //Get access to an element at the front of the list. Return a pointer to the element.
@@ -53,10 +60,21 @@ void* cbq_push_back(ch_cbq_t* this, void* value);
 //Push back count elements the C cbq to the back cbq-list
 void* cbq_push_back_carray(ch_cbq_t* this, void* ccbq, ch_word* count);
 
+//Return the number of elements in the queue. In SPSC mode, where count is not kept up to date, this is a snapshot that
+//may be out of date by the time it returns
+ch_word cbq_count(ch_cbq_t* this);
+
 //Free the resources associated with this cbq, assumes that individual items have been freed
 void cbq_delete(ch_cbq_t* this);
 
 //Create a new circualr buffer queue structure with size queue slots in it, each with element_size storage.
 ch_cbq_t* ch_cbq_new(ch_word size, ch_word element_size);
 
+//Create a new queue for a single producer thread and a single consumer thread, with size rounded up to a power of 2.
+//The head and tail indices are kept on separate cache lines, and handed between threads with acquire/release atomics.
+//Each side keeps a cached copy of the other's index, and only reloads it when the queue looks full (or empty). The
+//count and in_use members are not kept up to date in this mode, use cbq_count(). A pointer returned by a push is only
+//valid until the consumer pops the element.
+ch_cbq_t* ch_cbq_new_spsc(ch_word size, ch_word element_size);
+
 #endif // CBQ_H_
@@ -0,0 +1,328 @@
+/*
+ * deque.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../../utils/util.h"
+#include "../../types/types.h"
+#include "deque.h"
+
+#define CH_DEQUE_MAP_MIN 8
+
+
+//Address of the element at logical index idx, no bounds checking
+static inline void* _deque_at(ch_deque_t* this, ch_word idx)
+{
+    const ch_word pos = this->_head + idx;
+    return this->_map[this->_map_first + (pos >> this->_chunk_shift)] + (pos & this->_chunk_mask) * this->_element_size;
+}
+
+static inline ch_deque_it _deque_it(ch_deque_t* this, ch_word idx)
+{
+    ch_deque_it result = { ._idx = idx, .value = idx >= 0 && idx < this->count ? _deque_at(this, idx) : NULL };
+    return result;
+}
+
+
+static ch_byte* _chunk_alloc(ch_deque_t* this)
+{
+    if(this->_spare){
+        ch_byte* result = this->_spare;
+        this->_spare = NULL;
+        return result;
+    }
+
+    ch_byte* result = (ch_byte*)malloc((this->_chunk_mask + 1) * this->_element_size);
+    if(!result){
+        printf("Could not allocate memory for deque chunk\n");
+    }
+
+    return result;
+}
+
+static void _chunk_release(ch_deque_t* this, ch_byte* chunk)
+{
+    if(!this->_spare){
+        this->_spare = chunk;
+        return;
+    }
+
+    free(chunk);
+}
+
+
+//Make sure there is a free map slot before (front = true) or after the chunks in use. Chunks stay where they are, only
+//the pointers to them move.
+static ch_word _map_make_room(ch_deque_t* this, ch_bool front)
+{
+    if(front ? this->_map_first > 0 : this->_map_first + this->_map_count < this->_map_size){
+        return 0;
+    }
+
+    //Plenty of space on the other side, so just recentre
+    if(this->_map_count < this->_map_size / 2){
+        const ch_word new_first = (this->_map_size - this->_map_count) / 2;
+        memmove(this->_map + new_first, this->_map + this->_map_first, this->_map_count * sizeof(ch_byte*));
+        this->_map_first = new_first;
+        return 0;
+    }
+
+    const ch_word new_size = MAX(this->_map_size * 2, CH_DEQUE_MAP_MIN);
+    ch_byte** new_map = (ch_byte**)malloc(new_size * sizeof(ch_byte*));
+    if(!new_map){
+        printf("Could not allocate memory for deque map\n");
+        return -1;
+    }
+
+    const ch_word new_first = (new_size - this->_map_count) / 2;
+    if(this->_map){
+        memcpy(new_map + new_first, this->_map + this->_map_first, this->_map_count * sizeof(ch_byte*));
+        free(this->_map);
+    }
+
+    this->_map       = new_map;
+    this->_map_size  = new_size;
+    this->_map_first = new_first;
+    return 0;
+}
+
+
+void* deque_off(ch_deque_t* this, ch_word idx)
+{
+    idx = idx < 0 ? idx + this->count : idx;
+    if(idx < 0 || idx >= this->count){
+        printf("Index (%lli) is out of the valid range [%lli,%lli]\n", idx, -1 * this->count, this->count - 1);
+        return NULL;
+    }
+
+    return _deque_at(this, idx);
+}
+
+
+ch_deque_it deque_first(ch_deque_t* this)
+{
+    return _deque_it(this, 0);
+}
+
+ch_deque_it deque_last(ch_deque_t* this)
+{
+    return _deque_it(this, this->count - 1);
+}
+
+ch_deque_it deque_end(ch_deque_t* this)
+{
+    return _deque_it(this, this->count);
+}
+
+
+void deque_next(ch_deque_t* this, ch_deque_it* it)
+{
+    it->_idx++;
+    if(it->_idx <= 0 || it->_idx >= this->count){
+        *it = _deque_it(this, it->_idx);
+        return;
+    }
+
+    //Within a chunk it's just a pointer bump
+    if((this->_head + it->_idx) & this->_chunk_mask){
+        it->value = (ch_byte*)it->value + this->_element_size;
+        return;
+    }
+
+    it->value = _deque_at(this, it->_idx);
+}
+
+void deque_prev(ch_deque_t* this, ch_deque_it* it)
+{
+    it->_idx--;
+    if(it->_idx < 0 || it->_idx >= this->count - 1){
+        *it = _deque_it(this, it->_idx);
+        return;
+    }
+
+    if((this->_head + it->_idx + 1) & this->_chunk_mask){
+        it->value = (ch_byte*)it->value - this->_element_size;
+        return;
+    }
+
+    it->value = _deque_at(this, it->_idx);
+}
+
+void deque_forward(ch_deque_t* this, ch_deque_it* it, ch_word amount)
+{
+    *it = _deque_it(this, it->_idx + amount);
+}
+
+void deque_back(ch_deque_t* this, ch_deque_it* it, ch_word amount)
+{
+    *it = _deque_it(this, it->_idx - amount);
+}
+
+
+void* deque_push_front(ch_deque_t* this, const void* value)
+{
+    if(this->_head == 0){
+        if(_map_make_room(this, true)){
+            return NULL;
+        }
+
+        ch_byte* chunk = _chunk_alloc(this);
+        if(!chunk){
+            return NULL;
+        }
+
+        this->_map_first--;
+        this->_map_count++;
+        this->_map[this->_map_first] = chunk;
+        this->_head = this->_chunk_mask + 1;
+    }
+
+    this->_head--;
+    this->count++;
+
+    void* result = _deque_at(this, 0);
+    memcpy(result, value, this->_element_size);
+    return result;
+}
+
+
+void* deque_push_back(ch_deque_t* this, const void* value)
+{
+    const ch_word pos = this->_head + this->count;
+    if((pos >> this->_chunk_shift) == this->_map_count){
+        if(_map_make_room(this, false)){
+            return NULL;
+        }
+
+        ch_byte* chunk = _chunk_alloc(this);
+        if(!chunk){
+            return NULL;
+        }
+
+        this->_map[this->_map_first + this->_map_count] = chunk;
+        this->_map_count++;
+    }
+
+    this->count++;
+
+    void* result = _deque_at(this, this->count - 1);
+    memcpy(result, value, this->_element_size);
+    return result;
+}
+
+
+void deque_clear(ch_deque_t* this)
+{
+    for(ch_word i = 0; i < this->_map_count; i++){
+        _chunk_release(this, this->_map[this->_map_first + i]);
+    }
+
+    this->count      = 0;
+    this->_head      = 0;
+    this->_map_count = 0;
+    this->_map_first = this->_map_size / 2;
+}
+
+
+void deque_pop_front(ch_deque_t* this)
+{
+    if(this->count == 0){
+        return;
+    }
+
+    if(this->count == 1){
+        deque_clear(this);
+        return;
+    }
+
+    this->_head++;
+    this->count--;
+
+    if(this->_head > this->_chunk_mask){
+        _chunk_release(this, this->_map[this->_map_first]);
+        this->_map_first++;
+        this->_map_count--;
+        this->_head = 0;
+    }
+}
+
+
+void deque_pop_back(ch_deque_t* this)
+{
+    if(this->count == 0){
+        return;
+    }
+
+    if(this->count == 1){
+        deque_clear(this);
+        return;
+    }
+
+    this->count--;
+
+    //Is the last chunk now empty?
+    const ch_word chunks_used = (this->_head + this->count + this->_chunk_mask) >> this->_chunk_shift;
+    if(chunks_used < this->_map_count){
+        this->_map_count--;
+        _chunk_release(this, this->_map[this->_map_first + this->_map_count]);
+    }
+}
+
+
+ch_deque_it deque_find(ch_deque_t* this, ch_deque_it* begin, ch_deque_it* end, void* value)
+{
+    ch_deque_it it = *begin;
+    for(; it._idx < end->_idx && it.value; deque_next(this, &it)){
+        if(!this->_cmp(it.value, value)){
+            return it;
+        }
+    }
+
+    return *end;
+}
+
+
+void deque_delete(ch_deque_t* this)
+{
+    deque_clear(this);
+    free(this->_spare);
+    free(this->_map);
+    free(this);
+}
+
+
+ch_deque_t* ch_deque_new(ch_word element_size, cmp_void_f cmp)
+{
+    if(element_size <= 0){
+        printf("Deque element size must be positive\n");
+        return NULL;
+    }
+
+    ch_deque_t* result = (ch_deque_t*)calloc(1, sizeof(ch_deque_t));
+    if(!result){
+        printf("Could not allocate memory for new deque structure. Giving up\n");
+        return NULL;
+    }
+
+    result->_cmp          = cmp;
+    result->_element_size = element_size;
+
+    //Largest power of 2 number of elements that fits in a chunk
+    while(((ch_word)2 << result->_chunk_shift) * element_size <= CH_DEQUE_CHUNK_BYTES){
+        result->_chunk_shift++;
+    }
+    result->_chunk_mask = ((ch_word)1 << result->_chunk_shift) - 1;
+
+    if(_map_make_room(result, false)){
+        free(result);
+        return NULL;
+    }
+
+    return result;
+}
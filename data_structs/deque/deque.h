@@ -0,0 +1,88 @@
+/*
+ * deque.h
+ *
+ * Double ended queue built from fixed size chunks. A map holds pointers to the chunks in order, with free slots at both
+ * ends, so pushing and popping at either end is O(1) (amortised over the occasional map resize) and never moves an
+ * element. Pointers to elements stay valid until that element is popped. Random access is O(1), with a shift and a
+ * mask to find the chunk and offset.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef DEQUE_H_
+#define DEQUE_H_
+
+#include "../../types/types.h"
+
+//Target size of each chunk. Chunks hold a power of 2 number of elements, at least 1.
+#define CH_DEQUE_CHUNK_BYTES 4096
+
+struct ch_deque;
+typedef struct ch_deque ch_deque_t;
+
+struct ch_deque{
+    ch_word count; //Return the actual number of elements in the deque
+
+    // Members prefixed with "_" are nominally "private" Don't touch my privates!
+    cmp_void_f _cmp; //Comparator function for find operations
+    ch_word _element_size;
+    ch_word _chunk_shift; //log2 of the number of elements per chunk
+    ch_word _chunk_mask; //Elements per chunk - 1
+    ch_byte** _map; //Chunks in order, used from _map_first for _map_count slots
+    ch_word _map_size; //Number of slots in the map
+    ch_word _map_first; //First used slot in the map
+    ch_word _map_count; //Number of chunks in use
+    ch_word _head; //Offset of the first element in the first chunk
+    ch_byte* _spare; //One free chunk, kept to avoid churning malloc() when pushing and popping across a chunk boundary
+};
+
+typedef struct {
+    //These state variables are private
+    ch_word _idx;
+
+    //This is public
+    void* value; //NULL at the end
+} ch_deque_it;
+
+
+//Return the element at a given offset, with bounds checking
+void* deque_off(ch_deque_t* this, ch_word idx);
+
+//Get the first entry
+ch_deque_it deque_first(ch_deque_t* this);
+//Get the last entry
+ch_deque_it deque_last(ch_deque_t* this);
+//Get the end
+ch_deque_it deque_end(ch_deque_t* this);
+
+//Step forwards by one entry
+void deque_next(ch_deque_t* this, ch_deque_it* it);
+//Step backwards by one entry
+void deque_prev(ch_deque_t* this, ch_deque_it* it);
+//Step forwards by amount
+void deque_forward(ch_deque_t* this, ch_deque_it* it, ch_word amount);
+//Step backwards by amount
+void deque_back(ch_deque_t* this, ch_deque_it* it, ch_word amount);
+
+//Put an element at the front of the deque. Returns a pointer to it, or NULL on failure
+void* deque_push_front(ch_deque_t* this, const void* value);
+//Remove the element at the front of the deque
+void deque_pop_front(ch_deque_t* this);
+//Put an element at the back of the deque. Returns a pointer to it, or NULL on failure
+void* deque_push_back(ch_deque_t* this, const void* value);
+//Remove the element at the back of the deque
+void deque_pop_back(ch_deque_t* this);
+
+//Remove all elements
+void deque_clear(ch_deque_t* this);
+
+//Find the first element in [begin,end) equal to value using the comparator function. Returns end if there is none
+ch_deque_it deque_find(ch_deque_t* this, ch_deque_it* begin, ch_deque_it* end, void* value);
+
+//Free the resources associated with this deque, assumes that individual items have been freed
+void deque_delete(ch_deque_t* this);
+
+ch_deque_t* ch_deque_new(ch_word element_size, cmp_void_f cmp);
+
+#endif /* DEQUE_H_ */
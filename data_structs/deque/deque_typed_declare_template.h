@@ -0,0 +1,160 @@
+/*
+ * deque_typed_declare_template.h
+ *
+ * Typed wrapper around ch_deque_t. The iterators work like the linked list iterators: value is NULL once the iterator
+ * has stepped off either end.
+ *
+ * Usage:
+ *     declare_ch_deque(NAME, TYPE)
+ *     define_ch_deque(NAME, TYPE)   (in exactly one .c file)
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef DEQUE_TYPED_DECLARE_TEMPLATE_H_
+#define DEQUE_TYPED_DECLARE_TEMPLATE_H_
+
+#include "../../types/types.h"
+#include "../../utils/util.h"
+#include "deque.h"
+
+#include <stdio.h>
+
+#define declare_ch_deque(NAME,TYPE) \
+\
+struct ch_deque_##NAME;\
+typedef struct ch_deque_##NAME ch_deque_##NAME##_t;\
+\
+typedef struct { \
+    ch_word _idx; \
+    TYPE* value;\
+} ch_deque_##NAME##_it;\
+\
+struct ch_deque_##NAME{\
+    ch_word count;  /*Return the actual number of elements in the deque*/\
+\
+    TYPE* (*off)(ch_deque_##NAME##_t* this, ch_word idx); /*Return the element at a given offset, with bounds checking*/\
+\
+    ch_deque_##NAME##_it (*first)(ch_deque_##NAME##_t* this); /*Get the first entry*/\
+    ch_deque_##NAME##_it (*last)(ch_deque_##NAME##_t* this); /*Get the last entry*/\
+    ch_deque_##NAME##_it (*end)(ch_deque_##NAME##_t* this); /*Get the end*/\
+\
+    void (*next)(ch_deque_##NAME##_t* this, ch_deque_##NAME##_it* it); /*Step forwards by one entry*/\
+    void (*prev)(ch_deque_##NAME##_t* this, ch_deque_##NAME##_it* it); /*Step backwards by one entry*/\
+    void (*forward)(ch_deque_##NAME##_t* this, ch_deque_##NAME##_it* it, ch_word amount); /*Step forwards by amount*/\
+    void (*back)(ch_deque_##NAME##_t* this, ch_deque_##NAME##_it* it, ch_word amount); /*Step backwards by amount*/\
+\
+    TYPE* (*push_front)(ch_deque_##NAME##_t* this, TYPE value); /* Put an element at the front of the deque*/\
+    void (*pop_front)(ch_deque_##NAME##_t* this); /* Remove the element at the front of the deque*/\
+    TYPE* (*push_back)(ch_deque_##NAME##_t* this, TYPE value); /* Put an element at the back of the deque*/\
+    void (*pop_back)(ch_deque_##NAME##_t* this); /* Remove the element at the back of the deque*/\
+    void (*clear)(ch_deque_##NAME##_t* this); /*Remove everything from the deque*/\
+\
+    void (*delete)(ch_deque_##NAME##_t* this); /*Free the resources associated with this deque, assumes that individual items have been freed*/\
+\
+    TYPE* (*push_back_carray)(ch_deque_##NAME##_t* this, const TYPE* carray, ch_word count); /*Push back count elements from the C array to the back of the deque*/\
+\
+    ch_word (*eq)(ch_deque_##NAME##_t* this, ch_deque_##NAME##_t* that); /*Check for equality*/\
+    ch_deque_##NAME##_it (*find)(ch_deque_##NAME##_t* this, ch_deque_##NAME##_it* begin, ch_deque_##NAME##_it* end, TYPE value); /*find the given value using the comparator function*/\
+\
+     /* Members prefixed with "_" are nominally "private" Don't touch my privates!*/\
+    ch_deque_t* _deque; /*Actual deque storage*/\
+};\
+\
+\
+ch_deque_##NAME##_t* ch_deque_##NAME##_new(ch_word(*cmp)(TYPE* lhs, TYPE* rhs) );\
+_declare_ch_deque_inline(NAME,TYPE)
+
+//Direct call versions of the hot operations, see the typed vector. Pushes only fall back to the out of line versions
+//when they need a new chunk.
+#define _declare_ch_deque_inline(NAME,TYPE)\
+\
+/*Return the element at a given offset. Negative offsets count back from the end (the last element)*/\
+static inline TYPE* ch_deque_##NAME##_off(ch_deque_##NAME##_t* this, ch_word idx)\
+{\
+    ch_deque_t* const d = this->_deque;\
+    idx = idx < 0 ? idx + d->count : idx;\
+    CH_BOUNDS_CHECK(idx >= 0 && idx < d->count, NULL, "Index (%lli) is out of the valid range [%lli,%lli]\n", idx, -1 * d->count, d->count - 1);\
+    const ch_word pos = d->_head + idx;\
+    return (TYPE*)d->_map[d->_map_first + (pos >> d->_chunk_shift)] + (pos & d->_chunk_mask);\
+}\
+\
+static inline TYPE* ch_deque_##NAME##_push_back(ch_deque_##NAME##_t* this, TYPE value)\
+{\
+    ch_deque_t* const d = this->_deque;\
+    const ch_word pos = d->_head + d->count;\
+    TYPE* result;\
+    if(likely(pos & d->_chunk_mask)){\
+        result = (TYPE*)d->_map[d->_map_first + (pos >> d->_chunk_shift)] + (pos & d->_chunk_mask);\
+        *result = value;\
+        d->count++;\
+    }\
+    else{\
+        result = (TYPE*)deque_push_back(d, &value);\
+    }\
+\
+    this->count = d->count;\
+    return result;\
+}\
+\
+static inline TYPE* ch_deque_##NAME##_push_front(ch_deque_##NAME##_t* this, TYPE value)\
+{\
+    ch_deque_t* const d = this->_deque;\
+    TYPE* result;\
+    if(likely(d->_head)){\
+        d->_head--;\
+        d->count++;\
+        result = (TYPE*)d->_map[d->_map_first] + d->_head;\
+        *result = value;\
+    }\
+    else{\
+        result = (TYPE*)deque_push_front(d, &value);\
+    }\
+\
+    this->count = d->count;\
+    return result;\
+}\
+\
+static inline void ch_deque_##NAME##_pop_front(ch_deque_##NAME##_t* this)\
+{\
+    deque_pop_front(this->_deque);\
+    this->count = this->_deque->count;\
+}\
+\
+static inline void ch_deque_##NAME##_pop_back(ch_deque_##NAME##_t* this)\
+{\
+    deque_pop_back(this->_deque);\
+    this->count = this->_deque->count;\
+}\
+\
+static inline void ch_deque_##NAME##_next(ch_deque_##NAME##_t* this, ch_deque_##NAME##_it* it)\
+{\
+    ch_deque_it base_it = { ._idx = it->_idx, .value = it->value };\
+    deque_next(this->_deque, &base_it);\
+    it->_idx = base_it._idx;\
+    it->value = (TYPE*)base_it.value;\
+}\
+\
+static inline void ch_deque_##NAME##_prev(ch_deque_##NAME##_t* this, ch_deque_##NAME##_it* it)\
+{\
+    ch_deque_it base_it = { ._idx = it->_idx, .value = it->value };\
+    deque_prev(this->_deque, &base_it);\
+    it->_idx = base_it._idx;\
+    it->value = (TYPE*)base_it.value;\
+}
+
+
+#define declare_ch_deque_cmp(NAME, TYPE) ch_word ch_deque_cmp_##NAME(TYPE* lhs, TYPE* rhs)
+
+
+//**********************************************************************************************************************
+//Shortcuts to make things more accessible
+#define CH_DEQUE(NAME)  ch_deque_##NAME##_t
+#define CH_DEQUE_IT(NAME)  ch_deque_##NAME##_it
+#define CH_DEQUE_NEW(NAME, cmp) ch_deque_##NAME##_new(cmp)
+#define CH_DEQUE_CMP(NAME) ch_deque_cmp_##NAME
+#define CH_DEQUE_FOREACH(TYPE_NAME, DEQUE_NAME, IT_NAME) \
+    for(CH_DEQUE_IT(TYPE_NAME) IT_NAME = DEQUE_NAME->first(DEQUE_NAME); IT_NAME.value; DEQUE_NAME->next(DEQUE_NAME, &IT_NAME))
+
+#endif /* DEQUE_TYPED_DECLARE_TEMPLATE_H_ */
@@ -0,0 +1,178 @@
+/*
+ * deque_typed_define_template.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef DEQUE_TYPED_DEFINE_TEMPLATE_H_
+#define DEQUE_TYPED_DEFINE_TEMPLATE_H_
+
+#include "deque_typed_declare_template.h"
+#include "deque.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define define_ch_deque(NAME,TYPE)\
+\
+static inline ch_deque_##NAME##_it _to_##NAME##_it(const ch_deque_it* rhs)\
+{\
+    ch_deque_##NAME##_it result = { ._idx = rhs->_idx, .value = (TYPE*)(rhs->value) };\
+    return result;\
+}\
+\
+static inline ch_deque_it _from_##NAME##_it(const ch_deque_##NAME##_it* rhs)\
+{\
+    ch_deque_it result = { ._idx = rhs->_idx, .value = rhs->value };\
+    return result;\
+}\
+\
+static TYPE* _off_##NAME(ch_deque_##NAME##_t* this, ch_word idx)\
+{\
+    return (TYPE*)deque_off(this->_deque, idx);\
+}\
+\
+static ch_deque_##NAME##_it _first_##NAME(ch_deque_##NAME##_t* this)\
+{\
+    const ch_deque_it result = deque_first(this->_deque);\
+    return _to_##NAME##_it(&result);\
+}\
+\
+static ch_deque_##NAME##_it _last_##NAME(ch_deque_##NAME##_t* this)\
+{\
+    const ch_deque_it result = deque_last(this->_deque);\
+    return _to_##NAME##_it(&result);\
+}\
+\
+static ch_deque_##NAME##_it _end_##NAME(ch_deque_##NAME##_t* this)\
+{\
+    const ch_deque_it result = deque_end(this->_deque);\
+    return _to_##NAME##_it(&result);\
+}\
+\
+static void _forward_##NAME(ch_deque_##NAME##_t* this, ch_deque_##NAME##_it* it, ch_word amount)\
+{\
+    ch_deque_it base_it = _from_##NAME##_it(it);\
+    deque_forward(this->_deque, &base_it, amount);\
+    *it = _to_##NAME##_it(&base_it);\
+}\
+\
+static void _back_##NAME(ch_deque_##NAME##_t* this, ch_deque_##NAME##_it* it, ch_word amount)\
+{\
+    ch_deque_it base_it = _from_##NAME##_it(it);\
+    deque_back(this->_deque, &base_it, amount);\
+    *it = _to_##NAME##_it(&base_it);\
+}\
+\
+static void _next_##NAME(ch_deque_##NAME##_t* this, ch_deque_##NAME##_it* it)       { ch_deque_##NAME##_next(this, it); }\
+static void _prev_##NAME(ch_deque_##NAME##_t* this, ch_deque_##NAME##_it* it)       { ch_deque_##NAME##_prev(this, it); }\
+static TYPE* _push_front_##NAME(ch_deque_##NAME##_t* this, TYPE value)              { return ch_deque_##NAME##_push_front(this, value); }\
+static TYPE* _push_back_##NAME(ch_deque_##NAME##_t* this, TYPE value)               { return ch_deque_##NAME##_push_back(this, value); }\
+static void _pop_front_##NAME(ch_deque_##NAME##_t* this)                            { ch_deque_##NAME##_pop_front(this); }\
+static void _pop_back_##NAME(ch_deque_##NAME##_t* this)                             { ch_deque_##NAME##_pop_back(this); }\
+\
+static void _clear_##NAME(ch_deque_##NAME##_t* this)\
+{\
+    deque_clear(this->_deque);\
+    this->count = 0;\
+}\
+\
+static TYPE* _push_back_carray_##NAME(ch_deque_##NAME##_t* this, const TYPE* carray, ch_word count)\
+{\
+    TYPE* result = NULL;\
+    for(ch_word i = 0; i < count; i++){\
+        result = ch_deque_##NAME##_push_back(this, carray[i]);\
+        if(!result){\
+            return NULL;\
+        }\
+    }\
+\
+    return result;\
+}\
+\
+static ch_deque_##NAME##_it _find_##NAME(ch_deque_##NAME##_t* this, ch_deque_##NAME##_it* begin, ch_deque_##NAME##_it* end, TYPE value)\
+{\
+    ch_deque_it base_begin = _from_##NAME##_it(begin);\
+    ch_deque_it base_end   = _from_##NAME##_it(end);\
+    const ch_deque_it result = deque_find(this->_deque, &base_begin, &base_end, &value);\
+    return _to_##NAME##_it(&result);\
+}\
+\
+static ch_word _eq_##NAME(ch_deque_##NAME##_t* this, ch_deque_##NAME##_t* that)\
+{\
+    if(this->count != that->count){\
+        return 0;\
+    }\
+\
+    ch_deque_##NAME##_it lhs = _first_##NAME(this);\
+    ch_deque_##NAME##_it rhs = _first_##NAME(that);\
+    for(; lhs.value; ch_deque_##NAME##_next(this, &lhs), ch_deque_##NAME##_next(that, &rhs)){\
+        if(this->_deque->_cmp(lhs.value, rhs.value)){\
+            return 0;\
+        }\
+    }\
+\
+    return 1;\
+}\
+\
+static void _delete_##NAME(ch_deque_##NAME##_t* this)\
+{\
+    if(this->_deque){\
+        deque_delete(this->_deque);\
+    }\
+\
+    free(this);\
+}\
+\
+ch_deque_##NAME##_t* ch_deque_##NAME##_new(ch_word(*cmp)(TYPE* lhs, TYPE* rhs) )\
+{\
+    ch_deque_##NAME##_t* result = (ch_deque_##NAME##_t*)calloc(1, sizeof(ch_deque_##NAME##_t));\
+    if(!result){\
+        printf("Could not allocate memory for new deque structure. Giving up\n");\
+        return NULL;\
+    }\
+\
+    result->_deque = ch_deque_new(sizeof(TYPE), (cmp_void_f)cmp);\
+    if(!result->_deque){\
+        free(result);\
+        return NULL;\
+    }\
+\
+    result->off                     = _off_##NAME;\
+    result->first                   = _first_##NAME;\
+    result->last                    = _last_##NAME;\
+    result->end                     = _end_##NAME;\
+\
+    result->next                    = _next_##NAME;\
+    result->prev                    = _prev_##NAME;\
+    result->forward                 = _forward_##NAME;\
+    result->back                    = _back_##NAME;\
+\
+    result->push_front              = _push_front_##NAME;\
+    result->pop_front               = _pop_front_##NAME;\
+    result->push_back               = _push_back_##NAME;\
+    result->pop_back                = _pop_back_##NAME;\
+    result->clear                   = _clear_##NAME;\
+\
+    result->push_back_carray        = _push_back_carray_##NAME;\
+    result->delete                  = _delete_##NAME;\
+\
+    /*Fail hard and early if the compare function is NULL*/\
+    if(cmp){\
+        result->eq                      = _eq_##NAME;\
+        result->find                    = _find_##NAME;\
+    }\
+\
+    return result;\
+}
+
+
+//Regular comparison function
+#define define_ch_deque_cmp(NAME, TYPE) \
+ch_word ch_deque_cmp_##NAME(TYPE* lhs, TYPE* rhs)\
+{ \
+    return ( *lhs == *rhs ? 0 : *lhs < *rhs ? -1 : 1); \
+}
+
+#endif /* DEQUE_TYPED_DEFINE_TEMPLATE_H_ */
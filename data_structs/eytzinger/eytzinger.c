@@ -0,0 +1,147 @@
+/*
+ * eytzinger.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include "eytzinger.h"
+#include "../../utils/util.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CACHE_LINE_SIZE 64
+
+
+static inline ch_byte* tree_node(ch_eytzinger_t* this, ch_word k)
+{
+    return this->_tree + k * this->_element_size;
+}
+
+
+//Walk the implicit tree in order, handing out the sorted elements one by one
+static ch_word build(ch_eytzinger_t* this, const ch_byte* sorted, ch_word idx, ch_word k)
+{
+    if(k > this->count){
+        return idx;
+    }
+
+    idx = build(this, sorted, idx, 2 * k);
+    memcpy(tree_node(this, k), sorted + idx * this->_element_size, this->_element_size);
+    this->_rank[k] = idx;
+    idx++;
+    return build(this, sorted, idx, 2 * k + 1);
+}
+
+
+static inline void prefetch_descendants(ch_eytzinger_t* this, ch_word k)
+{
+    //Prefetching past the end of the tree is harmless, so there is no need to check
+    __builtin_prefetch((const void*)((uintptr_t)this->_tree + (uintptr_t)(k * CH_EYTZINGER_PREFETCH * this->_element_size)));
+}
+
+
+//k encodes the path taken, with a 1 for every right turn. The answer is the last left turn, found by stripping the
+//trailing 1s and then one 0.
+static inline ch_word rank_of(ch_eytzinger_t* this, ch_word k)
+{
+    k >>= __builtin_ffsll(~k);
+    return k ? this->_rank[k] : this->count;
+}
+
+
+ch_word eytzinger_lower_bound(ch_eytzinger_t* this, const void* value)
+{
+    ch_word k = 1;
+    while(k <= this->count){
+        prefetch_descendants(this, k);
+        k = 2 * k + (this->_cmp(tree_node(this, k), value) < 0);
+    }
+
+    return rank_of(this, k);
+}
+
+
+ch_word eytzinger_upper_bound(ch_eytzinger_t* this, const void* value)
+{
+    ch_word k = 1;
+    while(k <= this->count){
+        prefetch_descendants(this, k);
+        k = 2 * k + (this->_cmp(value, tree_node(this, k)) >= 0);
+    }
+
+    return rank_of(this, k);
+}
+
+
+ch_word eytzinger_find(ch_eytzinger_t* this, const void* value)
+{
+    ch_word k = 1;
+    while(k <= this->count){
+        prefetch_descendants(this, k);
+        k = 2 * k + (this->_cmp(tree_node(this, k), value) < 0);
+    }
+
+    k >>= __builtin_ffsll(~k);
+    if(k && this->_cmp(tree_node(this, k), value) == 0){
+        return this->_rank[k];
+    }
+
+    return -1;
+}
+
+
+void eytzinger_delete(ch_eytzinger_t* this)
+{
+    if(this->_tree){
+        free(this->_tree);
+    }
+
+    if(this->_rank){
+        free(this->_rank);
+    }
+
+    free(this);
+}
+
+
+ch_eytzinger_t* ch_eytzinger_new(const void* sorted, ch_word count, ch_word element_size, cmp_void_f cmp)
+{
+    if(!cmp){
+        printf("The comparator function is empty. Cannot build an index\n");
+        return NULL;
+    }
+
+    ch_eytzinger_t* result = (ch_eytzinger_t*)calloc(1, sizeof(ch_eytzinger_t));
+    if(!result){
+        printf("Could not allocate memory for new eytzinger index structure. Giving up\n");
+        return NULL;
+    }
+
+    result->count         = MAX(0, count);
+    result->_cmp          = cmp;
+    result->_element_size = element_size;
+
+    //Line up the tree so that each group of descendants lands in as few cache lines as possible
+    void* tree = NULL;
+    if(posix_memalign(&tree, CACHE_LINE_SIZE, (result->count + 1) * element_size)){
+        printf("Could not allocate memory for new eytzinger index tree. Giving up\n");
+        free(result);
+        return NULL;
+    }
+    result->_tree = tree;
+
+    result->_rank = (ch_word*)malloc((result->count + 1) * sizeof(ch_word));
+    if(!result->_rank){
+        printf("Could not allocate memory for new eytzinger index ranks. Giving up\n");
+        eytzinger_delete(result);
+        return NULL;
+    }
+
+    build(result, sorted, 0, 1);
+
+    return result;
+}
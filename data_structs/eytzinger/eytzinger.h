@@ -0,0 +1,93 @@
+/*
+ * eytzinger.h
+ *
+ * Read only search index over a sorted array, stored in Eytzinger (breadth first binary tree) order. The first few
+ * levels of the tree share a handful of cache lines that stay hot, and the four levels below the current node are
+ * contiguous, so they can be fetched four steps before they are needed. For lookup tables much larger than the cache,
+ * this hides most of the cache misses that a classic binary search takes on almost every step.
+ *
+ * The index is a copy. It does not track changes to the array that it was built from.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef EYTZINGER_H_
+#define EYTZINGER_H_
+
+#include "../../types/types.h"
+#include <stdint.h>
+
+struct ch_eytzinger;
+typedef struct ch_eytzinger ch_eytzinger_t;
+
+struct ch_eytzinger{
+    ch_word count; //Number of elements in the index
+
+    // Members prefixed with "_" are nominally "private" Don't touch my privates!
+    cmp_void_f _cmp; //Comparator function, must match the order of the sorted array
+    ch_word _element_size;
+    ch_byte* _tree; //count + 1 elements in breadth first order. Element 0 is unused
+    ch_word* _rank; //Index in the sorted array of each tree element
+};
+
+//Searches using the comparator function. The comparator is called once per level, so for small element types the
+//inlined searches below are considerably faster.
+//Return the index in the sorted array of the first element not less than value, or count if there is none
+ch_word eytzinger_lower_bound(ch_eytzinger_t* this, const void* value);
+
+//Return the index in the sorted array of the first element greater than value, or count if there is none
+ch_word eytzinger_upper_bound(ch_eytzinger_t* this, const void* value);
+
+//Return the index in the sorted array of the first element equal to value, or -1 if there is none
+ch_word eytzinger_find(ch_eytzinger_t* this, const void* value);
+
+//Free the resources associated with this index
+void eytzinger_delete(ch_eytzinger_t* this);
+
+//Build an index over count elements of sorted, which must be in the order given by cmp
+ch_eytzinger_t* ch_eytzinger_new(const void* sorted, ch_word count, ch_word element_size, cmp_void_f cmp);
+
+//Children of node k are 2k and 2k+1, so the 16 descendants four levels below node k start at 16k
+#define CH_EYTZINGER_PREFETCH 16
+
+//Inlined searches for one element type, where LESS(lhs,rhs) gives the order of the index (see array_sort_template.h).
+//    define_ch_eytzinger_search(my_prefix, TYPE, LESS)
+//generates
+//    static ch_word my_prefix_lower_bound(ch_eytzinger_t* this, TYPE value);
+//    static ch_word my_prefix_upper_bound(ch_eytzinger_t* this, TYPE value);
+//which behave as eytzinger_lower_bound() and eytzinger_upper_bound() above.
+#define define_ch_eytzinger_search(PREFIX, TYPE, LESS)\
+\
+static inline ch_word PREFIX##_rank(ch_eytzinger_t* this, ch_word k)\
+{\
+    /*k encodes the path taken, with a 1 for every right turn. The answer is the last left turn.*/\
+    k >>= __builtin_ffsll(~k);\
+    return k ? this->_rank[k] : this->count;\
+}\
+\
+static inline ch_word PREFIX##_lower_bound(ch_eytzinger_t* this, TYPE value)\
+{\
+    const TYPE* tree = (const TYPE*)this->_tree;\
+    const ch_word count = this->count;\
+    ch_word k = 1;\
+    while(k <= count){\
+        __builtin_prefetch((const void*)((uintptr_t)tree + (uintptr_t)(k * CH_EYTZINGER_PREFETCH * sizeof(TYPE))));\
+        k = 2 * k + (LESS(tree[k], value) ? 1 : 0);\
+    }\
+    return PREFIX##_rank(this, k);\
+}\
+\
+static inline ch_word PREFIX##_upper_bound(ch_eytzinger_t* this, TYPE value)\
+{\
+    const TYPE* tree = (const TYPE*)this->_tree;\
+    const ch_word count = this->count;\
+    ch_word k = 1;\
+    while(k <= count){\
+        __builtin_prefetch((const void*)((uintptr_t)tree + (uintptr_t)(k * CH_EYTZINGER_PREFETCH * sizeof(TYPE))));\
+        k = 2 * k + (LESS(value, tree[k]) ? 0 : 1);\
+    }\
+    return PREFIX##_rank(this, k);\
+}
+
+#endif /* EYTZINGER_H_ */
@@ -12,13 +12,13 @@
 #include "../array/array.h"
 #include "../linked_list/linked_list.h"
 #include "function_hash_map.h"
-#include "../../hash_functions/spooky/spooky_hash.h"
+#include "../../hash_functions/hash.h"
 #include "../../utils/util.h"
 
 
 static u64 hash(const void* key, ch_word key_size)
 {
-    return spooky_Hash64(key,key_size,0xFEEDBEEFCAFEB00BULL);
+    return ch_hash64(key,key_size,0xFEEDBEEFCAFEB00BULL);
 }
 
 
@@ -224,32 +224,23 @@ void function_hash_map_next (ch_function_hash_map* this, ch_function_hash_map_it
     ch_word idx = node->offset;
     node = NULL;
 
-    idx++;
-    if(idx >= this->_backing_array->size){
-        *it = result;
-        return;
-    }
-
+    //Try the rest of the current bucket first, then walk forwards through the remaining buckets
     fm_node_list = (ch_llist_t*)array_off(this->_backing_array, idx);
     llist_next(fm_node_list, &fm_node_list_it);
 
-    for(;idx < this->_backing_array->size;idx++){
-        if(fm_node_list_it.value){
-            node = fm_node_list_it.value;
-            break;
-        }
-
+    while(!fm_node_list_it.value && ++idx < this->_backing_array->size){
         fm_node_list = (ch_llist_t*)array_off(this->_backing_array, idx);
         fm_node_list_it = llist_first(fm_node_list);
-
     }
 
-    //Nothing found, the hasmap must be empty
-    if(!node){
+    //Nothing found, we've reached the end of the hash map
+    if(!fm_node_list_it.value){
         *it = result;
         return;
     }
 
+    node = fm_node_list_it.value;
+
     result._node = node;
     result.item = fm_node_list_it;
     result.value = node->value;
@@ -331,8 +322,19 @@ ch_function_hash_map* ch_function_hash_map_new( ch_word size, ch_word (*func)(ch
     result->_backing_array = ch_array_new(size, sizeof(ch_llist_t), NULL);
     result->_func          = func;
 
+    result->_node_pool     = llist_pool_new(sizeof(ch_function_hash_map_node) + sizeof(ch_word));
+    if(!result->_backing_array || !result->_node_pool){
+        printf("Could not allocate memory for new function_hash_map buckets. Giving up\n");
+        if(result->_backing_array){
+            array_delete(result->_backing_array);
+        }
+        pool_delete(result->_node_pool);
+        free(result);
+        return NULL;
+    }
+
     for(ch_llist_t* it = result->_backing_array->first; it != result->_backing_array->end; it = array_next(result->_backing_array, it)){
-        ch_llist_init(it, sizeof(ch_function_hash_map_node) + sizeof(ch_word), (cmp_void_f)hash_cmp);
+        ch_llist_init_pooled(it, sizeof(ch_function_hash_map_node) + sizeof(ch_word), (cmp_void_f)hash_cmp, result->_node_pool);
     }
 
     return result;
@@ -348,11 +350,8 @@ void function_hash_map_delete(ch_function_hash_map* this)
         return;
     }
 
-    //Free up all of the lists
-    for(ch_llist_t* it = this->_backing_array->first; it != this->_backing_array->end; it = array_next(this->_backing_array, it)){
-        //Can't use free here because the list object is statically allocated
-        llist_pop_all(it); //Free all the list nodes
-    }
+    //Free all the list nodes at once, a slab at a time
+    pool_delete(this->_node_pool);
 
     //Free up the array
     array_delete(this->_backing_array);
@@ -43,6 +43,7 @@ struct ch_hash_map_t{
     // Members prefixed with "_" are nominally "private" Don't touch my privates!
    cmp_void_f _cmp; // Comparator function for find and sort operations
    ch_array_t* _backing_array;
+   ch_pool_t* _node_pool; //Nodes for every bucket's list come from here
    ch_word _element_size;
 };
 
@@ -0,0 +1,340 @@
+/*
+ * heap.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "../../utils/util.h"
+#include "heap.h"
+
+//Free handles are chained together through _handle_slots. A free handle's entry holds -2 - (the next free handle), so
+//that it is always negative: -1 at the end of the chain, and <= -2 otherwise. Live handles hold their slot (>= 0).
+#define FREE_LINK(next) (-2 - (next))
+
+
+static inline void* _heap_elem(ch_heap_t* this, ch_word slot)
+{
+    return (ch_byte*)this->_array->first + slot * this->_element_size;
+}
+
+static inline ch_word* _slot_handles(ch_heap_t* this)
+{
+    return (ch_word*)this->_slot_handles->first;
+}
+
+static inline ch_word* _handle_slots(ch_heap_t* this)
+{
+    return (ch_word*)this->_handle_slots->first;
+}
+
+static inline ch_bool _heap_live(ch_heap_t* this, ch_word handle)
+{
+    return handle >= 0 && handle < this->_handles && _handle_slots(this)[handle] >= 0;
+}
+
+
+//Put the element with the given handle into slot
+static inline void _heap_place(ch_heap_t* this, ch_word slot, const void* value, ch_word handle)
+{
+    memcpy(_heap_elem(this, slot), value, this->_element_size);
+    _slot_handles(this)[slot] = handle;
+    _handle_slots(this)[handle] = slot;
+}
+
+//Move the element in slot up towards the top until its parent is not greater, moving parents down into the hole
+static void _heap_sift_up(ch_heap_t* this, ch_word slot)
+{
+    const ch_word handle = _slot_handles(this)[slot];
+    memcpy(this->_tmp, _heap_elem(this, slot), this->_element_size);
+
+    while(slot > 0){
+        const ch_word parent = (slot - 1) / CH_HEAP_ARITY;
+        if(this->_cmp(this->_tmp, _heap_elem(this, parent)) >= 0){
+            break;
+        }
+
+        _heap_place(this, slot, _heap_elem(this, parent), _slot_handles(this)[parent]);
+        slot = parent;
+    }
+
+    _heap_place(this, slot, this->_tmp, handle);
+}
+
+//Move the element in slot down until none of its children are smaller, moving the smallest child up into the hole
+static void _heap_sift_down(ch_heap_t* this, ch_word slot)
+{
+    const ch_word handle = _slot_handles(this)[slot];
+    memcpy(this->_tmp, _heap_elem(this, slot), this->_element_size);
+
+    for(;;){
+        const ch_word first = slot * CH_HEAP_ARITY + 1;
+        if(first >= this->count){
+            break;
+        }
+
+        //The children are next to each other, so finding the smallest is a short scan
+        const ch_word last = MIN(first + CH_HEAP_ARITY, this->count);
+        ch_word best = first;
+        for(ch_word child = first + 1; child < last; child++){
+            if(this->_cmp(_heap_elem(this, child), _heap_elem(this, best)) < 0){
+                best = child;
+            }
+        }
+
+        if(this->_cmp(_heap_elem(this, best), this->_tmp) >= 0){
+            break;
+        }
+
+        _heap_place(this, slot, _heap_elem(this, best), _slot_handles(this)[best]);
+        slot = best;
+    }
+
+    _heap_place(this, slot, this->_tmp, handle);
+}
+
+//Restore the heap order after the element in slot has changed in either direction
+static void _heap_fix(ch_heap_t* this, ch_word slot)
+{
+    if(slot > 0 && this->_cmp(_heap_elem(this, slot), _heap_elem(this, (slot - 1) / CH_HEAP_ARITY)) < 0){
+        _heap_sift_up(this, slot);
+    }
+    else{
+        _heap_sift_down(this, slot);
+    }
+}
+
+
+static inline void _heap_free_handle(ch_heap_t* this, ch_word handle)
+{
+    _handle_slots(this)[handle] = FREE_LINK(this->_free_handle);
+    this->_free_handle = handle;
+}
+
+//Take the element out of slot, filling the hole with the last element
+static void _heap_remove_slot(ch_heap_t* this, ch_word slot, void* value)
+{
+    if(value){
+        memcpy(value, _heap_elem(this, slot), this->_element_size);
+    }
+
+    _heap_free_handle(this, _slot_handles(this)[slot]);
+    this->count--;
+
+    if(slot < this->count){
+        _heap_place(this, slot, _heap_elem(this, this->count), _slot_handles(this)[this->count]);
+        _heap_fix(this, slot);
+    }
+}
+
+
+//Make sure that there is room for size elements
+static ch_word _heap_reserve(ch_heap_t* this, ch_word size)
+{
+    if(size <= this->_array->size){
+        return 0;
+    }
+
+    const ch_word new_size = MAX(size, this->_array->size * 2);
+    array_resize(this->_array, new_size);
+    array_resize(this->_slot_handles, new_size);
+    if(this->_array->size != new_size || this->_slot_handles->size != new_size){
+        return -1;
+    }
+
+    return 0;
+}
+
+//Make sure that there is room for size handles
+static ch_word _heap_reserve_handles(ch_heap_t* this, ch_word size)
+{
+    if(size <= this->_handle_slots->size){
+        return 0;
+    }
+
+    const ch_word new_size = MAX(size, this->_handle_slots->size * 2);
+    array_resize(this->_handle_slots, new_size);
+    return this->_handle_slots->size == new_size ? 0 : -1;
+}
+
+
+ch_word heap_push(ch_heap_t* this, const void* value)
+{
+    if(_heap_reserve(this, this->count + 1)){
+        return -1;
+    }
+
+    ch_word handle = this->_free_handle;
+    if(handle >= 0){
+        this->_free_handle = FREE_LINK(_handle_slots(this)[handle]);
+    }
+    else{
+        if(_heap_reserve_handles(this, this->_handles + 1)){
+            return -1;
+        }
+        handle = this->_handles++;
+    }
+
+    _heap_place(this, this->count, value, handle);
+    this->count++;
+    _heap_sift_up(this, this->count - 1);
+
+    return handle;
+}
+
+void* heap_peek(ch_heap_t* this)
+{
+    return this->count ? _heap_elem(this, 0) : NULL;
+}
+
+ch_word heap_pop(ch_heap_t* this, void* value)
+{
+    if(!this->count){
+        return -1;
+    }
+
+    _heap_remove_slot(this, 0, value);
+    return 0;
+}
+
+
+void* heap_get(ch_heap_t* this, ch_word handle)
+{
+    return _heap_live(this, handle) ? _heap_elem(this, _handle_slots(this)[handle]) : NULL;
+}
+
+ch_word heap_decrease_key(ch_heap_t* this, ch_word handle, const void* value)
+{
+    if(!_heap_live(this, handle)){
+        printf("Heap handle (%lli) is not in use\n", handle);
+        return -1;
+    }
+
+    const ch_word slot = _handle_slots(this)[handle];
+    if(this->_cmp(value, _heap_elem(this, slot)) > 0){
+        printf("Error: the new value is greater than the old one\n");
+        return -1;
+    }
+
+    memcpy(_heap_elem(this, slot), value, this->_element_size);
+    _heap_sift_up(this, slot);
+    return 0;
+}
+
+ch_word heap_update(ch_heap_t* this, ch_word handle, const void* value)
+{
+    if(!_heap_live(this, handle)){
+        printf("Heap handle (%lli) is not in use\n", handle);
+        return -1;
+    }
+
+    const ch_word slot = _handle_slots(this)[handle];
+    memcpy(_heap_elem(this, slot), value, this->_element_size);
+    _heap_fix(this, slot);
+    return 0;
+}
+
+ch_word heap_remove(ch_heap_t* this, ch_word handle, void* value)
+{
+    if(!_heap_live(this, handle)){
+        return -1;
+    }
+
+    _heap_remove_slot(this, _handle_slots(this)[handle], value);
+    return 0;
+}
+
+
+ch_word heap_heapify(ch_heap_t* this, const void* carray, ch_word count)
+{
+    heap_clear(this);
+    if(count <= 0){
+        return 0;
+    }
+
+    if(_heap_reserve(this, count) || _heap_reserve_handles(this, count)){
+        return -1;
+    }
+
+    memcpy(this->_array->first, carray, count * this->_element_size);
+    for(ch_word i = 0; i < count; i++){
+        _slot_handles(this)[i] = i;
+        _handle_slots(this)[i] = i;
+    }
+    this->count    = count;
+    this->_handles = count;
+
+    //Sift down every node that has children, bottom up. Most nodes are near the bottom and move at most a step or two
+    for(ch_word slot = (count - 2) / CH_HEAP_ARITY; slot >= 0 && count > 1; slot--){
+        _heap_sift_down(this, slot);
+    }
+
+    return 0;
+}
+
+
+void heap_clear(ch_heap_t* this)
+{
+    this->count        = 0;
+    this->_handles     = 0;
+    this->_free_handle = -1;
+}
+
+void heap_delete(ch_heap_t* this)
+{
+    if(!this){
+        return;
+    }
+
+    if(this->_array){
+        array_delete(this->_array);
+    }
+    if(this->_slot_handles){
+        array_delete(this->_slot_handles);
+    }
+    if(this->_handle_slots){
+        array_delete(this->_handle_slots);
+    }
+    free(this->_tmp);
+    free(this);
+}
+
+
+ch_heap_t* ch_heap_new(ch_word size, ch_word element_size, cmp_void_f cmp)
+{
+    if(element_size <= 0){
+        printf("Error: invalid element size (<=0), must have *some* data\n");
+        return NULL;
+    }
+
+    if(!cmp){
+        printf("Error: a heap needs a comparator function\n");
+        return NULL;
+    }
+
+    ch_heap_t* result = (ch_heap_t*)calloc(1,sizeof(ch_heap_t));
+    if(!result){
+        printf("Could not allocate memory for new heap structure. Giving up\n");
+        return NULL;
+    }
+
+    size = MAX(size, 1);
+    result->_cmp          = cmp;
+    result->_element_size = element_size;
+    result->_free_handle  = -1;
+    result->_array        = ch_array_new(size, element_size, cmp);
+    result->_slot_handles = ch_array_new(size, sizeof(ch_word), NULL);
+    result->_handle_slots = ch_array_new(size, sizeof(ch_word), NULL);
+    result->_tmp          = malloc(element_size);
+    if(!result->_array || !result->_slot_handles || !result->_handle_slots || !result->_tmp){
+        printf("Could not allocate memory for new heap structure. Giving up\n");
+        heap_delete(result);
+        return NULL;
+    }
+
+    return result;
+}
@@ -0,0 +1,73 @@
+/*
+ * heap.h
+ *
+ * Priority queue, implemented as an implicit 4-ary heap in a ch_array_t. The top of the heap is the element that
+ * compares smallest. With four children per node the heap is half as deep as a binary heap, and the children of a node
+ * sit next to each other (in one or two cache lines for small elements), so a pop touches far fewer cache lines.
+ *
+ * Each push returns a handle that stays with the element as it moves around the heap, until it is popped or removed.
+ * Handles can be used to look at the element, change its priority, or remove it. Handles are recycled.
+ *
+ * Elements with equal priority come out in no particular order. Not thread safe.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef HEAP_H_
+#define HEAP_H_
+
+#include "../../types/types.h"
+#include "../array/array.h"
+
+#define CH_HEAP_ARITY 4
+
+struct ch_heap;
+typedef struct ch_heap ch_heap_t;
+
+struct ch_heap{
+    ch_word count;  //Return the actual number of elements in the heap
+
+    // Members prefixed with "_" are nominally "private" Don't touch my privates!
+    cmp_void_f _cmp; //Comparator function that gives the priority order
+    ch_word _element_size;
+    ch_array_t* _array; //The elements, in heap order
+    ch_array_t* _slot_handles; //The handle of the element in each slot of _array
+    ch_array_t* _handle_slots; //The slot of the element with each handle. See heap.c for free handles
+    ch_word _handles; //Number of handles given out so far, live or free
+    ch_word _free_handle; //The most recently freed handle, or -1 if there are none
+    void* _tmp; //Space for the element being moved while sifting
+};
+
+
+//Put an element into the heap. Returns its handle, or -1 on failure
+ch_word heap_push(ch_heap_t* this, const void* value);
+//Return the top (smallest) element, or NULL if the heap is empty
+void* heap_peek(ch_heap_t* this);
+//Remove the top element, copying it into value unless value is NULL. Returns 0 on success, -1 if the heap is empty
+ch_word heap_pop(ch_heap_t* this, void* value);
+
+//Return the element with the given handle, or NULL if the handle is not live
+void* heap_get(ch_heap_t* this, ch_word handle);
+//Replace the element with the given handle by value, which must not compare greater. Returns 0 on success, -1 on failure
+ch_word heap_decrease_key(ch_heap_t* this, ch_word handle, const void* value);
+//Replace the element with the given handle by value, which may compare greater or smaller. Returns 0 on success, -1 on
+//failure
+ch_word heap_update(ch_heap_t* this, ch_word handle, const void* value);
+//Remove the element with the given handle, copying it into value unless value is NULL. Returns 0 on success, -1 if the
+//handle is not live
+ch_word heap_remove(ch_heap_t* this, ch_word handle, void* value);
+
+//Replace the contents of the heap with count elements from the C array, in O(count). The element at carray[i] gets
+//handle i. Returns 0 on success, -1 on failure
+ch_word heap_heapify(ch_heap_t* this, const void* carray, ch_word count);
+
+//Remove all elements. All handles become free
+void heap_clear(ch_heap_t* this);
+
+//Free the resources associated with this heap, assumes that individual items have been freed
+void heap_delete(ch_heap_t* this);
+
+ch_heap_t* ch_heap_new(ch_word size, ch_word element_size, cmp_void_f cmp);
+
+#endif // HEAP_H_
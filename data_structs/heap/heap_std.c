@@ -0,0 +1,39 @@
+/*
+ * heap_std.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include "../../types/types.h"
+#include "heap.h"
+#include "heap_std.h"
+#include "heap_typed_define_template.h"
+
+define_ch_heap(u8,  u8)
+define_ch_heap(u16, u16)
+define_ch_heap(u32, u32)
+define_ch_heap(u64, u64)
+
+define_ch_heap(i8,  i8)
+define_ch_heap(i16, i16)
+define_ch_heap(i32, i32)
+define_ch_heap(i64, i64)
+
+define_ch_heap(machine, ch_machine)
+define_ch_heap(word, ch_word)
+define_ch_heap(float, ch_float)
+
+define_ch_heap_cmp(u8,  u8)
+define_ch_heap_cmp(u16, u16)
+define_ch_heap_cmp(u32, u32)
+define_ch_heap_cmp(u64, u64)
+
+define_ch_heap_cmp(i8,  i8)
+define_ch_heap_cmp(i16, i16)
+define_ch_heap_cmp(i32, i32)
+define_ch_heap_cmp(i64, i64)
+
+define_ch_heap_cmp(machine, ch_machine)
+define_ch_heap_cmp(word, ch_word)
+define_ch_heap_cmp(float, ch_float)
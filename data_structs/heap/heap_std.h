@@ -0,0 +1,42 @@
+/*
+ * heap_std.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef HEAP_STD_H_
+#define HEAP_STD_H_
+
+#include "../../types/types.h"
+#include "heap_typed_declare_template.h"
+
+declare_ch_heap(u8,  u8)
+declare_ch_heap(u16, u16)
+declare_ch_heap(u32, u32)
+declare_ch_heap(u64, u64)
+
+declare_ch_heap(i8,  i8)
+declare_ch_heap(i16, i16)
+declare_ch_heap(i32, i32)
+declare_ch_heap(i64, i64)
+
+declare_ch_heap(machine, ch_machine)
+declare_ch_heap(word, ch_word)
+declare_ch_heap(float, ch_float)
+
+declare_ch_heap_cmp(u8,  u8)
+declare_ch_heap_cmp(u16, u16)
+declare_ch_heap_cmp(u32, u32)
+declare_ch_heap_cmp(u64, u64)
+
+declare_ch_heap_cmp(i8,  i8)
+declare_ch_heap_cmp(i16, i16)
+declare_ch_heap_cmp(i32, i32)
+declare_ch_heap_cmp(i64, i64)
+
+declare_ch_heap_cmp(machine, ch_machine)
+declare_ch_heap_cmp(word, ch_word)
+declare_ch_heap_cmp(float, ch_float)
+
+#endif /* HEAP_STD_H_ */
@@ -0,0 +1,85 @@
+/*
+ * heap_typed_declare_template.h
+ *
+ * Typed wrapper around ch_heap_t.
+ *
+ * Usage:
+ *     declare_ch_heap(NAME, TYPE)
+ *     define_ch_heap(NAME, TYPE)   (in exactly one .c file)
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef HEAP_TYPED_DECLARE_TEMPLATE_H_
+#define HEAP_TYPED_DECLARE_TEMPLATE_H_
+
+#include "../../types/types.h"
+#include "../../utils/util.h"
+#include "heap.h"
+
+#include <stdio.h>
+
+#define declare_ch_heap(NAME,TYPE) \
+\
+struct ch_heap_##NAME;\
+typedef struct ch_heap_##NAME ch_heap_##NAME##_t;\
+\
+struct ch_heap_##NAME{\
+    ch_word count;  /*Return the actual number of elements in the heap*/\
+\
+    ch_word (*push)(ch_heap_##NAME##_t* this, TYPE value); /*Put an element into the heap. Returns its handle, or -1 on failure*/\
+    TYPE* (*peek)(ch_heap_##NAME##_t* this); /*Return the top (smallest) element, or NULL if the heap is empty*/\
+    ch_word (*pop)(ch_heap_##NAME##_t* this, TYPE* value); /*Remove the top element, copying it into value unless value is NULL. Returns 0, or -1 if the heap is empty*/\
+\
+    TYPE* (*get)(ch_heap_##NAME##_t* this, ch_word handle); /*Return the element with the given handle, or NULL if the handle is not live*/\
+    ch_word (*decrease_key)(ch_heap_##NAME##_t* this, ch_word handle, TYPE value); /*Replace the element with the given handle by a value that does not compare greater*/\
+    ch_word (*update)(ch_heap_##NAME##_t* this, ch_word handle, TYPE value); /*Replace the element with the given handle by any value*/\
+    ch_word (*remove)(ch_heap_##NAME##_t* this, ch_word handle, TYPE* value); /*Remove the element with the given handle, copying it into value unless value is NULL*/\
+\
+    ch_word (*heapify)(ch_heap_##NAME##_t* this, const TYPE* carray, ch_word count); /*Replace the contents with count elements from the C array, in O(count). carray[i] gets handle i*/\
+    void (*clear)(ch_heap_##NAME##_t* this); /*Remove everything from the heap*/\
+\
+    void (*delete)(ch_heap_##NAME##_t* this); /*Free the resources associated with this heap, assumes that individual items have been freed*/\
+\
+     /* Members prefixed with "_" are nominally "private" Don't touch my privates!*/\
+    ch_heap_t* _heap; /*Actual heap storage*/\
+};\
+\
+\
+ch_heap_##NAME##_t* ch_heap_##NAME##_new(ch_word size, ch_word(*cmp)(TYPE* lhs, TYPE* rhs) );\
+_declare_ch_heap_inline(NAME,TYPE)
+
+//Direct call versions of the hot operations, see the typed vector
+#define _declare_ch_heap_inline(NAME,TYPE)\
+\
+static inline TYPE* ch_heap_##NAME##_peek(ch_heap_##NAME##_t* this)\
+{\
+    return this->_heap->count ? (TYPE*)this->_heap->_array->first : NULL;\
+}\
+\
+static inline ch_word ch_heap_##NAME##_push(ch_heap_##NAME##_t* this, TYPE value)\
+{\
+    const ch_word result = heap_push(this->_heap, &value);\
+    this->count = this->_heap->count;\
+    return result;\
+}\
+\
+static inline ch_word ch_heap_##NAME##_pop(ch_heap_##NAME##_t* this, TYPE* value)\
+{\
+    const ch_word result = heap_pop(this->_heap, value);\
+    this->count = this->_heap->count;\
+    return result;\
+}
+
+
+#define declare_ch_heap_cmp(NAME, TYPE) ch_word ch_heap_cmp_##NAME(TYPE* lhs, TYPE* rhs);
+
+
+//**********************************************************************************************************************
+//Shortcuts to make things more accessible
+#define CH_HEAP(NAME)  ch_heap_##NAME##_t
+#define CH_HEAP_NEW(NAME, size, cmp) ch_heap_##NAME##_new(size, cmp)
+#define CH_HEAP_CMP(NAME) ch_heap_cmp_##NAME
+
+#endif /* HEAP_TYPED_DECLARE_TEMPLATE_H_ */
@@ -0,0 +1,93 @@
+/*
+ * heap_typed_define_template.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef HEAP_TYPED_DEFINE_TEMPLATE_H_
+#define HEAP_TYPED_DEFINE_TEMPLATE_H_
+
+#include "heap_typed_declare_template.h"
+#include "heap.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define define_ch_heap(NAME,TYPE)\
+\
+static ch_word _push_##NAME(ch_heap_##NAME##_t* this, TYPE value)                  { return ch_heap_##NAME##_push(this, value); }\
+static TYPE* _peek_##NAME(ch_heap_##NAME##_t* this)                                 { return ch_heap_##NAME##_peek(this); }\
+static ch_word _pop_##NAME(ch_heap_##NAME##_t* this, TYPE* value)                   { return ch_heap_##NAME##_pop(this, value); }\
+static TYPE* _get_##NAME(ch_heap_##NAME##_t* this, ch_word handle)                  { return (TYPE*)heap_get(this->_heap, handle); }\
+static ch_word _decrease_key_##NAME(ch_heap_##NAME##_t* this, ch_word handle, TYPE value)  { return heap_decrease_key(this->_heap, handle, &value); }\
+static ch_word _update_##NAME(ch_heap_##NAME##_t* this, ch_word handle, TYPE value)        { return heap_update(this->_heap, handle, &value); }\
+\
+static ch_word _remove_##NAME(ch_heap_##NAME##_t* this, ch_word handle, TYPE* value)\
+{\
+    const ch_word result = heap_remove(this->_heap, handle, value);\
+    this->count = this->_heap->count;\
+    return result;\
+}\
+\
+static ch_word _heapify_##NAME(ch_heap_##NAME##_t* this, const TYPE* carray, ch_word count)\
+{\
+    const ch_word result = heap_heapify(this->_heap, carray, count);\
+    this->count = this->_heap->count;\
+    return result;\
+}\
+\
+static void _clear_##NAME(ch_heap_##NAME##_t* this)\
+{\
+    heap_clear(this->_heap);\
+    this->count = 0;\
+}\
+\
+static void _delete_##NAME(ch_heap_##NAME##_t* this)\
+{\
+    if(this->_heap){\
+        heap_delete(this->_heap);\
+    }\
+\
+    free(this);\
+}\
+\
+ch_heap_##NAME##_t* ch_heap_##NAME##_new(ch_word size, ch_word(*cmp)(TYPE* lhs, TYPE* rhs) )\
+{\
+    ch_heap_##NAME##_t* result = (ch_heap_##NAME##_t*)calloc(1, sizeof(ch_heap_##NAME##_t));\
+    if(!result){\
+        printf("Could not allocate memory for new heap structure. Giving up\n");\
+        return NULL;\
+    }\
+\
+    result->_heap = ch_heap_new(size, sizeof(TYPE), (cmp_void_f)cmp);\
+    if(!result->_heap){\
+        free(result);\
+        return NULL;\
+    }\
+\
+    result->push                    = _push_##NAME;\
+    result->peek                    = _peek_##NAME;\
+    result->pop                     = _pop_##NAME;\
+\
+    result->get                     = _get_##NAME;\
+    result->decrease_key            = _decrease_key_##NAME;\
+    result->update                  = _update_##NAME;\
+    result->remove                  = _remove_##NAME;\
+\
+    result->heapify                 = _heapify_##NAME;\
+    result->clear                   = _clear_##NAME;\
+    result->delete                  = _delete_##NAME;\
+\
+    return result;\
+}
+
+
+//Regular comparison function
+#define define_ch_heap_cmp(NAME, TYPE) \
+ch_word ch_heap_cmp_##NAME(TYPE* lhs, TYPE* rhs)\
+{ \
+    return ( *lhs == *rhs ? 0 : *lhs < *rhs ? -1 : 1); \
+}
+
+#endif /* HEAP_TYPED_DEFINE_TEMPLATE_H_ */
@@ -0,0 +1,146 @@
+/*
+ * intrusive_list.h
+ *
+ * Intrusive doubly linked list. Rather than copying values into nodes that the list allocates (as ch_llist does), the
+ * caller embeds a ch_llist_node_t in their own structure and the list links those together. Nothing is allocated or
+ * copied, so every operation is O(1) and an object can live in whatever pool or array suits it. The list does not own
+ * its objects: removing an object, or deleting the list, leaves the object itself alone.
+ *
+ * An object can be on as many lists at once as it has embedded nodes, but each node can only be on one list at a time.
+ *
+ * Usage:
+ *     typedef struct { ch_word id; ch_llist_node_t by_age; } my_obj_t;
+ *     ch_ilist_t list; ilist_init(&list);
+ *     ilist_push_back(&list, &obj->by_age);
+ *     CH_ILIST_FOREACH(&list, my_obj_t, by_age, it){ ... it->id ... }
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef INTRUSIVE_LIST_H_
+#define INTRUSIVE_LIST_H_
+
+#include <stddef.h>
+
+#include "../../types/types.h"
+#include "../../utils/util.h"
+#include "linked_list.h"
+
+typedef struct {
+    ch_word count;  //Return the actual number of elements in the list
+
+    // Members prefixed with "_" are nominally "private" Don't touch my privates!
+    ch_llist_node_t* _first;
+    ch_llist_node_t* _last;
+} ch_ilist_t;
+
+
+static inline void ilist_init(ch_ilist_t* this)
+{
+    this->count  = 0;
+    this->_first = NULL;
+    this->_last  = NULL;
+}
+
+//Get the first node, NULL if the list is empty
+static inline ch_llist_node_t* ilist_first(ch_ilist_t* this) { return this->_first; }
+//Get the last node, NULL if the list is empty
+static inline ch_llist_node_t* ilist_last(ch_ilist_t* this)  { return this->_last; }
+
+
+//Insert node after pos. If pos is NULL, node goes at the front
+static inline void ilist_insert_after(ch_ilist_t* this, ch_llist_node_t* pos, ch_llist_node_t* node)
+{
+    node->prev = pos;
+    node->next = pos ? pos->next : this->_first;
+
+    if(node->next){
+        node->next->prev = node;
+    }
+    else{
+        this->_last = node;
+    }
+
+    if(pos){
+        pos->next = node;
+    }
+    else{
+        this->_first = node;
+    }
+
+    this->count++;
+}
+
+//Insert node before pos. If pos is NULL, node goes at the back
+static inline void ilist_insert_before(ch_ilist_t* this, ch_llist_node_t* pos, ch_llist_node_t* node)
+{
+    ilist_insert_after(this, pos ? pos->prev : this->_last, node);
+}
+
+static inline void ilist_push_front(ch_ilist_t* this, ch_llist_node_t* node) { ilist_insert_after(this, NULL, node); }
+static inline void ilist_push_back(ch_ilist_t* this, ch_llist_node_t* node)  { ilist_insert_after(this, this->_last, node); }
+
+
+//Unlink node from the list, return the node that followed it, or NULL
+static inline ch_llist_node_t* ilist_remove(ch_ilist_t* this, ch_llist_node_t* node)
+{
+    ch_llist_node_t* const next = node->next;
+
+    if(node->prev){
+        node->prev->next = next;
+    }
+    else{
+        this->_first = next;
+    }
+
+    if(next){
+        next->prev = node->prev;
+    }
+    else{
+        this->_last = node->prev;
+    }
+
+    node->next = NULL;
+    node->prev = NULL;
+    this->count--;
+    return next;
+}
+
+//Unlink and return the first node, or NULL if the list is empty
+static inline ch_llist_node_t* ilist_pop_front(ch_ilist_t* this)
+{
+    ch_llist_node_t* const result = this->_first;
+    if(result){
+        ilist_remove(this, result);
+    }
+
+    return result;
+}
+
+//Unlink and return the last node, or NULL if the list is empty
+static inline ch_llist_node_t* ilist_pop_back(ch_ilist_t* this)
+{
+    ch_llist_node_t* const result = this->_last;
+    if(result){
+        ilist_remove(this, result);
+    }
+
+    return result;
+}
+
+
+//The structure of type TYPE that NODE (a ch_llist_node_t* in field MEMBER) is embedded in, or NULL if NODE is NULL
+#define CH_ILIST_ENTRY(NODE, TYPE, MEMBER) ((NODE) ? container_of((NODE), TYPE, MEMBER) : NULL)
+
+//Iterate over the list from front to back, with IT (a TYPE*) pointing to each object in turn
+#define CH_ILIST_FOREACH(LIST, TYPE, MEMBER, IT) \
+    for(TYPE* IT = CH_ILIST_ENTRY((LIST)->_first, TYPE, MEMBER); IT; IT = CH_ILIST_ENTRY(IT->MEMBER.next, TYPE, MEMBER))
+
+//As above, but IT can be removed from the list (or freed) inside the loop
+#define CH_ILIST_FOREACH_SAFE(LIST, TYPE, MEMBER, IT) \
+    for(TYPE* IT = CH_ILIST_ENTRY((LIST)->_first, TYPE, MEMBER), *IT##_next = IT ? CH_ILIST_ENTRY(IT->MEMBER.next, TYPE, MEMBER) : NULL; \
+        IT; \
+        IT = IT##_next, IT##_next = IT ? CH_ILIST_ENTRY(IT->MEMBER.next, TYPE, MEMBER) : NULL)
+
+#endif /* INTRUSIVE_LIST_H_ */
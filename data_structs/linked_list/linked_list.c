@@ -14,16 +14,61 @@
 
 //Allocate an object using whatever mechanism we want
 static ch_llist_node_t* alloc_ch_llist_node_obj(ch_llist_t* this){
+    if(this->_pool){
+        return (ch_llist_node_t*)pool_alloc(this->_pool);
+    }
+
     ch_llist_node_t* result = (ch_llist_node_t*)malloc(sizeof(ch_llist_node_t) + this->_element_size );
     return result;
 }
 
 static void free_ch_llist_node_obj(ch_llist_t* this, ch_llist_node_t* lhs){
-    (void)this;
+    if(this->_pool){
+        pool_free(this->_pool, lhs);
+        return;
+    }
+
     free(lhs);
 }
 
 
+//Fix up the prev pointers, first and last, given a chain of nodes linked only through next
+static void _llist_relink(ch_llist_t* this, ch_llist_node_t* first)
+{
+    ch_llist_node_t* prev = NULL;
+    for(ch_llist_node_t* node = first; node; node = node->next){
+        node->prev = prev;
+        prev = node;
+    }
+
+    this->_first = first;
+    this->_last  = prev;
+}
+
+
+//Merge two sorted chains of nodes, linked only through next. Equal elements come from lhs first, so the merge is stable
+static ch_llist_node_t* _llist_merge(ch_llist_t* this, ch_llist_node_t* lhs, ch_llist_node_t* rhs)
+{
+    ch_llist_node_t head = { 0 };
+    ch_llist_node_t* tail = &head;
+
+    while(lhs && rhs){
+        if(this->_cmp(NODE_DATAP(lhs), NODE_DATAP(rhs)) <= 0){
+            tail->next = lhs;
+            lhs = lhs->next;
+        }
+        else{
+            tail->next = rhs;
+            rhs = rhs->next;
+        }
+        tail = tail->next;
+    }
+
+    tail->next = lhs ? lhs : rhs;
+    return head.next;
+}
+
+
 //Get the first entry
 ch_llist_it llist_first(ch_llist_t* this)
 {
@@ -353,13 +398,23 @@ ch_llist_it llist_pop_front(ch_llist_t* this)
 //Get rid of everything
 void llist_pop_all(ch_llist_t* this)
 {
-    ch_llist_node_t* node = this->_first;
+    //Nobody else has nodes in our pool, so there is no need to walk the list
+    if(this->_own_pool){
+        pool_clear(this->_pool);
+    }
+    else{
+        ch_llist_node_t* node = this->_first;
 
-    while(node){
-        ch_llist_node_t* tmp = node;
-        node = node->next;
-        free_ch_llist_node_obj(this, tmp);
+        while(node){
+            ch_llist_node_t* tmp = node;
+            node = node->next;
+            free_ch_llist_node_obj(this, tmp);
+        }
     }
+
+    this->_first = NULL;
+    this->_last  = NULL;
+    this->count  = 0;
 }
 
 
@@ -371,7 +426,12 @@ void llist_delete(ch_llist_t* this)
         return;
     }
 
-    llist_pop_all(this);
+    if(this->_own_pool){
+        pool_delete(this->_pool);
+    }
+    else{
+        llist_pop_all(this);
+    }
 
     free(this);
 
@@ -397,16 +457,23 @@ ch_llist_it llist_push_back_carray(ch_llist_t* this, const void* carray, ch_word
 //Insert count elements into the linked list in order
 ch_llist_it llist_insert_carray_ordered(ch_llist_t* this, void* carray, ch_word count)
 {
-    ch_llist_it result;
+    //Put the new elements on a list of their own (with nodes from the same place as ours), sort it, then merge the two
+    ch_llist_t incoming = *this;
+    incoming._first     = NULL;
+    incoming._last      = NULL;
+    incoming.count      = 0;
+    incoming._own_pool  = false;
 
-    ch_byte* ptr = carray;
-    for(ch_word i =  0; i < count; i++){
-        result = llist_insert_inorder(this,ptr); //This is a stupid way to do it, simpler is to sort the array first
-        //But this will test the idea
-        ptr += this->_element_size;
+    if(count > 0){
+        llist_push_back_carray(&incoming, carray, count);
+        llist_sort(&incoming);
     }
 
-    return result;
+    //New elements go before existing equal ones, as with llist_insert_inorder()
+    _llist_relink(this, _llist_merge(this, incoming._first, this->_first));
+    this->count += incoming.count;
+
+    return llist_first(this);
 }
 
 
@@ -481,11 +548,63 @@ ch_llist_it llist_find_next(ch_llist_t* this,  ch_llist_it* begin, void* value)
 
 
 //sort into order given the comparator function
+//Bottom up merge sort. Each pass merges neighbouring sorted runs of width elements into runs of 2 * width, until one
+//run is left. Only the links are changed, the elements themselves never move or get copied.
 void llist_sort(ch_llist_t* this)
 {
-    (void)this;
-    printf("%s:%s%u Not (yet  )implemented!\n", __FUNCTION__, __FILE__, __LINE__ );
-    exit(1);
+    ch_llist_node_t* list = this->_first;
+    if(!list){
+        return;
+    }
+
+    for(ch_word width = 1; ; width *= 2){
+        ch_llist_node_t* lhs  = list;
+        ch_llist_node_t* tail = NULL;
+        ch_word merges        = 0;
+        list = NULL;
+
+        while(lhs){
+            merges++;
+
+            //Split off runs lhs and rhs of (up to) width elements each, then the rest
+            ch_llist_node_t* rhs = lhs;
+            for(ch_word i = 1; i < width && rhs->next; i++){
+                rhs = rhs->next;
+            }
+            ch_llist_node_t* lhs_end = rhs;
+            rhs = rhs->next;
+            lhs_end->next = NULL;
+
+            ch_llist_node_t* rest = rhs;
+            for(ch_word i = 1; i < width && rest && rest->next; i++){
+                rest = rest->next;
+            }
+            if(rest){
+                ch_llist_node_t* rhs_end = rest;
+                rest = rest->next;
+                rhs_end->next = NULL;
+            }
+
+            ch_llist_node_t* merged = _llist_merge(this, lhs, rhs);
+            if(tail){
+                tail->next = merged;
+            }
+            else{
+                list = merged;
+            }
+
+            for(tail = merged; tail->next; tail = tail->next){
+            }
+
+            lhs = rest;
+        }
+
+        if(merges <= 1){
+            break;
+        }
+    }
+
+    _llist_relink(this, list);
 }
 
 ch_llist_t* ch_llist_new( ch_word element_size, cmp_void_f cmp )
@@ -497,7 +616,12 @@ ch_llist_t* ch_llist_new( ch_word element_size, cmp_void_f cmp )
         return NULL;
     }
 
-    return ch_llist_init(result, element_size,cmp);
+    if(!ch_llist_init(result, element_size,cmp)){
+        free(result);
+        return NULL;
+    }
+
+    return result;
 
 }
 
@@ -516,9 +640,77 @@ ch_llist_t* ch_llist_init( ch_llist_t* this, ch_word element_size, cmp_void_f cm
     this->_first          = NULL;
     this->_last           = NULL;
     this->count           = 0;
+    this->_pool           = NULL;
+    this->_own_pool       = false;
 
     return this;
 
 }
 
 
+ch_pool_t* llist_pool_new( ch_word element_size )
+{
+    if(element_size <= 0){
+        printf("Error: invalid element size (<=0), must have *some* data\n");
+        return NULL;
+    }
+
+    return ch_pool_new(sizeof(ch_llist_node_t) + element_size);
+}
+
+
+ch_llist_t* ch_llist_new_pooled( ch_word element_size, cmp_void_f cmp, ch_pool_t* pool )
+{
+    ch_llist_t* result = (ch_llist_t*)calloc(1,sizeof(ch_llist_t));
+    if(!result){
+        printf("Could not allocate memory for new llist structure. Giving up\n");
+        return NULL;
+    }
+
+    //A list made here can be deleted, so it can own its pool
+    ch_bool own_pool = false;
+    if(!pool){
+        pool = llist_pool_new(element_size);
+        if(!pool){
+            free(result);
+            return NULL;
+        }
+        own_pool = true;
+    }
+
+    if(!ch_llist_init_pooled(result, element_size, cmp, pool)){
+        if(own_pool){
+            pool_delete(pool);
+        }
+        free(result);
+        return NULL;
+    }
+
+    result->_own_pool = own_pool;
+    return result;
+}
+
+
+ch_llist_t* ch_llist_init_pooled( ch_llist_t* this, ch_word element_size, cmp_void_f cmp, ch_pool_t* pool )
+{
+    if(!ch_llist_init(this, element_size, cmp)){
+        return NULL;
+    }
+
+    //Nothing deletes a list made here, so nothing would delete a pool made for it either
+    if(!pool){
+        printf("Error: an initialised list needs a pool, only ch_llist_new_pooled() can make one of its own\n");
+        return NULL;
+    }
+
+    if(pool->object_size < (ch_word)sizeof(ch_llist_node_t) + element_size){
+        printf("Error: pool objects (%lli bytes) are too small for list nodes (%lli bytes)\n",
+                pool->object_size, (ch_word)sizeof(ch_llist_node_t) + element_size);
+        return NULL;
+    }
+
+    this->_pool = pool;
+    return this;
+}
+
+
@@ -9,6 +9,7 @@
 #define LINKEDLIST_H_
 
 #include "../../types/types.h"
+#include "../pool/pool.h"
 
 struct ch_llist_node;
 typedef struct ch_llist_node ch_llist_node_t;
@@ -29,6 +30,8 @@ struct ch_llist{
    ch_llist_node_t* _first;
    ch_llist_node_t* _last;
    ch_word _element_size;
+   ch_pool_t* _pool; //Where nodes come from. NULL to use malloc()
+   ch_bool _own_pool; //The pool belongs to this list alone, so it can be cleared and deleted along with the list
 };
 
 typedef struct {
@@ -93,11 +96,23 @@ ch_llist_it llist_find(ch_llist_t* this, ch_llist_it* begin, ch_llist_it* end, v
 ch_llist_it llist_find_first(ch_llist_t* this, void* value);
 ch_llist_it llist_find_next(ch_llist_t* this,  ch_llist_it* begin, void* value);
 ch_llist_it llist_insert_inorder(ch_llist_t* this,  void* value);
+//Insert count elements from carray into a sorted list, keeping it sorted. Returns the first element
 ch_llist_it llist_insert_carray_ordered(ch_llist_t* this, void* carray, ch_word count);
-//sort into order given the comparator function
+//sort into order given the comparator function. The sort is stable and O(n log n), and relinks nodes without copying
 void llist_sort(ch_llist_t* this);
 
 ch_llist_t* ch_llist_new( ch_word element_size, cmp_void_f cmp );
 ch_llist_t* ch_llist_init( ch_llist_t* this, ch_word element_size, cmp_void_f cmp );
 
+//As above, but take nodes from pool instead of calling malloc() and free() for every node. Pools can be shared between
+//lists with the same element size, see llist_pool_new(). If pool is NULL, ch_llist_new_pooled() gives the list a pool
+//of its own, which lets llist_pop_all() and llist_delete() release the nodes a whole slab at a time. Initialised lists
+//are never deleted, so ch_llist_init_pooled() needs a pool, which the caller deletes once the list is done with it.
+ch_llist_t* ch_llist_new_pooled( ch_word element_size, cmp_void_f cmp, ch_pool_t* pool );
+ch_llist_t* ch_llist_init_pooled( ch_llist_t* this, ch_word element_size, cmp_void_f cmp, ch_pool_t* pool );
+
+//Make a pool of nodes that can be shared by lists with the given element size. Delete it with pool_delete() once all
+//of the lists using it have been deleted.
+ch_pool_t* llist_pool_new( ch_word element_size );
+
 #endif // LINKEDLIST_H_
@@ -60,7 +60,71 @@ struct ch_llist_##NAME{\
 };\
 \
 \
-ch_llist_##NAME##_t* ch_llist_##NAME##_new(ch_word(*cmp)(TYPE* lhs, TYPE* rhs) );
+ch_llist_##NAME##_t* ch_llist_##NAME##_new(ch_word(*cmp)(TYPE* lhs, TYPE* rhs) );\
+/*Take nodes from pool, see ch_llist_new_pooled(). Use llist_pool_new(sizeof(TYPE)) to make a pool to share*/\
+ch_llist_##NAME##_t* ch_llist_##NAME##_new_pooled(ch_word(*cmp)(TYPE* lhs, TYPE* rhs), ch_pool_t* pool );\
+_declare_ch_llist_inline(NAME,TYPE)
+
+//Direct call versions of the common operations. These are static inline, so unlike calls through the function
+//pointers above, the compiler can inline them (and iteration becomes a plain pointer chase).
+#define _declare_ch_llist_inline(NAME,TYPE)\
+\
+static inline ch_llist_##NAME##_it _ch_llist_##NAME##_it(ch_llist_node_t* node)\
+{\
+    ch_llist_##NAME##_it result = { ._node = node, .value = node ? (TYPE*)(node + 1) : NULL };\
+    return result;\
+}\
+\
+/*Get the first entry*/\
+static inline ch_llist_##NAME##_it ch_llist_##NAME##_first(ch_llist_##NAME##_t* this) { return _ch_llist_##NAME##_it(this->_llist->_first); }\
+/*Get the last entry*/\
+static inline ch_llist_##NAME##_it ch_llist_##NAME##_last(ch_llist_##NAME##_t* this)  { return _ch_llist_##NAME##_it(this->_llist->_last); }\
+\
+/*Step forwards by one entry*/\
+static inline void ch_llist_##NAME##_next(ch_llist_##NAME##_t* this, ch_llist_##NAME##_it* it)\
+{\
+    (void)this;\
+    *it = _ch_llist_##NAME##_it(it->_node ? it->_node->next : NULL);\
+}\
+\
+/*Step backwards by one entry*/\
+static inline void ch_llist_##NAME##_prev(ch_llist_##NAME##_t* this, ch_llist_##NAME##_it* it)\
+{\
+    (void)this;\
+    *it = _ch_llist_##NAME##_it(it->_node ? it->_node->prev : NULL);\
+}\
+\
+/*Put an element at the front of the list*/\
+static inline ch_llist_##NAME##_it ch_llist_##NAME##_push_front(ch_llist_##NAME##_t* this, TYPE value)\
+{\
+    const ch_llist_it result = llist_push_front(this->_llist, &value);\
+    this->count = this->_llist->count;\
+    return _ch_llist_##NAME##_it(result._node);\
+}\
+\
+/*Put an element at the back of the list*/\
+static inline ch_llist_##NAME##_it ch_llist_##NAME##_push_back(ch_llist_##NAME##_t* this, TYPE value)\
+{\
+    const ch_llist_it result = llist_push_back(this->_llist, &value);\
+    this->count = this->_llist->count;\
+    return _ch_llist_##NAME##_it(result._node);\
+}\
+\
+/*Remove the element at the front of the list, return the new first entry*/\
+static inline ch_llist_##NAME##_it ch_llist_##NAME##_pop_front(ch_llist_##NAME##_t* this)\
+{\
+    const ch_llist_it result = llist_pop_front(this->_llist);\
+    this->count = this->_llist->count;\
+    return _ch_llist_##NAME##_it(result._node);\
+}\
+\
+/*Remove the element at the back of the list, returns the end*/\
+static inline ch_llist_##NAME##_it ch_llist_##NAME##_pop_back(ch_llist_##NAME##_t* this)\
+{\
+    const ch_llist_it result = llist_pop_back(this->_llist);\
+    this->count = this->_llist->count;\
+    return _ch_llist_##NAME##_it(result._node);\
+}
 
 
 #define declare_ch_llist_cmp(NAME, TYPE) ch_word ch_llist_cmp_##NAME(TYPE* lhs, TYPE* rhs)
@@ -209,16 +209,20 @@ static void _delete_##NAME(ch_llist_##NAME##_t* this)\
 }\
 \
 \
-ch_llist_##NAME##_t* ch_llist_##NAME##_new(ch_word(*cmp)(TYPE* lhs, TYPE* rhs) )\
+static ch_llist_##NAME##_t* _wrap_##NAME(ch_llist_t* llist, ch_word(*cmp)(TYPE* lhs, TYPE* rhs) )\
 {\
+    if(!llist){\
+        return ((void *)0);\
+    }\
 \
     ch_llist_##NAME##_t* result = (ch_llist_##NAME##_t*)calloc(1,sizeof(ch_llist_##NAME##_t));\
     if(!result){\
         printf("Could not allocate memory for new llist structure. Giving upn");\
+        llist_delete(llist);\
         return ((void *)0);\
     }\
 \
-    result->_llist = ch_llist_new(sizeof(TYPE), (cmp_void_f)cmp );\
+    result->_llist = llist;\
 \
 \
     /*We have memory to play with, now do all the other assignments*/\
@@ -263,6 +267,16 @@ ch_llist_##NAME##_t* ch_llist_##NAME##_new(ch_word(*cmp)(TYPE* lhs, TYPE* rhs) )
     return result;\
 }\
 \
+ch_llist_##NAME##_t* ch_llist_##NAME##_new(ch_word(*cmp)(TYPE* lhs, TYPE* rhs) )\
+{\
+    return _wrap_##NAME(ch_llist_new(sizeof(TYPE), (cmp_void_f)cmp ), cmp);\
+}\
+\
+ch_llist_##NAME##_t* ch_llist_##NAME##_new_pooled(ch_word(*cmp)(TYPE* lhs, TYPE* rhs), ch_pool_t* pool )\
+{\
+    return _wrap_##NAME(ch_llist_new_pooled(sizeof(TYPE), (cmp_void_f)cmp, pool ), cmp);\
+}\
+\
 
 
 //Regular comparison function
@@ -0,0 +1,168 @@
+/*
+ * mpmc_queue.c
+ *
+ * Slot sequence numbers, for the slot at position pos (masked into the ring):
+ *     seq == pos           the slot is empty, and the producer that claims pos may write it
+ *     seq == pos + 1       the slot is full, and the consumer that claims pos may read it
+ *     seq == pos + size    the consumer is done, and the slot is empty for position pos + size on the next lap
+ * Positions run freely (they never wrap), so comparing seq with pos tells a producer whether the slot is ready, still
+ * being read from the last lap (the queue is full), or already claimed by another producer (pos is stale).
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include "mpmc_queue.h"
+#include "../../utils/util.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+static inline ch_word* _seq(ch_mpmcq_t* this, ch_word pos)
+{
+    return (ch_word*)((ch_byte*)this->_array->first + (pos & this->_mask) * this->_slot_size);
+}
+
+static inline void* _data(ch_word* seq)
+{
+    return seq + 1;
+}
+
+
+//Claim a run of up to count ready slots, from the position in *pos_ptr (the tail for producers, or the head for
+//consumers). A slot is ready if seq == pos + offset, where offset is 0 for producers and 1 for consumers. Returns the
+//number claimed, with the position of the first in *pos_io
+static ch_word _claim(ch_mpmcq_t* this, ch_word* pos_ptr, ch_word count, ch_word offset, ch_word* pos_io)
+{
+    ch_word pos = __atomic_load_n(pos_ptr, __ATOMIC_RELAXED);
+    for(;;){
+        const ch_word dif = __atomic_load_n(_seq(this, pos), __ATOMIC_ACQUIRE) - (pos + offset);
+        if(dif < 0){
+            return 0; //Full (or empty)
+        }
+        if(dif > 0){
+            pos = __atomic_load_n(pos_ptr, __ATOMIC_RELAXED); //Someone else got there first
+            continue;
+        }
+
+        //The first slot is ready. Slots after it can only become ready, not stop being ready, until pos moves on, so
+        //if the CAS succeeds the whole run is still ours
+        ch_word run = 1;
+        while(run < count && __atomic_load_n(_seq(this, pos + run), __ATOMIC_ACQUIRE) == pos + run + offset){
+            run++;
+        }
+
+        if(__atomic_compare_exchange_n(pos_ptr, &pos, pos + run, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)){
+            *pos_io = pos;
+            return run;
+        }
+    }
+}
+
+
+ch_word mpmcq_try_push_carray(ch_mpmcq_t* this, const void* carray, ch_word count)
+{
+    if(count <= 0){
+        return 0;
+    }
+
+    ch_word pos;
+    const ch_word run = _claim(this, &this->_tail, count, 0, &pos);
+    for(ch_word i = 0; i < run; i++){
+        ch_word* seq = _seq(this, pos + i);
+        memcpy(_data(seq), (const ch_byte*)carray + i * this->_element_size, this->_element_size);
+        __atomic_store_n(seq, pos + i + 1, __ATOMIC_RELEASE);
+    }
+
+    return run;
+}
+
+ch_word mpmcq_try_pop_carray(ch_mpmcq_t* this, void* carray, ch_word count)
+{
+    if(count <= 0){
+        return 0;
+    }
+
+    ch_word pos;
+    const ch_word run = _claim(this, &this->_head, count, 1, &pos);
+    for(ch_word i = 0; i < run; i++){
+        ch_word* seq = _seq(this, pos + i);
+        memcpy((ch_byte*)carray + i * this->_element_size, _data(seq), this->_element_size);
+        __atomic_store_n(seq, pos + i + this->size, __ATOMIC_RELEASE);
+    }
+
+    return run;
+}
+
+ch_word mpmcq_try_push(ch_mpmcq_t* this, const void* value)
+{
+    return mpmcq_try_push_carray(this, value, 1) ? 0 : -1;
+}
+
+ch_word mpmcq_try_pop(ch_mpmcq_t* this, void* value)
+{
+    return mpmcq_try_pop_carray(this, value, 1) ? 0 : -1;
+}
+
+
+ch_word mpmcq_count(ch_mpmcq_t* this)
+{
+    const ch_word head = __atomic_load_n(&this->_head, __ATOMIC_ACQUIRE);
+    const ch_word tail = __atomic_load_n(&this->_tail, __ATOMIC_ACQUIRE);
+    return MAX(MIN(tail - head, this->size), 0);
+}
+
+
+void mpmcq_delete(ch_mpmcq_t* this)
+{
+    if(!this){
+        return;
+    }
+
+    if(this->_array){
+        array_delete(this->_array);
+    }
+
+    free(this);
+}
+
+
+ch_mpmcq_t* ch_mpmcq_new(ch_word size, ch_word element_size)
+{
+    if(size <= 0 || element_size <= 0){
+        printf("Error: invalid queue size (%lli) or element size (%lli)\n", size, element_size);
+        return NULL;
+    }
+
+    ch_word pow2 = 1;
+    while(pow2 < size){
+        pow2 <<= 1;
+    }
+
+    //Keep the head and tail on their own cache lines
+    ch_mpmcq_t* result = (ch_mpmcq_t*)aligned_alloc(CH_ARRAY_ALIGN_CACHE_LINE, sizeof(ch_mpmcq_t));
+    if(!result){
+        printf("Could not allocate memory for new mpmc queue structure. Giving up\n");
+        return NULL;
+    }
+    memset(result, 0, sizeof(ch_mpmcq_t));
+
+    result->size          = pow2;
+    result->_mask         = pow2 - 1;
+    result->_element_size = element_size;
+    result->_slot_size    = round_up((ch_word)sizeof(ch_word) + element_size, (ch_word)sizeof(ch_word));
+    result->_array        = ch_array_new_aligned(pow2, result->_slot_size, NULL, CH_ARRAY_ALIGN_CACHE_LINE, 0);
+    if(!result->_array){
+        mpmcq_delete(result);
+        return NULL;
+    }
+
+    //Every slot starts empty, for the first lap
+    for(ch_word pos = 0; pos < pow2; pos++){
+        *_seq(result, pos) = pos;
+    }
+
+    return result;
+}
@@ -0,0 +1,63 @@
+/*
+ * mpmc_queue.h
+ *
+ * Bounded, lock-free queue for any number of producer and consumer threads, with fixed size elements like ch_cbq_t.
+ * Each slot carries a sequence number that says whether it is ready to be written (on this lap of the ring) or ready to
+ * be read, after D. Vyukov's bounded MPMC queue. A producer claims a slot by advancing the tail with a single CAS, copies
+ * its element in, then publishes it by bumping the slot's sequence number. Consumers do the same with the head. Threads
+ * only contend on the head (or the tail), and never wait for each other while copying.
+ *
+ * The batch versions claim a run of slots with one CAS, which cuts contention on the head and tail. Elements come out in
+ * the order that their slots were claimed, so elements from one producer come out in the order they were pushed. A pop
+ * reports the queue empty if the front slot has been claimed but not yet filled, even if later slots have been.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef MPMC_QUEUE_H_
+#define MPMC_QUEUE_H_
+
+#include "../../types/types.h"
+#include "../array/array.h"
+
+struct ch_mpmcq;
+typedef struct ch_mpmcq ch_mpmcq_t;
+
+struct ch_mpmcq{
+    ch_word size;   //Return the max number number of elements in the queue
+
+    // Members prefixed with "_" are nominally "private" Don't touch my privates!
+    ch_word _mask;  //size - 1
+    ch_word _element_size;
+    ch_word _slot_size; //The sequence number, then the element, rounded up to keep the sequence numbers aligned
+    ch_array_t* _array; //The slots
+    ch_byte _pad0[CH_ARRAY_ALIGN_CACHE_LINE - 4 * sizeof(ch_word) - sizeof(ch_array_t*)];
+
+    ch_word _tail; //Next position to push into. Producers only
+    ch_byte _pad1[CH_ARRAY_ALIGN_CACHE_LINE - sizeof(ch_word)];
+
+    ch_word _head; //Next position to pop from. Consumers only
+    ch_byte _pad2[CH_ARRAY_ALIGN_CACHE_LINE - sizeof(ch_word)];
+};
+
+//Copy value into the back of the queue. Returns 0 on success, -1 if the queue is full
+ch_word mpmcq_try_push(ch_mpmcq_t* this, const void* value);
+//Copy the front of the queue into value and remove it. Returns 0 on success, -1 if the queue is empty
+ch_word mpmcq_try_pop(ch_mpmcq_t* this, void* value);
+
+//Push up to count elements from the C array, as one run. Returns the number pushed, which is 0 if the queue is full
+ch_word mpmcq_try_push_carray(ch_mpmcq_t* this, const void* carray, ch_word count);
+//Pop up to count elements into the C array, as one run. Returns the number popped, which is 0 if the queue is empty
+ch_word mpmcq_try_pop_carray(ch_mpmcq_t* this, void* carray, ch_word count);
+
+//Return the number of elements in the queue. This is a snapshot, which may be out of date by the time it returns
+ch_word mpmcq_count(ch_mpmcq_t* this);
+
+//Free the resources associated with this queue, assumes that individual items have been freed
+void mpmcq_delete(ch_mpmcq_t* this);
+
+//Create a new queue with size slots (rounded up to a power of 2), each with element_size storage
+ch_mpmcq_t* ch_mpmcq_new(ch_word size, ch_word element_size);
+
+#endif // MPMC_QUEUE_H_
@@ -0,0 +1,150 @@
+/*
+ * pool.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stddef.h>
+
+#include "../../utils/util.h"
+#include "../../types/types.h"
+#include "pool.h"
+
+#define CH_POOL_ALIGN ((ch_word)_Alignof(max_align_t))
+
+struct ch_pool_slab{
+    ch_pool_slab_t* next;
+};
+
+//Objects start after the slab header, suitably aligned
+#define SLAB_HEADER_BYTES round_up((ch_word)sizeof(ch_pool_slab_t), CH_POOL_ALIGN)
+
+//Slabs left before allocations are made to fail, see pool_fail_after()
+static ch_word _fail_after = -1;
+
+
+static ch_byte* _slab_objects(ch_pool_slab_t* slab)
+{
+    return (ch_byte*)slab + SLAB_HEADER_BYTES;
+}
+
+
+static ch_word _pool_add_slab(ch_pool_t* this)
+{
+    ch_pool_slab_t* slab = NULL;
+    if(_fail_after != 0){
+        slab = (ch_pool_slab_t*)malloc(SLAB_HEADER_BYTES + this->_slab_objects * this->object_size);
+        _fail_after -= _fail_after > 0;
+    }
+    if(!slab){
+        printf("Could not allocate memory for pool slab\n");
+        return -1;
+    }
+
+    slab->next       = this->_slab_list;
+    this->_slab_list = slab;
+    this->_bump      = _slab_objects(slab);
+    this->_bump_end  = this->_bump + this->_slab_objects * this->object_size;
+    this->slabs++;
+    return 0;
+}
+
+
+void* pool_alloc(ch_pool_t* this)
+{
+    void* result = this->_free;
+    if(likely(result != NULL)){
+        this->_free = *(void**)result;
+        this->count++;
+        return result;
+    }
+
+    if(unlikely(this->_bump == this->_bump_end) && _pool_add_slab(this)){
+        return NULL;
+    }
+
+    result = this->_bump;
+    this->_bump += this->object_size;
+    this->count++;
+    return result;
+}
+
+
+void pool_free(ch_pool_t* this, void* obj)
+{
+    if(!obj){
+        return;
+    }
+
+    *(void**)obj = this->_free;
+    this->_free  = obj;
+    this->count--;
+}
+
+
+void pool_clear(ch_pool_t* this)
+{
+    ch_pool_slab_t* keep = NULL;
+    for(ch_pool_slab_t* slab = this->_slab_list; slab; ){
+        ch_pool_slab_t* next = slab->next;
+        if(!keep){
+            keep = slab;
+        }
+        else{
+            free(slab);
+        }
+        slab = next;
+    }
+
+    this->_slab_list = keep;
+    this->_free      = NULL;
+    this->count      = 0;
+    this->slabs      = keep ? 1 : 0;
+    this->_bump      = keep ? _slab_objects(keep) : NULL;
+    this->_bump_end  = keep ? this->_bump + this->_slab_objects * this->object_size : NULL;
+    if(keep){
+        keep->next = NULL;
+    }
+}
+
+
+void pool_delete(ch_pool_t* this)
+{
+    if(!this){
+        return;
+    }
+
+    pool_clear(this);
+    free(this->_slab_list);
+    free(this);
+}
+
+
+void pool_fail_after(ch_word count)
+{
+    _fail_after = count;
+}
+
+
+ch_pool_t* ch_pool_new(ch_word object_size)
+{
+    if(object_size <= 0){
+        printf("Error: invalid object size (<=0)\n");
+        return NULL;
+    }
+
+    ch_pool_t* result = (ch_pool_t*)calloc(1, sizeof(ch_pool_t));
+    if(!result){
+        printf("Could not allocate memory for new pool structure. Giving up\n");
+        return NULL;
+    }
+
+    //Every object must be able to hold the free list pointer, and start suitably aligned
+    result->object_size   = round_up(MAX(object_size, (ch_word)sizeof(void*)), CH_POOL_ALIGN);
+    result->_slab_objects = MAX((CH_POOL_SLAB_BYTES - SLAB_HEADER_BYTES) / result->object_size, 1);
+
+    return result;
+}
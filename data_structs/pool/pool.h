@@ -0,0 +1,57 @@
+/*
+ * pool.h
+ *
+ * Fixed size object pool. Objects are carved out of 64kB slabs and recycled through an intrusive free list, so
+ * allocating and freeing is a few instructions with no calls to malloc() once the pool is warm, objects allocated
+ * together sit together in memory, and the heap is not fragmented by many small allocations. Everything can be given
+ * back at once with pool_clear() or pool_delete(), without freeing objects one at a time.
+ *
+ * A pool can be shared by several containers, as long as they all want objects of (at most) the same size. Pools are
+ * not thread safe.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef POOL_H_
+#define POOL_H_
+
+#include "../../types/types.h"
+
+#define CH_POOL_SLAB_BYTES (64 * 1024)
+
+struct ch_pool_slab;
+typedef struct ch_pool_slab ch_pool_slab_t;
+
+struct ch_pool;
+typedef struct ch_pool ch_pool_t;
+
+struct ch_pool{
+    ch_word object_size; //Size of each object, rounded up so that every object is suitably aligned for any type
+    ch_word count; //Number of objects currently allocated
+    ch_word slabs; //Number of slabs currently held
+
+    // Members prefixed with "_" are nominally "private" Don't touch my privates!
+    ch_word _slab_objects; //Objects per slab
+    ch_pool_slab_t* _slab_list; //All slabs, most recent first
+    ch_byte* _bump; //Next never used object in the most recent slab
+    ch_byte* _bump_end; //End of the most recent slab
+    void* _free; //Free list of returned objects, linked through their first word
+};
+
+//Return a new object, or NULL if there is no memory
+void* pool_alloc(ch_pool_t* this);
+//Give an object back to the pool
+void pool_free(ch_pool_t* this, void* obj);
+//Give back every object at once. One slab is kept for reuse, the others are released
+void pool_clear(ch_pool_t* this);
+//Free the pool and all of its slabs, and so every object allocated from it
+void pool_delete(ch_pool_t* this);
+
+ch_pool_t* ch_pool_new(ch_word object_size);
+
+//Make new slabs fail to allocate, in every pool, once count more have been allocated. This is for testing how out of
+//memory errors are handled. A negative count (the default) turns it off. Not thread safe
+void pool_fail_after(ch_word count);
+
+#endif /* POOL_H_ */
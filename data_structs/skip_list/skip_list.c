@@ -0,0 +1,327 @@
+/*
+ * skip_list.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "../../utils/util.h"
+#include "skip_list.h"
+
+#define CH_SKIP_LIST_ALIGN ((ch_word)_Alignof(max_align_t))
+
+//The element follows the next pointers, suitably aligned
+static inline ch_word _node_header_bytes(ch_word level)
+{
+    return round_up((ch_word)(sizeof(ch_skip_list_node_t) + level * sizeof(ch_skip_list_node_t*)), CH_SKIP_LIST_ALIGN);
+}
+
+#define NODE_DATAP(node) ( (void*)((ch_byte*)(node) + _node_header_bytes((node)->level)) )
+
+
+static inline ch_skip_list_it _skip_list_it(ch_skip_list_t* this, ch_skip_list_node_t* node)
+{
+    ch_skip_list_it result = { 0 };
+    if(node && node != this->_head){
+        result._node = node;
+        result.value = NODE_DATAP(node);
+    }
+
+    return result;
+}
+
+
+//Pick a level for a new node: 1 with probability 3/4, 2 with probability 3/16, and so on
+static ch_word _random_level(ch_skip_list_t* this)
+{
+    //xorshift64*
+    this->_seed ^= this->_seed >> 12;
+    this->_seed ^= this->_seed << 25;
+    this->_seed ^= this->_seed >> 27;
+    const u64 r = this->_seed * 2685821657736338717ULL;
+
+    return 1 + __builtin_ctzll((r >> 2) | (1ULL << 61)) / 2;
+}
+
+
+//Find, on every level in use, the last node before value. With or_equal, the last node before or equal to value
+static ch_skip_list_node_t* _skip_list_search(ch_skip_list_t* this, const void* value, ch_bool or_equal,
+        ch_skip_list_node_t** update)
+{
+    ch_skip_list_node_t* node = this->_head;
+    for(ch_word i = this->_level - 1; i >= 0; i--){
+        for(ch_skip_list_node_t* next = node->next[i]; next; next = node->next[i]){
+            const int cmp = this->_cmp(NODE_DATAP(next), value);
+            if(cmp > 0 || (cmp == 0 && !or_equal)){
+                break;
+            }
+            node = next;
+        }
+
+        if(update){
+            update[i] = node;
+        }
+    }
+
+    return node;
+}
+
+
+static void _skip_list_unlink(ch_skip_list_t* this, ch_skip_list_node_t* node, ch_skip_list_node_t** update)
+{
+    for(ch_word i = 0; i < node->level; i++){
+        update[i]->next[i] = node->next[i];
+    }
+
+    if(node->next[0]){
+        node->next[0]->prev = node->prev;
+    }
+    else{
+        this->_last = node->prev == this->_head ? NULL : node->prev;
+    }
+
+    while(this->_level > 0 && this->_head->next[this->_level - 1] == NULL){
+        this->_level--;
+    }
+
+    pool_free(this->_pools[node->level - 1], node);
+    this->count--;
+}
+
+
+ch_skip_list_it skip_list_first(ch_skip_list_t* this)
+{
+    return _skip_list_it(this, this->_head->next[0]);
+}
+
+ch_skip_list_it skip_list_last(ch_skip_list_t* this)
+{
+    return _skip_list_it(this, this->_last);
+}
+
+ch_skip_list_it skip_list_end(ch_skip_list_t* this)
+{
+    return _skip_list_it(this, NULL);
+}
+
+void skip_list_next(ch_skip_list_t* this, ch_skip_list_it* it)
+{
+    *it = _skip_list_it(this, it->_node ? it->_node->next[0] : NULL);
+}
+
+void skip_list_prev(ch_skip_list_t* this, ch_skip_list_it* it)
+{
+    *it = _skip_list_it(this, it->_node ? it->_node->prev : NULL);
+}
+
+
+ch_skip_list_it skip_list_insert(ch_skip_list_t* this, const void* value)
+{
+    ch_skip_list_node_t* update[CH_SKIP_LIST_MAX_LEVEL];
+    _skip_list_search(this, value, true, update);
+
+    const ch_word level = _random_level(this);
+    if(!this->_pools[level - 1]){
+        this->_pools[level - 1] = ch_pool_new(_node_header_bytes(level) + this->_element_size);
+        if(!this->_pools[level - 1]){
+            return skip_list_end(this);
+        }
+    }
+
+    ch_skip_list_node_t* node = (ch_skip_list_node_t*)pool_alloc(this->_pools[level - 1]);
+    if(!node){
+        return skip_list_end(this);
+    }
+
+    node->level = level;
+    memcpy(NODE_DATAP(node), value, this->_element_size);
+
+    for(; this->_level < level; this->_level++){
+        update[this->_level] = this->_head;
+    }
+
+    for(ch_word i = 0; i < level; i++){
+        node->next[i] = update[i]->next[i];
+        update[i]->next[i] = node;
+    }
+
+    node->prev = update[0];
+    if(node->next[0]){
+        node->next[0]->prev = node;
+    }
+    else{
+        this->_last = node;
+    }
+
+    this->count++;
+    return _skip_list_it(this, node);
+}
+
+
+ch_skip_list_it skip_list_insert_carray(ch_skip_list_t* this, const void* carray, ch_word count)
+{
+    ch_skip_list_it result = { 0 };
+
+    const ch_byte* ptr = carray;
+    for(ch_word i =  0; i < count; i++){
+        result = skip_list_insert(this, ptr);
+        ptr += this->_element_size;
+    }
+
+    return result;
+}
+
+
+ch_skip_list_it skip_list_lower_bound(ch_skip_list_t* this, const void* value)
+{
+    return _skip_list_it(this, _skip_list_search(this, value, false, NULL)->next[0]);
+}
+
+ch_skip_list_it skip_list_upper_bound(ch_skip_list_t* this, const void* value)
+{
+    return _skip_list_it(this, _skip_list_search(this, value, true, NULL)->next[0]);
+}
+
+ch_skip_list_it skip_list_find(ch_skip_list_t* this, const void* value)
+{
+    const ch_skip_list_it result = skip_list_lower_bound(this, value);
+    if(result.value && this->_cmp(result.value, value) == 0){
+        return result;
+    }
+
+    return skip_list_end(this);
+}
+
+ch_word skip_list_range(ch_skip_list_t* this, const void* lo, const void* hi, ch_skip_list_it* begin, ch_skip_list_it* end)
+{
+    *begin = skip_list_lower_bound(this, lo);
+    *end   = skip_list_lower_bound(this, hi);
+
+    //An empty (or backwards) range
+    if(!begin->value || this->_cmp(lo, hi) >= 0){
+        *begin = *end;
+        return 0;
+    }
+
+    ch_word count = 0;
+    for(ch_skip_list_node_t* node = begin->_node; node != end->_node; node = node->next[0]){
+        count++;
+    }
+
+    return count;
+}
+
+
+ch_word skip_list_remove(ch_skip_list_t* this, const void* value)
+{
+    ch_skip_list_node_t* update[CH_SKIP_LIST_MAX_LEVEL];
+    ch_skip_list_node_t* node = _skip_list_search(this, value, false, update)->next[0];
+    if(!node || this->_cmp(NODE_DATAP(node), value) != 0){
+        return 0;
+    }
+
+    //node is the first equal element, so it directly follows update[] on every level that it is on
+    _skip_list_unlink(this, node, update);
+    return 1;
+}
+
+
+ch_skip_list_it skip_list_remove_it(ch_skip_list_t* this, ch_skip_list_it* it)
+{
+    if(!it || !it->_node){
+        return skip_list_end(this);
+    }
+
+    ch_skip_list_node_t* target = it->_node;
+    const void* value = NODE_DATAP(target);
+
+    //As in the search, but step over any equal elements in front of target on the levels it is on
+    ch_skip_list_node_t* update[CH_SKIP_LIST_MAX_LEVEL];
+    ch_skip_list_node_t* node = this->_head;
+    for(ch_word i = this->_level - 1; i >= 0; i--){
+        while(node->next[i] && this->_cmp(NODE_DATAP(node->next[i]), value) < 0){
+            node = node->next[i];
+        }
+
+        if(i < target->level){
+            while(node->next[i] != target){
+                node = node->next[i];
+            }
+        }
+
+        update[i] = node;
+    }
+
+    ch_skip_list_node_t* next = target->next[0];
+    _skip_list_unlink(this, target, update);
+    return _skip_list_it(this, next);
+}
+
+
+void skip_list_pop_all(ch_skip_list_t* this)
+{
+    for(ch_word i = 0; i < CH_SKIP_LIST_MAX_LEVEL; i++){
+        if(this->_pools[i]){
+            pool_clear(this->_pools[i]);
+        }
+        this->_head->next[i] = NULL;
+    }
+
+    this->_level = 0;
+    this->_last  = NULL;
+    this->count  = 0;
+}
+
+
+void skip_list_delete(ch_skip_list_t* this)
+{
+    if(!this){
+        return;
+    }
+
+    for(ch_word i = 0; i < CH_SKIP_LIST_MAX_LEVEL; i++){
+        pool_delete(this->_pools[i]);
+    }
+
+    free(this->_head);
+    free(this);
+}
+
+
+ch_skip_list_t* ch_skip_list_new( ch_word element_size, cmp_void_f cmp )
+{
+    if(element_size <= 0){
+        printf("Error: invalid element size (<=0), must have *some* data\n");
+        return NULL;
+    }
+
+    if(!cmp){
+        printf("Error: a skip list needs a comparator function\n");
+        return NULL;
+    }
+
+    ch_skip_list_t* result = (ch_skip_list_t*)calloc(1,sizeof(ch_skip_list_t));
+    if(!result){
+        printf("Could not allocate memory for new skip list structure. Giving up\n");
+        return NULL;
+    }
+
+    result->_head = (ch_skip_list_node_t*)calloc(1, _node_header_bytes(CH_SKIP_LIST_MAX_LEVEL));
+    if(!result->_head){
+        printf("Could not allocate memory for new skip list structure. Giving up\n");
+        free(result);
+        return NULL;
+    }
+
+    result->_head->level  = CH_SKIP_LIST_MAX_LEVEL;
+    result->_cmp          = cmp;
+    result->_element_size = element_size;
+    result->_seed         = 0x9E3779B97F4A7C15ULL ^ (u64)(uintptr_t)result;
+
+    return result;
+}
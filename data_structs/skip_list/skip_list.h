@@ -0,0 +1,102 @@
+/*
+ * skip_list.h
+ *
+ * Ordered container with O(log n) expected insert, find and remove. Elements are kept in the order given by the
+ * comparator on a doubly linked bottom level, so iteration in order and range queries are just a walk along it. Each
+ * node is also on a random number of "express" levels above that (each level has about a quarter of the nodes of the
+ * one below), which searches use to skip ahead.
+ *
+ * Nodes come from one ch_pool per height, so there is no malloc() per element once the pools are warm, and
+ * skip_list_pop_all() and skip_list_delete() release whole slabs at a time.
+ *
+ * Equal elements are allowed, and keep their insertion order. Not thread safe.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef SKIP_LIST_H_
+#define SKIP_LIST_H_
+
+#include "../../types/types.h"
+#include "../pool/pool.h"
+
+#define CH_SKIP_LIST_MAX_LEVEL 32
+
+struct ch_skip_list_node;
+typedef struct ch_skip_list_node ch_skip_list_node_t;
+
+struct ch_skip_list_node {
+    ch_skip_list_node_t* prev; //Previous node on the bottom level
+    ch_word level; //Number of levels this node is on
+    ch_skip_list_node_t* next[]; //Next node on each level. The element follows
+};
+
+struct ch_skip_list;
+typedef struct ch_skip_list ch_skip_list_t;
+
+struct ch_skip_list{
+    ch_word count;  //Return the actual number of elements in the skip list
+
+    // Members prefixed with "_" are nominally "private" Don't touch my privates!
+    cmp_void_f _cmp; //Comparator function that gives the order
+    ch_word _element_size;
+    ch_word _level; //Number of levels in use
+    ch_skip_list_node_t* _head; //Sentinel on every level, without an element
+    ch_skip_list_node_t* _last;
+    u64 _seed; //For choosing node levels
+    ch_pool_t* _pools[CH_SKIP_LIST_MAX_LEVEL]; //_pools[i] holds nodes with i + 1 levels
+};
+
+typedef struct {
+    //These state variables are private
+    ch_skip_list_node_t* _node;
+
+    //This is public
+    void* value;
+} ch_skip_list_it;
+
+
+//Get the first (smallest) entry
+ch_skip_list_it skip_list_first(ch_skip_list_t* this);
+//Get the last (largest) entry
+ch_skip_list_it skip_list_last(ch_skip_list_t* this);
+//Get the end
+ch_skip_list_it skip_list_end(ch_skip_list_t* this);
+
+//Step forwards by one entry
+void skip_list_next(ch_skip_list_t* this, ch_skip_list_it* it);
+//Step backwards by one entry
+void skip_list_prev(ch_skip_list_t* this, ch_skip_list_it* it);
+
+//Insert an element in order, after any equal elements. Returns an iterator to it, or the end on failure
+ch_skip_list_it skip_list_insert(ch_skip_list_t* this, const void* value);
+//Insert count elements from the C array
+ch_skip_list_it skip_list_insert_carray(ch_skip_list_t* this, const void* carray, ch_word count);
+
+//Find the first element equal to value, or the end if there is none
+ch_skip_list_it skip_list_find(ch_skip_list_t* this, const void* value);
+//Return the first element that is not less than value, or the end if there is none
+ch_skip_list_it skip_list_lower_bound(ch_skip_list_t* this, const void* value);
+//Return the first element that is greater than value, or the end if there is none
+ch_skip_list_it skip_list_upper_bound(ch_skip_list_t* this, const void* value);
+//Set begin and end so that [begin, end) covers the elements in the range [lo, hi). Returns the number of elements in it
+ch_word skip_list_range(ch_skip_list_t* this, const void* lo, const void* hi, ch_skip_list_it* begin, ch_skip_list_it* end);
+
+//Remove the first element equal to value. Returns 1 if there was one to remove, 0 otherwise
+ch_word skip_list_remove(ch_skip_list_t* this, const void* value);
+//Remove the element given by the iterator, return an iterator to the element that followed it
+ch_skip_list_it skip_list_remove_it(ch_skip_list_t* this, ch_skip_list_it* it);
+
+//Remove all elements
+void skip_list_pop_all(ch_skip_list_t* this);
+
+//Free the resources associated with this skip list, assumes that individual items have been freed
+void skip_list_delete(ch_skip_list_t* this);
+
+ch_skip_list_t* ch_skip_list_new( ch_word element_size, cmp_void_f cmp );
+
+#define CH_SKIP_LIST_FOREACH(LIST, IT) \
+    for(ch_skip_list_it IT = skip_list_first(LIST); IT.value; skip_list_next(LIST, &IT))
+
+#endif // SKIP_LIST_H_
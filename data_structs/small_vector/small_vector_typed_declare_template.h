@@ -0,0 +1,186 @@
+/*
+ * small_vector_typed_declare_template.h
+ *
+ * A vector with space for N elements inside the structure itself. Until more than N elements are added, the vector is
+ * a single allocation (or none at all, if it lives on the stack or inside another structure), and its elements share
+ * cache lines with its header. Beyond N elements, the elements spill to the heap and it behaves like ch_vector.
+ *
+ * The API mirrors the typed vector (ch_vector_NAME_t), so one can be swapped for the other: the same members, the same
+ * static inline versions of the hot operations, and the same define variants for types with a natural order, which
+ * sort and search with LESS inlined. Only ch_vector_NAME_new_reserved() has no equivalent.
+ *
+ * Usage:
+ *     declare_ch_small_vector(NAME, TYPE, N)
+ *     define_ch_small_vector(NAME, TYPE, N)   (in exactly one .c file)
+ * or, with declare_ch_small_vector_cmp(NAME, TYPE) / define_ch_small_vector_cmp(NAME, TYPE) as the standard comparator,
+ *     define_ch_small_vector_std(NAME, TYPE, N, LESS)
+ *     define_ch_small_vector_std_find(NAME, TYPE, N, LESS, FIND_EQ)
+ *     define_ch_small_vector_std_radix(NAME, TYPE, N, LESS, UTYPE, KEY, FIND_EQ)
+ *
+ * NB: first/last/end may point into the structure itself, so a small vector must not be copied by value.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef SMALL_VECTOR_TYPED_DECLARE_TEMPLATE_H_
+#define SMALL_VECTOR_TYPED_DECLARE_TEMPLATE_H_
+
+#include "../../types/types.h"
+#include "../../utils/util.h"
+
+#include <stdio.h>
+
+#define declare_ch_small_vector(NAME,TYPE,N) \
+\
+struct ch_small_vector_##NAME;\
+typedef struct ch_small_vector_##NAME ch_small_vector_##NAME##_t;\
+\
+struct ch_small_vector_##NAME{\
+    ch_word size;  /*Return the max number number of elements in the vector*/\
+    ch_word count;  /*Return the actual number of elements in the vector*/\
+    TYPE* first; /*Pointer to the fist valid entry list. Not valid if first == end*/\
+    TYPE* last; /*Pointer to the last valid element in the list. Not valid if last == end*/\
+    TYPE* end; /*Pointer to the one element beyond the end of the valid elements in list. Do not dereference! */\
+\
+    void (*resize)(ch_small_vector_##NAME##_t* this, ch_word new_size); /*Resize the vector. It never shrinks below N*/\
+    TYPE* (*off)(ch_small_vector_##NAME##_t* this, ch_word idx); /*Return the element at a given offset, with bounds checking*/\
+\
+    TYPE* (*next)(ch_small_vector_##NAME##_t* this, TYPE* ptr);  /*Step forwards by one entry*/\
+    TYPE* (*prev)(ch_small_vector_##NAME##_t* this, TYPE* ptr); /*Step backwards by one entry*/\
+    TYPE* (*forward)(ch_small_vector_##NAME##_t* this, TYPE* ptr, ch_word amount);  /*Step forwards by amount*/\
+    TYPE* (*back)(ch_small_vector_##NAME##_t* this, TYPE* ptr, ch_word amount);  /*Step backwards by amount*/\
+\
+    TYPE* (*push_front)(ch_small_vector_##NAME##_t* this, TYPE value); /* Put an element at the front of the vector [WARN: moves every element] */\
+    void (*pop_front)(ch_small_vector_##NAME##_t* this); /* Remove the element at the front of the vector [WARN: moves every element] */\
+    TYPE* (*push_back)(ch_small_vector_##NAME##_t* this, TYPE value); /* Put an element at the back of the vector*/\
+    void (*pop_back)(ch_small_vector_##NAME##_t* this); /* Remove the element at the back of the vector*/\
+    void (*clear)(ch_small_vector_##NAME##_t* this); /*Remove everything from the vector*/\
+\
+    TYPE* (*insert_after)(ch_small_vector_##NAME##_t* this, TYPE* ptr, TYPE value); /* Insert an element after the element given by ptr*/\
+    TYPE* (*insert_before)(ch_small_vector_##NAME##_t* this, TYPE* ptr, TYPE value); /* Insert an element before the element given by ptr*/\
+    TYPE* (*remove)(ch_small_vector_##NAME##_t* this, TYPE* ptr); /*Remove the given ptr, return a pointer to the element that took its place, or NULL*/\
+    ch_word (*remove_if)(ch_small_vector_##NAME##_t* this, ch_bool (*pred)(TYPE* value, void* arg), void* arg); /*Remove every element for which pred is true in one pass, return the number removed. See also define_ch_small_vector_remove_if()*/\
+    TYPE* (*erase_range)(ch_small_vector_##NAME##_t* this, TYPE* first, TYPE* last); /*Remove the elements in [first,last), return the element that took first's place*/\
+    ch_word (*compact)(ch_small_vector_##NAME##_t* this, const ch_byte* mask); /*Keep only the elements with a non-zero mask entry in one pass, return the number removed*/\
+    void (*delete)(ch_small_vector_##NAME##_t* this); /*Free the resources associated with this vector*/\
+\
+    TYPE* (*find)(ch_small_vector_##NAME##_t* this, TYPE* begin, TYPE* end, TYPE value); /*find the given value using the comparator function*/\
+    int (*get_idx)(ch_small_vector_##NAME##_t* this, TYPE* value); /*Convert the iterator into an index for use with off() above*/\
+    TYPE* (*lower_bound)(ch_small_vector_##NAME##_t* this, TYPE value); /*in a sorted vector, return the first element not less than value, or end*/\
+    TYPE* (*upper_bound)(ch_small_vector_##NAME##_t* this, TYPE value); /*in a sorted vector, return the first element greater than value, or end*/\
+    void (*equal_range)(ch_small_vector_##NAME##_t* this, TYPE value, TYPE** lower, TYPE** upper); /*in a sorted vector, set [lower,upper) to the elements equal to value*/\
+    void (*sort)(ch_small_vector_##NAME##_t* this); /*sort into order given the comparator function*/\
+    void (*sort_parallel)(ch_small_vector_##NAME##_t* this, ch_word workers); /*sort into order given the comparator function, using up to workers threads (<= 0 for one per CPU)*/\
+    void (*sort_radix)(ch_small_vector_##NAME##_t* this); /*sort into ascending order with a radix sort, ignoring the comparator. NULL unless defined with define_ch_small_vector_std_radix()*/\
+    ch_word (*eq)(ch_small_vector_##NAME##_t* this, ch_small_vector_##NAME##_t* that); /*Check for equality*/\
+\
+    TYPE* (*push_back_carray)(ch_small_vector_##NAME##_t* this, TYPE* carray, ch_word count); /*Push back count elements from the C array to the back of the vector*/\
+\
+     /* Members prefixed with "_" are "private" Don't touch my privates!*/\
+    ch_word (*_cmp)(TYPE* lhs, TYPE* rhs); /*Comparator function for find, sort and eq*/\
+    ch_bool _owned; /*Allocated by ch_small_vector_NAME_new(), so delete() frees the structure too*/\
+    TYPE* _heap; /*Storage once the vector has outgrown _inline, NULL until then*/\
+    TYPE _inline[N]; /*Storage for the first N elements*/\
+};\
+\
+/*Allocate a new small vector with room for at least size elements*/\
+ch_small_vector_##NAME##_t* ch_small_vector_##NAME##_new(ch_word size, ch_word(*cmp)(TYPE* lhs, TYPE* rhs) );\
+/*Initialise a small vector that lives somewhere else, e.g. on the stack. Returns this, or NULL on failure*/\
+ch_small_vector_##NAME##_t* ch_small_vector_##NAME##_init(ch_small_vector_##NAME##_t* this, ch_word size, ch_word(*cmp)(TYPE* lhs, TYPE* rhs) );\
+TYPE* _ch_small_vector_##NAME##_grow(ch_small_vector_##NAME##_t* this);\
+_declare_ch_small_vector_inline(NAME,TYPE,N)
+
+//Direct call versions of the hot operations, see the typed vector
+#define _declare_ch_small_vector_inline(NAME,TYPE,N)\
+\
+/*Return the element at a given offset. Negative offsets count back from the end (the last element)*/\
+static inline TYPE* ch_small_vector_##NAME##_off(ch_small_vector_##NAME##_t* this, ch_word idx)\
+{\
+    idx = idx < 0 ? idx + this->count : idx;\
+    CH_BOUNDS_CHECK(idx >= 0 && idx < this->count, NULL, "Index (%lli) is out of the valid range [%lli,%lli]\n", idx, -1 * this->count, this->count - 1);\
+    return this->first + idx;\
+}\
+\
+/*Step forwards by amount*/\
+static inline TYPE* ch_small_vector_##NAME##_forward(ch_small_vector_##NAME##_t* this, TYPE* ptr, ch_word amount)\
+{\
+    CH_BOUNDS_CHECK(ptr + amount <= this->end, ptr, "Vector forward catch\n");\
+    (void)this;\
+    return ptr + amount;\
+}\
+\
+/*Step backwards by amount*/\
+static inline TYPE* ch_small_vector_##NAME##_back(ch_small_vector_##NAME##_t* this, TYPE* ptr, ch_word amount)\
+{\
+    CH_BOUNDS_CHECK(ptr - amount >= this->first, ptr, "Vector backward catch\n");\
+    (void)this;\
+    return ptr - amount;\
+}\
+\
+static inline TYPE* ch_small_vector_##NAME##_next(ch_small_vector_##NAME##_t* this, TYPE* ptr) { return ch_small_vector_##NAME##_forward(this, ptr, 1); }\
+static inline TYPE* ch_small_vector_##NAME##_prev(ch_small_vector_##NAME##_t* this, TYPE* ptr) { return ch_small_vector_##NAME##_back(this, ptr, 1); }\
+\
+/*Put an element at the back of the vector. Only spilling to the heap, or growing it, takes a function call*/\
+static inline TYPE* ch_small_vector_##NAME##_push_back(ch_small_vector_##NAME##_t* this, TYPE value)\
+{\
+    if(unlikely(this->count == this->size) && !_ch_small_vector_##NAME##_grow(this)){\
+        return NULL;\
+    }\
+\
+    TYPE* result = this->end;\
+    *result = value;\
+    this->count++;\
+    this->last = result;\
+    this->end  = result + 1;\
+    return result;\
+}\
+\
+/*Remove the element at the back of the vector*/\
+static inline void ch_small_vector_##NAME##_pop_back(ch_small_vector_##NAME##_t* this)\
+{\
+    if(unlikely(this->count == 0)){\
+        return;\
+    }\
+\
+    this->count--;\
+    this->end--;\
+    this->last = this->count ? this->last - 1 : this->end;\
+}\
+\
+/*Remove all elements*/\
+static inline void ch_small_vector_##NAME##_clear(ch_small_vector_##NAME##_t* this)\
+{\
+    this->count = 0;\
+    this->last  = this->first;\
+    this->end   = this->first;\
+}
+
+//remove_if() with the predicate inlined, as define_ch_vector_remove_if() for the typed vector
+#define define_ch_small_vector_remove_if(PREFIX, NAME, TYPE, PRED)\
+\
+static inline ch_word PREFIX##_remove_if(ch_small_vector_##NAME##_t* this, void* arg)\
+{\
+    (void)arg;\
+    TYPE* write = this->first;\
+    TYPE* const end = this->end;\
+    for(TYPE* read = this->first; read < end; read++){\
+        const TYPE value = *read;\
+        *write = value;\
+        write += !(PRED(value, arg));\
+    }\
+\
+    const ch_word removed = end - write;\
+    this->count -= removed;\
+    this->end    = write;\
+    this->last   = this->count ? write - 1 : write;\
+    return removed;\
+}
+
+#define declare_ch_small_vector_cmp(NAME, TYPE) ch_word ch_small_vector_cmp_##NAME(TYPE* lhs, TYPE* rhs);
+
+#define CH_SMALL_VECTOR(NAME) ch_small_vector_##NAME##_t
+#define CH_SMALL_VECTOR_NEW(NAME, size, cmp) ch_small_vector_##NAME##_new(size, cmp)
+#define CH_SMALL_VECTOR_CMP(NAME) ch_small_vector_cmp_##NAME
+
+#endif /* SMALL_VECTOR_TYPED_DECLARE_TEMPLATE_H_ */
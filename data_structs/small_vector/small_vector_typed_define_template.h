@@ -0,0 +1,467 @@
+/*
+ * small_vector_typed_define_template.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef SMALL_VECTOR_TYPED_DEFINE_TEMPLATE_H_
+#define SMALL_VECTOR_TYPED_DEFINE_TEMPLATE_H_
+
+#include "small_vector_typed_declare_template.h"
+#include "../array/array.h"
+#include "../array/array_sort_template.h"
+#include "../array/array_radix_template.h"
+#include "../array/array_search_template.h"
+#include "../array/simd_find.h"
+#include "../vector/parallel_sort.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//Generic small vectors, sort and search using the comparator function
+#define define_ch_small_vector(NAME,TYPE,N)\
+_define_ch_small_vector_base(NAME,TYPE,N)\
+static void _sort_##NAME(ch_small_vector_##NAME##_t* this)\
+{\
+    qsort(this->first, this->count, sizeof(TYPE), (cmp_void_f)this->_cmp);\
+}\
+\
+static void _sort_parallel_##NAME(ch_small_vector_##NAME##_t* this, ch_word workers)\
+{\
+    ch_sort_parallel_carray(this->first, this->count, sizeof(TYPE), (cmp_void_f)this->_cmp, NULL, workers);\
+}\
+_define_ch_small_vector_bounds(NAME,TYPE)\
+_define_ch_small_vector_init(NAME,TYPE,N,_find_##NAME,NULL)
+
+//Small vectors of types with a natural order given by LESS(lhs,rhs), see define_ch_vector_std(). If the vector is
+//constructed with the standard comparator (CH_SMALL_VECTOR_CMP(NAME)), sorting and searching have LESS inlined
+#define define_ch_small_vector_std(NAME,TYPE,N,LESS)\
+_define_ch_small_vector_std(NAME,TYPE,N,LESS)\
+_define_ch_small_vector_init(NAME,TYPE,N,_find_##NAME,NULL)
+
+//As above, for types that can be searched with SIMD instructions. FIND_EQ is one of CH_FIND_EQ_{INT,FLOAT}
+#define define_ch_small_vector_std_find(NAME,TYPE,N,LESS,FIND_EQ)\
+_define_ch_small_vector_std(NAME,TYPE,N,LESS)\
+_define_ch_small_vector_find_simd(NAME,TYPE,FIND_EQ)\
+_define_ch_small_vector_init(NAME,TYPE,N,_find_simd_##NAME,NULL)
+
+//As above, for integer and floating point types that can also be radix sorted, see define_ch_vector_std_radix()
+#define define_ch_small_vector_std_radix(NAME,TYPE,N,LESS,UTYPE,KEY,FIND_EQ)\
+_define_ch_small_vector_std(NAME,TYPE,N,LESS)\
+_define_ch_small_vector_find_simd(NAME,TYPE,FIND_EQ)\
+define_ch_radix_sort(_ch_small_vector_##NAME, TYPE, UTYPE, KEY)\
+static void _sort_radix_##NAME(ch_small_vector_##NAME##_t* this)\
+{\
+    if(this->count < CH_RADIX_THRESHOLD){\
+        _ch_small_vector_##NAME##_introsort(this->first, this->count);\
+    }\
+    else if(_ch_small_vector_##NAME##_radix_sort(this->first, this->count)){\
+        printf("Could not allocate radix sort scratch space, falling back to introsort\n");\
+        _ch_small_vector_##NAME##_introsort(this->first, this->count);\
+    }\
+}\
+_define_ch_small_vector_init(NAME,TYPE,N,_find_simd_##NAME,_sort_radix_##NAME)
+
+#define _define_ch_small_vector_std(NAME,TYPE,N,LESS)\
+_define_ch_small_vector_base(NAME,TYPE,N)\
+_define_ch_small_vector_bounds_std(NAME,TYPE,LESS)\
+define_ch_introsort(_ch_small_vector_##NAME, TYPE, LESS)\
+static void _sort_##NAME(ch_small_vector_##NAME##_t* this)\
+{\
+    if(this->_cmp == ch_small_vector_cmp_##NAME){\
+        _ch_small_vector_##NAME##_introsort(this->first, this->count);\
+    }\
+    else{\
+        qsort(this->first, this->count, sizeof(TYPE), (cmp_void_f)this->_cmp);\
+    }\
+}\
+\
+static void _sort_chunk_##NAME(void* carray, ch_word count)\
+{\
+    _ch_small_vector_##NAME##_introsort((TYPE*)carray, count);\
+}\
+\
+static void _sort_parallel_##NAME(ch_small_vector_##NAME##_t* this, ch_word workers)\
+{\
+    const ch_bool std_cmp = this->_cmp == ch_small_vector_cmp_##NAME;\
+    ch_sort_parallel_carray(this->first, this->count, sizeof(TYPE), (cmp_void_f)this->_cmp,\
+                            std_cmp ? _sort_chunk_##NAME : NULL, workers);\
+}
+
+//Binary searches using the comparator function
+#define _define_ch_small_vector_bounds(NAME,TYPE)\
+static TYPE* _lower_bound_##NAME(ch_small_vector_##NAME##_t* this, TYPE value)\
+{\
+    return (TYPE*)ch_lower_bound_carray(this->first, this->count, sizeof(TYPE), (cmp_void_f)this->_cmp, &value);\
+}\
+\
+static TYPE* _upper_bound_##NAME(ch_small_vector_##NAME##_t* this, TYPE value)\
+{\
+    return (TYPE*)ch_upper_bound_carray(this->first, this->count, sizeof(TYPE), (cmp_void_f)this->_cmp, &value);\
+}\
+\
+static void _equal_range_##NAME(ch_small_vector_##NAME##_t* this, TYPE value, TYPE** lower, TYPE** upper)\
+{\
+    *lower = _lower_bound_##NAME(this, value);\
+    *upper = _upper_bound_##NAME(this, value);\
+}
+
+//Binary searches with LESS inlined if the vector uses the standard comparator
+#define _define_ch_small_vector_bounds_std(NAME,TYPE,LESS)\
+define_ch_bsearch(_ch_small_vector_##NAME, TYPE, LESS)\
+static TYPE* _lower_bound_##NAME(ch_small_vector_##NAME##_t* this, TYPE value)\
+{\
+    if(this->_cmp != ch_small_vector_cmp_##NAME){\
+        return (TYPE*)ch_lower_bound_carray(this->first, this->count, sizeof(TYPE), (cmp_void_f)this->_cmp, &value);\
+    }\
+    return _ch_small_vector_##NAME##_lower_bound(this->first, this->count, value);\
+}\
+\
+static TYPE* _upper_bound_##NAME(ch_small_vector_##NAME##_t* this, TYPE value)\
+{\
+    if(this->_cmp != ch_small_vector_cmp_##NAME){\
+        return (TYPE*)ch_upper_bound_carray(this->first, this->count, sizeof(TYPE), (cmp_void_f)this->_cmp, &value);\
+    }\
+    return _ch_small_vector_##NAME##_upper_bound(this->first, this->count, value);\
+}\
+\
+static void _equal_range_##NAME(ch_small_vector_##NAME##_t* this, TYPE value, TYPE** lower, TYPE** upper)\
+{\
+    *lower = _lower_bound_##NAME(this, value);\
+    *upper = _upper_bound_##NAME(this, value);\
+}
+
+//If the vector uses the standard comparator, search with SIMD equality instead of calling the comparator per element.
+//Bad iterators go to the generic find
+#define _define_ch_small_vector_find_simd(NAME,TYPE,FIND_EQ)\
+static TYPE* _find_simd_##NAME(ch_small_vector_##NAME##_t* this, TYPE* begin, TYPE* end, TYPE value)\
+{\
+    if(this->_cmp != ch_small_vector_cmp_##NAME ||\
+       begin < this->first || begin > this->end || end < this->first || end > this->end){\
+        return _find_##NAME(this, begin, end, value);\
+    }\
+\
+    return (TYPE*)FIND_EQ(begin, end, value);\
+}
+
+#define _define_ch_small_vector_base(NAME,TYPE,N)\
+\
+static void _update_##NAME(ch_small_vector_##NAME##_t* this)\
+{\
+    this->first = this->_heap ? this->_heap : this->_inline;\
+    this->end   = this->first + this->count;\
+    this->last  = this->count ? this->end - 1 : this->end;\
+}\
+\
+/*Make sure that there is room for at least new_size elements, moving to the heap if need be*/\
+static TYPE* _reserve_##NAME(ch_small_vector_##NAME##_t* this, ch_word new_size)\
+{\
+    if(new_size <= this->size){\
+        return this->first;\
+    }\
+\
+    TYPE* heap = (TYPE*)realloc(this->_heap, new_size * sizeof(TYPE));\
+    if(!heap){\
+        printf("Could not allocate memory for small vector\n");\
+        return NULL;\
+    }\
+\
+    if(!this->_heap){\
+        memcpy(heap, this->_inline, this->count * sizeof(TYPE));\
+    }\
+\
+    this->_heap = heap;\
+    this->size  = new_size;\
+    _update_##NAME(this);\
+    return this->first;\
+}\
+\
+TYPE* _ch_small_vector_##NAME##_grow(ch_small_vector_##NAME##_t* this)\
+{\
+    return _reserve_##NAME(this, this->size * 2);\
+}\
+\
+static void _resize_##NAME(ch_small_vector_##NAME##_t* this, ch_word new_size)\
+{\
+    new_size = MAX(new_size, (ch_word)N);\
+    this->count = MIN(this->count, new_size);\
+\
+    if(new_size > this->size){\
+        _reserve_##NAME(this, new_size);\
+        return;\
+    }\
+\
+    if(this->_heap && new_size == N){\
+        /*Everything fits inline again*/\
+        memcpy(this->_inline, this->_heap, this->count * sizeof(TYPE));\
+        free(this->_heap);\
+        this->_heap = NULL;\
+    }\
+    else if(this->_heap){\
+        TYPE* heap = (TYPE*)realloc(this->_heap, new_size * sizeof(TYPE));\
+        this->_heap = heap ? heap : this->_heap;\
+    }\
+\
+    this->size = new_size;\
+    _update_##NAME(this);\
+}\
+\
+static TYPE* _off_##NAME(ch_small_vector_##NAME##_t* this, ch_word idx)\
+{\
+    idx = idx < 0 ? idx + this->count : idx;\
+    if(idx < 0 || idx >= this->count){\
+        printf("Index (%lli) is out of the valid range [%lli,%lli]\n", idx, -1 * this->count, this->count - 1);\
+        return NULL;\
+    }\
+\
+    return this->first + idx;\
+}\
+\
+static TYPE* _forward_##NAME(ch_small_vector_##NAME##_t* this, TYPE* ptr, ch_word amount)\
+{\
+    if(ptr + amount <= this->end){\
+        return ptr + amount;\
+    }\
+\
+    printf("Vector forward catch\n");\
+    return ptr;\
+}\
+\
+static TYPE* _back_##NAME(ch_small_vector_##NAME##_t* this, TYPE* ptr, ch_word amount)\
+{\
+    if(ptr - amount >= this->first){\
+        return ptr - amount;\
+    }\
+\
+    printf("Vector backward catch\n");\
+    return ptr;\
+}\
+\
+static TYPE* _next_##NAME(ch_small_vector_##NAME##_t* this, TYPE* ptr) { return _forward_##NAME(this, ptr, 1); }\
+static TYPE* _prev_##NAME(ch_small_vector_##NAME##_t* this, TYPE* ptr) { return _back_##NAME(this, ptr, 1); }\
+\
+static TYPE* _insert_before_##NAME(ch_small_vector_##NAME##_t* this, TYPE* ptr, TYPE value)\
+{\
+    const ch_word idx = ptr - this->first;\
+    if(unlikely(idx < 0 || idx > this->count)){\
+        printf("ptr supplied is out of range.\n");\
+        return NULL;\
+    }\
+\
+    if(unlikely(this->count == this->size) && !_ch_small_vector_##NAME##_grow(this)){\
+        return NULL;\
+    }\
+\
+    memmove(this->first + idx + 1, this->first + idx, (this->count - idx) * sizeof(TYPE));\
+    this->first[idx] = value;\
+    this->count++;\
+    _update_##NAME(this);\
+    return this->first + idx;\
+}\
+\
+static TYPE* _insert_after_##NAME(ch_small_vector_##NAME##_t* this, TYPE* ptr, TYPE value)\
+{\
+    return _insert_before_##NAME(this, ptr + 1, value);\
+}\
+\
+static TYPE* _remove_##NAME(ch_small_vector_##NAME##_t* this, TYPE* ptr)\
+{\
+    const ch_word idx = ptr - this->first;\
+    if(unlikely(idx < 0 || idx >= this->count)){\
+        printf("ptr supplied is out of range.\n");\
+        return NULL;\
+    }\
+\
+    memmove(this->first + idx, this->first + idx + 1, (this->count - idx - 1) * sizeof(TYPE));\
+    this->count--;\
+    _update_##NAME(this);\
+    return idx < this->count ? this->first + idx : NULL;\
+}\
+\
+static TYPE* _push_front_##NAME(ch_small_vector_##NAME##_t* this, TYPE value) { return _insert_before_##NAME(this, this->first, value); }\
+static TYPE* _push_back_##NAME(ch_small_vector_##NAME##_t* this, TYPE value)  { return ch_small_vector_##NAME##_push_back(this, value); }\
+static void _pop_back_##NAME(ch_small_vector_##NAME##_t* this)                { ch_small_vector_##NAME##_pop_back(this); }\
+static void _clear_##NAME(ch_small_vector_##NAME##_t* this)                   { ch_small_vector_##NAME##_clear(this); }\
+\
+static void _pop_front_##NAME(ch_small_vector_##NAME##_t* this)\
+{\
+    if(this->count){\
+        _remove_##NAME(this, this->first);\
+    }\
+}\
+\
+static ch_word _remove_if_##NAME(ch_small_vector_##NAME##_t* this, ch_bool (*pred)(TYPE* value, void* arg), void* arg)\
+{\
+    TYPE* write = this->first;\
+    for(TYPE* read = this->first; read < this->end; read++){\
+        if(!pred(read, arg)){\
+            *write++ = *read;\
+        }\
+    }\
+\
+    const ch_word removed = this->end - write;\
+    this->count -= removed;\
+    _update_##NAME(this);\
+    return removed;\
+}\
+\
+static TYPE* _erase_range_##NAME(ch_small_vector_##NAME##_t* this, TYPE* first, TYPE* last)\
+{\
+    if(unlikely(first < this->first || last > this->end || first > last)){\
+        printf("Range supplied is out of range.\n");\
+        return NULL;\
+    }\
+\
+    memmove(first, last, (this->end - last) * sizeof(TYPE));\
+    this->count -= last - first;\
+    _update_##NAME(this);\
+    return first;\
+}\
+\
+static ch_word _compact_##NAME(ch_small_vector_##NAME##_t* this, const ch_byte* mask)\
+{\
+    TYPE* write = this->first;\
+    for(ch_word i = 0; i < this->count; i++){\
+        *write = this->first[i];\
+        write += mask[i] != 0;\
+    }\
+\
+    const ch_word removed = this->end - write;\
+    this->count -= removed;\
+    _update_##NAME(this);\
+    return removed;\
+}\
+\
+static TYPE* _find_##NAME(ch_small_vector_##NAME##_t* this, TYPE* begin, TYPE* end, TYPE value)\
+{\
+    for(TYPE* i = begin; i < end; i++){\
+        if(!this->_cmp(i, &value)){\
+            return i;\
+        }\
+    }\
+\
+    return NULL;\
+}\
+\
+static int _get_idx_##NAME(ch_small_vector_##NAME##_t* this, TYPE* value)\
+{\
+    return value - this->first;\
+}\
+\
+static ch_word _eq_##NAME(ch_small_vector_##NAME##_t* this, ch_small_vector_##NAME##_t* that)\
+{\
+    if(this->count != that->count){\
+        return 0;\
+    }\
+\
+    for(ch_word i = 0; i < this->count; i++){\
+        if(this->_cmp(this->first + i, that->first + i)){\
+            return 0;\
+        }\
+    }\
+\
+    return 1;\
+}\
+\
+static TYPE* _push_back_carray_##NAME(ch_small_vector_##NAME##_t* this, TYPE* carray, ch_word count)\
+{\
+    if(count <= 0){\
+        return NULL;\
+    }\
+\
+    if(!_reserve_##NAME(this, MAX(this->size * 2, this->count + count))){\
+        return NULL;\
+    }\
+\
+    memcpy(this->end, carray, count * sizeof(TYPE));\
+    this->count += count;\
+    _update_##NAME(this);\
+    return this->last;\
+}\
+\
+static void _delete_##NAME(ch_small_vector_##NAME##_t* this)\
+{\
+    free(this->_heap);\
+    this->_heap = NULL;\
+\
+    if(this->_owned){\
+        free(this);\
+    }\
+}
+
+#define _define_ch_small_vector_init(NAME,TYPE,N,FIND,SORT_RADIX)\
+\
+ch_small_vector_##NAME##_t* ch_small_vector_##NAME##_init(ch_small_vector_##NAME##_t* this, ch_word size, ch_word(*cmp)(TYPE* lhs, TYPE* rhs) )\
+{\
+    memset(this, 0, sizeof(*this));\
+    this->size                    = N;\
+    this->_cmp                    = cmp;\
+    this->resize                  = _resize_##NAME;\
+    this->off                     = _off_##NAME;\
+    this->next                    = _next_##NAME;\
+    this->prev                    = _prev_##NAME;\
+    this->forward                 = _forward_##NAME;\
+    this->back                    = _back_##NAME;\
+    this->push_front              = _push_front_##NAME;\
+    this->pop_front               = _pop_front_##NAME;\
+    this->push_back               = _push_back_##NAME;\
+    this->pop_back                = _pop_back_##NAME;\
+    this->clear                   = _clear_##NAME;\
+    this->insert_after            = _insert_after_##NAME;\
+    this->insert_before           = _insert_before_##NAME;\
+    this->remove                  = _remove_##NAME;\
+    this->remove_if               = _remove_if_##NAME;\
+    this->erase_range             = _erase_range_##NAME;\
+    this->compact                 = _compact_##NAME;\
+    this->get_idx                 = _get_idx_##NAME;\
+    this->push_back_carray        = _push_back_carray_##NAME;\
+    this->delete                  = _delete_##NAME;\
+    this->sort_radix              = SORT_RADIX;\
+\
+    /*Fail hard and early if the compare function is NULL*/\
+    if(cmp){\
+        this->find                    = FIND;\
+        this->sort                    = _sort_##NAME;\
+        this->sort_parallel           = _sort_parallel_##NAME;\
+        this->lower_bound             = _lower_bound_##NAME;\
+        this->upper_bound             = _upper_bound_##NAME;\
+        this->equal_range             = _equal_range_##NAME;\
+        this->eq                      = _eq_##NAME;\
+    }\
+\
+    _update_##NAME(this);\
+\
+    if(size > N && !_reserve_##NAME(this, size)){\
+        return NULL;\
+    }\
+\
+    return this;\
+}\
+\
+ch_small_vector_##NAME##_t* ch_small_vector_##NAME##_new(ch_word size, ch_word(*cmp)(TYPE* lhs, TYPE* rhs) )\
+{\
+    ch_small_vector_##NAME##_t* result = (ch_small_vector_##NAME##_t*)malloc(sizeof(ch_small_vector_##NAME##_t));\
+    if(!result){\
+        printf("Could not allocate memory for new small vector structure. Giving up\n");\
+        return NULL;\
+    }\
+\
+    if(!ch_small_vector_##NAME##_init(result, size, cmp)){\
+        free(result);\
+        return NULL;\
+    }\
+\
+    result->_owned = true;\
+    return result;\
+}
+
+//Regular comparison function
+#define define_ch_small_vector_cmp(NAME, TYPE) \
+ch_word ch_small_vector_cmp_##NAME(TYPE* lhs, TYPE* rhs)\
+{ \
+    return ( *lhs == *rhs ? 0 : *lhs < *rhs ? -1 : 1); \
+}
+
+#endif /* SMALL_VECTOR_TYPED_DEFINE_TEMPLATE_H_ */
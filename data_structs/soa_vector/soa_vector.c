@@ -0,0 +1,246 @@
+/*
+ * soa_vector.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include "soa_vector.h"
+#include "../../utils/util.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+ch_word soa_vector_resize(ch_soa_vector_t* this, ch_word new_size)
+{
+    for(ch_word c = 0; c < this->columns; c++){
+        array_resize(this->_columns[c], new_size);
+        if(this->_columns[c]->size != new_size){
+            //Put back the columns that have already been resized
+            for(ch_word i = 0; i < c; i++){
+                array_resize(this->_columns[i], this->size);
+            }
+            return -1;
+        }
+    }
+
+    this->size  = new_size;
+    this->count = MIN(this->count, new_size);
+    return 0;
+}
+
+
+ch_word soa_vector_append(ch_soa_vector_t* this)
+{
+    if(unlikely(this->count == this->size)){
+        if(soa_vector_resize(this, this->size ? this->size * 2 : 1)){
+            printf("Could not grow structure of arrays vector\n");
+            return -1;
+        }
+    }
+
+    return this->count++;
+}
+
+
+ch_word soa_vector_push_back(ch_soa_vector_t* this, const void* const* values)
+{
+    const ch_word idx = soa_vector_append(this);
+    if(idx < 0){
+        return -1;
+    }
+
+    for(ch_word c = 0; c < this->columns; c++){
+        const ch_word element_size = this->_columns[c]->_element_size;
+        memcpy((ch_byte*)this->_columns[c]->first + idx * element_size, values[c], element_size);
+    }
+
+    return idx;
+}
+
+
+void soa_vector_pop_back(ch_soa_vector_t* this)
+{
+    if(this->count > 0){
+        this->count--;
+    }
+}
+
+
+void soa_vector_clear(ch_soa_vector_t* this)
+{
+    this->count = 0;
+}
+
+
+void* soa_vector_column(ch_soa_vector_t* this, ch_word column)
+{
+    if(column < 0 || column >= this->columns){
+        printf("Column (%lli) is out of the valid range [0,%lli]\n", column, this->columns - 1);
+        return NULL;
+    }
+
+    return this->_columns[column]->first;
+}
+
+
+ch_word soa_vector_sort_perm(ch_soa_vector_t* this, ch_word column, cmp_void_f cmp, ch_word* perm)
+{
+    if(unlikely(!cmp)){
+        printf("The comparator function is empty. Cannot sort\n");
+        return -1;
+    }
+
+    const ch_byte* keys = soa_vector_column(this, column);
+    if(!keys && this->count){
+        return -1;
+    }
+
+    const ch_word count = this->count;
+    const ch_word element_size = this->_columns[column]->_element_size;
+    for(ch_word i = 0; i < count; i++){
+        perm[i] = i;
+    }
+
+    ch_word* scratch = (ch_word*)malloc(count * sizeof(ch_word));
+    if(!scratch && count){
+        printf("Could not allocate memory for sort. Giving up\n");
+        return -1;
+    }
+
+    //Bottom up merge sort of the indices, comparing the keys that they refer to. Ties keep their order.
+    ch_word* src = perm;
+    ch_word* dst = scratch;
+    for(ch_word width = 1; width < count; width *= 2){
+        for(ch_word begin = 0; begin < count; begin += 2 * width){
+            const ch_word mid = MIN(begin + width, count);
+            const ch_word end = MIN(begin + 2 * width, count);
+            ch_word i = begin, j = mid, k = begin;
+            while(i < mid && j < end){
+                if(cmp(keys + src[j] * element_size, keys + src[i] * element_size) < 0){
+                    dst[k++] = src[j++];
+                }
+                else{
+                    dst[k++] = src[i++];
+                }
+            }
+            while(i < mid){ dst[k++] = src[i++]; }
+            while(j < end){ dst[k++] = src[j++]; }
+        }
+
+        ch_word* tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if(src != perm){
+        memcpy(perm, src, count * sizeof(ch_word));
+    }
+
+    free(scratch);
+    return 0;
+}
+
+
+ch_word soa_vector_permute(ch_soa_vector_t* this, const ch_word* perm)
+{
+    ch_word max_element_size = 0;
+    for(ch_word c = 0; c < this->columns; c++){
+        max_element_size = MAX(max_element_size, this->_columns[c]->_element_size);
+    }
+
+    ch_byte* scratch = (ch_byte*)malloc(this->count * max_element_size);
+    if(!scratch && this->count){
+        printf("Could not allocate memory for permute. Giving up\n");
+        return -1;
+    }
+
+    //Gather each column into the scratch space in the new order, then copy it back
+    for(ch_word c = 0; c < this->columns; c++){
+        const ch_word element_size = this->_columns[c]->_element_size;
+        ch_byte* column = this->_columns[c]->first;
+
+        #define GATHER(TYPE) \
+            for(ch_word i = 0; i < this->count; i++){ ((TYPE*)scratch)[i] = ((TYPE*)column)[perm[i]]; }
+        switch(element_size){
+            case 1: GATHER(u8);  break;
+            case 2: GATHER(u16); break;
+            case 4: GATHER(u32); break;
+            case 8: GATHER(u64); break;
+            default:
+                for(ch_word i = 0; i < this->count; i++){
+                    memcpy(scratch + i * element_size, column + perm[i] * element_size, element_size);
+                }
+        }
+        #undef GATHER
+
+        memcpy(column, scratch, this->count * element_size);
+    }
+
+    free(scratch);
+    return 0;
+}
+
+
+ch_word soa_vector_sort(ch_soa_vector_t* this, ch_word column, cmp_void_f cmp)
+{
+    ch_word* perm = (ch_word*)malloc(this->count * sizeof(ch_word));
+    if(!perm && this->count){
+        printf("Could not allocate memory for sort. Giving up\n");
+        return -1;
+    }
+
+    ch_word result = soa_vector_sort_perm(this, column, cmp, perm);
+    if(!result){
+        result = soa_vector_permute(this, perm);
+    }
+
+    free(perm);
+    return result;
+}
+
+
+void soa_vector_delete(ch_soa_vector_t* this)
+{
+    for(ch_word c = 0; c < this->columns; c++){
+        if(this->_columns[c]){
+            array_delete(this->_columns[c]);
+        }
+    }
+
+    free(this->_columns);
+    free(this);
+}
+
+
+ch_soa_vector_t* ch_soa_vector_new(ch_word size, ch_word columns, const ch_word* column_sizes)
+{
+    ch_soa_vector_t* result = (ch_soa_vector_t*)calloc(1,sizeof(ch_soa_vector_t));
+    if(!result){
+        printf("Could not allocate memory for new structure of arrays vector. Giving up\n");
+        return NULL;
+    }
+
+    result->_columns = (ch_array_t**)calloc(columns, sizeof(ch_array_t*));
+    if(!result->_columns){
+        printf("Could not allocate memory for new structure of arrays vector. Giving up\n");
+        free(result);
+        return NULL;
+    }
+
+    result->columns = columns;
+    result->size    = size;
+    result->count   = 0;
+
+    for(ch_word c = 0; c < columns; c++){
+        result->_columns[c] = ch_array_new_aligned(size, column_sizes[c], NULL, CH_SOA_ALIGN, 0);
+        if(!result->_columns[c]){
+            soa_vector_delete(result);
+            return NULL;
+        }
+    }
+
+    return result;
+}
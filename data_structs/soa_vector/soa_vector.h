@@ -0,0 +1,100 @@
+/*
+ * soa_vector.h
+ *
+ * Structure of arrays (SoA) vector. Rather than storing whole records one after the other, each field (column) is kept
+ * in its own cache line aligned array. A loop over one or two fields of every record then only fetches the cache lines
+ * holding those fields, and each column is a plain C array that SIMD kernels can work on directly.
+ *
+ * Use the typed template (declare_ch_soa_vector / define_ch_soa_vector) rather than this directly.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef SOA_VECTOR_H_
+#define SOA_VECTOR_H_
+
+#include "../../types/types.h"
+#include "../array/array.h"
+
+struct ch_soa_vector;
+typedef struct ch_soa_vector ch_soa_vector_t;
+
+//Alignment of each column
+#define CH_SOA_ALIGN CH_ARRAY_ALIGN_CACHE_LINE
+
+struct ch_soa_vector{
+    ch_word size;    //Number of rows that there is space for
+    ch_word count;   //Number of rows in use
+    ch_word columns; //Number of columns
+
+    // Members prefixed with "_" are nominally "private" Don't touch my privates!
+    ch_array_t** _columns; //One aligned array per column
+};
+
+
+//Resize every column to new_size rows. Returns 0 on success, -1 on failure, in which case nothing has changed.
+ch_word soa_vector_resize(ch_soa_vector_t* this, ch_word new_size);
+
+//Add a row to the end, growing if need be. values[c] points to the value for column c. Returns the index of the new
+//row, or -1 on failure.
+ch_word soa_vector_push_back(ch_soa_vector_t* this, const void* const* values);
+
+//Make room for one more row at the end, growing if need be, and return its index, or -1 on failure. The row is not
+//initialised.
+ch_word soa_vector_append(ch_soa_vector_t* this);
+
+//Remove the last row
+void soa_vector_pop_back(ch_soa_vector_t* this);
+
+//Remove all rows
+void soa_vector_clear(ch_soa_vector_t* this);
+
+//Return the start of the given column. Valid for count rows, and until the next resize.
+void* soa_vector_column(ch_soa_vector_t* this, ch_word column);
+
+//Fill perm with the row indices in the order that stably sorts the rows by column, given the comparator function for
+//that column's elements. perm must have space for count entries. Returns 0 on success, -1 on failure.
+ch_word soa_vector_sort_perm(ch_soa_vector_t* this, ch_word column, cmp_void_f cmp, ch_word* perm);
+
+//Reorder every column so that row i is the row that was at perm[i]. perm must be a permutation of [0,count). Returns 0
+//on success, -1 on failure.
+ch_word soa_vector_permute(ch_soa_vector_t* this, const ch_word* perm);
+
+//Stably sort all rows by the given column. Only the keys are compared, the other columns are moved once each at the
+//end. Returns 0 on success, -1 on failure.
+ch_word soa_vector_sort(ch_soa_vector_t* this, ch_word column, cmp_void_f cmp);
+
+//Free the resources associated with this vector
+void soa_vector_delete(ch_soa_vector_t* this);
+
+//Make a new vector with space for size rows. column_sizes gives the element size of each of the columns.
+ch_soa_vector_t* ch_soa_vector_new(ch_word size, ch_word columns, const ch_word* column_sizes);
+
+
+//Preprocessor helpers for the typed template. CH_PP_FOR_EACH(M, CTX, a, b, ...) expands to M(CTX,a) M(CTX,b) ... for
+//up to 16 arguments.
+#define CH_PP_CAT(a, b) CH_PP_CAT_(a, b)
+#define CH_PP_CAT_(a, b) a##b
+#define CH_PP_APPLY(M, ...) M(__VA_ARGS__)
+#define CH_PP_NARG(...) CH_PP_NARG_(__VA_ARGS__, 16,15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0)
+#define CH_PP_NARG_(_1,_2,_3,_4,_5,_6,_7,_8,_9,_10,_11,_12,_13,_14,_15,_16,N,...) N
+#define CH_PP_FOR_EACH(M, CTX, ...) CH_PP_CAT(CH_PP_FOR_EACH_, CH_PP_NARG(__VA_ARGS__))(M, CTX, __VA_ARGS__)
+#define CH_PP_FOR_EACH_1(M, C, x)       M(C, x)
+#define CH_PP_FOR_EACH_2(M, C, x, ...)  M(C, x) CH_PP_FOR_EACH_1(M, C, __VA_ARGS__)
+#define CH_PP_FOR_EACH_3(M, C, x, ...)  M(C, x) CH_PP_FOR_EACH_2(M, C, __VA_ARGS__)
+#define CH_PP_FOR_EACH_4(M, C, x, ...)  M(C, x) CH_PP_FOR_EACH_3(M, C, __VA_ARGS__)
+#define CH_PP_FOR_EACH_5(M, C, x, ...)  M(C, x) CH_PP_FOR_EACH_4(M, C, __VA_ARGS__)
+#define CH_PP_FOR_EACH_6(M, C, x, ...)  M(C, x) CH_PP_FOR_EACH_5(M, C, __VA_ARGS__)
+#define CH_PP_FOR_EACH_7(M, C, x, ...)  M(C, x) CH_PP_FOR_EACH_6(M, C, __VA_ARGS__)
+#define CH_PP_FOR_EACH_8(M, C, x, ...)  M(C, x) CH_PP_FOR_EACH_7(M, C, __VA_ARGS__)
+#define CH_PP_FOR_EACH_9(M, C, x, ...)  M(C, x) CH_PP_FOR_EACH_8(M, C, __VA_ARGS__)
+#define CH_PP_FOR_EACH_10(M, C, x, ...) M(C, x) CH_PP_FOR_EACH_9(M, C, __VA_ARGS__)
+#define CH_PP_FOR_EACH_11(M, C, x, ...) M(C, x) CH_PP_FOR_EACH_10(M, C, __VA_ARGS__)
+#define CH_PP_FOR_EACH_12(M, C, x, ...) M(C, x) CH_PP_FOR_EACH_11(M, C, __VA_ARGS__)
+#define CH_PP_FOR_EACH_13(M, C, x, ...) M(C, x) CH_PP_FOR_EACH_12(M, C, __VA_ARGS__)
+#define CH_PP_FOR_EACH_14(M, C, x, ...) M(C, x) CH_PP_FOR_EACH_13(M, C, __VA_ARGS__)
+#define CH_PP_FOR_EACH_15(M, C, x, ...) M(C, x) CH_PP_FOR_EACH_14(M, C, __VA_ARGS__)
+#define CH_PP_FOR_EACH_16(M, C, x, ...) M(C, x) CH_PP_FOR_EACH_15(M, C, __VA_ARGS__)
+
+#endif /* SOA_VECTOR_H_ */
@@ -0,0 +1,75 @@
+/*
+ * soa_vector_typed_declare_template.h
+ *
+ * Usage:
+ *     declare_ch_soa_vector(NAME, (type1, field1), (type2, field2), ...)
+ * declares
+ *     ch_soa_NAME_row_t          a struct with all of the fields, for passing whole rows in and out
+ *     CH_SOA_COL(NAME, field)    the column number of each field, for sorting
+ *     ch_soa_vector_NAME_t       the vector, with a "TYPE* field" column pointer per field, valid for count rows
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef SOA_VECTOR_TYPED_DECLARE_TEMPLATE_H_
+#define SOA_VECTOR_TYPED_DECLARE_TEMPLATE_H_
+
+#include "../../types/types.h"
+#include "soa_vector.h"
+
+#define CH_SOA_COL(NAME, FIELD) ch_soa_##NAME##_col_##FIELD
+
+#define _ch_soa_row_member(CTX, TF) CH_PP_APPLY(_ch_soa_row_member_, CH_PP_UNPACK TF)
+#define _ch_soa_row_member_(TYPE, FIELD) TYPE FIELD;
+#define _ch_soa_col_member(CTX, TF) CH_PP_APPLY(_ch_soa_col_member_, CH_PP_UNPACK TF)
+#define _ch_soa_col_member_(TYPE, FIELD) TYPE* FIELD; /*Column of FIELD values, valid for count rows*/
+#define _ch_soa_col_enum(NAME, TF) CH_PP_APPLY(_ch_soa_col_enum_, NAME, CH_PP_UNPACK TF)
+#define _ch_soa_col_enum_(NAME, TYPE, FIELD) CH_SOA_COL(NAME, FIELD),
+#define CH_PP_UNPACK(TYPE, FIELD) TYPE, FIELD
+
+#define declare_ch_soa_vector(NAME, ...)\
+\
+typedef struct ch_soa_##NAME##_row {\
+    CH_PP_FOR_EACH(_ch_soa_row_member, NAME, __VA_ARGS__)\
+} ch_soa_##NAME##_row_t;\
+\
+typedef enum {\
+    CH_PP_FOR_EACH(_ch_soa_col_enum, NAME, __VA_ARGS__)\
+    ch_soa_##NAME##_col_count\
+} ch_soa_##NAME##_col_e;\
+\
+struct ch_soa_vector_##NAME;\
+typedef struct ch_soa_vector_##NAME ch_soa_vector_##NAME##_t;\
+\
+struct ch_soa_vector_##NAME{\
+    ch_word size;  /*Return the max number of rows in the vector*/\
+    ch_word count; /*Return the actual number of rows in the vector*/\
+\
+    CH_PP_FOR_EACH(_ch_soa_col_member, NAME, __VA_ARGS__)\
+\
+    void (*resize)(ch_soa_vector_##NAME##_t* this, ch_word new_size); /*Resize the vector*/\
+    ch_word (*push_back)(ch_soa_vector_##NAME##_t* this, ch_soa_##NAME##_row_t value); /*Put a row at the back of the vector, returns its index or -1 on failure*/\
+    void (*pop_back)(ch_soa_vector_##NAME##_t* this); /*Remove the row at the back of the vector*/\
+    void (*clear)(ch_soa_vector_##NAME##_t* this); /*Remove all rows*/\
+    ch_soa_##NAME##_row_t (*get)(ch_soa_vector_##NAME##_t* this, ch_word idx); /*Gather the row at idx, no bounds checking*/\
+    void (*set)(ch_soa_vector_##NAME##_t* this, ch_word idx, ch_soa_##NAME##_row_t value); /*Scatter value into the row at idx, no bounds checking*/\
+\
+    ch_word (*sort)(ch_soa_vector_##NAME##_t* this, ch_word column, cmp_void_f cmp); /*Stably sort the rows by column (CH_SOA_COL(NAME,field)), given the comparator for that field's type. 0 on success*/\
+    ch_word (*sort_perm)(ch_soa_vector_##NAME##_t* this, ch_word column, cmp_void_f cmp, ch_word* perm); /*As above, but only fill perm (count entries) with the sorted order of the rows. 0 on success*/\
+    ch_word (*permute)(ch_soa_vector_##NAME##_t* this, const ch_word* perm); /*Reorder the rows so that row i is the row that was at perm[i]. 0 on success*/\
+\
+    void (*delete)(ch_soa_vector_##NAME##_t* this); /*Free the resources associated with this vector*/\
+\
+     /* Members prefixed with "_" are "private" Don't touch my privates!*/\
+    ch_soa_vector_t* _soa; /*Actual column storage*/\
+};\
+\
+ch_soa_vector_##NAME##_t* ch_soa_vector_##NAME##_new(ch_word size);
+
+
+#define CH_SOA_VECTOR(NAME) ch_soa_vector_##NAME##_t
+#define CH_SOA_ROW(NAME) ch_soa_##NAME##_row_t
+#define CH_SOA_VECTOR_NEW(NAME, size) ch_soa_vector_##NAME##_new(size)
+
+#endif /* SOA_VECTOR_TYPED_DECLARE_TEMPLATE_H_ */
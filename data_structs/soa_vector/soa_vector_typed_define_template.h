@@ -0,0 +1,133 @@
+/*
+ * soa_vector_typed_define_template.h
+ *
+ * Usage:
+ *     define_ch_soa_vector(NAME, (type1, field1), (type2, field2), ...)
+ * with exactly the same fields as the matching declare_ch_soa_vector()
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef SOA_VECTOR_TYPED_DEFINE_TEMPLATE_H_
+#define SOA_VECTOR_TYPED_DEFINE_TEMPLATE_H_
+
+#include "soa_vector_typed_declare_template.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define _ch_soa_size(CTX, TF) CH_PP_APPLY(_ch_soa_size_, CH_PP_UNPACK TF)
+#define _ch_soa_size_(TYPE, FIELD) sizeof(TYPE),
+#define _ch_soa_update(NAME, TF) CH_PP_APPLY(_ch_soa_update_, NAME, CH_PP_UNPACK TF)
+#define _ch_soa_update_(NAME, TYPE, FIELD) this->FIELD = (TYPE*)this->_soa->_columns[CH_SOA_COL(NAME, FIELD)]->first;
+#define _ch_soa_store(CTX, TF) CH_PP_APPLY(_ch_soa_store_, CH_PP_UNPACK TF)
+#define _ch_soa_store_(TYPE, FIELD) this->FIELD[idx] = value.FIELD;
+#define _ch_soa_load(CTX, TF) CH_PP_APPLY(_ch_soa_load_, CH_PP_UNPACK TF)
+#define _ch_soa_load_(TYPE, FIELD) result.FIELD = this->FIELD[idx];
+
+#define define_ch_soa_vector(NAME, ...)\
+\
+static void _update_##NAME(ch_soa_vector_##NAME##_t* this)\
+{\
+    this->size  = this->_soa->size;\
+    this->count = this->_soa->count;\
+    CH_PP_FOR_EACH(_ch_soa_update, NAME, __VA_ARGS__)\
+}\
+\
+static void _resize_##NAME(ch_soa_vector_##NAME##_t* this, ch_word new_size)\
+{\
+    soa_vector_resize(this->_soa, new_size);\
+    _update_##NAME(this);\
+}\
+\
+static ch_word _push_back_##NAME(ch_soa_vector_##NAME##_t* this, ch_soa_##NAME##_row_t value)\
+{\
+    const ch_word idx = this->count < this->size ? this->_soa->count++ : soa_vector_append(this->_soa);\
+    if(idx < 0){\
+        return -1;\
+    }\
+    _update_##NAME(this);\
+    CH_PP_FOR_EACH(_ch_soa_store, NAME, __VA_ARGS__)\
+    return idx;\
+}\
+\
+static void _pop_back_##NAME(ch_soa_vector_##NAME##_t* this)\
+{\
+    soa_vector_pop_back(this->_soa);\
+    _update_##NAME(this);\
+}\
+\
+static void _clear_##NAME(ch_soa_vector_##NAME##_t* this)\
+{\
+    soa_vector_clear(this->_soa);\
+    _update_##NAME(this);\
+}\
+\
+static ch_soa_##NAME##_row_t _get_##NAME(ch_soa_vector_##NAME##_t* this, ch_word idx)\
+{\
+    ch_soa_##NAME##_row_t result;\
+    CH_PP_FOR_EACH(_ch_soa_load, NAME, __VA_ARGS__)\
+    return result;\
+}\
+\
+static void _set_##NAME(ch_soa_vector_##NAME##_t* this, ch_word idx, ch_soa_##NAME##_row_t value)\
+{\
+    CH_PP_FOR_EACH(_ch_soa_store, NAME, __VA_ARGS__)\
+}\
+\
+static ch_word _sort_##NAME(ch_soa_vector_##NAME##_t* this, ch_word column, cmp_void_f cmp)\
+{\
+    return soa_vector_sort(this->_soa, column, cmp);\
+}\
+\
+static ch_word _sort_perm_##NAME(ch_soa_vector_##NAME##_t* this, ch_word column, cmp_void_f cmp, ch_word* perm)\
+{\
+    return soa_vector_sort_perm(this->_soa, column, cmp, perm);\
+}\
+\
+static ch_word _permute_##NAME(ch_soa_vector_##NAME##_t* this, const ch_word* perm)\
+{\
+    return soa_vector_permute(this->_soa, perm);\
+}\
+\
+static void _delete_##NAME(ch_soa_vector_##NAME##_t* this)\
+{\
+    if(this->_soa){\
+        soa_vector_delete(this->_soa);\
+    }\
+\
+    free(this);\
+}\
+\
+ch_soa_vector_##NAME##_t* ch_soa_vector_##NAME##_new(ch_word size)\
+{\
+    ch_soa_vector_##NAME##_t* result = (ch_soa_vector_##NAME##_t*)calloc(1,sizeof(ch_soa_vector_##NAME##_t));\
+    if(!result){\
+        printf("Could not allocate memory for new structure of arrays vector. Giving up\n");\
+        return ((void *)0);\
+    }\
+\
+    const ch_word column_sizes[] = { CH_PP_FOR_EACH(_ch_soa_size, NAME, __VA_ARGS__) };\
+    result->_soa = ch_soa_vector_new(size, ch_soa_##NAME##_col_count, column_sizes);\
+    if(!result->_soa){\
+        free(result);\
+        return ((void *)0);\
+    }\
+\
+    result->resize                  = _resize_##NAME;\
+    result->push_back               = _push_back_##NAME;\
+    result->pop_back                = _pop_back_##NAME;\
+    result->clear                   = _clear_##NAME;\
+    result->get                     = _get_##NAME;\
+    result->set                     = _set_##NAME;\
+    result->sort                    = _sort_##NAME;\
+    result->sort_perm               = _sort_perm_##NAME;\
+    result->permute                 = _permute_##NAME;\
+    result->delete                  = _delete_##NAME;\
+\
+    _update_##NAME(result);\
+\
+    return result;\
+}
+
+#endif /* SOA_VECTOR_TYPED_DEFINE_TEMPLATE_H_ */
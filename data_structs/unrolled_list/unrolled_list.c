@@ -0,0 +1,424 @@
+/*
+ * unrolled_list.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "../../utils/util.h"
+#include "unrolled_list.h"
+
+//Elements start after the node header, suitably aligned
+#define NODE_HEADER_BYTES round_up((ch_word)sizeof(ch_ulist_node_t), (ch_word)_Alignof(max_align_t))
+#define NODE_DATAP(node) ((ch_byte*)(node) + NODE_HEADER_BYTES)
+
+
+static inline void* _ulist_elem(ch_ulist_t* this, ch_ulist_node_t* node, ch_word idx)
+{
+    return NODE_DATAP(node) + idx * this->_element_size;
+}
+
+static inline ch_ulist_it _ulist_it(ch_ulist_t* this, ch_ulist_node_t* node, ch_word idx)
+{
+    ch_ulist_it result = { ._node = node, ._idx = idx, .value = node ? _ulist_elem(this, node, idx) : NULL };
+    return result;
+}
+
+static inline ch_ulist_it _ulist_it_end(void)
+{
+    ch_ulist_it result = { 0 };
+    return result;
+}
+
+
+//Make a new, empty node and link it in after pos (or at the front if pos is NULL)
+static ch_ulist_node_t* _ulist_node_new(ch_ulist_t* this, ch_ulist_node_t* pos)
+{
+    ch_ulist_node_t* node = (ch_ulist_node_t*)pool_alloc(this->_pool);
+    if(!node){
+        return NULL;
+    }
+
+    node->count = 0;
+    node->prev  = pos;
+    node->next  = pos ? pos->next : this->_first;
+
+    if(node->next){
+        node->next->prev = node;
+    }
+    else{
+        this->_last = node;
+    }
+
+    if(pos){
+        pos->next = node;
+    }
+    else{
+        this->_first = node;
+    }
+
+    return node;
+}
+
+static void _ulist_node_delete(ch_ulist_t* this, ch_ulist_node_t* node)
+{
+    if(node->prev){
+        node->prev->next = node->next;
+    }
+    else{
+        this->_first = node->next;
+    }
+
+    if(node->next){
+        node->next->prev = node->prev;
+    }
+    else{
+        this->_last = node->prev;
+    }
+
+    pool_free(this->_pool, node);
+}
+
+
+//Insert value so that it lands at index idx (0 <= idx <= count) of node, splitting node if it is full
+static ch_ulist_it _ulist_insert_at(ch_ulist_t* this, ch_ulist_node_t* node, ch_word idx, const void* value)
+{
+    if(!node){
+        node = _ulist_node_new(this, this->_last);
+        idx  = 0;
+    }
+    else if(node->count == this->_node_capacity){
+        if(idx == node->count){
+            //Appending to a full node, so start the next one rather than leave this one half empty
+            node = _ulist_node_new(this, node);
+            idx  = 0;
+        }
+        else{
+            //Move the top half into a new node
+            ch_ulist_node_t* upper = _ulist_node_new(this, node);
+            if(!upper){
+                return _ulist_it_end();
+            }
+
+            const ch_word half = node->count / 2;
+            upper->count = node->count - half;
+            memcpy(NODE_DATAP(upper), _ulist_elem(this, node, half), upper->count * this->_element_size);
+            node->count = half;
+
+            if(idx > half){
+                node = upper;
+                idx -= half;
+            }
+        }
+    }
+
+    if(!node){
+        return _ulist_it_end();
+    }
+
+    ch_byte* slot = _ulist_elem(this, node, idx);
+    memmove(slot + this->_element_size, slot, (node->count - idx) * this->_element_size);
+    memcpy(slot, value, this->_element_size);
+    node->count++;
+    this->count++;
+
+    return _ulist_it(this, node, idx);
+}
+
+
+//Remove the element at index idx of node, return an iterator to the element that followed it
+static ch_ulist_it _ulist_remove_at(ch_ulist_t* this, ch_ulist_node_t* node, ch_word idx)
+{
+    ch_byte* slot = _ulist_elem(this, node, idx);
+    memmove(slot, slot + this->_element_size, (node->count - idx - 1) * this->_element_size);
+    node->count--;
+    this->count--;
+
+    if(node->count == 0){
+        ch_ulist_node_t* next = node->next;
+        _ulist_node_delete(this, node);
+        return _ulist_it(this, next, 0);
+    }
+
+    //Keep nodes at least half full on average by folding a sparse neighbour into this node
+    ch_ulist_node_t* next = node->next;
+    if(next && node->count + next->count <= this->_node_capacity / 2){
+        memcpy(_ulist_elem(this, node, node->count), NODE_DATAP(next), next->count * this->_element_size);
+        node->count += next->count;
+        _ulist_node_delete(this, next);
+    }
+
+    if(idx < node->count){
+        return _ulist_it(this, node, idx);
+    }
+
+    return _ulist_it(this, node->next, 0);
+}
+
+
+ch_ulist_it ulist_off(ch_ulist_t* this, ch_word idx)
+{
+    idx = idx < 0 ? idx + this->count : idx;
+    if(idx < 0 || idx >= this->count){
+        printf("Index (%lli) is out of the valid range [%lli,%lli]\n", idx, -1 * this->count, this->count - 1);
+        return _ulist_it_end();
+    }
+
+    //Walk from whichever end is closer
+    if(idx < this->count / 2){
+        ch_ulist_node_t* node = this->_first;
+        for(; idx >= node->count; node = node->next){
+            idx -= node->count;
+        }
+        return _ulist_it(this, node, idx);
+    }
+
+    idx = this->count - 1 - idx;
+    ch_ulist_node_t* node = this->_last;
+    for(; idx >= node->count; node = node->prev){
+        idx -= node->count;
+    }
+    return _ulist_it(this, node, node->count - 1 - idx);
+}
+
+
+ch_ulist_it ulist_first(ch_ulist_t* this)
+{
+    return _ulist_it(this, this->_first, 0);
+}
+
+ch_ulist_it ulist_last(ch_ulist_t* this)
+{
+    return this->_last ? _ulist_it(this, this->_last, this->_last->count - 1) : _ulist_it_end();
+}
+
+ch_ulist_it ulist_end(ch_ulist_t* this)
+{
+    (void)this;
+    return _ulist_it_end();
+}
+
+
+void ulist_next(ch_ulist_t* this, ch_ulist_it* it)
+{
+    if(!it->_node){
+        return;
+    }
+
+    //Most steps stay in the same node
+    if(likely(it->_idx + 1 < it->_node->count)){
+        it->_idx++;
+        it->value = (ch_byte*)it->value + this->_element_size;
+        return;
+    }
+
+    *it = _ulist_it(this, it->_node->next, 0);
+}
+
+void ulist_prev(ch_ulist_t* this, ch_ulist_it* it)
+{
+    if(!it->_node){
+        return;
+    }
+
+    if(likely(it->_idx > 0)){
+        it->_idx--;
+        it->value = (ch_byte*)it->value - this->_element_size;
+        return;
+    }
+
+    ch_ulist_node_t* prev = it->_node->prev;
+    *it = prev ? _ulist_it(this, prev, prev->count - 1) : _ulist_it_end();
+}
+
+void ulist_forward(ch_ulist_t* this, ch_ulist_it* it, ch_word amount)
+{
+    ch_ulist_node_t* node = it->_node;
+    ch_word idx = it->_idx + amount;
+    while(node && idx >= node->count){
+        idx -= node->count;
+        node = node->next;
+    }
+
+    *it = node ? _ulist_it(this, node, idx) : _ulist_it_end();
+}
+
+void ulist_back(ch_ulist_t* this, ch_ulist_it* it, ch_word amount)
+{
+    ch_ulist_node_t* node = it->_node;
+    ch_word idx = it->_idx - amount;
+    while(node && idx < 0){
+        node = node->prev;
+        idx += node ? node->count : 0;
+    }
+
+    *it = node ? _ulist_it(this, node, idx) : _ulist_it_end();
+}
+
+
+ch_ulist_it ulist_push_front(ch_ulist_t* this, const void* value)
+{
+    return _ulist_insert_at(this, this->_first, 0, value);
+}
+
+ch_ulist_it ulist_push_back(ch_ulist_t* this, const void* value)
+{
+    return _ulist_insert_at(this, this->_last, this->_last ? this->_last->count : 0, value);
+}
+
+ch_ulist_it ulist_pop_front(ch_ulist_t* this)
+{
+    if(!this->_first){
+        return _ulist_it_end();
+    }
+
+    return _ulist_remove_at(this, this->_first, 0);
+}
+
+ch_ulist_it ulist_pop_back(ch_ulist_t* this)
+{
+    if(!this->_last){
+        return _ulist_it_end();
+    }
+
+    return _ulist_remove_at(this, this->_last, this->_last->count - 1);
+}
+
+
+ch_ulist_it* ulist_insert_after(ch_ulist_t* this, ch_ulist_it* it, const void* value)
+{
+    if(!it){
+        return NULL;
+    }
+
+    if(!it->_node){
+        printf("Cannot insert after the end\n");
+        *it = _ulist_it_end();
+        return it;
+    }
+
+    *it = _ulist_insert_at(this, it->_node, it->_idx + 1, value);
+    return it;
+}
+
+ch_ulist_it* ulist_insert_before(ch_ulist_t* this, ch_ulist_it* it, const void* value)
+{
+    if(!it){
+        return NULL;
+    }
+
+    *it = it->_node ? _ulist_insert_at(this, it->_node, it->_idx, value) : ulist_push_back(this, value);
+    return it;
+}
+
+ch_ulist_it ulist_remove_it(ch_ulist_t* this, ch_ulist_it* it)
+{
+    if(!it || !it->_node){
+        return _ulist_it_end();
+    }
+
+    return _ulist_remove_at(this, it->_node, it->_idx);
+}
+
+
+void ulist_pop_all(ch_ulist_t* this)
+{
+    pool_clear(this->_pool);
+    this->_first = NULL;
+    this->_last  = NULL;
+    this->count  = 0;
+}
+
+void ulist_delete(ch_ulist_t* this)
+{
+    if(!this){
+        return;
+    }
+
+    pool_delete(this->_pool);
+    free(this);
+}
+
+
+ch_ulist_it ulist_push_back_carray(ch_ulist_t* this, const void* carray, ch_word count)
+{
+    ch_ulist_it result = { 0 };
+
+    const ch_byte* ptr = carray;
+    for(ch_word i =  0; i < count; i++){
+        result = ulist_push_back(this, ptr);
+        ptr += this->_element_size;
+    }
+
+    return result;
+}
+
+
+ch_word ulist_eq(ch_ulist_t* this, ch_ulist_t* that)
+{
+    if(this->count != that->count){
+        return 0;
+    }
+
+    ch_ulist_it it1 = ulist_first(this);
+    ch_ulist_it it2 = ulist_first(that);
+    for( ; it1.value && it2.value; ulist_next(this, &it1), ulist_next(that, &it2)){
+        if(this->_cmp(it1.value, it2.value)){
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+
+ch_ulist_it ulist_find(ch_ulist_t* this, ch_ulist_it* begin, ch_ulist_it* end, void* value)
+{
+    ch_ulist_it it = *begin;
+    for(; it._node && !(it._node == end->_node && it._idx == end->_idx); ulist_next(this, &it)){
+        if(this->_cmp(it.value, value) == 0){
+            return it;
+        }
+    }
+
+    return *end;
+}
+
+ch_ulist_it ulist_find_first(ch_ulist_t* this, void* value)
+{
+    ch_ulist_it begin = ulist_first(this);
+    ch_ulist_it end   = ulist_end(this);
+    return ulist_find(this, &begin, &end, value);
+}
+
+
+ch_ulist_t* ch_ulist_new( ch_word element_size, cmp_void_f cmp )
+{
+    if(element_size <= 0){
+        printf("Error: invalid element size (<=0), must have *some* data\n");
+        return NULL;
+    }
+
+    ch_ulist_t* result = (ch_ulist_t*)calloc(1,sizeof(ch_ulist_t));
+    if(!result){
+        printf("Could not allocate memory for new unrolled list structure. Giving up\n");
+        return NULL;
+    }
+
+    result->_cmp           = cmp;
+    result->_element_size  = element_size;
+    result->_node_capacity = MAX((CH_ULIST_NODE_BYTES - NODE_HEADER_BYTES) / element_size, CH_ULIST_NODE_MIN);
+
+    result->_pool = ch_pool_new(NODE_HEADER_BYTES + result->_node_capacity * element_size);
+    if(!result->_pool){
+        free(result);
+        return NULL;
+    }
+
+    return result;
+}
@@ -0,0 +1,116 @@
+/*
+ * unrolled_list.h
+ *
+ * Unrolled doubly linked list. Each node holds a small array of elements rather than just one, sized so that a node
+ * fills a few cache lines. Walking the list is then mostly a pointer bump through contiguous memory, with one pointer
+ * chase (and likely cache miss) per node rather than per element. Inserting or removing next to an iterator moves at
+ * most one node's worth of elements, so it is still O(1). Nodes that fill up are split in two, and nodes that become
+ * sparse are merged with their neighbour.
+ *
+ * The API follows ch_llist. NB: unlike ch_llist, inserting or removing invalidates iterators and element pointers into
+ * the node(s) that changed. Use the iterator returned by the insert or remove.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef UNROLLED_LIST_H_
+#define UNROLLED_LIST_H_
+
+#include "../../types/types.h"
+#include "../pool/pool.h"
+
+//Target size of each node, including its header. Nodes hold at least CH_ULIST_NODE_MIN elements
+#define CH_ULIST_NODE_BYTES 256
+#define CH_ULIST_NODE_MIN 4
+
+struct ch_ulist_node;
+typedef struct ch_ulist_node ch_ulist_node_t;
+
+struct ch_ulist_node {
+    ch_ulist_node_t* next;
+    ch_ulist_node_t* prev;
+    ch_word count; //Number of elements in use in this node. Elements follow the header
+};
+
+struct ch_ulist;
+typedef struct ch_ulist ch_ulist_t;
+
+struct ch_ulist{
+    ch_word count;  //Return the actual number of elements in the list
+
+    // Members prefixed with "_" are nominally "private" Don't touch my privates!
+    cmp_void_f _cmp; // Comparator function for find operations
+    ch_ulist_node_t* _first;
+    ch_ulist_node_t* _last;
+    ch_word _element_size;
+    ch_word _node_capacity; //Elements per node
+    ch_pool_t* _pool; //Where the nodes come from
+};
+
+typedef struct {
+    //These state variables are private
+    ch_ulist_node_t* _node;
+    ch_word _idx; //Index of the element in _node
+
+    //This is public
+    void* value;
+} ch_ulist_it;
+
+
+//Return the element at a given offset, with bounds checking
+ch_ulist_it ulist_off(ch_ulist_t* this, ch_word idx);
+
+//Get the first entry
+ch_ulist_it ulist_first(ch_ulist_t* this);
+//Get the last entry
+ch_ulist_it ulist_last(ch_ulist_t* this);
+//Get the end
+ch_ulist_it ulist_end(ch_ulist_t* this);
+
+//Step forwards by one entry
+void ulist_next(ch_ulist_t* this, ch_ulist_it* it);
+//Step backwards by one entry
+void ulist_prev(ch_ulist_t* this, ch_ulist_it* it);
+//Step forwards by amount
+void ulist_forward(ch_ulist_t* this, ch_ulist_it* it, ch_word amount);
+//Step backwards by amount
+void ulist_back(ch_ulist_t* this, ch_ulist_it* it, ch_word amount);
+
+// Put an element at the front of the list
+ch_ulist_it ulist_push_front(ch_ulist_t* this, const void* value);
+// Remove the element at the front of the list, return the new first entry
+ch_ulist_it ulist_pop_front(ch_ulist_t* this);
+// Put an element at the back of the list
+ch_ulist_it ulist_push_back(ch_ulist_t* this, const void* value);
+// Remove the element at the back of the list, returns the end
+ch_ulist_it ulist_pop_back(ch_ulist_t* this);
+
+// Insert an element after the element given by it. it is updated to point to the new element
+ch_ulist_it* ulist_insert_after(ch_ulist_t* this, ch_ulist_it* it, const void* value);
+// Insert an element before the element given by it (or at the back if it is the end). it is updated to point to the new element
+ch_ulist_it* ulist_insert_before(ch_ulist_t* this, ch_ulist_it* it, const void* value);
+//Remove the given iterator, return an iterator to the element that followed it
+ch_ulist_it ulist_remove_it(ch_ulist_t* this, ch_ulist_it* it);
+
+//Remove all elements from the list
+void ulist_pop_all(ch_ulist_t* this);
+
+//Free the resources associated with this list, assumes that individual items have been freed
+void ulist_delete(ch_ulist_t* this);
+
+//Push back count elements from the C array to the back of the list
+ch_ulist_it ulist_push_back_carray(ch_ulist_t* this, const void* carray, ch_word count);
+
+//Check for equality
+ch_word ulist_eq(ch_ulist_t* this, ch_ulist_t* that);
+//find the given value in [begin,end) using the comparator function, the end if there is none
+ch_ulist_it ulist_find(ch_ulist_t* this, ch_ulist_it* begin, ch_ulist_it* end, void* value);
+ch_ulist_it ulist_find_first(ch_ulist_t* this, void* value);
+
+ch_ulist_t* ch_ulist_new( ch_word element_size, cmp_void_f cmp );
+
+#define CH_ULIST_FOREACH(LIST, IT) \
+    for(ch_ulist_it IT = ulist_first(LIST); IT.value; ulist_next(LIST, &IT))
+
+#endif // UNROLLED_LIST_H_
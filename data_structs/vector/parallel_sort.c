@@ -0,0 +1,273 @@
+/*
+ * parallel_sort.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include "parallel_sort.h"
+#include "../../utils/util.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+
+typedef enum {
+    TASK_SORT,  //Sort a in place
+    TASK_MERGE, //Merge the [out_begin, out_end) slice of the merge of a and b into dst
+    TASK_COPY,  //Copy a into dst
+} task_type_e;
+
+typedef struct {
+    task_type_e type;
+    ch_byte* a;
+    ch_word a_count;
+    ch_byte* b;
+    ch_word b_count;
+    ch_byte* dst;
+    ch_word out_begin;
+    ch_word out_end;
+
+    ch_word element_size;
+    cmp_void_f cmp;
+    ch_sort_chunk_f sort_chunk;
+} sort_task_t;
+
+
+static inline void copy_element(ch_byte* dst, const ch_byte* src, ch_word element_size)
+{
+    //Let the compiler turn the common sizes into a single load and store
+    switch(element_size){
+        case 4:  memcpy(dst, src, 4); return;
+        case 8:  memcpy(dst, src, 8); return;
+        case 16: memcpy(dst, src, 16); return;
+        default: memcpy(dst, src, element_size);
+    }
+}
+
+
+//Return how many elements of a are in the first k elements of the stable merge of a and b
+static ch_word corank(const sort_task_t* task, ch_word k)
+{
+    const ch_word es = task->element_size;
+    ch_word lo = MAX(0, k - task->b_count);
+    ch_word hi = MIN(k, task->a_count);
+
+    while(lo < hi){
+        const ch_word i = lo + (hi - lo) / 2;
+        const ch_word j = k - i;
+        //Ties go to a, so a[i] belongs in the first k if it is <= b[j-1]
+        if(task->cmp(task->a + i * es, task->b + (j - 1) * es) <= 0){
+            lo = i + 1;
+        }
+        else{
+            hi = i;
+        }
+    }
+
+    return lo;
+}
+
+
+static void merge_slice(const sort_task_t* task)
+{
+    const ch_word es = task->element_size;
+    const ch_word i_begin = corank(task, task->out_begin);
+    const ch_word i_end   = corank(task, task->out_end);
+    ch_word i = i_begin;
+    ch_word j = task->out_begin - i_begin;
+    const ch_word j_end = task->out_end - i_end;
+    ch_byte* out = task->dst + task->out_begin * es;
+
+    while(i < i_end && j < j_end){
+        const ch_byte* a = task->a + i * es;
+        const ch_byte* b = task->b + j * es;
+        if(task->cmp(b, a) < 0){
+            copy_element(out, b, es);
+            j++;
+        }
+        else{
+            copy_element(out, a, es);
+            i++;
+        }
+        out += es;
+    }
+
+    memcpy(out, task->a + i * es, (i_end - i) * es);
+    out += (i_end - i) * es;
+    memcpy(out, task->b + j * es, (j_end - j) * es);
+}
+
+
+static void* run_task(void* arg)
+{
+    const sort_task_t* task = arg;
+
+    switch(task->type){
+        case TASK_SORT:
+            if(task->sort_chunk){
+                task->sort_chunk(task->a, task->a_count);
+            }
+            else{
+                qsort(task->a, task->a_count, task->element_size, task->cmp);
+            }
+            break;
+        case TASK_MERGE:
+            merge_slice(task);
+            break;
+        case TASK_COPY:
+            memcpy(task->dst, task->a, task->a_count * task->element_size);
+            break;
+    }
+
+    return NULL;
+}
+
+
+//Run all of the tasks to completion, one per thread. The calling thread takes the first task. If a thread cannot be
+//started, its task is run on the calling thread instead.
+static void run_tasks(sort_task_t* tasks, pthread_t* threads, ch_bool* started, ch_word count)
+{
+    for(ch_word i = 1; i < count; i++){
+        started[i] = pthread_create(&threads[i], NULL, run_task, &tasks[i]) == 0;
+    }
+
+    run_task(&tasks[0]);
+
+    for(ch_word i = 1; i < count; i++){
+        if(started[i]){
+            pthread_join(threads[i], NULL);
+        }
+        else{
+            run_task(&tasks[i]);
+        }
+    }
+}
+
+
+ch_word ch_sort_parallel_carray(void* carray, ch_word count, ch_word element_size, cmp_void_f cmp,
+                                ch_sort_chunk_f sort_chunk, ch_word workers)
+{
+    if(unlikely(!cmp)){
+        printf("The comparator function is empty. Cannot sort\n");
+        return -1;
+    }
+
+    if(workers <= 0){
+        workers = sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    workers = MIN(workers, count / CH_PARALLEL_SORT_MIN_CHUNK);
+
+    const sort_task_t proto = { .element_size = element_size, .cmp = cmp, .sort_chunk = sort_chunk };
+
+    ch_byte* scratch     = NULL;
+    ch_word* bounds      = NULL;
+    sort_task_t* tasks   = NULL;
+    pthread_t* threads   = NULL;
+    ch_bool* started     = NULL;
+    if(workers > 1){
+        scratch = (ch_byte*)malloc(count * element_size);
+        bounds  = (ch_word*)malloc((workers + 1) * sizeof(ch_word));
+        tasks   = (sort_task_t*)malloc((workers + 1) * sizeof(sort_task_t));
+        threads = (pthread_t*)malloc((workers + 1) * sizeof(pthread_t));
+        started = (ch_bool*)malloc((workers + 1) * sizeof(ch_bool));
+        if(!scratch || !bounds || !tasks || !threads || !started){
+            printf("Could not allocate memory for parallel sort, sorting on one thread\n");
+            workers = 1;
+        }
+    }
+
+    if(workers <= 1){
+        sort_task_t task = proto;
+        task.type    = TASK_SORT;
+        task.a       = carray;
+        task.a_count = count;
+        run_task(&task);
+        goto done;
+    }
+
+    //Sort one chunk per worker
+    for(ch_word w = 0; w <= workers; w++){
+        bounds[w] = count * w / workers;
+    }
+    for(ch_word w = 0; w < workers; w++){
+        tasks[w]         = proto;
+        tasks[w].type    = TASK_SORT;
+        tasks[w].a       = (ch_byte*)carray + bounds[w] * element_size;
+        tasks[w].a_count = bounds[w + 1] - bounds[w];
+    }
+    run_tasks(tasks, threads, started, workers);
+
+    //Merge pairs of runs, ping-ponging between the array and the scratch space
+    ch_byte* src = carray;
+    ch_byte* dst = scratch;
+    for(ch_word runs = workers; runs > 1; runs = (runs + 1) / 2){
+        const ch_word pairs = runs / 2;
+        const ch_word slices = MAX(1, workers / pairs);
+        ch_word task_count = 0;
+
+        for(ch_word p = 0; p < pairs; p++){
+            const ch_word begin = bounds[2 * p];
+            const ch_word mid   = bounds[2 * p + 1];
+            const ch_word end   = bounds[2 * p + 2];
+            for(ch_word s = 0; s < slices; s++){
+                sort_task_t* task = &tasks[task_count++];
+                *task           = proto;
+                task->type      = TASK_MERGE;
+                task->a         = src + begin * element_size;
+                task->a_count   = mid - begin;
+                task->b         = src + mid * element_size;
+                task->b_count   = end - mid;
+                task->dst       = dst + begin * element_size;
+                task->out_begin = (end - begin) * s / slices;
+                task->out_end   = (end - begin) * (s + 1) / slices;
+            }
+        }
+
+        //An odd run out has nothing to merge with, carry it over to the next round
+        if(runs & 1){
+            sort_task_t* task = &tasks[task_count++];
+            *task         = proto;
+            task->type    = TASK_COPY;
+            task->a       = src + bounds[runs - 1] * element_size;
+            task->a_count = count - bounds[runs - 1];
+            task->dst     = dst + bounds[runs - 1] * element_size;
+        }
+
+        run_tasks(tasks, threads, started, task_count);
+
+        for(ch_word p = 0; p < (runs + 1) / 2; p++){
+            bounds[p] = bounds[2 * p];
+        }
+        bounds[(runs + 1) / 2] = count;
+
+        ch_byte* tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    //Finished in the scratch space, copy back in parallel
+    if(src != carray){
+        for(ch_word w = 0; w < workers; w++){
+            const ch_word begin = count * w / workers;
+            const ch_word end   = count * (w + 1) / workers;
+            tasks[w]         = proto;
+            tasks[w].type    = TASK_COPY;
+            tasks[w].a       = src + begin * element_size;
+            tasks[w].a_count = end - begin;
+            tasks[w].dst     = (ch_byte*)carray + begin * element_size;
+        }
+        run_tasks(tasks, threads, started, workers);
+    }
+
+done:
+    free(scratch);
+    free(bounds);
+    free(tasks);
+    free(threads);
+    free(started);
+    return 0;
+}
@@ -0,0 +1,30 @@
+/*
+ * parallel_sort.h
+ *
+ * Multi-threaded merge sort over a raw C array. The array is cut into one chunk per worker and the chunks are sorted
+ * concurrently. Pairs of sorted runs are then merged in rounds until one run is left. Each merge is shared between
+ * the workers by binary searching for the point in both inputs where each worker's slice of the output begins, so
+ * every worker stays busy right up to the final merge.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef PARALLEL_SORT_H_
+#define PARALLEL_SORT_H_
+
+#include "../../types/types.h"
+
+//Below this many elements per worker, the threads cost more than they save. Use fewer workers.
+#define CH_PARALLEL_SORT_MIN_CHUNK (64 * 1024)
+
+//Sorts count elements of carray in place. Used to sort each chunk when something faster than qsort() is available.
+typedef void (*ch_sort_chunk_f)(void* carray, ch_word count);
+
+//Sort count elements of carray into the order given by cmp, using at most workers threads (workers <= 0 means one per
+//online CPU). If sort_chunk is NULL, the chunks are sorted with qsort(). Falls back to a single threaded sort for
+//small arrays or if scratch memory cannot be allocated. Returns 0 on success, -1 on failure.
+ch_word ch_sort_parallel_carray(void* carray, ch_word count, ch_word element_size, cmp_void_f cmp,
+                                ch_sort_chunk_f sort_chunk, ch_word workers);
+
+#endif /* PARALLEL_SORT_H_ */
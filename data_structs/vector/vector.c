@@ -135,6 +135,36 @@ int vector_get_idx(ch_vector_t* this, void* value)
 }
 
 
+void* vector_lower_bound(ch_vector_t* this, void* value)
+{
+    if(unlikely(!this->_cmp)){
+        printf("The comparator function is empty. Cannot search\n");
+        return NULL;
+    }
+
+    return ch_lower_bound_carray(this->first, this->count, this->_array->_element_size, this->_cmp, value);
+}
+
+
+void* vector_upper_bound(ch_vector_t* this, void* value)
+{
+    if(unlikely(!this->_cmp)){
+        printf("The comparator function is empty. Cannot search\n");
+        return NULL;
+    }
+
+    return ch_upper_bound_carray(this->first, this->count, this->_array->_element_size, this->_cmp, value);
+}
+
+
+void vector_equal_range(ch_vector_t* this, void* value, void** lower, void** upper)
+{
+    *lower = vector_lower_bound(this, value);
+    *upper = *lower ? ch_upper_bound_carray(*lower, ((ch_byte*)this->end - (ch_byte*)*lower) / this->_array->_element_size,
+                                            this->_array->_element_size, this->_cmp, value) : NULL;
+}
+
+
 
 /*sort into reverse order given the comparitor function*/
 void vector_sort(ch_vector_t* this)
@@ -143,6 +173,17 @@ void vector_sort(ch_vector_t* this)
 }
 
 
+ch_word vector_sort_parallel(ch_vector_t* this, ch_word workers)
+{
+    return ch_sort_parallel_carray(this->first, this->count, this->_array->_element_size, this->_array->_cmp, NULL, workers);
+}
+
+ch_word vector_sort_radix(ch_vector_t* this, ch_word key_offset, ch_word key_size, ch_radix_key_e key_type)
+{
+    return ch_radix_sort_carray(this->first, this->count, this->_array->_element_size, key_offset, key_size, key_type);
+}
+
+
 /* Insert an element before the element giver by ptr [WARN: In general this is very expensive for an vector] */
 void* vector_insert_before(ch_vector_t* this, void* ptr, void* value)
 {
@@ -150,7 +191,12 @@ void* vector_insert_before(ch_vector_t* this, void* ptr, void* value)
     /*If the backing memory is full, grow the vector*/
     if(unlikely(this->_array_count == this->_array->size)){
         const ch_word ptr_idx = ptr ? (ch_byte*)ptr - (ch_byte*)this->_array->first: 0;
-        const ch_word new_size = this->size ? this->size * 2 : 1;
+        ch_word new_size = this->size ? this->size * 2 : 1;
+        //Fill up the reservation before growing beyond it, which costs nothing
+        const ch_word reserved = array_reserved(this->_array);
+        if(this->size < reserved){
+            new_size = MIN(new_size, reserved);
+        }
         vector_resize(this,new_size);
         ptr = (ch_byte*)this->_array->first + ptr_idx;
     }
@@ -292,6 +338,106 @@ void vector_clear(ch_vector_t* this)
 }
 
 
+/*Drop everything from new_end onwards*/
+static void _vector_truncate(ch_vector_t* this, void* new_end)
+{
+    this->_array_count = ((ch_byte*)new_end - (ch_byte*)this->first) / this->_array->_element_size;
+    this->count        = this->_array_count;
+
+    if(this->_array_count == 0){
+        this->first = this->_array->first;
+        this->last  = this->first;
+        this->end   = this->last;
+    }
+    else{
+        this->end  = new_end;
+        this->last = _vector_back_unsafe(this, this->end, 1);
+    }
+}
+
+
+/*Close the gap between write and the run of kept elements [run, run_end), return the new write position*/
+static inline ch_byte* _vector_keep_run(ch_byte* write, ch_byte* run, ch_byte* run_end)
+{
+    if(write != run){
+        memmove(write, run, run_end - run);
+    }
+
+    return write + (run_end - run);
+}
+
+
+ch_word vector_remove_if(ch_vector_t* this, ch_vector_pred_f pred, void* arg)
+{
+    const ch_word element_size = this->_array->_element_size;
+    ch_byte* const end = this->end;
+    ch_byte* write     = this->first;
+    ch_byte* run       = NULL; /*Start of the current run of elements to keep*/
+
+    for(ch_byte* read = this->first; read < end; read += element_size){
+        if(!pred(read, arg)){
+            run = run ? run : read;
+            continue;
+        }
+
+        if(run){
+            write = _vector_keep_run(write, run, read);
+            run   = NULL;
+        }
+    }
+
+    if(run){
+        write = _vector_keep_run(write, run, end);
+    }
+
+    const ch_word removed = (end - write) / element_size;
+    _vector_truncate(this, write);
+    return removed;
+}
+
+
+void* vector_erase_range(ch_vector_t* this, void* first, void* last)
+{
+    if(unlikely(first < this->first || last > this->end || first > last)){
+        printf("Range supplied is out of range.\n");
+        return NULL;
+    }
+
+    ch_byte* const new_end = _vector_keep_run(first, last, this->end);
+    _vector_truncate(this, new_end);
+    return first;
+}
+
+
+ch_word vector_compact(ch_vector_t* this, const ch_byte* mask)
+{
+    const ch_word element_size = this->_array->_element_size;
+    const ch_word count        = this->_array_count;
+    ch_byte* write             = this->first;
+    ch_word run                = -1; /*Index of the start of the current run of elements to keep*/
+
+    for(ch_word i = 0; i < count; i++){
+        if(mask[i]){
+            run = run < 0 ? i : run;
+            continue;
+        }
+
+        if(run >= 0){
+            write = _vector_keep_run(write, (ch_byte*)this->first + run * element_size, (ch_byte*)this->first + i * element_size);
+            run   = -1;
+        }
+    }
+
+    if(run >= 0){
+        write = _vector_keep_run(write, (ch_byte*)this->first + run * element_size, this->end);
+    }
+
+    const ch_word removed = ((ch_byte*)this->end - write) / element_size;
+    _vector_truncate(this, write);
+    return removed;
+}
+
+
 void vector_delete(ch_vector_t* this)
 {
     if(this->_array){
@@ -329,16 +475,20 @@ void* vector_push_back_carray(ch_vector_t* this, void* carray, ch_word count)
 }
 
 
-ch_vector_t* ch_vector_new(ch_word size, ch_word element_size, int(*cmp)(const void* lhs, const void* rhs) )
+static ch_vector_t* _vector_wrap(ch_array_t* array, int(*cmp)(const void* lhs, const void* rhs) )
 {
+    if(!array){
+        return NULL;
+    }
 
     ch_vector_t* result = (ch_vector_t*)calloc(1,sizeof(ch_vector_t));
     if(!result){
         printf("Could not allocate memory for new vector structure. Giving up\n");
+        array_delete(array);
         return NULL;
     }
 
-    result->_array       = ch_array_new(size, element_size, cmp);
+    result->_array       = array;
 
     /*We have memory to play with, now do all the other assignments*/
     result->_array_count            = 0;
@@ -352,3 +502,15 @@ ch_vector_t* ch_vector_new(ch_word size, ch_word element_size, int(*cmp)(const v
     return result;
 }
 
+
+ch_vector_t* ch_vector_new(ch_word size, ch_word element_size, int(*cmp)(const void* lhs, const void* rhs) )
+{
+    return _vector_wrap(ch_array_new(size, element_size, cmp), cmp);
+}
+
+
+ch_vector_t* ch_vector_new_reserved(ch_word size, ch_word max_size, ch_word element_size,
+                                    int(*cmp)(const void* lhs, const void* rhs) )
+{
+    return _vector_wrap(ch_array_new_reserved(size, max_size, element_size, cmp), cmp);
+}
@@ -10,10 +10,14 @@
 
 #include "../../types/types.h"
 #include "../array/array.h"
+#include "parallel_sort.h"
 
 struct ch_vector;
 typedef struct ch_vector ch_vector_t;
 
+//Predicate for vector_remove_if(). Return true to remove value. arg is passed through unchanged.
+typedef ch_bool (*ch_vector_pred_f)(const void* value, void* arg);
+
 
 struct ch_vector{
     ch_word size;  //Return the max number number of elements in the vector list
@@ -63,6 +67,17 @@ void* vector_remove(ch_vector_t* this, void* ptr);
 //Pop everything out of the vector
 void vector_clear(ch_vector_t* this);
 
+//The bulk removes below make a single pass over the vector, so removing k of n elements costs O(n), not O(n*k) as
+//with repeated calls to vector_remove(). The order of the remaining elements is preserved.
+//Remove every element for which pred returns true. Returns the number of elements removed
+ch_word vector_remove_if(ch_vector_t* this, ch_vector_pred_f pred, void* arg);
+//Remove the elements in [first, last). Returns a pointer to the element that took first's place (end if none), or NULL
+//if the range is invalid
+void* vector_erase_range(ch_vector_t* this, void* first, void* last);
+//Keep only the elements whose entry in mask (one per element, count in total) is non-zero. Returns the number of
+//elements removed
+ch_word vector_compact(ch_vector_t* this, const ch_byte* mask);
+
 //Free the resources associated with this vector, assumes that individual items have been freed
 void vector_delete(ch_vector_t* this);
 
@@ -75,9 +90,27 @@ ch_word vector_eq(ch_vector_t* this, ch_vector_t* that);
 void* vector_find(ch_vector_t* this, void* begin, void* end, void* value);
 //return the index of the value
 int vector_get_idx(ch_vector_t* this, void* value);
+
+//The vector must be sorted by the comparator function for the following:
+//Return the first element that is not less than value, or end if there is none
+void* vector_lower_bound(ch_vector_t* this, void* value);
+//Return the first element that is greater than value, or end if there is none
+void* vector_upper_bound(ch_vector_t* this, void* value);
+//Set lower and upper to the range [lower, upper) of elements equal to value. The range is empty if there are none.
+void vector_equal_range(ch_vector_t* this, void* value, void** lower, void** upper);
 //sort into order given the comparator function
 void vector_sort(ch_vector_t* this);
+//sort into order given the comparator function, using up to workers threads (<= 0 for one per CPU). Small vectors are
+//sorted on the calling thread. Returns 0 on success, -1 on failure.
+ch_word vector_sort_parallel(ch_vector_t* this, ch_word workers);
+//sort into ascending order of an integer or floating point key found key_offset bytes into each element, using a stable
+//LSD radix sort. The rest of each element is carried along as payload. Returns 0 on success, -1 on failure.
+ch_word vector_sort_radix(ch_vector_t* this, ch_word key_offset, ch_word key_size, ch_radix_key_e key_type);
 
 ch_vector_t* ch_vector_new(ch_word size, ch_word element_size, cmp_void_f cmp );
 
+//As above, but reserve address space for up to max_size elements up front, committing memory only as it is used. The
+//vector grows up to max_size without ever moving or copying its elements, and can still grow beyond it if need be.
+ch_vector_t* ch_vector_new_reserved(ch_word size, ch_word max_size, ch_word element_size, cmp_void_f cmp );
+
 #endif // VECTOR_H_
@@ -10,43 +10,43 @@
 #include "vector_typed_define_template.h"
 #include <string.h>
 
-define_ch_vector(u8,  u8)
-define_ch_vector(u16, u16)
-define_ch_vector(u32, u32)
-define_ch_vector(u64, u64)
-
-define_ch_vector(u8p,  u8*)
-define_ch_vector(u16p, u16*)
-define_ch_vector(u32p, u32*)
-define_ch_vector(u64p, u64*)
-
-define_ch_vector(i8,  i8)
-define_ch_vector(i16, i16)
-define_ch_vector(i32, i32)
-define_ch_vector(i64, i64)
-
-define_ch_vector(i8p,  i8*)
-define_ch_vector(i16p, i16*)
-define_ch_vector(i32p, i32*)
-define_ch_vector(i64p, i64*)
-
-define_ch_vector(machine, ch_machine)
-define_ch_vector(word, ch_word)
-define_ch_vector(char, ch_char)
-define_ch_vector(ch_bool, ch_bool)
-define_ch_vector(float, ch_float)
-define_ch_vector(string, ch_str)
-define_ch_vector(cstr, ch_cstr)
-
-define_ch_vector(machinep, ch_machine*)
-define_ch_vector(wordp, ch_word*)
-define_ch_vector(charp, ch_char*)
+define_ch_vector_std_radix(u8,  u8, CH_SORT_LT, u8, CH_RADIX_KEY_UNSIGNED, CH_FIND_EQ_INT)
+define_ch_vector_std_radix(u16, u16, CH_SORT_LT, u16, CH_RADIX_KEY_UNSIGNED, CH_FIND_EQ_INT)
+define_ch_vector_std_radix(u32, u32, CH_SORT_LT, u32, CH_RADIX_KEY_UNSIGNED, CH_FIND_EQ_INT)
+define_ch_vector_std_radix(u64, u64, CH_SORT_LT, u64, CH_RADIX_KEY_UNSIGNED, CH_FIND_EQ_INT)
+
+define_ch_vector_std(u8p,  u8*, CH_SORT_LT_DEREF)
+define_ch_vector_std(u16p, u16*, CH_SORT_LT_DEREF)
+define_ch_vector_std(u32p, u32*, CH_SORT_LT_DEREF)
+define_ch_vector_std(u64p, u64*, CH_SORT_LT_DEREF)
+
+define_ch_vector_std_radix(i8,  i8, CH_SORT_LT, u8, CH_RADIX_KEY_SIGNED, CH_FIND_EQ_INT)
+define_ch_vector_std_radix(i16, i16, CH_SORT_LT, u16, CH_RADIX_KEY_SIGNED, CH_FIND_EQ_INT)
+define_ch_vector_std_radix(i32, i32, CH_SORT_LT, u32, CH_RADIX_KEY_SIGNED, CH_FIND_EQ_INT)
+define_ch_vector_std_radix(i64, i64, CH_SORT_LT, u64, CH_RADIX_KEY_SIGNED, CH_FIND_EQ_INT)
+
+define_ch_vector_std(i8p,  i8*, CH_SORT_LT_DEREF)
+define_ch_vector_std(i16p, i16*, CH_SORT_LT_DEREF)
+define_ch_vector_std(i32p, i32*, CH_SORT_LT_DEREF)
+define_ch_vector_std(i64p, i64*, CH_SORT_LT_DEREF)
+
+define_ch_vector_std_radix(machine, ch_machine, CH_SORT_LT, ch_machine, CH_RADIX_KEY_UNSIGNED, CH_FIND_EQ_INT)
+define_ch_vector_std_radix(word, ch_word, CH_SORT_LT, u64, CH_RADIX_KEY_SIGNED, CH_FIND_EQ_INT)
+define_ch_vector_std_radix(char, ch_char, CH_SORT_LT, u8, CH_RADIX_KEY_SIGNED, CH_FIND_EQ_INT)
+define_ch_vector_std(ch_bool, ch_bool, CH_SORT_LT)
+define_ch_vector_std_radix(float, ch_float, CH_SORT_LT, u64, CH_RADIX_KEY_FLOAT, CH_FIND_EQ_FLOAT)
+define_ch_vector_std(string, ch_str, CH_SORT_LT_STR)
+define_ch_vector_std(cstr, ch_cstr, CH_SORT_LT_CSTR)
+
+define_ch_vector_std(machinep, ch_machine*, CH_SORT_LT_DEREF)
+define_ch_vector_std(wordp, ch_word*, CH_SORT_LT_DEREF)
+define_ch_vector_std(charp, ch_char*, CH_SORT_LT_DEREF)
 define_ch_vector(boolp, ch_bool*)
-define_ch_vector(floatp, ch_float*)
-define_ch_vector(stringp, ch_str*)
-define_ch_vector(cstrp, ch_cstr*)
+define_ch_vector_std(floatp, ch_float*, CH_SORT_LT_DEREF)
+define_ch_vector_std(stringp, ch_str*, CH_SORT_LT_STRP)
+define_ch_vector_std(cstrp, ch_cstr*, CH_SORT_LT_CSTRP)
 
-define_ch_vector(voidp,  void*)
+define_ch_vector_std_find(voidp,  void*, CH_SORT_LT_PTR, CH_FIND_EQ_INT)
 
 define_ch_vector_cmp(u8,  u8)
 define_ch_vector_cmp(u16, u16)
@@ -4,6 +4,9 @@
 
 #include "../../types/types.h"
 #include "vector.h"
+#include "../../utils/util.h"
+
+#include <stdio.h>
 
 
 #define declare_ch_vector(NAME,TYPE) \
@@ -37,11 +40,19 @@ struct ch_vector_##NAME{\
     TYPE* (*insert_after)(ch_vector_##NAME##_t* this, TYPE* ptr, TYPE value); /* Insert an element after the element given by ptr*/\
     TYPE* (*insert_before)(ch_vector_##NAME##_t* this, TYPE* ptr, TYPE value); /* Insert an element before the element giver by ptr [WARN: In general this is very expensive for a vector] */\
     TYPE* (*remove)(ch_vector_##NAME##_t* this, TYPE* ptr); /*Remove the given ptr [WARN: In general this is very expensive] */\
+    ch_word (*remove_if)(ch_vector_##NAME##_t* this, ch_bool (*pred)(TYPE* value, void* arg), void* arg); /*Remove every element for which pred is true in one pass, return the number removed. See also define_ch_vector_remove_if()*/\
+    TYPE* (*erase_range)(ch_vector_##NAME##_t* this, TYPE* first, TYPE* last); /*Remove the elements in [first,last), return the element that took first's place*/\
+    ch_word (*compact)(ch_vector_##NAME##_t* this, const ch_byte* mask); /*Keep only the elements with a non-zero mask entry in one pass, return the number removed*/\
     void (*delete)(ch_vector_##NAME##_t* this); /*Free the resources associated with this vector, assumes that individual items have been freed*/\
 \
     TYPE* (*find)(ch_vector_##NAME##_t* this, TYPE* begin, TYPE* end, TYPE value); /*find the given value using the comparator function*/\
     int (*get_idx)(ch_vector_##NAME##_t* this, TYPE* value); /*Convert the iterator into an index for use with off() above*/\
+    TYPE* (*lower_bound)(ch_vector_##NAME##_t* this, TYPE value); /*in a sorted vector, return the first element not less than value, or end*/\
+    TYPE* (*upper_bound)(ch_vector_##NAME##_t* this, TYPE value); /*in a sorted vector, return the first element greater than value, or end*/\
+    void (*equal_range)(ch_vector_##NAME##_t* this, TYPE value, TYPE** lower, TYPE** upper); /*in a sorted vector, set [lower,upper) to the elements equal to value*/\
     void (*sort)(ch_vector_##NAME##_t* this); /*sort into order given the comparator function*/\
+    void (*sort_parallel)(ch_vector_##NAME##_t* this, ch_word workers); /*sort into order given the comparator function, using up to workers threads (<= 0 for one per CPU)*/\
+    void (*sort_radix)(ch_vector_##NAME##_t* this); /*sort into ascending order with a radix sort, ignoring the comparator. NULL unless TYPE is an integer or float*/\
     ch_word (*eq)(ch_vector_##NAME##_t* this, ch_vector_##NAME##_t* that); /*Check for equality*/\
 \
     TYPE* (*push_back_carray)(ch_vector_##NAME##_t* this, TYPE* carray, ch_word count); /*Push back count elements the C vector to the back vector-list*/\
@@ -52,7 +63,121 @@ struct ch_vector_##NAME{\
 };\
 \
 \
-ch_vector_##NAME##_t* ch_vector_##NAME##_new(ch_word size, ch_word(*cmp)(TYPE* lhs, TYPE* rhs) );
+ch_vector_##NAME##_t* ch_vector_##NAME##_new(ch_word size, ch_word(*cmp)(TYPE* lhs, TYPE* rhs) );\
+ch_vector_##NAME##_t* ch_vector_##NAME##_new_reserved(ch_word size, ch_word max_size, ch_word(*cmp)(TYPE* lhs, TYPE* rhs) );\
+_declare_ch_vector_inline(NAME,TYPE)
+
+//Direct call versions of the hot operations. These are static inline, so unlike calls through the function pointers
+//above, the compiler can inline them at the call site. Bounds checks are compiled out in release (NDEBUG) builds.
+#define _declare_ch_vector_inline(NAME,TYPE)\
+\
+static inline void _ch_vector_##NAME##_sync(ch_vector_##NAME##_t* this)\
+{\
+    this->size  = this->_vector->size;\
+    this->first = this->_vector->first;\
+    this->last  = this->_vector->last;\
+    this->end   = this->_vector->end;\
+    this->count = this->_vector->count;\
+}\
+\
+/*Return the element at a given offset. Negative offsets count back from the end (the last element)*/\
+static inline TYPE* ch_vector_##NAME##_off(ch_vector_##NAME##_t* this, ch_word idx)\
+{\
+    idx = idx < 0 ? idx + this->count : idx;\
+    CH_BOUNDS_CHECK(idx >= 0 && idx < this->count, NULL, "Index (%lli) is out of the valid range [%lli,%lli]\n", idx, -1 * this->count, this->count - 1);\
+    return this->first + idx;\
+}\
+\
+/*Step forwards by amount*/\
+static inline TYPE* ch_vector_##NAME##_forward(ch_vector_##NAME##_t* this, TYPE* ptr, ch_word amount)\
+{\
+    CH_BOUNDS_CHECK(ptr + amount <= this->end, ptr, "Vector forward catch\n");\
+    (void)this;\
+    return ptr + amount;\
+}\
+\
+/*Step backwards by amount*/\
+static inline TYPE* ch_vector_##NAME##_back(ch_vector_##NAME##_t* this, TYPE* ptr, ch_word amount)\
+{\
+    CH_BOUNDS_CHECK(ptr - amount >= this->first, ptr, "Vector backward catch\n");\
+    (void)this;\
+    return ptr - amount;\
+}\
+\
+static inline TYPE* ch_vector_##NAME##_next(ch_vector_##NAME##_t* this, TYPE* ptr) { return ch_vector_##NAME##_forward(this, ptr, 1); }\
+static inline TYPE* ch_vector_##NAME##_prev(ch_vector_##NAME##_t* this, TYPE* ptr) { return ch_vector_##NAME##_back(this, ptr, 1); }\
+\
+/*Put an element at the back of the vector. Only growing the vector takes a function call*/\
+static inline TYPE* ch_vector_##NAME##_push_back(ch_vector_##NAME##_t* this, TYPE value)\
+{\
+    ch_vector_t* vector = this->_vector;\
+    if(unlikely(vector->_array_count == vector->_array->size)){\
+        TYPE* result = (TYPE*)vector_push_back(vector, &value);\
+        _ch_vector_##NAME##_sync(this);\
+        return result;\
+    }\
+\
+    TYPE* result = (TYPE*)vector->_array->first + vector->_array_count;\
+    *result = value;\
+    vector->_array_count++;\
+    vector->count = vector->_array_count;\
+    vector->first = vector->_array->first;\
+    vector->last  = result;\
+    vector->end   = result + 1;\
+    _ch_vector_##NAME##_sync(this);\
+    return result;\
+}\
+\
+/*Remove the element at the back of the vector*/\
+static inline void ch_vector_##NAME##_pop_back(ch_vector_##NAME##_t* this)\
+{\
+    ch_vector_t* vector = this->_vector;\
+    if(unlikely(vector->_array_count == 0)){\
+        return;\
+    }\
+\
+    vector->_array_count--;\
+    vector->count = vector->_array_count;\
+    vector->end   = (TYPE*)vector->end - 1;\
+    vector->last  = vector->_array_count ? (TYPE*)vector->last - 1 : vector->end;\
+    _ch_vector_##NAME##_sync(this);\
+}\
+\
+/*Remove all elements*/\
+static inline void ch_vector_##NAME##_clear(ch_vector_##NAME##_t* this)\
+{\
+    vector_clear(this->_vector);\
+    _ch_vector_##NAME##_sync(this);\
+}
+
+//remove_if() with the predicate inlined, for the cleanup passes over big vectors where an indirect call per element
+//dominates. PRED(value, arg) is a macro or function taking a TYPE and the void* arg, true to remove value.
+//    define_ch_vector_remove_if(my_prefix, NAME, TYPE, PRED)
+//generates
+//    static inline ch_word my_prefix_remove_if(ch_vector_NAME_t* this, void* arg);
+//which returns the number of elements removed. The loop has no data dependent branches: every element is copied to
+//the write cursor, which only advances past the ones that are kept.
+#define define_ch_vector_remove_if(PREFIX, NAME, TYPE, PRED)\
+\
+static inline ch_word PREFIX##_remove_if(ch_vector_##NAME##_t* this, void* arg)\
+{\
+    (void)arg;\
+    TYPE* write = this->first;\
+    TYPE* const end = this->end;\
+    for(TYPE* read = this->first; read < end; read++){\
+        const TYPE value = *read;\
+        *write = value;\
+        write += !(PRED(value, arg));\
+    }\
+\
+    const ch_word removed = end - write;\
+    if(removed){\
+        vector_erase_range(this->_vector, write, end);\
+        _ch_vector_##NAME##_sync(this);\
+    }\
+\
+    return removed;\
+}
 
 #define declare_ch_vector_cmp(NAME, TYPE) ch_word ch_vector_cmp_##NAME(TYPE* lhs, TYPE* rhs);
 
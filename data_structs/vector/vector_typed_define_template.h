@@ -7,11 +7,134 @@
 #include "../../utils/util.h"
 #include "../../types/types.h"
 
+#include "../array/array_sort_template.h"
+#include "../array/array_radix_template.h"
+#include "../array/array_search_template.h"
+#include "../array/simd_find.h"
+
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
+//Generic vectors, sort using the comparator function
 #define define_ch_vector(NAME,TYPE)\
+_define_ch_vector_base(NAME,TYPE)\
+static void _sort_##NAME(ch_vector_##NAME##_t* this)                                        { vector_sort(this->_vector); _update_##NAME(this); }\
+static void _sort_parallel_##NAME(ch_vector_##NAME##_t* this, ch_word workers)              { vector_sort_parallel(this->_vector, workers); _update_##NAME(this); }\
+_define_ch_vector_bounds(NAME,TYPE)\
+_define_ch_vector_new(NAME,TYPE,_find_##NAME,NULL)
+
+//Vectors of types with a natural order given by LESS(lhs,rhs). If the vector is constructed with the standard comparator
+//(CH_VECTOR_CMP(NAME)), sorting uses a type specialised introsort with the comparison inlined, rather than qsort().
+#define define_ch_vector_std(NAME,TYPE,LESS)\
+_define_ch_vector_std(NAME,TYPE,LESS)\
+_define_ch_vector_new(NAME,TYPE,_find_##NAME,NULL)
+
+//As above, for types that can be searched with SIMD instructions. FIND_EQ is one of CH_FIND_EQ_{INT,FLOAT}
+#define define_ch_vector_std_find(NAME,TYPE,LESS,FIND_EQ)\
+_define_ch_vector_std(NAME,TYPE,LESS)\
+_define_ch_vector_find_simd(NAME,TYPE,FIND_EQ)\
+_define_ch_vector_new(NAME,TYPE,_find_simd_##NAME,NULL)
+
+//As above, for integer and floating point types that can also be radix sorted. UTYPE is the unsigned type of the same
+//width as TYPE and KEY is one of CH_RADIX_KEY_{UNSIGNED,SIGNED,FLOAT}
+#define define_ch_vector_std_radix(NAME,TYPE,LESS,UTYPE,KEY,FIND_EQ)\
+_define_ch_vector_std(NAME,TYPE,LESS)\
+_define_ch_vector_find_simd(NAME,TYPE,FIND_EQ)\
+define_ch_radix_sort(_ch_vector_##NAME, TYPE, UTYPE, KEY)\
+static void _sort_radix_##NAME(ch_vector_##NAME##_t* this)\
+{\
+    TYPE* carray = (TYPE*)this->_vector->first;\
+    const ch_word count = this->_vector->count;\
+    if(count < CH_RADIX_THRESHOLD){\
+        _ch_vector_##NAME##_introsort(carray, count);\
+    }\
+    else if(_ch_vector_##NAME##_radix_sort(carray, count)){\
+        printf("Could not allocate radix sort scratch space, falling back to introsort\n");\
+        _ch_vector_##NAME##_introsort(carray, count);\
+    }\
+    _update_##NAME(this);\
+}\
+_define_ch_vector_new(NAME,TYPE,_find_simd_##NAME,_sort_radix_##NAME)
+
+#define _define_ch_vector_std(NAME,TYPE,LESS)\
+_define_ch_vector_base(NAME,TYPE)\
+_define_ch_vector_bounds_std(NAME,TYPE,LESS)\
+define_ch_introsort(_ch_vector_##NAME, TYPE, LESS)\
+static void _sort_##NAME(ch_vector_##NAME##_t* this)\
+{\
+    if(this->_vector->_cmp == (cmp_void_f)ch_vector_cmp_##NAME){\
+        _ch_vector_##NAME##_introsort((TYPE*)this->_vector->first, this->_vector->count);\
+    }\
+    else{\
+        vector_sort(this->_vector);\
+    }\
+    _update_##NAME(this);\
+}\
+\
+static void _sort_chunk_##NAME(void* carray, ch_word count)\
+{\
+    _ch_vector_##NAME##_introsort((TYPE*)carray, count);\
+}\
+\
+static void _sort_parallel_##NAME(ch_vector_##NAME##_t* this, ch_word workers)\
+{\
+    const ch_bool std_cmp = this->_vector->_cmp == (cmp_void_f)ch_vector_cmp_##NAME;\
+    ch_sort_parallel_carray(this->_vector->first, this->_vector->count, sizeof(TYPE), this->_vector->_cmp,\
+                            std_cmp ? _sort_chunk_##NAME : NULL, workers);\
+    _update_##NAME(this);\
+}
+
+//Binary searches using the comparator function
+#define _define_ch_vector_bounds(NAME,TYPE)\
+static TYPE* _lower_bound_##NAME(ch_vector_##NAME##_t* this, TYPE value)                     { return (TYPE*)vector_lower_bound(this->_vector, &value); }\
+static TYPE* _upper_bound_##NAME(ch_vector_##NAME##_t* this, TYPE value)                     { return (TYPE*)vector_upper_bound(this->_vector, &value); }\
+static void _equal_range_##NAME(ch_vector_##NAME##_t* this, TYPE value, TYPE** lower, TYPE** upper)\
+{\
+    vector_equal_range(this->_vector, &value, (void**)lower, (void**)upper);\
+}
+
+//Binary searches with LESS inlined if the vector uses the standard comparator
+#define _define_ch_vector_bounds_std(NAME,TYPE,LESS)\
+define_ch_bsearch(_ch_vector_##NAME, TYPE, LESS)\
+static TYPE* _lower_bound_##NAME(ch_vector_##NAME##_t* this, TYPE value)\
+{\
+    if(this->_vector->_cmp != (cmp_void_f)ch_vector_cmp_##NAME){\
+        return (TYPE*)vector_lower_bound(this->_vector, &value);\
+    }\
+    return _ch_vector_##NAME##_lower_bound((TYPE*)this->_vector->first, this->_vector->count, value);\
+}\
+\
+static TYPE* _upper_bound_##NAME(ch_vector_##NAME##_t* this, TYPE value)\
+{\
+    if(this->_vector->_cmp != (cmp_void_f)ch_vector_cmp_##NAME){\
+        return (TYPE*)vector_upper_bound(this->_vector, &value);\
+    }\
+    return _ch_vector_##NAME##_upper_bound((TYPE*)this->_vector->first, this->_vector->count, value);\
+}\
+\
+static void _equal_range_##NAME(ch_vector_##NAME##_t* this, TYPE value, TYPE** lower, TYPE** upper)\
+{\
+    *lower = _lower_bound_##NAME(this, value);\
+    *upper = _upper_bound_##NAME(this, value);\
+}
+
+//If the vector uses the standard comparator, search with SIMD equality instead of calling the comparator per element.
+//Bad iterators go to the generic find, which reports them.
+#define _define_ch_vector_find_simd(NAME,TYPE,FIND_EQ)\
+static TYPE* _find_simd_##NAME(ch_vector_##NAME##_t* this, TYPE* begin, TYPE* end, TYPE value)\
+{\
+    TYPE* first = (TYPE*)this->_vector->_array->first;\
+    TYPE* last  = (TYPE*)this->_vector->_array->end;\
+    if(this->_vector->_cmp != (cmp_void_f)ch_vector_cmp_##NAME ||\
+       begin < first || begin > last || end < first || end > last){\
+        return _find_##NAME(this, begin, end, value);\
+    }\
+\
+    return (TYPE*)FIND_EQ(begin, end, value);\
+}
+
+#define _define_ch_vector_base(NAME,TYPE)\
 \
 static void _update_##NAME(ch_vector_##NAME##_t* this)\
 {\
@@ -31,12 +154,14 @@ static TYPE* _next_##NAME(ch_vector_##NAME##_t* this, TYPE* ptr)
 static TYPE* _prev_##NAME(ch_vector_##NAME##_t* this, TYPE* ptr)                              { TYPE* result = (TYPE*)_back_##NAME(this, ptr, 1); _update_##NAME(this); return result; }\
 static TYPE* _find_##NAME(ch_vector_##NAME##_t* this, TYPE* begin, TYPE* end, TYPE value)       { TYPE* result = (TYPE*) vector_find(this->_vector, (void*)begin, (void*)end, &value); _update_##NAME(this); return result; }\
 static int _get_idx_##NAME(ch_vector_##NAME##_t* this, TYPE* value)                          { return vector_get_idx(this->_vector, value); }\
-static void _sort_##NAME(ch_vector_##NAME##_t* this)                                        { vector_sort(this->_vector); _update_##NAME(this); }\
 static TYPE* _push_front_##NAME(ch_vector_##NAME##_t* this, TYPE value)                       { TYPE* result = (TYPE*) vector_push_front(this->_vector, &value); _update_##NAME(this); return result; }\
 static TYPE* _push_back_##NAME(ch_vector_##NAME##_t* this, TYPE value)                        { TYPE* result = (TYPE*) vector_push_back(this->_vector, &value); _update_##NAME(this); return result; }\
 static TYPE* _insert_after_##NAME(ch_vector_##NAME##_t* this, TYPE* ptr, TYPE value)           { TYPE* result = (TYPE*) vector_insert_after(this->_vector, ptr, &value); _update_##NAME(this); return result; }\
 static TYPE* _insert_before_##NAME(ch_vector_##NAME##_t* this, TYPE* ptr, TYPE value)          { TYPE* result = (TYPE*) vector_insert_before(this->_vector, ptr, &value); _update_##NAME(this); return result; }\
 static TYPE* _remove_##NAME(ch_vector_##NAME##_t* this, TYPE* ptr)                            { TYPE* result = (TYPE*) vector_remove(this->_vector, ptr); _update_##NAME(this); return result; }\
+static ch_word _remove_if_##NAME(ch_vector_##NAME##_t* this, ch_bool (*pred)(TYPE* value, void* arg), void* arg) { ch_word result = vector_remove_if(this->_vector, (ch_vector_pred_f)pred, arg); _update_##NAME(this); return result; }\
+static TYPE* _erase_range_##NAME(ch_vector_##NAME##_t* this, TYPE* first, TYPE* last)          { TYPE* result = (TYPE*) vector_erase_range(this->_vector, first, last); _update_##NAME(this); return result; }\
+static ch_word _compact_##NAME(ch_vector_##NAME##_t* this, const ch_byte* mask)             { ch_word result = vector_compact(this->_vector, mask); _update_##NAME(this); return result; }\
 static void _pop_front_##NAME(ch_vector_##NAME##_t* this)                                   { vector_pop_front(this->_vector); _update_##NAME(this); }\
 static void _pop_back_##NAME(ch_vector_##NAME##_t* this)                                    { vector_pop_back(this->_vector); _update_##NAME(this); }\
 static void _clear_##NAME(ch_vector_##NAME##_t* this)                                       { vector_clear(this->_vector); _update_##NAME(this); }\
@@ -49,19 +174,24 @@ static void _delete_##NAME(ch_vector_##NAME##_t* this)\
     }\
 \
     free(this);\
-}\
-\
+}
+
+#define _define_ch_vector_new(NAME,TYPE,FIND,SORT_RADIX)\
 \
-ch_vector_##NAME##_t* ch_vector_##NAME##_new(ch_word size, ch_word (*cmp)(TYPE* lhs, TYPE* rhs) )\
+static ch_vector_##NAME##_t* _wrap_##NAME(ch_vector_t* vector, ch_word (*cmp)(TYPE* lhs, TYPE* rhs) )\
 {\
+    if(!vector){\
+        return ((void *)0);\
+    }\
 \
     ch_vector_##NAME##_t* result = (ch_vector_##NAME##_t*)calloc(1,sizeof(ch_vector_##NAME##_t));\
     if(!result){\
         printf("Could not allocate memory for new vector structure. Giving upn");\
+        vector_delete(vector);\
         return ((void *)0);\
     }\
 \
-    result->_vector = ch_vector_new(size, sizeof(TYPE), (cmp_void_f)cmp );\
+    result->_vector = vector;\
 \
 \
     /*We have memory to play with, now do all the other assignments*/\
@@ -73,7 +203,7 @@ ch_vector_##NAME##_t* ch_vector_##NAME##_new(ch_word size, ch_word (*cmp)(TYPE*
     result->prev                    = _prev_##NAME;\
     result->forward                 = _forward_##NAME;\
     result->back                    = _back_##NAME;\
-    result->find                    = _find_##NAME;\
+    result->find                    = FIND;\
     result->sort                    = _sort_##NAME;\
     result->push_front              = _push_front_##NAME;\
     result->pop_front               = _pop_front_##NAME;\
@@ -82,22 +212,40 @@ ch_vector_##NAME##_t* ch_vector_##NAME##_new(ch_word size, ch_word (*cmp)(TYPE*
     result->insert_after            = _insert_after_##NAME;\
     result->insert_before           = _insert_before_##NAME;\
     result->remove                  = _remove_##NAME;\
+    result->remove_if               = _remove_if_##NAME;\
+    result->erase_range             = _erase_range_##NAME;\
+    result->compact                 = _compact_##NAME;\
     result->push_back_carray        = _push_back_carray_##NAME;\
     result->clear                   = _clear_##NAME;\
     result->delete                  = _delete_##NAME;\
+    result->sort_radix              = SORT_RADIX;\
 \
 \
 \
     /*Fail hard and early if the compare function is NULL*/\
     if(cmp){\
         result->eq                      = _eq_##NAME;\
-        result->find                    = _find_##NAME;\
+        result->find                    = FIND;\
         result->sort                    = _sort_##NAME;\
+        result->sort_parallel           = _sort_parallel_##NAME;\
+        result->lower_bound             = _lower_bound_##NAME;\
+        result->upper_bound             = _upper_bound_##NAME;\
+        result->equal_range             = _equal_range_##NAME;\
     }\
 \
     _update_##NAME(result);\
 \
     return result;\
+}\
+\
+ch_vector_##NAME##_t* ch_vector_##NAME##_new(ch_word size, ch_word (*cmp)(TYPE* lhs, TYPE* rhs) )\
+{\
+    return _wrap_##NAME(ch_vector_new(size, sizeof(TYPE), (cmp_void_f)cmp ), cmp);\
+}\
+\
+ch_vector_##NAME##_t* ch_vector_##NAME##_new_reserved(ch_word size, ch_word max_size, ch_word (*cmp)(TYPE* lhs, TYPE* rhs) )\
+{\
+    return _wrap_##NAME(ch_vector_new_reserved(size, max_size, sizeof(TYPE), (cmp_void_f)cmp ), cmp);\
 }
 
 //Regular comparison function
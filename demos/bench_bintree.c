@@ -0,0 +1,144 @@
+/*
+ * bench_bintree.c
+ *
+ * Compare the B+-tree bintree against a pointer-per-node binary tree (the glibc tsearch() red-black tree) for inserts,
+ * random lookups and an ordered walk over every key. Then compare pushing sorted keys one at a time against building
+ * the tree from them in bulk.
+ *
+ * Usage: bench_bintree [count] [lookups]
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include "../data_structs/binary_tree/binary_tree.h"
+
+#include <search.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int cmp_i64(const void* lhs, const void* rhs)
+{
+    const i64 l = *(const i64*)lhs, r = *(const i64*)rhs;
+    return l < r ? -1 : l > r;
+}
+
+static i64 walk_sum = 0;
+static void walk_action(const void* node, VISIT which, int depth)
+{
+    (void)depth;
+    if(which == postorder || which == leaf){
+        walk_sum += **(const i64* const*)node;
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    const ch_word count   = argc > 1 ? strtoll(argv[1], NULL, 10) : 10 * 1000 * 1000;
+    const ch_word lookups = argc > 2 ? strtoll(argv[2], NULL, 10) : 10 * 1000 * 1000;
+
+    //Distinct keys, in a scattered order
+    i64* keys = (i64*)malloc(count * sizeof(i64));
+    for(ch_word i = 0; i < count; i++){
+        keys[i] = 2 * i;
+    }
+    u64 x = 88172645463325252ULL;
+    for(ch_word i = count - 1; i > 0; i--){
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        const ch_word j = x % (i + 1);
+        const i64 tmp = keys[i]; keys[i] = keys[j]; keys[j] = tmp;
+    }
+
+    i64* probes = (i64*)malloc(lookups * sizeof(i64));
+    for(ch_word i = 0; i < lookups; i++){
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        probes[i] = 2 * (x % count);
+    }
+
+    printf("%lli random i64 keys, %lli random lookups\n", count, lookups);
+    printf("             insert         lookup         walk\n");
+
+    //Red-black tree, one malloc()ed node per key, pointing into keys[]
+    void* root = NULL;
+    double start = now();
+    for(ch_word i = 0; i < count; i++){
+        tsearch(&keys[i], &root, cmp_i64);
+    }
+    const double rb_insert = now() - start;
+
+    ch_word check = 0;
+    start = now();
+    for(ch_word i = 0; i < lookups; i++){
+        check += **(i64**)tfind(&probes[i], &root, cmp_i64);
+    }
+    const double rb_lookup = now() - start;
+
+    start = now();
+    twalk(root, walk_action);
+    const double rb_walk = now() - start;
+    printf("tsearch   %8.1fns/key %8.1fns/lookup %8.1fns/key\n", rb_insert * 1e9 / count, rb_lookup * 1e9 / lookups,
+           rb_walk * 1e9 / count);
+
+    //B+-tree
+    ch_bintree_t* bt = ch_bintree_new_i64(sizeof(i64));
+    start = now();
+    for(ch_word i = 0; i < count; i++){
+        bintree_push(bt, &keys[i]);
+    }
+    const double bt_insert = now() - start;
+
+    start = now();
+    for(ch_word i = 0; i < lookups; i++){
+        check -= *(i64*)bintree_find(bt, &probes[i]).value;
+    }
+    const double bt_lookup = now() - start;
+
+    start = now();
+    CH_BINTREE_FOREACH(bt, it){
+        walk_sum -= *(i64*)it.value;
+    }
+    const double bt_walk = now() - start;
+    printf("bintree   %8.1fns/key %8.1fns/lookup %8.1fns/key\n", bt_insert * 1e9 / count, bt_lookup * 1e9 / lookups,
+           bt_walk * 1e9 / count);
+    printf("speedup   %8.2fx       %8.2fx          %8.2fx\n", rb_insert / bt_insert, rb_lookup / bt_lookup,
+           rb_walk / bt_walk);
+
+    printf("%s\n", check || walk_sum ? "MISMATCH!" : "Results agree");
+
+    for(ch_word i = 0; i < count; i++){
+        tdelete(&keys[i], &root, cmp_i64);
+    }
+
+    //Building from keys that are already in order
+    for(ch_word i = 0; i < count; i++){
+        keys[i] = 2 * i;
+    }
+
+    bintree_pop_all(bt);
+    start = now();
+    for(ch_word i = 0; i < count; i++){
+        bintree_push(bt, &keys[i]);
+    }
+    const double push_time = now() - start;
+
+    start = now();
+    bintree_build_sorted(bt, keys, count);
+    const double build_time = now() - start;
+    printf("sorted    %8.1fns/key pushed, %8.1fns/key built (%5.2fx)\n", push_time * 1e9 / count,
+           build_time * 1e9 / count, push_time / build_time);
+
+    bintree_delete(bt);
+    free(probes);
+    free(keys);
+    return 0;
+}
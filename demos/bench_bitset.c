@@ -0,0 +1,133 @@
+/*
+ * bench_bitset.c
+ *
+ * Compare the bitset against a plain array of ch_bool flags, one byte per id, for the usual filtering operations:
+ * intersecting two sets, counting the members, and walking the members of a sparse set. Then time rank and select
+ * with the rank index.
+ *
+ * Usage: bench_bitset [ids]
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include "../data_structs/bitset/bitset.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static u64 x = 88172645463325252ULL;
+static u64 next_rand(void)
+{
+    x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+    return x;
+}
+
+
+int main(int argc, char** argv)
+{
+    const ch_word ids = argc > 1 ? strtoll(argv[1], NULL, 10) : 100 * 1000 * 1000;
+
+    //A dense set (half of the ids) and a sparse set (1 in 100)
+    ch_bool* dense_flags  = (ch_bool*)calloc(ids, sizeof(ch_bool));
+    ch_bool* sparse_flags = (ch_bool*)calloc(ids, sizeof(ch_bool));
+    ch_bitset_t* dense  = ch_bitset_new(ids);
+    ch_bitset_t* sparse = ch_bitset_new(ids);
+    for(ch_word i = 0; i < ids; i++){
+        const u64 r = next_rand();
+        if(r & 1){
+            dense_flags[i] = 1;
+            bitset_set(dense, i);
+        }
+        if(r % 100 == 1){
+            sparse_flags[i] = 1;
+            bitset_set(sparse, i);
+        }
+    }
+
+    printf("%lli ids, %lliMB of flags vs %lliMB of bits\n", ids, ids * (ch_word)sizeof(ch_bool) >> 20, ids / 8 >> 20);
+    printf("             and            count          walk sparse\n");
+
+    //Flags
+    double start = now();
+    for(ch_word i = 0; i < ids; i++){
+        dense_flags[i] &= sparse_flags[i];
+    }
+    const double flags_and = now() - start;
+
+    ch_word flags_count = 0;
+    start = now();
+    for(ch_word i = 0; i < ids; i++){
+        flags_count += dense_flags[i];
+    }
+    const double flags_popcount = now() - start;
+
+    ch_word flags_walk = 0;
+    start = now();
+    for(ch_word i = 0; i < ids; i++){
+        if(sparse_flags[i]){
+            flags_walk += i;
+        }
+    }
+    const double flags_walk_time = now() - start;
+    printf("flags     %8.2fms      %8.2fms      %8.2fms\n", flags_and * 1e3, flags_popcount * 1e3,
+           flags_walk_time * 1e3);
+
+    //Bits
+    start = now();
+    bitset_and(dense, sparse);
+    const double bits_and = now() - start;
+
+    start = now();
+    const ch_word bits_count = bitset_count(dense);
+    const double bits_popcount = now() - start;
+
+    ch_word bits_walk = 0;
+    start = now();
+    CH_BITSET_FOREACH(sparse, idx){
+        bits_walk += idx;
+    }
+    const double bits_walk_time = now() - start;
+    printf("bitset    %8.2fms      %8.2fms      %8.2fms\n", bits_and * 1e3, bits_popcount * 1e3, bits_walk_time * 1e3);
+    printf("speedup   %8.2fx       %8.2fx       %8.2fx\n", flags_and / bits_and, flags_popcount / bits_popcount,
+           flags_walk_time / bits_walk_time);
+
+    printf("%s\n", flags_count != bits_count || flags_walk != bits_walk ? "MISMATCH!" : "Results agree");
+
+    //Rank and select over the sparse set
+    const ch_word lookups = 10 * 1000 * 1000;
+    start = now();
+    bitset_build_rank(sparse);
+    const double build_time = now() - start;
+
+    const ch_word members = bitset_count(sparse);
+    ch_word check = 0;
+    start = now();
+    for(ch_word i = 0; i < lookups; i++){
+        check += bitset_rank(sparse, next_rand() % ids);
+    }
+    const double rank_time = now() - start;
+
+    start = now();
+    for(ch_word i = 0; i < lookups && members; i++){
+        check += bitset_select(sparse, next_rand() % members);
+    }
+    const double select_time = now() - start;
+    printf("rank index built in %.2fms, %.1fns/rank, %.1fns/select (%lli)\n", build_time * 1e3,
+           rank_time * 1e9 / lookups, select_time * 1e9 / lookups, check & 1);
+
+    bitset_delete(sparse);
+    bitset_delete(dense);
+    free(sparse_flags);
+    free(dense_flags);
+    return 0;
+}
@@ -0,0 +1,132 @@
+/*
+ * bench_cbq.c
+ *
+ * Pass messages from one producer thread to one consumer thread through a ch_cbq_t, first with the queue wrapped in a
+ * mutex, then through a queue in SPSC mode with no lock at all. Both sides yield the CPU when the queue is full (or
+ * empty), so that the benchmark still makes progress with fewer cores than threads.
+ *
+ * Usage: bench_cbq [messages] [queue size]
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include "../data_structs/circular_queue/circular_queue.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static ch_word messages = 0;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+
+static void* locked_producer(void* arg)
+{
+    ch_cbq_t* q = arg;
+    for(i64 i = 0; i < messages; ){
+        pthread_mutex_lock(&lock);
+        const ch_bool pushed = cbq_push_back(q, &i) != NULL;
+        pthread_mutex_unlock(&lock);
+        if(pushed){
+            i++;
+        }
+        else{
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static i64 locked_consumer(ch_cbq_t* q)
+{
+    i64 sum = 0;
+    for(ch_word i = 0; i < messages; ){
+        pthread_mutex_lock(&lock);
+        const i64* value = cbq_peek_front(q);
+        if(value){
+            sum += *value;
+            cbq_pop_front(q);
+            i++;
+        }
+        pthread_mutex_unlock(&lock);
+        if(!value){
+            sched_yield();
+        }
+    }
+    return sum;
+}
+
+static void* spsc_producer(void* arg)
+{
+    ch_cbq_t* q = arg;
+    for(i64 i = 0; i < messages; ){
+        if(cbq_push_back(q, &i)){
+            i++;
+        }
+        else{
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static i64 spsc_consumer(ch_cbq_t* q)
+{
+    i64 sum = 0;
+    for(ch_word i = 0; i < messages; ){
+        const i64* value = cbq_peek_front(q);
+        if(value){
+            sum += *value;
+            cbq_pop_front(q);
+            i++;
+        }
+        else{
+            sched_yield();
+        }
+    }
+    return sum;
+}
+
+
+int main(int argc, char** argv)
+{
+    messages = argc > 1 ? strtoll(argv[1], NULL, 10) : 10 * 1000 * 1000;
+    const ch_word size = argc > 2 ? strtoll(argv[2], NULL, 10) : 1024;
+    const i64 expected = messages * (messages - 1) / 2;
+
+    printf("%lli i64 messages through a %lli slot queue\n", messages, size);
+
+    ch_cbq_t* q = ch_cbq_new(size, sizeof(i64));
+    pthread_t thread;
+    double start = now();
+    pthread_create(&thread, NULL, locked_producer, q);
+    const i64 locked_sum = locked_consumer(q);
+    pthread_join(thread, NULL);
+    const double locked_time = now() - start;
+    cbq_delete(q);
+    printf("mutex     %8.1fns/msg %8.2fM msgs/s\n", locked_time * 1e9 / messages, messages / locked_time / 1e6);
+
+    q = ch_cbq_new_spsc(size, sizeof(i64));
+    start = now();
+    pthread_create(&thread, NULL, spsc_producer, q);
+    const i64 spsc_sum = spsc_consumer(q);
+    pthread_join(thread, NULL);
+    const double spsc_time = now() - start;
+    cbq_delete(q);
+    printf("spsc      %8.1fns/msg %8.2fM msgs/s\n", spsc_time * 1e9 / messages, messages / spsc_time / 1e6);
+    printf("speedup   %8.2fx\n", locked_time / spsc_time);
+
+    printf("%s\n", locked_sum != expected || spsc_sum != expected ? "MISMATCH!" : "Results agree");
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * bench_heap.c
+ *
+ * Compare the 4-ary heap against an ordered linked list (llist_insert_inorder() and llist_pop_front()) as a priority
+ * queue. Both queues are filled, then put through the "hold" model used for event queues: pop the top event, then push
+ * it back with a later time, so that the queue size stays fixed. Then compare building the heap with pushes against
+ * heapify.
+ *
+ * Usage: bench_heap [queue size] [operations]
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include "../data_structs/heap/heap.h"
+#include "../data_structs/linked_list/linked_list.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int cmp_i64(const void* lhs, const void* rhs)
+{
+    const i64 l = *(const i64*)lhs, r = *(const i64*)rhs;
+    return l < r ? -1 : l > r;
+}
+
+
+int main(int argc, char** argv)
+{
+    const ch_word size = argc > 1 ? strtoll(argv[1], NULL, 10) : 10 * 1000;
+    const ch_word ops  = argc > 2 ? strtoll(argv[2], NULL, 10) : 50 * 1000;
+
+    //Start times, and the increments used to reschedule the events
+    i64* times = (i64*)malloc(size * sizeof(i64));
+    i64* steps = (i64*)malloc(ops * sizeof(i64));
+    u64 x = 88172645463325252ULL;
+    for(ch_word i = 0; i < size; i++){
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        times[i] = x % (size * 16);
+    }
+    for(ch_word i = 0; i < ops; i++){
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        steps[i] = x % (size * 16);
+    }
+
+    printf("Queue of %lli i64 events, %lli hold operations\n", size, ops);
+    printf("             fill           hold\n");
+
+    //Ordered linked list
+    ch_llist_t* list = ch_llist_new(sizeof(i64), cmp_i64);
+    double start = now();
+    for(ch_word i = 0; i < size; i++){
+        llist_insert_inorder(list, &times[i]);
+    }
+    const double list_fill = now() - start;
+
+    i64 check = 0;
+    start = now();
+    for(ch_word i = 0; i < ops; i++){
+        i64 time = *(i64*)llist_first(list).value;
+        check += time;
+        llist_pop_front(list);
+        time += steps[i];
+        llist_insert_inorder(list, &time);
+    }
+    const double list_hold = now() - start;
+    printf("llist     %8.1fns/push %8.1fns/op\n", list_fill * 1e9 / size, list_hold * 1e9 / ops);
+
+    //4-ary heap
+    ch_heap_t* heap = ch_heap_new(size, sizeof(i64), cmp_i64);
+    start = now();
+    for(ch_word i = 0; i < size; i++){
+        heap_push(heap, &times[i]);
+    }
+    const double heap_fill = now() - start;
+
+    start = now();
+    for(ch_word i = 0; i < ops; i++){
+        i64 time;
+        heap_pop(heap, &time);
+        check -= time;
+        time += steps[i];
+        heap_push(heap, &time);
+    }
+    const double heap_hold = now() - start;
+    printf("heap      %8.1fns/push %8.1fns/op\n", heap_fill * 1e9 / size, heap_hold * 1e9 / ops);
+    printf("speedup   %8.2fx       %8.2fx\n", list_fill / heap_fill, list_hold / heap_hold);
+
+    printf("%s\n", check ? "MISMATCH!" : "Results agree");
+
+    //Building the heap in one go
+    heap_clear(heap);
+    start = now();
+    for(ch_word i = 0; i < size; i++){
+        heap_push(heap, &times[i]);
+    }
+    const double push_time = now() - start;
+
+    start = now();
+    heap_heapify(heap, times, size);
+    const double heapify_time = now() - start;
+    printf("build     %8.1fns/key pushed, %8.1fns/key heapified (%5.2fx)\n", push_time * 1e9 / size,
+           heapify_time * 1e9 / size, push_time / heapify_time);
+
+    heap_delete(heap);
+    llist_delete(list);
+    free(steps);
+    free(times);
+    return 0;
+}
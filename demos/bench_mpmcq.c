@@ -0,0 +1,178 @@
+/*
+ * bench_mpmcq.c
+ *
+ * Pass messages from P producer threads to C consumer threads, for a range of P and C, through a ch_cbq_t wrapped in a
+ * mutex, through the MPMC queue one message at a time, and through the MPMC queue in batches. All threads yield the CPU
+ * when the queue is full (or empty), so that the benchmark still makes progress with fewer cores than threads.
+ *
+ * Usage: bench_mpmcq [messages] [queue size]
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include "../data_structs/mpmc_queue/mpmc_queue.h"
+#include "../data_structs/circular_queue/circular_queue.h"
+#include "../utils/util.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BATCH 16
+#define MAX_THREADS 8
+
+typedef enum { MODE_MUTEX, MODE_SINGLE, MODE_BATCH } mode_e;
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static mode_e mode;
+static ch_cbq_t* cbq;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static ch_mpmcq_t* mpmcq;
+static ch_word per_producer;
+static ch_word remaining;
+static i64 total;
+
+
+static ch_word push(i64* values, ch_word count)
+{
+    switch(mode){
+        case MODE_MUTEX:{
+            pthread_mutex_lock(&lock);
+            const ch_bool pushed = cbq_push_back(cbq, values) != NULL;
+            pthread_mutex_unlock(&lock);
+            return pushed;
+        }
+        case MODE_SINGLE:   return mpmcq_try_push(mpmcq, values) == 0;
+        case MODE_BATCH:    return mpmcq_try_push_carray(mpmcq, values, count);
+    }
+    return 0;
+}
+
+static ch_word pop(i64* values)
+{
+    switch(mode){
+        case MODE_MUTEX:{
+            pthread_mutex_lock(&lock);
+            const i64* value = cbq_peek_front(cbq);
+            if(value){
+                values[0] = *value;
+                cbq_pop_front(cbq);
+            }
+            pthread_mutex_unlock(&lock);
+            return value != NULL;
+        }
+        case MODE_SINGLE:   return mpmcq_try_pop(mpmcq, values) == 0;
+        case MODE_BATCH:    return mpmcq_try_pop_carray(mpmcq, values, BATCH);
+    }
+    return 0;
+}
+
+static void* producer(void* arg)
+{
+    (void)arg;
+    i64 values[BATCH];
+    for(i64 i = 0; i < per_producer; ){
+        const ch_word count = MIN(BATCH, per_producer - i);
+        for(ch_word j = 0; j < count; j++){
+            values[j] = i + j;
+        }
+
+        const ch_word pushed = push(values, count);
+        i += pushed;
+        if(!pushed){
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void* consumer(void* arg)
+{
+    (void)arg;
+    i64 values[BATCH];
+    i64 sum = 0;
+    while(__atomic_load_n(&remaining, __ATOMIC_RELAXED) > 0){
+        const ch_word popped = pop(values);
+        if(!popped){
+            sched_yield();
+            continue;
+        }
+
+        for(ch_word i = 0; i < popped; i++){
+            sum += values[i];
+        }
+        __atomic_sub_fetch(&remaining, popped, __ATOMIC_RELAXED);
+    }
+
+    __atomic_add_fetch(&total, sum, __ATOMIC_RELAXED);
+    return NULL;
+}
+
+//Run one configuration, return the time taken
+static double run(ch_word producers, ch_word consumers, ch_word messages)
+{
+    pthread_t threads[2 * MAX_THREADS];
+    per_producer = messages / producers;
+    remaining = per_producer * producers;
+
+    const double start = now();
+    for(ch_word i = 0; i < consumers; i++){
+        pthread_create(&threads[i], NULL, consumer, NULL);
+    }
+    for(ch_word i = 0; i < producers; i++){
+        pthread_create(&threads[consumers + i], NULL, producer, NULL);
+    }
+    for(ch_word i = 0; i < producers + consumers; i++){
+        pthread_join(threads[i], NULL);
+    }
+    return now() - start;
+}
+
+
+int main(int argc, char** argv)
+{
+    const ch_word messages = argc > 1 ? strtoll(argv[1], NULL, 10) : 4 * 1000 * 1000;
+    const ch_word size     = argc > 2 ? strtoll(argv[2], NULL, 10) : 1024;
+
+    const ch_word configs[][2] = { {1,1}, {2,2}, {4,4}, {1,4}, {4,1}, {8,8} };
+    const ch_word config_count = sizeof(configs) / sizeof(configs[0]);
+
+    printf("%lli i64 messages through a %lli slot queue\n", messages, size);
+    printf("P x C     mutex cbq      mpmcq          mpmcq batch %i\n", BATCH);
+
+    ch_bool agree = true;
+    for(ch_word c = 0; c < config_count; c++){
+        const ch_word producers = configs[c][0];
+        const ch_word consumers = configs[c][1];
+        const ch_word sent = messages / producers * producers;
+        const i64 expected = producers * ((messages / producers) * (messages / producers - 1) / 2);
+
+        double times[3];
+        for(ch_word m = MODE_MUTEX; m <= MODE_BATCH; m++){
+            mode = (mode_e)m;
+            cbq = ch_cbq_new(size, sizeof(i64));
+            mpmcq = ch_mpmcq_new(size, sizeof(i64));
+            total = 0;
+            times[m] = run(producers, consumers, messages);
+            agree = agree && total == expected;
+            mpmcq_delete(mpmcq);
+            cbq_delete(cbq);
+        }
+
+        printf("%lli x %lli     %8.1fns/msg %8.1fns/msg %8.1fns/msg\n", producers, consumers,
+               times[MODE_MUTEX] * 1e9 / sent, times[MODE_SINGLE] * 1e9 / sent, times[MODE_BATCH] * 1e9 / sent);
+    }
+
+    printf("%s\n", agree ? "Results agree" : "MISMATCH!");
+    return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * bench_search.c
+ *
+ * Compare bsearch() against the branchless lower_bound and the Eytzinger index for random lookups in a sorted array.
+ *
+ * Usage: bench_search [count] [lookups]
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include "../data_structs/vector/vector_std.h"
+#include "../data_structs/eytzinger/eytzinger.h"
+#include "../data_structs/array/array_sort_template.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+define_ch_eytzinger_search(bench_u64, u64, CH_SORT_LT)
+
+static int cmp_u64(const void* lhs, const void* rhs)
+{
+    const u64 l = *(const u64*)lhs, r = *(const u64*)rhs;
+    return l < r ? -1 : l > r;
+}
+
+
+int main(int argc, char** argv)
+{
+    const ch_word count   = argc > 1 ? strtoll(argv[1], NULL, 10) : 64 * 1000 * 1000;
+    const ch_word lookups = argc > 2 ? strtoll(argv[2], NULL, 10) : 10 * 1000 * 1000;
+
+    ch_vector_u64_t* v = ch_vector_u64_new(count, CH_VECTOR_CMP(u64));
+    for(ch_word i = 0; i < count; i++){
+        v->push_back(v, 2 * i);
+    }
+
+    u64* keys = (u64*)malloc(lookups * sizeof(u64));
+    u64 x = 88172645463325252ULL;
+    for(ch_word i = 0; i < lookups; i++){
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        keys[i] = 2 * (x % count);
+    }
+
+    printf("%lli random lookups in %lli sorted u64 elements\n", lookups, count);
+
+    ch_word check = 0;
+    double start = now();
+    for(ch_word i = 0; i < lookups; i++){
+        check += (u64*)bsearch(&keys[i], v->first, v->count, sizeof(u64), cmp_u64) - v->first;
+    }
+    const double bsearch_time = now() - start;
+    printf("bsearch      %8.3fs %8.1fns/lookup\n", bsearch_time, bsearch_time * 1e9 / lookups);
+
+    start = now();
+    for(ch_word i = 0; i < lookups; i++){
+        check -= v->lower_bound(v, keys[i]) - v->first;
+    }
+    const double bound_time = now() - start;
+    printf("lower_bound  %8.3fs %8.1fns/lookup (%5.2fx)\n", bound_time, bound_time * 1e9 / lookups,
+           bsearch_time / bound_time);
+
+    ch_eytzinger_t* e = ch_eytzinger_new(v->first, v->count, sizeof(u64), cmp_u64);
+    start = now();
+    for(ch_word i = 0; i < lookups; i++){
+        check += eytzinger_lower_bound(e, &keys[i]);
+    }
+    const double eytz_cmp_time = now() - start;
+    printf("eytzinger    %8.3fs %8.1fns/lookup (%5.2fx) comparator\n", eytz_cmp_time, eytz_cmp_time * 1e9 / lookups,
+           bsearch_time / eytz_cmp_time);
+
+    start = now();
+    for(ch_word i = 0; i < lookups; i++){
+        check -= bench_u64_lower_bound(e, keys[i]);
+    }
+    const double eytz_time = now() - start;
+    printf("eytzinger    %8.3fs %8.1fns/lookup (%5.2fx) inlined\n", eytz_time, eytz_time * 1e9 / lookups,
+           bsearch_time / eytz_time);
+
+    printf("%s\n", check ? "MISMATCH!" : "Results agree");
+
+    eytzinger_delete(e);
+    free(keys);
+    v->delete(v);
+    return 0;
+}
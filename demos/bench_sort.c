@@ -0,0 +1,166 @@
+/*
+ * bench_sort.c
+ *
+ * Compare qsort() against the typed introsort and radix sort for the standard vector types, and against the key plus
+ * payload radix sort for an array of structures.
+ *
+ * Usage: bench_sort [count]
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include "../data_structs/vector/vector_std.h"
+#include "../data_structs/array/array.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+static u64 xorshift_state = 88172645463325252ULL;
+static inline u64 xorshift64(void)
+{
+    xorshift_state ^= xorshift_state << 13;
+    xorshift_state ^= xorshift_state >> 7;
+    xorshift_state ^= xorshift_state << 17;
+    return xorshift_state;
+}
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int cmp_u64(const void* lhs, const void* rhs)
+{
+    const u64 l = *(const u64*)lhs, r = *(const u64*)rhs;
+    return l < r ? -1 : l > r;
+}
+
+static int cmp_i64(const void* lhs, const void* rhs)
+{
+    const i64 l = *(const i64*)lhs, r = *(const i64*)rhs;
+    return l < r ? -1 : l > r;
+}
+
+static int cmp_u32(const void* lhs, const void* rhs)
+{
+    const u32 l = *(const u32*)lhs, r = *(const u32*)rhs;
+    return l < r ? -1 : l > r;
+}
+
+static int cmp_float(const void* lhs, const void* rhs)
+{
+    const ch_float l = *(const ch_float*)lhs, r = *(const ch_float*)rhs;
+    return l < r ? -1 : l > r;
+}
+
+typedef struct {
+    u64 key;
+    u64 payload[3];
+} record_t;
+
+static int cmp_record(const void* lhs, const void* rhs)
+{
+    return cmp_u64(&((const record_t*)lhs)->key, &((const record_t*)rhs)->key);
+}
+
+
+#define BENCH_TYPE(NAME, TYPE, CMP, GEN)\
+static void bench_##NAME(ch_word count)\
+{\
+    ch_vector_##NAME##_t* vq = ch_vector_##NAME##_new(count, CH_VECTOR_CMP(NAME));\
+    ch_vector_##NAME##_t* vi = ch_vector_##NAME##_new(count, CH_VECTOR_CMP(NAME));\
+    ch_vector_##NAME##_t* vr = ch_vector_##NAME##_new(count, CH_VECTOR_CMP(NAME));\
+    for(ch_word i = 0; i < count; i++){\
+        const TYPE value = (GEN);\
+        vq->push_back(vq, value);\
+        vi->push_back(vi, value);\
+        vr->push_back(vr, value);\
+    }\
+\
+    double start = now();\
+    qsort(vq->first, vq->count, sizeof(TYPE), CMP);\
+    const double qsort_time = now() - start;\
+\
+    start = now();\
+    vi->sort(vi);\
+    const double intro_time = now() - start;\
+\
+    start = now();\
+    vr->sort_radix(vr);\
+    const double radix_time = now() - start;\
+\
+    const int same = !memcmp(vq->first, vi->first, count * sizeof(TYPE)) &&\
+                     !memcmp(vq->first, vr->first, count * sizeof(TYPE));\
+    printf("%-8s qsort=%8.3fs introsort=%8.3fs (%5.2fx) radix=%8.3fs (%5.2fx) %s\n", #NAME,\
+           qsort_time, intro_time, qsort_time / intro_time, radix_time, qsort_time / radix_time,\
+           same ? "" : "MISMATCH!");\
+\
+    vq->delete(vq);\
+    vi->delete(vi);\
+    vr->delete(vr);\
+}
+
+BENCH_TYPE(u64,   u64,      cmp_u64,   xorshift64())
+BENCH_TYPE(i64,   i64,      cmp_i64,   (i64)xorshift64())
+BENCH_TYPE(u32,   u32,      cmp_u32,   (u32)xorshift64())
+BENCH_TYPE(float, ch_float, cmp_float, (ch_float)(i64)xorshift64() / 1e9)
+
+
+static void bench_records(ch_word count)
+{
+    record_t* rq = (record_t*)malloc(count * sizeof(record_t));
+    record_t* rr = (record_t*)malloc(count * sizeof(record_t));
+    if(!rq || !rr){
+        printf("Could not allocate memory for the record benchmark\n");
+        free(rq);
+        free(rr);
+        return;
+    }
+
+    for(ch_word i = 0; i < count; i++){
+        rq[i].key = xorshift64();
+        rq[i].payload[0] = rq[i].payload[1] = rq[i].payload[2] = (u64)i;
+    }
+    memcpy(rr, rq, count * sizeof(record_t));
+
+    double start = now();
+    qsort(rq, count, sizeof(record_t), cmp_record);
+    const double qsort_time = now() - start;
+
+    start = now();
+    ch_radix_sort_carray(rr, count, sizeof(record_t), offsetof(record_t, key), sizeof(u64), CH_RADIX_UNSIGNED);
+    const double radix_time = now() - start;
+
+    //qsort is not stable, so only the keys can be compared
+    int same = 1;
+    for(ch_word i = 0; i < count; i++){
+        same &= rq[i].key == rr[i].key;
+    }
+    printf("%-8s qsort=%8.3fs                               radix=%8.3fs (%5.2fx) %s\n", "record",
+           qsort_time, radix_time, qsort_time / radix_time, same ? "" : "MISMATCH!");
+
+    free(rq);
+    free(rr);
+}
+
+
+int main(int argc, char** argv)
+{
+    const ch_word count = argc > 1 ? strtoll(argv[1], NULL, 10) : 10 * 1000 * 1000;
+    printf("Sorting %lli random elements\n", count);
+
+    bench_u64(count);
+    bench_i64(count);
+    bench_u32(count);
+    bench_float(count);
+    bench_records(count);
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+/*
+ * bench_sort_parallel.c
+ *
+ * Report how parallel sorting scales with the number of threads, from 1 up to 64.
+ *
+ * Usage: bench_sort_parallel [count] [max threads]
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include "../data_structs/vector/vector_std.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void fill(ch_vector_u64_t* v, ch_word count)
+{
+    v->clear(v);
+    u64 x = 88172645463325252ULL;
+    for(ch_word i = 0; i < count; i++){
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        v->push_back(v, x);
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    const ch_word count       = argc > 1 ? strtoll(argv[1], NULL, 10) : 100 * 1000 * 1000;
+    const ch_word max_threads = argc > 2 ? strtoll(argv[2], NULL, 10) : 64;
+
+    ch_vector_u64_t* v = ch_vector_u64_new(count, CH_VECTOR_CMP(u64));
+    if(!v){
+        return 1;
+    }
+
+    printf("Sorting %lli random u64 elements\n", count);
+    printf("%8s %10s %12s %8s\n", "threads", "seconds", "Melem/s", "speedup");
+
+    double base_time = 0;
+    for(ch_word threads = 1; threads <= max_threads; threads *= 2){
+        fill(v, count);
+
+        const double start = now();
+        v->sort_parallel(v, threads);
+        const double time = now() - start;
+
+        for(u64* i = v->first; i < v->last; i++){
+            if(*i > *(i + 1)){
+                printf("Sort failed with %lli threads!\n", threads);
+                return 1;
+            }
+        }
+
+        if(threads == 1){
+            base_time = time;
+        }
+        printf("%8lli %10.3f %12.2f %7.2fx\n", threads, time, count / time / 1e6, base_time / time);
+    }
+
+    v->delete(v);
+    return 0;
+}
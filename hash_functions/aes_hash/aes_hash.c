@@ -0,0 +1,96 @@
+/*
+ * aes_hash.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include "aes_hash.h"
+#include "../../utils/cpu.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__)
+
+#include <wmmintrin.h>
+
+//Digits of pi, as nothing-up-my-sleeve key material
+#define AES_HASH_K0 0x243F6A8885A308D3ULL
+#define AES_HASH_K1 0x13198A2E03707344ULL
+#define AES_HASH_K2 0xA4093822299F31D0ULL
+#define AES_HASH_K3 0x082EFA98EC4E6C89ULL
+
+CH_TARGET("aes")
+static inline __m128i load_block(const u8* ptr)
+{
+    return _mm_loadu_si128((const __m128i*)ptr);
+}
+
+CH_TARGET("aes")
+static inline __m128i mix_block(__m128i state, __m128i block, __m128i key)
+{
+    return _mm_aesenc_si128(_mm_xor_si128(state, block), key);
+}
+
+CH_TARGET("aes")
+u64 ch_aes_hash64(const void* key, ch_word len, u64 seed)
+{
+    const u8* ptr = key;
+    ch_word remain = len;
+
+    //Fold the seed and the length into the keys so that zero padding of the tail can't produce collisions
+    const __m128i k0 = _mm_set_epi64x((long long)(seed ^ AES_HASH_K0), (long long)((u64)len ^ AES_HASH_K1));
+    const __m128i k1 = _mm_set_epi64x((long long)AES_HASH_K2, (long long)(seed ^ AES_HASH_K3));
+
+    __m128i a = k1;
+    __m128i b = k0;
+
+    for(; remain >= 32; remain -= 32, ptr += 32){
+        a = mix_block(a, load_block(ptr),      k0);
+        b = mix_block(b, load_block(ptr + 16), k1);
+    }
+
+    if(remain >= 16){
+        a = mix_block(a, load_block(ptr), k0);
+        remain -= 16;
+        ptr    += 16;
+    }
+
+    if(remain > 0){
+        u8 tail[16] = { 0 };
+        memcpy(tail, ptr, remain);
+        b = mix_block(b, load_block(tail), k1);
+    }
+
+    //Finalise, three rounds is enough for every input bit to affect every output bit
+    __m128i x = _mm_aesenc_si128(a, b);
+    x = _mm_aesenc_si128(x, k0);
+    x = _mm_aesenc_si128(x, k1);
+
+    return (u64)_mm_cvtsi128_si64(x) ^ (u64)_mm_cvtsi128_si64(_mm_unpackhi_epi64(x, x));
+}
+
+ch_bool ch_aes_hash_available(void)
+{
+    return ch_cpu_has(CH_CPU_AES | CH_CPU_SSE2);
+}
+
+#else
+
+u64 ch_aes_hash64(const void* key, ch_word len, u64 seed)
+{
+    (void)key;
+    (void)len;
+    (void)seed;
+    printf("%s:%s%u AES hashing is not available on this architecture!\n", __FUNCTION__, __FILE__, __LINE__ );
+    exit(1);
+}
+
+ch_bool ch_aes_hash_available(void)
+{
+    return false;
+}
+
+#endif
@@ -0,0 +1,24 @@
+/*
+ * aes_hash.h
+ *
+ * A fast, non-cryptographic 64bit hash built from AES-NI rounds. Each aesenc instruction does a full SubBytes /
+ * ShiftRows / MixColumns diffusion over 128 bits in a few cycles, so a handful of rounds gives good avalanche for very
+ * little work. Two independent lanes are used to hide the aesenc latency on long keys.
+ *
+ * NB: Only available on x86_64 machines with AES-NI. Use ch_aes_hash_available() to check before calling, or just use
+ * ch_hash64() in hash.h which does this for you.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef AES_HASH_H_
+#define AES_HASH_H_
+
+#include "../../types/types.h"
+
+ch_bool ch_aes_hash_available(void);
+
+u64 ch_aes_hash64(const void* key, ch_word len, u64 seed);
+
+#endif /* AES_HASH_H_ */
@@ -0,0 +1,150 @@
+/*
+ * crc32c.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include "crc32c.h"
+#include "../../utils/cpu.h"
+#include "../../utils/util.h"
+
+#include <string.h>
+
+#if defined(CH_ARCH_X86)
+#include <nmmintrin.h>
+#endif
+
+#define CRC32C_POLY_REFLECTED 0x82F63B78U
+
+//Slicing-by-8 tables. Built once at startup, before main() is called
+static u32 crc32c_table[8][256];
+
+__attribute__((constructor)) static void crc32c_init_tables(void)
+{
+    for(u32 n = 0; n < 256; n++){
+        u32 crc = n;
+        for(int k = 0; k < 8; k++){
+            crc = crc & 1 ? (crc >> 1) ^ CRC32C_POLY_REFLECTED : crc >> 1;
+        }
+        crc32c_table[0][n] = crc;
+    }
+
+    for(u32 n = 0; n < 256; n++){
+        u32 crc = crc32c_table[0][n];
+        for(int k = 1; k < 8; k++){
+            crc = crc32c_table[0][crc & 0xFF] ^ (crc >> 8);
+            crc32c_table[k][n] = crc;
+        }
+    }
+}
+
+
+static inline u64 load_u64(const u8* ptr)
+{
+    u64 result;
+    memcpy(&result, ptr, sizeof(result)); //Compiles to a single unaligned load
+    return result;
+}
+
+
+u32 ch_crc32c_update_u8_sw(u32 crc, u8 value)
+{
+    return crc32c_table[0][(crc ^ value) & 0xFF] ^ (crc >> 8);
+}
+
+
+u32 ch_crc32c_update_u64_sw(u32 crc, u64 value)
+{
+    const u64 x = crc ^ value;
+    return crc32c_table[7][ x        & 0xFF] ^
+           crc32c_table[6][(x >>  8) & 0xFF] ^
+           crc32c_table[5][(x >> 16) & 0xFF] ^
+           crc32c_table[4][(x >> 24) & 0xFF] ^
+           crc32c_table[3][(x >> 32) & 0xFF] ^
+           crc32c_table[2][(x >> 40) & 0xFF] ^
+           crc32c_table[1][(x >> 48) & 0xFF] ^
+           crc32c_table[0][ x >> 56        ];
+}
+
+
+u32 ch_crc32c_sw(u32 crc, const void* data, size_t len)
+{
+    const u8* ptr = data;
+    crc = ~crc;
+
+    for(; len >= 8; len -= 8, ptr += 8){
+        crc = ch_crc32c_update_u64_sw(crc, load_u64(ptr));
+    }
+
+    for(; len; len--, ptr++){
+        crc = ch_crc32c_update_u8_sw(crc, *ptr);
+    }
+
+    return ~crc;
+}
+
+
+#if defined(CH_ARCH_X86)
+
+CH_TARGET("sse4.2")
+u32 ch_crc32c_hw(u32 crc, const void* data, size_t len)
+{
+    const u8* ptr = data;
+    crc = ~crc;
+
+#if defined(__x86_64__)
+    u64 crc64 = crc;
+    for(; len >= 8; len -= 8, ptr += 8){
+        crc64 = _mm_crc32_u64(crc64, load_u64(ptr));
+    }
+    crc = (u32)crc64;
+#endif
+
+    for(; len >= 4; len -= 4, ptr += 4){
+        u32 word;
+        memcpy(&word, ptr, sizeof(word));
+        crc = _mm_crc32_u32(crc, word);
+    }
+
+    for(; len; len--, ptr++){
+        crc = _mm_crc32_u8(crc, *ptr);
+    }
+
+    return ~crc;
+}
+
+ch_bool ch_crc32c_hw_available(void)
+{
+    return ch_cpu_has(CH_CPU_SSE42);
+}
+
+#else
+
+//No hardware support on this architecture, quietly use the tables
+u32 ch_crc32c_hw(u32 crc, const void* data, size_t len)
+{
+    return ch_crc32c_sw(crc, data, len);
+}
+
+ch_bool ch_crc32c_hw_available(void)
+{
+    return false;
+}
+
+#endif
+
+
+//Pick the best implementation once, at startup
+static u32 (*crc32c_impl)(u32 crc, const void* data, size_t len) = ch_crc32c_sw;
+
+__attribute__((constructor)) static void crc32c_select_impl(void)
+{
+    crc32c_impl = ch_crc32c_hw_available() ? ch_crc32c_hw : ch_crc32c_sw;
+}
+
+
+u32 ch_crc32c(u32 crc, const void* data, size_t len)
+{
+    return crc32c_impl(crc, data, len);
+}
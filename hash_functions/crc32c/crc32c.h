@@ -0,0 +1,33 @@
+/*
+ * crc32c.h
+ *
+ * CRC32C (Castagnoli polynomial 0x1EDC6F41, as used by iSCSI, ext4, SCTP etc). Uses the SSE4.2 crc32 instruction where
+ * the CPU supports it and falls back to a portable slicing-by-8 table implementation otherwise. Both produce identical
+ * results, so CRCs are stable across machines and are suitable for on-disk / on-wire integrity checks.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef CRC32C_H_
+#define CRC32C_H_
+
+#include <stddef.h>
+#include "../../types/types.h"
+
+//Compute (or continue) the CRC32C of data. Start with crc = 0. To continue a CRC, pass in the previous result.
+//  e.g. ch_crc32c(0,"123456789",9) == 0xE3069283
+u32 ch_crc32c(u32 crc, const void* data, size_t len);
+
+//Explicit implementations, mostly useful for testing and benchmarking. The hardware version must only be called when
+//ch_crc32c_hw_available() returns true.
+u32 ch_crc32c_sw(u32 crc, const void* data, size_t len);
+u32 ch_crc32c_hw(u32 crc, const void* data, size_t len);
+ch_bool ch_crc32c_hw_available(void);
+
+//Raw CRC32C register updates (no pre/post inversion), with the same semantics as the SSE4.2 crc32 instruction. These are
+//the portable building blocks for CRC based hashing.
+u32 ch_crc32c_update_u8_sw(u32 crc, u8 value);
+u32 ch_crc32c_update_u64_sw(u32 crc, u64 value);
+
+#endif /* CRC32C_H_ */
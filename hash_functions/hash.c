@@ -0,0 +1,149 @@
+/*
+ * hash.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include "hash.h"
+#include "../utils/cpu.h"
+
+#include <string.h>
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
+//Second lane CRC seed, so that the two lanes never start in the same state
+#define CRC_LANE_B_SEED 0x9E3779B9U
+
+
+//Murmur3 finaliser. CRCs are linear, so scramble the combined lanes before handing them out
+static inline u64 fmix64(u64 k)
+{
+    k ^= k >> 33;
+    k *= 0xFF51AFD7ED558CCDULL;
+    k ^= k >> 33;
+    k *= 0xC4CEB9FE1A85EC53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+
+static inline u64 load_u64(const u8* ptr)
+{
+    u64 result;
+    memcpy(&result, ptr, sizeof(result));
+    return result;
+}
+
+
+static inline u64 load_tail(const u8* ptr, ch_word len)
+{
+    u64 result = 0;
+    memcpy(&result, ptr, len);
+    return result;
+}
+
+
+//Two independent CRC lanes over alternate 8 byte words. The crc32 instruction has a latency of 3 cycles but a
+//throughput of 1, so interleaving the lanes roughly doubles the speed over a single CRC.
+u64 ch_hash64_crc32c_sw(const void* key, ch_word len, u64 seed)
+{
+    const u8* ptr = key;
+    ch_word remain = len;
+    u32 a = (u32)seed;
+    u32 b = (u32)(seed >> 32) ^ CRC_LANE_B_SEED;
+
+    for(; remain >= 16; remain -= 16, ptr += 16){
+        a = ch_crc32c_update_u64_sw(a, load_u64(ptr));
+        b = ch_crc32c_update_u64_sw(b, load_u64(ptr + 8));
+    }
+
+    if(remain >= 8){
+        a = ch_crc32c_update_u64_sw(a, load_u64(ptr));
+        remain -= 8;
+        ptr    += 8;
+    }
+
+    if(remain > 0){
+        b = ch_crc32c_update_u64_sw(b, load_tail(ptr, remain));
+    }
+
+    return fmix64((((u64)a << 32) | b) ^ (u64)len);
+}
+
+
+#if defined(__x86_64__)
+
+CH_TARGET("sse4.2")
+u64 ch_hash64_crc32c_hw(const void* key, ch_word len, u64 seed)
+{
+    const u8* ptr = key;
+    ch_word remain = len;
+    u64 a = (u32)seed;
+    u64 b = (u32)(seed >> 32) ^ CRC_LANE_B_SEED;
+
+    for(; remain >= 16; remain -= 16, ptr += 16){
+        a = _mm_crc32_u64(a, load_u64(ptr));
+        b = _mm_crc32_u64(b, load_u64(ptr + 8));
+    }
+
+    if(remain >= 8){
+        a = _mm_crc32_u64(a, load_u64(ptr));
+        remain -= 8;
+        ptr    += 8;
+    }
+
+    if(remain > 0){
+        b = _mm_crc32_u64(b, load_tail(ptr, remain));
+    }
+
+    return fmix64(((a << 32) | (u32)b) ^ (u64)len);
+}
+
+#else
+
+u64 ch_hash64_crc32c_hw(const void* key, ch_word len, u64 seed)
+{
+    return ch_hash64_crc32c_sw(key, len, seed);
+}
+
+#endif
+
+
+u64 ch_hash64_spooky(const void* key, ch_word len, u64 seed)
+{
+    return spooky_Hash64(key, len, seed);
+}
+
+
+//Start with the portable version so that ch_hash64() is always safe to call, even from other constructors
+ch_hash64_f ch_hash64_impl = ch_hash64_spooky;
+static const char* ch_hash64_impl_name = "spooky";
+
+__attribute__((constructor)) static void ch_hash64_select_impl(void)
+{
+    if(ch_aes_hash_available()){
+        ch_hash64_impl      = ch_aes_hash64;
+        ch_hash64_impl_name = "aes";
+        return;
+    }
+
+#if defined(__x86_64__)
+    if(ch_crc32c_hw_available()){
+        ch_hash64_impl      = ch_hash64_crc32c_hw;
+        ch_hash64_impl_name = "crc32c";
+        return;
+    }
+#endif
+
+    ch_hash64_impl      = ch_hash64_spooky;
+    ch_hash64_impl_name = "spooky";
+}
+
+
+const char* ch_hash64_name(void)
+{
+    return ch_hash64_impl_name;
+}
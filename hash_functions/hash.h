@@ -0,0 +1,47 @@
+/*
+ * hash.h
+ *
+ * Unified front door to the hash functions. ch_hash64() is bound once at startup to the cheapest adequate
+ * implementation on this machine:
+ *
+ *   1) AES-NI hash (x86_64 with AES-NI)
+ *   2) Dual lane CRC32C hash using the SSE4.2 crc32 instruction
+ *   3) Spooky hash V2 (portable)
+ *
+ * NB: Because the implementation is chosen at runtime, ch_hash64() values may differ between machines. Use it for in
+ * memory structures (e.g. hash maps) only. For anything that is stored or sent over the wire, use one of the explicit
+ * functions below, or ch_crc32c() which gives identical results with or without hardware support.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef CH_HASH_H_
+#define CH_HASH_H_
+
+#include "../types/types.h"
+#include "crc32c/crc32c.h"
+#include "aes_hash/aes_hash.h"
+#include "spooky/spooky_hash.h"
+
+typedef u64 (*ch_hash64_f)(const void* key, ch_word len, u64 seed);
+
+//Bound at startup, do not assign to this directly
+extern ch_hash64_f ch_hash64_impl;
+
+//Hash len bytes of key with the best available implementation
+static inline u64 ch_hash64(const void* key, ch_word len, u64 seed)
+{
+    return ch_hash64_impl(key, len, seed);
+}
+
+//Return a human readable name for the implementation that ch_hash64() is using
+const char* ch_hash64_name(void);
+
+//Explicit implementations. The _hw and aes versions must only be used if the CPU supports them. The CRC32C _hw and _sw
+//versions produce identical results.
+u64 ch_hash64_crc32c_hw(const void* key, ch_word len, u64 seed);
+u64 ch_hash64_crc32c_sw(const void* key, ch_word len, u64 seed);
+u64 ch_hash64_spooky(const void* key, ch_word len, u64 seed);
+
+#endif /* CH_HASH_H_ */
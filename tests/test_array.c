@@ -5,7 +5,11 @@
 #include "../data_structs/array/array_std.h"
 #include "../utils/util.h"
 
+#include <stddef.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <unistd.h>
 
 
 
@@ -330,6 +334,338 @@ static i64 test12_i64(i64* test_data)
 
 
 
+/* Sorting with the standard comparator uses the inlined introsort, it must agree with qsort */
+static i64 test13_i64(i64* test_data)
+{
+    i64 result = 1;
+    (void)test_data;
+
+    const ch_word count = 100 * 1000;
+    ch_array_i64_t* al1 = ch_array_i64_new(count,CH_ARRAY_CMP(i64));
+    ch_array_i64_t* al2 = ch_array_i64_new(count,cmp_i64);
+
+    //Lots of duplicates, negative numbers and an already sorted run to poke at the pivot selection
+    u64 x = 88172645463325252ULL;
+    for(ch_word i = 0; i < count; i++){
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        const i64 value = i < count / 4 ? i : (i64)(x % 1000) - 500;
+        *al1->off(al1,i) = value;
+        *al2->off(al2,i) = value;
+    }
+
+    al1->sort(al1);
+    al2->sort(al2);
+
+    CH_ASSERT(al1->eq(al1,al2));
+    for(i64* i = al1->first; i < al1->last; i++){
+        CH_ASSERT(*i <= *(i+1));
+    }
+
+    al1->delete(al1);
+    al2->delete(al2);
+
+    ch_array_float_t* af = ch_array_float_new(1000,CH_ARRAY_CMP(float));
+    for(ch_word i = 0; i < af->size; i++){
+        *af->off(af,i) = (ch_float)((i * 7919) % 1000) / 3.0 - 100.0;
+    }
+    af->sort(af);
+    for(ch_float* i = af->first; i < af->last; i++){
+        CH_ASSERT(*i <= *(i+1));
+    }
+    af->delete(af);
+
+    return result;
+}
+
+
+//Radix sorting must agree with the comparison sort for signed, unsigned and floating point types
+static i64 test14_i64(i64* test_data)
+{
+    i64 result = 1;
+    (void)test_data;
+
+    const ch_word count = 100 * 1000;
+    ch_array_i64_t* al1 = ch_array_i64_new(count,CH_ARRAY_CMP(i64));
+    ch_array_i64_t* al2 = ch_array_i64_new(count,CH_ARRAY_CMP(i64));
+    ch_array_float_t* af1 = ch_array_float_new(count,CH_ARRAY_CMP(float));
+    ch_array_float_t* af2 = ch_array_float_new(count,CH_ARRAY_CMP(float));
+
+    u64 x = 88172645463325252ULL;
+    for(ch_word i = 0; i < count; i++){
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        *al1->off(al1,i) = *al2->off(al2,i) = i % 3 ? (i64)x : (i64)(x % 100) - 50;
+        *af1->off(af1,i) = *af2->off(af2,i) = ((ch_float)(i64)x) / 1e12;
+    }
+    *af1->off(af1,0) = *af2->off(af2,0) = INFINITY;
+    *af1->off(af1,1) = *af2->off(af2,1) = -INFINITY;
+
+    al1->sort_radix(al1);
+    al2->sort(al2);
+    CH_ASSERT(al1->eq(al1,al2));
+
+    af1->sort_radix(af1);
+    af2->sort(af2);
+    CH_ASSERT(af1->eq(af1,af2));
+    CH_ASSERT(*af1->first == -INFINITY);
+    CH_ASSERT(*af1->last == INFINITY);
+
+    al1->delete(al1);
+    al2->delete(al2);
+    af1->delete(af1);
+    af2->delete(af2);
+
+    //Small arrays take the comparison sort path
+    ch_array_u8_t* au = ch_array_u8_new(10,CH_ARRAY_CMP(u8));
+    for(ch_word i = 0; i < au->size; i++){
+        *au->off(au,i) = (u8)(250 - i * 20);
+    }
+    au->sort_radix(au);
+    for(u8* i = au->first; i < au->last; i++){
+        CH_ASSERT(*i <= *(i+1));
+    }
+    au->delete(au);
+
+    //Radix sorting is not available for types without an integer key
+    ch_array_string_t* as = ch_array_string_new(1,CH_ARRAY_CMP(string));
+    CH_ASSERT(as->sort_radix == NULL);
+    as->delete(as);
+
+    return result;
+}
+
+
+#define FIND_EVERY_POSITION(NAME, TYPE, VALUE)\
+{\
+    ch_array_##NAME##_t* a = ch_array_##NAME##_new(300,CH_ARRAY_CMP(NAME));\
+    for(ch_word pos = 0; pos < a->size; pos++){\
+        for(ch_word i = 0; i < a->size; i++){\
+            *a->off(a,i) = (TYPE)(i % 5);\
+        }\
+        *a->off(a,pos) = (VALUE);\
+        CH_ASSERT(a->find(a, a->first, a->end, (VALUE)) == a->off(a,pos));\
+        CH_ASSERT(a->find(a, a->off(a,pos) + 1, a->end, (VALUE)) == NULL);\
+        CH_ASSERT(a->find(a, a->first, a->off(a,pos), (VALUE)) == NULL);\
+        CH_ASSERT(a->find(a, a->first + 1, a->end, (TYPE)0) == (pos == 5 ? a->off(a,10) : a->off(a,5)));\
+    }\
+    a->delete(a);\
+}
+
+//SIMD searching for primitive types must find the first match at every offset and alignment
+static i64 test15_i64(i64* test_data)
+{
+    i64 result = 1;
+    (void)test_data;
+
+    FIND_EVERY_POSITION(u8, u8, 0xFF)
+    FIND_EVERY_POSITION(i16, i16, -1)
+    FIND_EVERY_POSITION(u32, u32, 0x80000000)
+    FIND_EVERY_POSITION(i64, i64, -9)
+    FIND_EVERY_POSITION(float, ch_float, -0.5)
+
+    //Floating point equality, not bitwise
+    ch_array_float_t* af = ch_array_float_new(64,CH_ARRAY_CMP(float));
+    for(ch_word i = 0; i < af->size; i++){
+        *af->off(af,i) = NAN;
+    }
+    *af->off(af,40) = -0.0;
+    CH_ASSERT(af->find(af, af->first, af->end, 0.0) == af->off(af,40));
+    CH_ASSERT(af->find(af, af->first, af->end, NAN) == NULL);
+    af->delete(af);
+
+    //A custom comparator still takes the generic path
+    ch_array_i64_t* ai = ch_array_i64_new(100,cmp_i64);
+    for(ch_word i = 0; i < ai->size; i++){
+        *ai->off(ai,i) = i;
+    }
+    CH_ASSERT(ai->find(ai, ai->first, ai->end, 77) == ai->off(ai,77));
+    CH_ASSERT(ai->find(ai, ai->first, ai->end, 100) == NULL);
+    ai->delete(ai);
+
+    return result;
+}
+
+
+//Binary searches on sorted arrays, with both the inlined and the comparator function paths
+static i64 test16_i64(i64* test_data)
+{
+    i64 result = 1;
+    (void)test_data;
+
+    for(ch_word size = 1; size < 40; size++){
+        ch_array_i64_t* a1 = ch_array_i64_new(size,CH_ARRAY_CMP(i64));
+        ch_array_i64_t* a2 = ch_array_i64_new(size,cmp_i64);
+        for(ch_word i = 0; i < size; i++){
+            *a1->off(a1,i) = *a2->off(a2,i) = 2 * (i / 2); //0,0,2,2,4,4...
+        }
+
+        for(i64 value = -1; value <= size + 1; value++){
+            i64* lower = a1->first;
+            for(; lower < a1->end && *lower < value; lower++){}
+            i64* upper = lower;
+            for(; upper < a1->end && *upper <= value; upper++){}
+
+            CH_ASSERT(a1->lower_bound(a1, value) == lower);
+            CH_ASSERT(a1->upper_bound(a1, value) == upper);
+            CH_ASSERT(a2->lower_bound(a2, value) - a2->first == lower - a1->first);
+            CH_ASSERT(a2->upper_bound(a2, value) - a2->first == upper - a1->first);
+
+            i64* range_lower = NULL;
+            i64* range_upper = NULL;
+            a2->equal_range(a2, value, &range_lower, &range_upper);
+            CH_ASSERT(range_upper - range_lower == upper - lower);
+            CH_ASSERT(range_lower - a2->first == lower - a1->first);
+        }
+
+        a1->delete(a1);
+        a2->delete(a2);
+    }
+
+    ch_array_string_t* as = ch_array_string_new(3,CH_ARRAY_CMP(string));
+    *as->off(as,0) = (ch_str){ .cstr = "apple" };
+    *as->off(as,1) = (ch_str){ .cstr = "banana" };
+    *as->off(as,2) = (ch_str){ .cstr = "cherry" };
+    CH_ASSERT(as->lower_bound(as, (ch_str){ .cstr = "b" }) == as->off(as,1));
+    CH_ASSERT(as->upper_bound(as, (ch_str){ .cstr = "cherry" }) == as->end);
+    as->delete(as);
+
+    return result;
+}
+
+
+//Aligned and huge page backed arrays keep their alignment and contents when resized
+static i64 test17_i64(i64* test_data)
+{
+    i64 result = 1;
+    (void)test_data;
+
+    //Up to malloc's own alignment, heap arrays grow with realloc(). Beyond it, they get a fresh allocation
+    const ch_word alignments[] = { (ch_word)_Alignof(max_align_t), CH_ARRAY_ALIGN_CACHE_LINE, 4096, 1024 * 1024 };
+    for(ch_word a = 0; a < 4; a++){
+        for(ch_word flags = 0; flags <= CH_ARRAY_HUGE_PAGES; flags += CH_ARRAY_HUGE_PAGES){
+            ch_array_i64_t* aa = ch_array_i64_new_aligned(10, CH_ARRAY_CMP(i64), alignments[a], flags);
+            CH_ASSERT(aa != NULL);
+            const ch_word misalignment = (ch_word)((uintptr_t)aa->first % alignments[a]);
+            CH_ASSERT(misalignment == 0);
+            for(ch_word i = 0; i < aa->size; i++){
+                CH_ASSERT(*aa->off(aa,i) == 0);
+                *aa->off(aa,i) = i;
+            }
+
+            const ch_word sizes[] = { 1000, 300000, 7, 0, 20 };
+            for(ch_word s = 0; s < 5; s++){
+                const ch_word old_size = aa->size;
+                aa->resize(aa, sizes[s]);
+                CH_ASSERT(aa->size == sizes[s]);
+                if(sizes[s] == 0){
+                    CH_ASSERT(aa->first == NULL);
+                    continue;
+                }
+
+                const ch_word resized_misalignment = (ch_word)((uintptr_t)aa->first % alignments[a]);
+                CH_ASSERT(resized_misalignment == 0);
+                for(ch_word i = 0; i < MIN(old_size, aa->size); i++){
+                    CH_ASSERT(*aa->off(aa,i) == i);
+                }
+                for(ch_word i = old_size; i < aa->size; i++){
+                    *aa->off(aa,i) = i;
+                }
+            }
+
+            aa->delete(aa);
+        }
+    }
+
+    //Alignments must be a power of 2
+    CH_ASSERT(ch_array_i64_new_aligned(10, CH_ARRAY_CMP(i64), 48, 0) == NULL);
+
+    return result;
+}
+
+
+//File backed arrays can be searched and sorted in place, and the changes written back to the file
+static i64 test18_i64(i64* test_data)
+{
+    i64 result = 1;
+    (void)test_data;
+
+    char path[] = "/tmp/test_array_XXXXXX";
+    const int fd = mkstemp(path);
+    CH_ASSERT(fd >= 0);
+    if(fd < 0){
+        return result;
+    }
+
+    //1000 elements in reverse order, plus a partial element that should be ignored
+    for(i64 i = 999; i >= 0; i--){
+        CH_ASSERT(write(fd, &i, sizeof(i)) == sizeof(i));
+    }
+    CH_ASSERT(write(fd, "xyz", 3) == 3);
+    close(fd);
+
+    ch_array_i64_t* aw = ch_array_i64_map_file(path, CH_ARRAY_MAP_RDWR | CH_ARRAY_MAP_SEQUENTIAL, CH_ARRAY_CMP(i64));
+    CH_ASSERT(aw != NULL);
+    CH_ASSERT(aw->size == 1000);
+    CH_ASSERT(*aw->first == 999 && *aw->last == 0);
+    CH_ASSERT(aw->find(aw, aw->first, aw->end, 10) == aw->off(aw,989));
+    aw->sort(aw);
+    CH_ASSERT(aw->sync(aw) == 0);
+    aw->resize(aw, 10);
+    CH_ASSERT(aw->size == 1000);
+    aw->delete(aw);
+
+    ch_array_i64_t* ar = ch_array_i64_map_file(path, CH_ARRAY_MAP_RDONLY | CH_ARRAY_MAP_RANDOM, CH_ARRAY_CMP(i64));
+    CH_ASSERT(ar != NULL);
+    for(i64 i = 0; i < 1000; i++){
+        CH_ASSERT(*ar->off(ar,i) == i);
+    }
+    CH_ASSERT(ar->lower_bound(ar, 500) == ar->off(ar,500));
+    ar->delete(ar);
+
+    //Smaller than one element. The array is still file backed, so it can't be resized onto the heap
+    ch_array_t* ae = ch_array_map_file(path, 16384, CH_ARRAY_MAP_RDWR, NULL);
+    CH_ASSERT(ae != NULL && ae->size == 0 && ae->first == NULL);
+    CH_ASSERT(ae->_backing_type == CH_ARRAY_BACKING_FILE);
+    array_resize(ae, 10);
+    CH_ASSERT(ae->size == 0 && ae->first == NULL && array_sync(ae) == 0);
+    array_delete(ae);
+
+    //Empty
+    CH_ASSERT(truncate(path, 0) == 0);
+    ae = ch_array_map_file(path, 8, CH_ARRAY_MAP_RDWR, NULL);
+    CH_ASSERT(ae != NULL && ae->size == 0 && ae->first == NULL);
+    CH_ASSERT(ae->_backing_type == CH_ARRAY_BACKING_FILE);
+    array_resize(ae, 10);
+    CH_ASSERT(ae->size == 0 && ae->first == NULL && array_sync(ae) == 0);
+    array_delete(ae);
+
+    unlink(path);
+    CH_ASSERT(ch_array_map_file(path, 8, CH_ARRAY_MAP_RDONLY, NULL) == NULL);
+
+    return result;
+}
+
+
+//The static inline API and the function pointers see the same array
+static i64 test19_i64(i64* test_data)
+{
+    i64 result = 1;
+
+    ch_array_i64_t* a1 = ch_array_i64_new(10,CH_ARRAY_CMP(i64));
+    a1->from_carray(a1, test_data, 10);
+    for(ch_word i = -10; i < 10; i++){
+        CH_ASSERT(ch_array_i64_off(a1, i) == a1->off(a1, i));
+    }
+    CH_ASSERT(*ch_array_i64_off(a1, -1) == test_data[9]);
+    CH_ASSERT(ch_array_i64_next(a1, a1->first) == a1->first + 1);
+    CH_ASSERT(ch_array_i64_prev(a1, a1->last) == a1->last - 1);
+    CH_ASSERT(ch_array_i64_forward(a1, a1->first, 10) == a1->end);
+    CH_ASSERT(ch_array_i64_back(a1, a1->last, 9) == a1->first);
+
+    a1->delete(a1);
+    return result;
+}
+
+
 int main(int argc, char** argv)
 {
     (void)argc;
@@ -353,6 +689,13 @@ int main(int argc, char** argv)
     printf("CH Data Structures: Array Test 09: ");  printf("%s", (test_pass = test10_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
     printf("CH Data Structures: Array Test 10: ");  printf("%s", (test_pass = test11_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
     printf("CH Data Structures: Array Test 11: ");  printf("%s", (test_pass = test12_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Array Test 12: ");  printf("%s", (test_pass = test13_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Array Test 13: ");  printf("%s", (test_pass = test14_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Array Test 14: ");  printf("%s", (test_pass = test15_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Array Test 15: ");  printf("%s", (test_pass = test16_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Array Test 16: ");  printf("%s", (test_pass = test17_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Array Test 17: ");  printf("%s", (test_pass = test18_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Array Test 18: ");  printf("%s", (test_pass = test19_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
 
     return 0;
 }
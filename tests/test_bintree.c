@@ -0,0 +1,499 @@
+// CamIO 2: test_bintree.c
+// Copyright (C) 2013: Matthew P. Grosvenor (matthew.grosvenor@cl.cam.ac.uk)
+// Licensed under BSD 3 Clause, please see LICENSE for more details.
+
+#include "../data_structs/binary_tree/binary_tree.h"
+#include "../data_structs/pool/pool.h"
+#include "../utils/util.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+typedef struct {
+    i64 key;
+    i64 seq;
+    ch_byte pad[48]; //Make the nodes narrow, so that small tests still build deep trees
+} kv_t;
+
+//Order by key only, so that the seq shows the order of equal elements
+static int cmp_kv(const void* lhs, const void* rhs)
+{
+    const i64 l = ((const kv_t*)lhs)->key, r = ((const kv_t*)rhs)->key;
+    return l < r ? -1 : l > r;
+}
+
+
+//Walk the tree checking the links, counts and key order. Returns the number of elements under node
+static ch_word check_node(ch_bintree_t* bt, ch_bintree_node_t* node, ch_bintree_node_t** next_leaf)
+{
+    if(node->leaf){
+        if(node != *next_leaf || node->count <= 0 || node->count > bt->_leaf_capacity){
+            return -1;
+        }
+        *next_leaf = node->next;
+        return node->count;
+    }
+
+    if(node->count < 0 || node->count > bt->_inner_capacity){
+        return -1;
+    }
+
+    ch_bintree_node_t** children = (ch_bintree_node_t**)((ch_byte*)node + round_up((ch_word)sizeof(ch_bintree_node_t),
+            (ch_word)_Alignof(max_align_t)) + round_up(bt->_inner_capacity * bt->_key_size, (ch_word)sizeof(void*)));
+    ch_word total = 0;
+    for(ch_word i = 0; i <= node->count; i++){
+        if(children[i]->parent != node){
+            return -1;
+        }
+        const ch_word count = check_node(bt, children[i], next_leaf);
+        if(count < 0){
+            return -1;
+        }
+        total += count;
+    }
+
+    return total;
+}
+
+static ch_bool check_tree(ch_bintree_t* bt)
+{
+    if(!bt->_root){
+        return bt->count == 0 && !bt->_first && !bt->_last;
+    }
+
+    ch_bintree_node_t* next_leaf = bt->_first;
+    if(bt->_root->parent || check_node(bt, bt->_root, &next_leaf) != bt->count || next_leaf){
+        return false;
+    }
+
+    ch_bintree_it it = bintree_first(bt);
+    for(ch_bintree_it next = it; bintree_next(bt, &next), next.value; it = next){
+        if(bt->_cmp(it.value, next.value) > 0){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+//Ordered inserts, duplicates, searches and ranges
+static ch_word test1(i64* test_data)
+{
+    ch_word result = 1;
+
+    CH_ASSERT(ch_bintree_new(sizeof(kv_t), NULL) == NULL);
+    CH_ASSERT(ch_bintree_new_i64(4) == NULL);
+
+    ch_bintree_t* bt = ch_bintree_new(sizeof(kv_t), cmp_kv);
+    CH_ASSERT(bt != NULL && bt->count == 0 && check_tree(bt));
+    CH_ASSERT(bintree_first(bt).value == NULL && bintree_last(bt).value == NULL);
+
+    //Enough copies to spread the duplicates over several leaves
+    for(ch_word i = 0; i < 150; i++){
+        const ch_word j = i % 15;
+        const kv_t kv = { .key = test_data[j], .seq = i };
+        const ch_bintree_it it = bintree_push(bt, &kv);
+        CH_ASSERT(it.value && ((kv_t*)it.value)->seq == i);
+    }
+    CH_ASSERT(bt->count == 150 && check_tree(bt) && !bt->_root->leaf);
+
+    //Sorted by key, and equal keys in insertion order
+    const kv_t* prev = NULL;
+    CH_BINTREE_FOREACH(bt, it){
+        const kv_t* kv = it.value;
+        CH_ASSERT(!prev || prev->key < kv->key || (prev->key == kv->key && prev->seq < kv->seq));
+        prev = kv;
+    }
+    CH_ASSERT(prev && prev->key == 9);
+    CH_ASSERT(((kv_t*)bintree_first(bt).value)->key == 0);
+    CH_ASSERT(((kv_t*)bintree_last(bt).value)->key == 9);
+
+    kv_t probe = { .key = 1 };
+    ch_bintree_it it = bintree_find(bt, &probe);
+    CH_ASSERT(it.value && ((kv_t*)it.value)->seq == 2);
+    it = bintree_upper_bound(bt, &probe);
+    CH_ASSERT(it.value && ((kv_t*)it.value)->key == 3);
+    probe.key = 2;
+    CH_ASSERT(bintree_find(bt, &probe).value == NULL);
+    it = bintree_lower_bound(bt, &probe);
+    CH_ASSERT(it.value && ((kv_t*)it.value)->key == 3);
+    probe.key = 10;
+    CH_ASSERT(bintree_lower_bound(bt, &probe).value == NULL);
+
+    //[1, 7) holds the four 1s, 3, 4, 5 and the three 6s of every copy
+    const kv_t lo = { .key = 1 }, hi = { .key = 7 };
+    ch_bintree_it begin, end;
+    CH_ASSERT(bintree_range(bt, &lo, &hi, &begin, &end) == 100);
+    CH_ASSERT(((kv_t*)begin.value)->key == 1 && ((kv_t*)end.value)->key == 7);
+    CH_ASSERT(bintree_range(bt, &hi, &lo, &begin, &end) == 0);
+
+    //Random access
+    CH_ASSERT(((kv_t*)bintree_off(bt, 0).value)->key == 0);
+    CH_ASSERT(((kv_t*)bintree_off(bt, 10).value)->key == 1);
+    CH_ASSERT(((kv_t*)bintree_off(bt, -1).value)->key == 9);
+    CH_ASSERT(bintree_off(bt, 150).value == NULL);
+    it = bintree_first(bt);
+    bintree_forward(bt, &it, 60);
+    CH_ASSERT(((kv_t*)it.value)->key == 4);
+    bintree_back(bt, &it, 60);
+    CH_ASSERT(it.value == bintree_first(bt).value);
+
+    //Removing by value takes out the first of the equal elements
+    probe.key = 6;
+    CH_ASSERT(bintree_remove(bt, &probe) == 1);
+    CH_ASSERT(((kv_t*)bintree_find(bt, &probe).value)->seq == 10);
+    probe.key = 2;
+    CH_ASSERT(bintree_remove(bt, &probe) == 0);
+    CH_ASSERT(bt->count == 149 && check_tree(bt));
+
+    //Removing by iterator can take any of them
+    probe.key = 1;
+    it = bintree_find(bt, &probe);
+    bintree_next(bt, &it);
+    bintree_next(bt, &it);
+    CH_ASSERT(((kv_t*)it.value)->seq == 11);
+    it = bintree_remove_it(bt, &it);
+    CH_ASSERT(((kv_t*)it.value)->seq == 13);
+    CH_ASSERT(check_tree(bt));
+
+    //Walk backwards
+    ch_word count = 0;
+    prev = NULL;
+    for(it = bintree_last(bt); it.value; bintree_prev(bt, &it)){
+        const kv_t* kv = it.value;
+        CH_ASSERT(!prev || prev->key >= kv->key);
+        prev = kv;
+        count++;
+    }
+    CH_ASSERT(count == bt->count && count == 148);
+
+    ch_bintree_t* bt2 = ch_bintree_new(sizeof(kv_t), cmp_kv);
+    CH_ASSERT(!bintree_eq(bt, bt2));
+    CH_BINTREE_FOREACH(bt, it2){
+        bintree_push(bt2, it2.value);
+    }
+    CH_ASSERT(bintree_eq(bt, bt2) && bintree_eq(bt2, bt));
+    bintree_delete(bt2);
+
+    bintree_pop_all(bt);
+    CH_ASSERT(bt->count == 0 && check_tree(bt));
+    probe.key = 1;
+    CH_ASSERT(bintree_find(bt, &probe).value == NULL);
+
+    bintree_delete(bt);
+    return result;
+}
+
+
+//Random inserts and removes, against a sorted array
+static ch_word test2(void)
+{
+    ch_word result = 1;
+
+    ch_bintree_t* bt = ch_bintree_new(sizeof(kv_t), cmp_kv);
+    static i64 model[8192];
+    ch_word model_count = 0;
+    u64 seed = 42;
+
+    for(ch_word step = 0; step < 40000; step++){
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        const ch_word r = (ch_word)(seed >> 33);
+        const kv_t kv = { .key = (r >> 3) & 0x3ff, .seq = step };
+
+        //Fill up, drain down, then fill up again
+        const ch_bool grow = step < 15000 || step >= 30000 ? (r & 0x3) != 0 : (r & 0x3) == 0;
+        if(model_count < 6000 && grow){
+            const ch_bintree_it it = bintree_push(bt, &kv);
+            CH_ASSERT(it.value && ((kv_t*)it.value)->seq == step);
+
+            ch_word pos = model_count;
+            while(pos > 0 && model[pos - 1] > kv.key){
+                pos--;
+            }
+            memmove(&model[pos + 1], &model[pos], (model_count - pos) * sizeof(i64));
+            model[pos] = kv.key;
+            model_count++;
+        }
+        else if(model_count){
+            //Remove at a random position by iterator, or a random value
+            if(r & 0x4){
+                const ch_word idx = r % model_count;
+                ch_bintree_it it = bintree_off(bt, idx);
+                it = bintree_remove_it(bt, &it);
+                memmove(&model[idx], &model[idx + 1], (model_count - idx - 1) * sizeof(i64));
+                model_count--;
+                CH_ASSERT(idx < model_count ? ((kv_t*)it.value)->key == model[idx] : it.value == NULL);
+            }
+            else{
+                ch_word pos = 0;
+                while(pos < model_count && model[pos] < kv.key){
+                    pos++;
+                }
+                const ch_bool found = pos < model_count && model[pos] == kv.key;
+                CH_ASSERT(bintree_remove(bt, &kv) == (found ? 1 : 0));
+                if(found){
+                    memmove(&model[pos], &model[pos + 1], (model_count - pos - 1) * sizeof(i64));
+                    model_count--;
+                }
+            }
+        }
+
+        if(step % 1000 == 0){
+            CH_ASSERT(check_tree(bt));
+            ch_word i = 0;
+            CH_BINTREE_FOREACH(bt, it){
+                CH_ASSERT(((kv_t*)it.value)->key == model[i]);
+                i++;
+            }
+            CH_ASSERT(i == model_count && bt->count == model_count);
+
+            const kv_t lo = { .key = 100 }, hi = { .key = 200 };
+            ch_word expected = 0;
+            for(i = 0; i < model_count; i++){
+                expected += model[i] >= lo.key && model[i] < hi.key;
+            }
+            ch_bintree_it begin, end;
+            CH_ASSERT(bintree_range(bt, &lo, &hi, &begin, &end) == expected);
+        }
+    }
+
+    //Drain it from the front
+    for(ch_bintree_it it = bintree_first(bt); it.value; ){
+        it = bintree_remove_it(bt, &it);
+    }
+    CH_ASSERT(bt->count == 0 && check_tree(bt));
+
+    bintree_delete(bt);
+    return result;
+}
+
+
+//i64 keyed trees, in and out of order
+static ch_word test3(void)
+{
+    ch_word result = 1;
+
+    ch_bintree_t* bt = ch_bintree_new_i64(sizeof(i64));
+    const ch_word count = 200 * 1000;
+
+    //Ascending pushes leave the leaves full
+    for(i64 i = 0; i < count; i++){
+        const i64 value = 2 * i;
+        bintree_push(bt, &value);
+    }
+    CH_ASSERT(bt->count == count && check_tree(bt));
+    CH_ASSERT(bt->_leaves->count == (count + bt->_leaf_capacity - 1) / bt->_leaf_capacity);
+
+    for(i64 i = 0; i < count; i++){
+        const i64 value = 2 * i, odd = 2 * i + 1;
+        const ch_bintree_it it = bintree_find(bt, &value);
+        CH_ASSERT(it.value && *(i64*)it.value == value);
+        CH_ASSERT(bintree_find(bt, &odd).value == NULL);
+        const ch_bintree_it next = bintree_lower_bound(bt, &odd);
+        CH_ASSERT(i + 1 < count ? *(i64*)next.value == value + 2 : next.value == NULL);
+    }
+
+    //Take out every other element, in a scattered order
+    for(i64 i = 0; i < count / 2; i++){
+        const i64 value = 4 * ((i * 7919) % (count / 2));
+        CH_ASSERT(bintree_remove(bt, &value) == 1);
+    }
+    CH_ASSERT(bt->count == count / 2 && check_tree(bt));
+
+    i64 expected = 2;
+    CH_BINTREE_FOREACH(bt, it){
+        CH_ASSERT(*(i64*)it.value == expected);
+        expected += 4;
+    }
+
+    bintree_pop_all(bt);
+
+    //Scattered pushes
+    for(i64 i = 0; i < count; i++){
+        const i64 value = (i * 7919) % count;
+        bintree_push(bt, &value);
+    }
+    CH_ASSERT(check_tree(bt));
+    expected = 0;
+    CH_BINTREE_FOREACH(bt, it){
+        CH_ASSERT(*(i64*)it.value == expected);
+        expected++;
+    }
+    CH_ASSERT(expected == count);
+
+    bintree_delete(bt);
+    return result;
+}
+
+
+//Bulk building and merging
+static ch_word test4(void)
+{
+    ch_word result = 1;
+
+    const ch_word count = 100 * 1000;
+    kv_t* data = (kv_t*)calloc(count, sizeof(kv_t));
+    for(ch_word i = 0; i < count; i++){
+        data[i].key = i / 2;
+        data[i].seq = i;
+    }
+
+    ch_bintree_t* a = ch_bintree_new(sizeof(kv_t), cmp_kv);
+    kv_t kv = { .key = 7 };
+    bintree_push(a, &kv);
+    CH_ASSERT(bintree_build_sorted(a, data, count) == count);
+    CH_ASSERT(a->count == count && check_tree(a));
+    CH_ASSERT(a->_leaves->count == (count + a->_leaf_capacity - 1) / a->_leaf_capacity);
+    ch_word i = 0;
+    CH_BINTREE_FOREACH(a, it){
+        CH_ASSERT(((kv_t*)it.value)->seq == i);
+        i++;
+    }
+    CH_ASSERT(i == count);
+
+    //The tree still works normally afterwards
+    kv.key = count / 4;
+    kv.seq = -1;
+    CH_ASSERT(((kv_t*)bintree_push(a, &kv).value)->seq == -1);
+    CH_ASSERT(((kv_t*)bintree_find(a, &kv).value)->seq == count / 2);
+    CH_ASSERT(bintree_remove(a, &kv) == 1 && bintree_remove(a, &kv) == 1 && bintree_remove(a, &kv) == 1);
+    CH_ASSERT(bintree_find(a, &kv).value == NULL && a->count == count - 2 && check_tree(a));
+
+    //Merge in the odd keys, with a copy of each of the even ones
+    ch_bintree_t* b = ch_bintree_new(sizeof(kv_t), cmp_kv);
+    for(i = 0; i < count; i++){
+        data[i].key = i;
+        data[i].seq = count + i;
+    }
+    CH_ASSERT(bintree_build_sorted(b, data, count) == count && check_tree(b));
+    CH_ASSERT(bintree_merge(a, b) == 2 * count - 2);
+    CH_ASSERT(b->count == 0 && check_tree(b) && b->_leaves->count == 0);
+    CH_ASSERT(check_tree(a));
+
+    //Equal keys from a come first
+    const kv_t* prev = NULL;
+    CH_BINTREE_FOREACH(a, it){
+        const kv_t* cur = it.value;
+        CH_ASSERT(!prev || prev->key < cur->key || (prev->key == cur->key && prev->seq < cur->seq));
+        prev = cur;
+    }
+    kv.key = 3;
+    ch_bintree_it it = bintree_find(a, &kv);
+    CH_ASSERT(((kv_t*)it.value)->seq == 6);
+    bintree_forward(a, &it, 2);
+    CH_ASSERT(((kv_t*)it.value)->seq == count + 3);
+
+    //Sorted C arrays are merged in, unsorted ones are pushed
+    for(i = 0; i < 4; i++){
+        data[i].key = 2 * i;
+        data[i].seq = -1 - i;
+    }
+    it = bintree_push_back_carray(b, data, 4);
+    CH_ASSERT(((kv_t*)it.value)->seq == -4 && b->count == 4);
+    it = bintree_push_back_carray(b, data, 4);
+    CH_ASSERT(((kv_t*)it.value)->seq == -4 && b->count == 8 && check_tree(b));
+    it = bintree_first(b);
+    bintree_next(b, &it);
+    CH_ASSERT(((kv_t*)it.value)->seq == -1);
+    data[0].key = 100;
+    it = bintree_push_back_carray(b, data, 4);
+    CH_ASSERT(((kv_t*)it.value)->seq == -4 && b->count == 12);
+    CH_ASSERT(((kv_t*)bintree_last(b).value)->key == 100 && check_tree(b));
+    CH_ASSERT(bintree_build_sorted(b, data, 4) == -1);
+
+    CH_ASSERT(bintree_merge(a, a) == -1);
+
+    bintree_delete(b);
+    bintree_delete(a);
+    free(data);
+    return result;
+}
+
+
+//Check that bt holds the keys first, first + step, first + 2 * step ... in order, in count elements
+static ch_bool check_keys(ch_bintree_t* bt, ch_word count, i64 first, i64 step)
+{
+    i64 expected = first;
+    CH_BINTREE_FOREACH(bt, it){
+        if(((kv_t*)it.value)->key != expected){
+            return false;
+        }
+        expected += step;
+    }
+
+    return bt->count == count && expected == first + count * step && check_tree(bt);
+}
+
+//Failed bulk operations leave the trees as they were
+static ch_word test5(void)
+{
+    ch_word result = 1;
+
+    const ch_word count = 50 * 1000;
+    kv_t* data = (kv_t*)calloc(count, sizeof(kv_t));
+    for(ch_word i = 0; i < count; i++){
+        data[i].key = 2 * i;
+    }
+    ch_bintree_t* a = ch_bintree_new(sizeof(kv_t), cmp_kv);
+    CH_ASSERT(bintree_build_sorted(a, data, count) == count);
+    for(ch_word i = 0; i < count; i++){
+        data[i].key = 2 * i + 1;
+    }
+    ch_bintree_t* b = ch_bintree_new(sizeof(kv_t), cmp_kv);
+    CH_ASSERT(bintree_build_sorted(b, data, count) == count);
+
+    //Nodes are taken up front, so running out part way through must hand them all back
+    pool_fail_after(0);
+    CH_ASSERT(bintree_push_back_carray(a, data, count).value == NULL);
+    CH_ASSERT(bintree_build_sorted(a, data, count) == -1);
+    pool_fail_after(-1);
+    CH_ASSERT(check_keys(a, count, 0, 2));
+
+    //Fail after one more slab each time, until there are enough for the merge to go through
+    const ch_word leaves = a->_leaves->count, inners = a->_inners->count, inner_slabs = a->_inners->slabs;
+    ch_word failures = 0;
+    for(ch_word slabs = 0; ; slabs++){
+        pool_fail_after(slabs);
+        const ch_word merged = bintree_merge(a, b);
+        pool_fail_after(-1);
+        if(merged != -1){
+            CH_ASSERT(merged == 2 * count);
+            break;
+        }
+
+        failures++;
+        CH_ASSERT(a->_leaves->count == leaves && a->_inners->count == inners);
+        CH_ASSERT(check_keys(a, count, 0, 2));
+        CH_ASSERT(check_keys(b, count, 1, 2));
+    }
+    //The merge needs new slabs for both kinds of node, so it has failed while taking each
+    CH_ASSERT(failures > 1 && a->_inners->slabs > inner_slabs);
+    CH_ASSERT(check_keys(a, 2 * count, 0, 1) && b->count == 0 && check_tree(b));
+
+    bintree_delete(b);
+    bintree_delete(a);
+    free(data);
+    return result;
+}
+
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    i64 test_array[15] = {8,5,1,3,4,6,7,9,7,1,6,1,0,1,6};
+
+    ch_word test_pass = 0;
+    printf("CH Data Structures: Bintree Test 01: ");  printf("%s", (test_pass = test1(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Bintree Test 02: ");  printf("%s", (test_pass = test2()) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Bintree Test 03: ");  printf("%s", (test_pass = test3()) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Bintree Test 04: ");  printf("%s", (test_pass = test4()) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Bintree Test 05: ");  printf("%s", (test_pass = test5()) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+
+    return 0;
+}
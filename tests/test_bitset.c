@@ -0,0 +1,268 @@
+// CamIO 2: test_bitset.c
+// Copyright (C) 2013: Matthew P. Grosvenor (matthew.grosvenor@cl.cam.ac.uk)
+// Licensed under BSD 3 Clause, please see LICENSE for more details.
+
+#include "../data_structs/bitset/bitset.h"
+#include "../utils/util.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BITS 3037
+
+
+//Check every bit, and every search, against a model
+static ch_bool check_bitset(ch_bitset_t* bs, const ch_bool* model)
+{
+    ch_word count = 0;
+    for(ch_word i = 0; i < bs->size; i++){
+        if(bitset_test(bs, i) != model[i]){
+            return 0;
+        }
+        count += model[i];
+    }
+    if(bitset_count(bs) != count){
+        return 0;
+    }
+
+    //Walk the set bits both ways
+    ch_word expected = 0;
+    CH_BITSET_FOREACH(bs, idx){
+        while(!model[expected]){
+            expected++;
+        }
+        if(idx != expected){
+            return 0;
+        }
+        expected++;
+    }
+
+    ch_word indices[100];
+    ch_word next = 0;
+    ch_word seen = 0;
+    for(ch_word n = bitset_to_indices(bs, 0, indices, 100); n; n = bitset_to_indices(bs, next, indices, 100)){
+        for(ch_word i = 0; i < n; i++){
+            if(!model[indices[i]] || indices[i] < next){
+                return 0;
+            }
+            next = indices[i] + 1;
+        }
+        seen += n;
+    }
+
+    return seen == count;
+}
+
+
+//Single bits, searches and whole set operations
+static ch_word test1()
+{
+    ch_word result = 1;
+
+    CH_ASSERT(ch_bitset_new(-1) == NULL);
+
+    ch_bitset_t* bs = ch_bitset_new(BITS);
+    CH_ASSERT(bs != NULL && bs->size == BITS);
+    CH_ASSERT(bitset_count(bs) == 0);
+    CH_ASSERT(bitset_next_set(bs, 0) == -1);
+    CH_ASSERT(bitset_next_clear(bs, 0) == 0);
+
+    ch_bool model[BITS] = {0};
+    srand(42);
+    for(ch_word i = 0; i < 400; i++){
+        const ch_word idx = rand() % BITS;
+        bitset_set(bs, idx);
+        model[idx] = 1;
+    }
+    bitset_set(bs, 0);
+    model[0] = 1;
+    bitset_set(bs, BITS - 1);
+    model[BITS - 1] = 1;
+    CH_ASSERT(check_bitset(bs, model));
+
+    for(ch_word i = 0; i < 200; i++){
+        const ch_word idx = rand() % BITS;
+        bitset_unset(bs, idx);
+        model[idx] = 0;
+        const ch_word flip = rand() % BITS;
+        bitset_flip(bs, flip);
+        model[flip] = !model[flip];
+    }
+    CH_ASSERT(check_bitset(bs, model));
+
+    //Searches from every position
+    for(ch_word i = 0; i < BITS; i++){
+        ch_word set = i;
+        while(set < BITS && !model[set]){
+            set++;
+        }
+        ch_word clear = i;
+        while(clear < BITS && model[clear]){
+            clear++;
+        }
+        CH_ASSERT(bitset_next_set(bs, i) == (set < BITS ? set : -1));
+        CH_ASSERT(bitset_next_clear(bs, i) == (clear < BITS ? clear : -1));
+    }
+    CH_ASSERT(bitset_next_set(bs, BITS) == -1);
+
+    //A long empty run, to skip over
+    bitset_clear_all(bs);
+    bitset_set(bs, 2900);
+    CH_ASSERT(bitset_next_set(bs, 1) == 2900);
+
+    bitset_set_all(bs);
+    CH_ASSERT(bitset_count(bs) == BITS && bitset_next_clear(bs, 0) == -1);
+    CH_ASSERT(bitset_next_set(bs, BITS - 1) == BITS - 1);
+
+    //Shrinking drops bits and growing adds clear ones
+    CH_ASSERT(bitset_resize(bs, 100) == 0 && bitset_count(bs) == 100);
+    CH_ASSERT(bitset_resize(bs, 5000) == 0 && bitset_count(bs) == 100);
+    CH_ASSERT(bitset_next_clear(bs, 0) == 100 && !bitset_test(bs, 4999));
+    CH_ASSERT(bitset_resize(bs, 0) == 0 && bitset_count(bs) == 0 && bitset_next_set(bs, 0) == -1);
+
+    bitset_delete(bs);
+    return result;
+}
+
+
+//Bulk and, or, xor and andnot
+static ch_word test2()
+{
+    ch_word result = 1;
+
+    ch_bitset_t* a = ch_bitset_new(BITS);
+    ch_bitset_t* b = ch_bitset_new(BITS);
+    ch_bitset_t* c = ch_bitset_new(BITS + 1);
+    ch_bool ma[BITS] = {0};
+    ch_bool mb[BITS] = {0};
+
+    srand(7);
+    for(ch_word i = 0; i < BITS; i++){
+        ma[i] = rand() % 3 == 0;
+        mb[i] = rand() % 2 == 0;
+        if(ma[i]){
+            bitset_set(a, i);
+        }
+        if(mb[i]){
+            bitset_set(b, i);
+        }
+    }
+
+    ch_word both = 0;
+    for(ch_word i = 0; i < BITS; i++){
+        both += ma[i] && mb[i];
+    }
+    CH_ASSERT(bitset_and_count(a, b) == both);
+    CH_ASSERT(bitset_and_count(a, c) == -1);
+    CH_ASSERT(bitset_and(a, c) == -1);
+    CH_ASSERT(!bitset_eq(a, b) && !bitset_eq(a, c));
+
+    ch_bool model[BITS];
+    ch_bitset_t* r = ch_bitset_new(BITS);
+
+    bitset_or(r, a);
+    CH_ASSERT(bitset_eq(r, a));
+    CH_ASSERT(bitset_and(r, b) == 0);
+    for(ch_word i = 0; i < BITS; i++){
+        model[i] = ma[i] && mb[i];
+    }
+    CH_ASSERT(check_bitset(r, model));
+
+    CH_ASSERT(bitset_or(r, a) == 0 && bitset_or(r, b) == 0);
+    for(ch_word i = 0; i < BITS; i++){
+        model[i] = ma[i] || mb[i];
+    }
+    CH_ASSERT(check_bitset(r, model));
+
+    CH_ASSERT(bitset_xor(r, a) == 0);
+    for(ch_word i = 0; i < BITS; i++){
+        model[i] = (ma[i] || mb[i]) != ma[i];
+    }
+    CH_ASSERT(check_bitset(r, model));
+
+    bitset_clear_all(r);
+    bitset_or(r, a);
+    CH_ASSERT(bitset_andnot(r, b) == 0);
+    for(ch_word i = 0; i < BITS; i++){
+        model[i] = ma[i] && !mb[i];
+    }
+    CH_ASSERT(check_bitset(r, model));
+
+    //The bits past the end stay clear
+    bitset_set_all(r);
+    CH_ASSERT(bitset_xor(r, b) == 0);
+    for(ch_word i = 0; i < BITS; i++){
+        model[i] = !mb[i];
+    }
+    CH_ASSERT(check_bitset(r, model));
+
+    bitset_delete(r);
+    bitset_delete(c);
+    bitset_delete(b);
+    bitset_delete(a);
+    return result;
+}
+
+
+//Rank and select, with and without the index
+static ch_word test3()
+{
+    ch_word result = 1;
+
+    const ch_word bits = 20000;
+    ch_bitset_t* bs = ch_bitset_new(bits);
+    ch_bool* model = (ch_bool*)calloc(bits, sizeof(ch_bool));
+    srand(11);
+    for(ch_word i = 0; i < bits; i++){
+        //Dense and sparse stretches
+        const ch_word odds = (i / 1000) % 2 ? 50 : 2;
+        model[i] = rand() % odds == 0;
+        if(model[i]){
+            bitset_set(bs, i);
+        }
+    }
+
+    for(ch_word pass = 0; pass < 2; pass++){
+        if(pass){
+            CH_ASSERT(bitset_build_rank(bs) == 0);
+        }
+
+        ch_word rank = 0;
+        for(ch_word i = 0; i < bits; i++){
+            CH_ASSERT(bitset_rank(bs, i) == rank);
+            if(model[i]){
+                CH_ASSERT(bitset_select(bs, rank) == i);
+                rank++;
+            }
+        }
+        CH_ASSERT(bitset_rank(bs, bits) == rank);
+        CH_ASSERT(bitset_rank(bs, bits + 10) == rank);
+        CH_ASSERT(bitset_select(bs, rank) == -1);
+        CH_ASSERT(bitset_select(bs, -1) == -1);
+    }
+
+    //Changes make the index stale, so rank falls back to a scan
+    bitset_unset(bs, bitset_select(bs, 0));
+    CH_ASSERT(bitset_rank(bs, bits) == bitset_count(bs));
+    CH_ASSERT(bitset_build_rank(bs) == 0);
+    CH_ASSERT(bitset_rank(bs, bits) == bitset_count(bs));
+
+    free(model);
+    bitset_delete(bs);
+    return result;
+}
+
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    ch_word test_pass = 0;
+    printf("CH Data Structures: Bitset Test 01: ");  printf("%s", (test_pass = test1()) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Bitset Test 02: ");  printf("%s", (test_pass = test2()) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Bitset Test 03: ");  printf("%s", (test_pass = test3()) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+
+    return 0;
+}
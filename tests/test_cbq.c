@@ -0,0 +1,150 @@
+// CamIO 2: test_cbq.c
+// Copyright (C) 2013: Matthew P. Grosvenor (matthew.grosvenor@cl.cam.ac.uk)
+// Licensed under BSD 3 Clause, please see LICENSE for more details.
+
+#include "../data_structs/circular_queue/circular_queue.h"
+#include "../utils/util.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+//Push, peek, pop, use and unuse from a single thread, which behave the same in both modes
+static ch_word check_queue(ch_cbq_t* q)
+{
+    ch_word result = 1;
+
+    CH_ASSERT(q != NULL && q->size == 8 && cbq_count(q) == 0);
+    CH_ASSERT(cbq_peek_front(q) == NULL && cbq_pop_front(q) == -1 && cbq_use_front(q) == NULL);
+
+    //Fill it up
+    for(i64 i = 0; i < 8; i++){
+        i64* slot = cbq_push_back(q, &i);
+        CH_ASSERT(slot && *slot == i);
+    }
+    i64 extra = 8;
+    CH_ASSERT(cbq_push_back(q, &extra) == NULL && cbq_count(q) == 8);
+
+    //Use a couple, give one back, then pop them
+    CH_ASSERT(*(i64*)cbq_use_front(q) == 0);
+    CH_ASSERT(*(i64*)cbq_use_front(q) == 1);
+    cbq_unuse_front(q);
+    CH_ASSERT(*(i64*)cbq_use_front(q) == 1);
+    CH_ASSERT(*(i64*)cbq_use_front(q) == 2);
+
+    for(i64 i = 0; i < 5; i++){
+        CH_ASSERT(*(i64*)cbq_peek_front(q) == i);
+        CH_ASSERT(cbq_pop_front(q) == 0);
+    }
+    CH_ASSERT(cbq_count(q) == 3);
+
+    //Push an array that wraps around the end, trimmed to the space left
+    i64 more[7] = {8,9,10,11,12,13,14};
+    ch_word len = 7;
+    i64* first = cbq_push_back_carray(q, more, &len);
+    CH_ASSERT(len == 5 && first && *first == 8 && cbq_count(q) == 8);
+    len = 1;
+    CH_ASSERT(cbq_push_back_carray(q, more, &len) == NULL || len == 0);
+    CH_ASSERT(len == 0);
+
+    //Use them all, then pop them all
+    for(i64 i = 5; i < 13; i++){
+        CH_ASSERT(*(i64*)cbq_use_front(q) == i);
+    }
+    CH_ASSERT(cbq_use_front(q) == NULL);
+    for(i64 i = 5; i < 13; i++){
+        CH_ASSERT(*(i64*)cbq_peek_front(q) == i);
+        CH_ASSERT(cbq_pop_front(q) == 0);
+    }
+    CH_ASSERT(cbq_count(q) == 0 && cbq_peek_front(q) == NULL && cbq_pop_front(q) == -1);
+
+    cbq_delete(q);
+    return result;
+}
+
+static ch_word test1()
+{
+    ch_word result = 1;
+
+    CH_ASSERT(check_queue(ch_cbq_new(8, sizeof(i64))));
+    CH_ASSERT(check_queue(ch_cbq_new_spsc(8, sizeof(i64))));
+    //Sizes are rounded up to a power of 2
+    CH_ASSERT(check_queue(ch_cbq_new_spsc(5, sizeof(i64))));
+    CH_ASSERT(ch_cbq_new_spsc(0, sizeof(i64)) == NULL);
+
+    return result;
+}
+
+
+#define MESSAGES (1000 * 1000)
+
+static void* producer(void* arg)
+{
+    ch_cbq_t* q = arg;
+    i64 batch[16];
+    for(i64 i = 0; i < MESSAGES; ){
+        //Mix single pushes and batches
+        if(i % 3){
+            if(cbq_push_back(q, &i)){
+                i++;
+            }
+            else{
+                sched_yield();
+            }
+            continue;
+        }
+
+        ch_word len = MIN(16, MESSAGES - i);
+        for(ch_word j = 0; j < len; j++){
+            batch[j] = i + j;
+        }
+        cbq_push_back_carray(q, batch, &len);
+        i += len;
+    }
+
+    return NULL;
+}
+
+//One producer and one consumer thread, passing through a queue much smaller than the number of messages
+static ch_word test2()
+{
+    ch_word result = 1;
+
+    ch_cbq_t* q = ch_cbq_new_spsc(64, sizeof(i64));
+    pthread_t thread;
+    CH_ASSERT(pthread_create(&thread, NULL, producer, q) == 0);
+
+    ch_word errors = 0;
+    for(i64 expected = 0; expected < MESSAGES; ){
+        const i64* value = cbq_peek_front(q);
+        if(!value){
+            sched_yield();
+            continue;
+        }
+        errors += *value != expected;
+        expected++;
+        cbq_pop_front(q);
+    }
+
+    pthread_join(thread, NULL);
+    CH_ASSERT(errors == 0);
+    CH_ASSERT(cbq_count(q) == 0);
+
+    cbq_delete(q);
+    return result;
+}
+
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    ch_word test_pass = 0;
+    printf("CH Data Structures: CBQ Test 01: ");  printf("%s", (test_pass = test1()) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: CBQ Test 02: ");  printf("%s", (test_pass = test2()) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+
+    return 0;
+}
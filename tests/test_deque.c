@@ -0,0 +1,157 @@
+// CamIO 2: test_deque.c
+// Copyright (C) 2013: Matthew P. Grosvenor (matthew.grosvenor@cl.cam.ac.uk)
+// Licensed under BSD 3 Clause, please see LICENSE for more details.
+
+#include "../data_structs/deque/deque_typed_define_template.h"
+#include "../utils/util.h"
+
+#include <stdio.h>
+
+declare_ch_deque(i64, i64)
+declare_ch_deque_cmp(i64, i64);
+define_ch_deque(i64, i64)
+define_ch_deque_cmp(i64, i64)
+
+
+//Pushes and pops at both ends, across many chunks, with random access in between
+static ch_word test1(void)
+{
+    ch_word result = 1;
+
+    CH_DEQUE(i64)* d = CH_DEQUE_NEW(i64, CH_DEQUE_CMP(i64));
+    CH_ASSERT(d != NULL && d->count == 0);
+    CH_ASSERT(d->first(d).value == NULL);
+
+    const ch_word n = 5000;
+    for(ch_word i = 0; i < n; i++){
+        CH_ASSERT(*d->push_back(d, i) == i);
+        CH_ASSERT(*ch_deque_i64_push_front(d, -1 - i) == -1 - i);
+    }
+    CH_ASSERT(d->count == 2 * n);
+
+    //Front half is -n..-1, back half is 0..n-1
+    for(ch_word i = 0; i < 2 * n; i++){
+        CH_ASSERT(*d->off(d, i) == i - n);
+        CH_ASSERT(*ch_deque_i64_off(d, i) == i - n);
+    }
+    CH_ASSERT(*d->off(d, -1) == n - 1);
+    CH_ASSERT(*ch_deque_i64_off(d, -1) == n - 1 && *ch_deque_i64_off(d, -2 * n) == -n);
+    CH_ASSERT(d->off(d, 2 * n) == NULL);
+
+    //Addresses stay put while the other end grows and shrinks
+    i64* front = d->off(d, 0);
+    i64* back  = d->off(d, -1);
+    for(ch_word i = 0; i < 3 * n; i++){
+        d->push_back(d, i);
+    }
+    for(ch_word i = 0; i < 3 * n; i++){
+        d->pop_back(d);
+    }
+    for(ch_word i = 0; i < 3 * n; i++){
+        d->push_front(d, i);
+    }
+    CH_ASSERT(*front == -n && *back == n - 1);
+    CH_ASSERT(front == d->off(d, 3 * n) && back == d->off(d, -1));
+
+    for(ch_word i = 0; i < 3 * n; i++){
+        ch_deque_i64_pop_front(d);
+    }
+    CH_ASSERT(d->count == 2 * n && *d->first(d).value == -n);
+
+    //Drain from both ends
+    for(ch_word i = 0; i < n; i++){
+        CH_ASSERT(*d->first(d).value == i - n);
+        d->pop_front(d);
+        CH_ASSERT(*d->last(d).value == n - 1 - i);
+        d->pop_back(d);
+    }
+    CH_ASSERT(d->count == 0 && d->first(d).value == NULL);
+    d->pop_back(d);
+    d->pop_front(d);
+    CH_ASSERT(d->count == 0);
+
+    //A FIFO that keeps crossing a chunk boundary
+    for(ch_word i = 0; i < 10 * n; i++){
+        d->push_back(d, i);
+        if(i >= 3){
+            CH_ASSERT(*d->first(d).value == i - 3);
+            d->pop_front(d);
+        }
+    }
+    CH_ASSERT(d->count == 3);
+
+    d->clear(d);
+    CH_ASSERT(d->count == 0);
+    d->delete(d);
+    return result;
+}
+
+
+//Iterators, find and eq
+static ch_word test2(void)
+{
+    ch_word result = 1;
+
+    CH_DEQUE(i64)* d = CH_DEQUE_NEW(i64, CH_DEQUE_CMP(i64));
+    const ch_word n = 2000;
+    for(ch_word i = 0; i < n; i++){
+        d->push_front(d, n - 1 - i);
+    }
+
+    ch_word expected = 0;
+    CH_DEQUE_FOREACH(i64, d, it){
+        CH_ASSERT(*it.value == expected);
+        expected++;
+    }
+    CH_ASSERT(expected == n);
+
+    expected = n - 1;
+    for(CH_DEQUE_IT(i64) it = d->last(d); it.value; d->prev(d, &it)){
+        CH_ASSERT(*it.value == expected);
+        expected--;
+    }
+    CH_ASSERT(expected == -1);
+
+    CH_DEQUE_IT(i64) it = d->first(d);
+    d->forward(d, &it, 1500);
+    CH_ASSERT(*it.value == 1500);
+    d->back(d, &it, 1000);
+    CH_ASSERT(*it.value == 500);
+    ch_deque_i64_next(d, &it);
+    ch_deque_i64_prev(d, &it);
+    ch_deque_i64_prev(d, &it);
+    CH_ASSERT(*it.value == 499);
+
+    CH_DEQUE_IT(i64) begin = d->first(d);
+    CH_DEQUE_IT(i64) end = d->end(d);
+    CH_ASSERT(end.value == NULL);
+    CH_ASSERT(*d->find(d, &begin, &end, 1234).value == 1234);
+    CH_ASSERT(d->find(d, &begin, &end, n).value == NULL);
+
+    CH_DEQUE(i64)* e = CH_DEQUE_NEW(i64, CH_DEQUE_CMP(i64));
+    i64 carray[2000];
+    for(ch_word i = 0; i < n; i++){
+        carray[i] = i;
+    }
+    CH_ASSERT(*e->push_back_carray(e, carray, n) == n - 1);
+    CH_ASSERT(e->eq(e, d) && d->eq(d, e));
+    e->pop_back(e);
+    CH_ASSERT(!e->eq(e, d));
+
+    e->delete(e);
+    d->delete(d);
+    return result;
+}
+
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    ch_word test_pass = 0;
+    printf("CH Data Structures: Deque Test 01: ");  printf("%s", (test_pass = test1()) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Deque Test 02: ");  printf("%s", (test_pass = test2()) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+
+    return 0;
+}
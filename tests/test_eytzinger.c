@@ -0,0 +1,132 @@
+// CamIO 2: test_eytzinger.c
+// Copyright (C) 2013: Matthew P. Grosvenor (matthew.grosvenor@cl.cam.ac.uk)
+// Licensed under BSD 3 Clause, please see LICENSE for more details.
+
+#include "../data_structs/eytzinger/eytzinger.h"
+#include "../data_structs/array/array_sort_template.h"
+#include "../utils/util.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+static int cmp_i64(const void* lhs, const void* rhs)
+{
+    const i64 l = *(const i64*)lhs, r = *(const i64*)rhs;
+    return l < r ? -1 : l > r;
+}
+
+
+//Reference answers by linear search
+static ch_word lower_linear(const i64* sorted, ch_word count, i64 value)
+{
+    ch_word i = 0;
+    for(; i < count && sorted[i] < value; i++){}
+    return i;
+}
+
+static ch_word upper_linear(const i64* sorted, ch_word count, i64 value)
+{
+    ch_word i = 0;
+    for(; i < count && sorted[i] <= value; i++){}
+    return i;
+}
+
+
+//Every tree size up to a few full levels, with duplicates, against every value in and around the range
+static ch_word test1(i64* sorted)
+{
+    ch_word result = 1;
+
+    for(ch_word count = 0; count < 70; count++){
+        ch_eytzinger_t* e = ch_eytzinger_new(sorted, count, sizeof(i64), cmp_i64);
+        CH_ASSERT(e != NULL);
+        CH_ASSERT(e->count == count);
+
+        for(i64 value = -2; value < 2 * count + 2; value++){
+            CH_ASSERT(eytzinger_lower_bound(e, &value) == lower_linear(sorted, count, value));
+            CH_ASSERT(eytzinger_upper_bound(e, &value) == upper_linear(sorted, count, value));
+
+            const ch_word found = eytzinger_find(e, &value);
+            const ch_word lower = lower_linear(sorted, count, value);
+            if(lower < count && sorted[lower] == value){
+                CH_ASSERT(found == lower);
+            }
+            else{
+                CH_ASSERT(found == -1);
+            }
+        }
+
+        eytzinger_delete(e);
+    }
+
+    return result;
+}
+
+
+//A large index must agree with the sorted array it was built from
+static ch_word test2(i64* sorted)
+{
+    ch_word result = 1;
+    (void)sorted;
+
+    const ch_word count = 1000 * 1000;
+    i64* big = (i64*)malloc(count * sizeof(i64));
+    CH_ASSERT(big != NULL);
+    for(ch_word i = 0; i < count; i++){
+        big[i] = 3 * i;
+    }
+
+    ch_eytzinger_t* e = ch_eytzinger_new(big, count, sizeof(i64), cmp_i64);
+    for(i64 value = -1; value < 3 * count + 1; value += 7){
+        const ch_word lower = eytzinger_lower_bound(e, &value);
+        CH_ASSERT(lower == (value <= 0 ? 0 : MIN(count, (value + 2) / 3)));
+        const ch_word expected = value >= 0 && value % 3 == 0 && value / 3 < count ? value / 3 : -1;
+        CH_ASSERT(eytzinger_find(e, &value) == expected);
+    }
+
+    eytzinger_delete(e);
+    free(big);
+
+    return result;
+}
+
+
+define_ch_eytzinger_search(test_i64, i64, CH_SORT_LT)
+
+//The inlined searches must agree with the comparator function versions
+static ch_word test3(i64* sorted)
+{
+    ch_word result = 1;
+
+    for(ch_word count = 0; count < 70; count++){
+        ch_eytzinger_t* e = ch_eytzinger_new(sorted, count, sizeof(i64), cmp_i64);
+        for(i64 value = -2; value < 2 * count + 2; value++){
+            CH_ASSERT(test_i64_lower_bound(e, value) == eytzinger_lower_bound(e, &value));
+            CH_ASSERT(test_i64_upper_bound(e, value) == eytzinger_upper_bound(e, &value));
+        }
+        eytzinger_delete(e);
+    }
+
+    return result;
+}
+
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    //Sorted, with runs of duplicates and gaps
+    i64 sorted[70];
+    for(ch_word i = 0; i < 70; i++){
+        sorted[i] = i - i % 3 + i / 10;
+    }
+
+    ch_word test_pass = 0;
+    printf("CH Data Structures: Eytzinger Test 01: ");  printf("%s", (test_pass = test1(sorted)) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Eytzinger Test 02: ");  printf("%s", (test_pass = test2(sorted)) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Eytzinger Test 03: ");  printf("%s", (test_pass = test3(sorted)) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+
+    return 0;
+}
@@ -0,0 +1,158 @@
+// CamIO 2: test_hash.c
+// Copyright (C) 2013: Matthew P. Grosvenor (matthew.grosvenor@cl.cam.ac.uk)
+// Licensed under BSD 3 Clause, please see LICENSE for more details.
+
+#include "../hash_functions/hash.h"
+#include "../utils/util.h"
+
+#include <stdio.h>
+#include <string.h>
+
+
+//Known answer tests for CRC32C (RFC 3720 B.4 and the usual check value)
+static ch_word test1(u8* test_data, ch_word len)
+{
+    ch_word result = 1;
+    (void)test_data;
+    (void)len;
+
+    CH_ASSERT(ch_crc32c_sw(0, "123456789", 9) == 0xE3069283);
+
+    u8 zeros[32] = { 0 };
+    CH_ASSERT(ch_crc32c_sw(0, zeros, sizeof(zeros)) == 0x8A9136AA);
+
+    u8 ones[32];
+    memset(ones, 0xFF, sizeof(ones));
+    CH_ASSERT(ch_crc32c_sw(0, ones, sizeof(ones)) == 0x62A8AB43);
+
+    CH_ASSERT(ch_crc32c(0, "123456789", 9) == 0xE3069283);
+
+    return result;
+}
+
+
+//Hardware and software CRCs must agree for every length and alignment, and must be continuable
+static ch_word test2(u8* test_data, ch_word len)
+{
+    ch_word result = 1;
+
+    if(!ch_crc32c_hw_available()){
+        printf("(no SSE4.2, skipping) ");
+        return result;
+    }
+
+    for(ch_word off = 0; off < 8; off++){
+        for(ch_word i = 0; i < len - off; i++){
+            CH_ASSERT(ch_crc32c_hw(0, test_data + off, i) == ch_crc32c_sw(0, test_data + off, i));
+        }
+    }
+
+    const u32 whole = ch_crc32c_hw(0, test_data, len);
+    const u32 split = ch_crc32c_hw(ch_crc32c_hw(0, test_data, 13), test_data + 13, len - 13);
+    CH_ASSERT(whole == split);
+
+    return result;
+}
+
+
+//The two CRC based 64bit hashes must be identical
+static ch_word test3(u8* test_data, ch_word len)
+{
+    ch_word result = 1;
+
+    if(!ch_crc32c_hw_available()){
+        printf("(no SSE4.2, skipping) ");
+        return result;
+    }
+
+    for(ch_word i = 0; i < len; i++){
+        CH_ASSERT(ch_hash64_crc32c_hw(test_data, i, 0x1234) == ch_hash64_crc32c_sw(test_data, i, 0x1234));
+    }
+
+    return result;
+}
+
+
+//Every implementation is deterministic, depends on the seed, the length and on every byte of the key
+static ch_word test4(u8* test_data, ch_word len)
+{
+    ch_word result = 1;
+
+    ch_hash64_f impls[4] = { ch_hash64_spooky, ch_hash64_crc32c_sw, NULL, NULL };
+    if(ch_crc32c_hw_available()){
+        impls[2] = ch_hash64_crc32c_hw;
+    }
+    if(ch_aes_hash_available()){
+        impls[3] = ch_aes_hash64;
+    }
+
+    for(int i = 0; i < 4; i++){
+        if(!impls[i]){
+            continue;
+        }
+
+        ch_hash64_f h = impls[i];
+        CH_ASSERT(h(test_data, len, 1) == h(test_data, len, 1));
+        CH_ASSERT(h(test_data, len, 1) != h(test_data, len, 2));
+
+        //Zero padding in the tail must not collide
+        u8 zeros[16] = { 0 };
+        CH_ASSERT(h(zeros, 3, 0) != h(zeros, 4, 0));
+        CH_ASSERT(h(zeros, 0, 0) != h(zeros, 1, 0));
+
+        for(ch_word byte = 0; byte < len; byte++){
+            const u64 before = h(test_data, len, 7);
+            test_data[byte] ^= 0x01;
+            const u64 after = h(test_data, len, 7);
+            test_data[byte] ^= 0x01;
+            CH_ASSERT(before != after);
+        }
+    }
+
+    return result;
+}
+
+
+//The front door must be bound to something sensible and agree with the implementation it names
+static ch_word test5(u8* test_data, ch_word len)
+{
+    ch_word result = 1;
+
+    const char* name = ch_hash64_name();
+    printf("(using %s) ", name);
+
+    if(strcmp(name, "aes") == 0){
+        CH_ASSERT(ch_hash64(test_data, len, 99) == ch_aes_hash64(test_data, len, 99));
+    }
+    else if(strcmp(name, "crc32c") == 0){
+        CH_ASSERT(ch_hash64(test_data, len, 99) == ch_hash64_crc32c_sw(test_data, len, 99));
+    }
+    else{
+        CH_ASSERT(strcmp(name, "spooky") == 0);
+        CH_ASSERT(ch_hash64(test_data, len, 99) == ch_hash64_spooky(test_data, len, 99));
+    }
+
+    return result;
+}
+
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    u8 test_data[203];
+    for(u64 i = 0, x = 88172645463325252ULL; i < sizeof(test_data); i++){
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17; //xorshift64
+        test_data[i] = (u8)x;
+    }
+
+    ch_word test_pass = 0;
+    printf("CH Hash Functions: Test 01: ");  printf("%s", (test_pass = test1(test_data, sizeof(test_data))) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Hash Functions: Test 02: ");  printf("%s", (test_pass = test2(test_data, sizeof(test_data))) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Hash Functions: Test 03: ");  printf("%s", (test_pass = test3(test_data, sizeof(test_data))) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Hash Functions: Test 04: ");  printf("%s", (test_pass = test4(test_data, sizeof(test_data))) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Hash Functions: Test 05: ");  printf("%s", (test_pass = test5(test_data, sizeof(test_data))) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+
+    return 0;
+}
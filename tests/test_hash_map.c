@@ -268,12 +268,20 @@ static ch_word test7_i64(kv* test_data)
     CH_ASSERT(it1.key_size == sizeof(key1) || it1.key_size == sizeof(key2));
     CH_ASSERT(*(char**)it2.value == test_data[0].value || *(char**)it2.value == test_data[1].value );
 
+    //Keys may be duplicated, so the next item can have the same key, but it must be a different entry
     hash_map_next(hm1,&it2);
     CH_ASSERT(it2.key);
-    CH_ASSERT(*(u64*)it2.key != *(u64*)it1.key);
+    CH_ASSERT(*(u64*)it2.key == key1 || *(u64*)it2.key == key2);
     CH_ASSERT(it2.key_size == it1.key_size);
     CH_ASSERT(it2.value != it1.value);
 
+    //Every entry must be visited exactly once, regardless of which buckets the hash function chose
+    ch_word count = 0;
+    for(ch_hash_map_it it = hash_map_first(hm1); it.value; hash_map_next(hm1,&it)){
+        count++;
+    }
+    CH_ASSERT(count == 3);
+
     //dump_hash_map_i64(hm1);
 
     return result;
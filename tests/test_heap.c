@@ -0,0 +1,267 @@
+// CamIO 2: test_heap.c
+// Copyright (C) 2013: Matthew P. Grosvenor (matthew.grosvenor@cl.cam.ac.uk)
+// Licensed under BSD 3 Clause, please see LICENSE for more details.
+
+#include "../data_structs/heap/heap.h"
+#include "../data_structs/heap/heap_std.h"
+#include "../utils/util.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+typedef struct {
+    i64 key;
+    i64 id;
+} kv_t;
+
+static int cmp_kv(const void* lhs, const void* rhs)
+{
+    const i64 l = ((const kv_t*)lhs)->key, r = ((const kv_t*)rhs)->key;
+    return l < r ? -1 : l > r;
+}
+
+//Check the heap order, and that the slots and handles agree with each other
+static ch_bool check_heap(ch_heap_t* h)
+{
+    const ch_word* slot_handles = h->_slot_handles->first;
+    const ch_word* handle_slots = h->_handle_slots->first;
+    for(ch_word i = 0; i < h->count; i++){
+        const void* elem = (ch_byte*)h->_array->first + i * h->_element_size;
+        const void* parent = (ch_byte*)h->_array->first + (i - 1) / CH_HEAP_ARITY * h->_element_size;
+        if(i > 0 && h->_cmp(parent, elem) > 0){
+            return 0;
+        }
+        if(handle_slots[slot_handles[i]] != i){
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+
+//Push and pop against a model, on a generic heap
+static ch_word test1()
+{
+    ch_word result = 1;
+
+    CH_ASSERT(ch_heap_new(4, sizeof(i64), NULL) == NULL);
+
+    ch_heap_t* h = ch_heap_new(4, sizeof(kv_t), cmp_kv);
+    CH_ASSERT(h != NULL && h->count == 0);
+    CH_ASSERT(heap_peek(h) == NULL);
+    CH_ASSERT(heap_pop(h, NULL) == -1);
+
+    //Each id counts how often its key has been seen, so that pops can be matched against the model
+    i64 model[64] = {0};
+    srand(42);
+    for(ch_word i = 0; i < 2000; i++){
+        const kv_t kv = { rand() % 64, i };
+        const ch_word handle = heap_push(h, &kv);
+        CH_ASSERT(handle == i);
+        CH_ASSERT(((kv_t*)heap_get(h, handle))->id == i);
+        model[kv.key]++;
+    }
+    CH_ASSERT(h->count == 2000 && check_heap(h));
+
+    i64 prev = -1;
+    while(h->count){
+        const i64 top = ((kv_t*)heap_peek(h))->key;
+        kv_t kv;
+        CH_ASSERT(heap_pop(h, &kv) == 0);
+        CH_ASSERT(kv.key == top && kv.key >= prev);
+        model[kv.key]--;
+        prev = kv.key;
+        if(h->count % 100 == 0){
+            CH_ASSERT(check_heap(h));
+        }
+    }
+    for(ch_word i = 0; i < 64; i++){
+        CH_ASSERT(model[i] == 0);
+    }
+
+    heap_delete(h);
+    return result;
+}
+
+
+//Handles: decrease key, update, remove and reuse
+static ch_word test2()
+{
+    ch_word result = 1;
+
+    ch_heap_t* h = ch_heap_new(0, sizeof(i64), (cmp_void_f)ch_heap_cmp_i64);
+    CH_ASSERT(h != NULL);
+
+    ch_word handles[500];
+    i64 values[500];
+    ch_bool live[500];
+    srand(7);
+    for(ch_word i = 0; i < 500; i++){
+        values[i] = 1000 + rand() % 10000;
+        handles[i] = heap_push(h, &values[i]);
+        live[i] = 1;
+        CH_ASSERT(handles[i] == i);
+    }
+
+    //Decrease key only goes down
+    const i64 greater = values[0] + 1;
+    CH_ASSERT(heap_decrease_key(h, handles[0], &greater) == -1);
+    CH_ASSERT(*(i64*)heap_get(h, handles[0]) == values[0]);
+    CH_ASSERT(heap_decrease_key(h, 500, &greater) == -1);
+
+    for(ch_word step = 0; step < 5000; step++){
+        const ch_word i = rand() % 500;
+        const ch_word op = rand() % 4;
+        if(!live[i]){
+            CH_ASSERT(heap_get(h, handles[i]) == NULL);
+            values[i] = rand() % 20000;
+            handles[i] = heap_push(h, &values[i]);
+            live[i] = 1;
+            CH_ASSERT(handles[i] >= 0 && handles[i] < 500);
+        }
+        else if(op == 0){
+            const i64 value = values[i] - rand() % 100;
+            CH_ASSERT(heap_decrease_key(h, handles[i], &value) == 0);
+            values[i] = value;
+        }
+        else if(op == 1){
+            values[i] += rand() % 100;
+            CH_ASSERT(heap_update(h, handles[i], &values[i]) == 0);
+        }
+        else if(op == 2){
+            values[i] = rand() % 20000;
+            CH_ASSERT(heap_update(h, handles[i], &values[i]) == 0);
+        }
+        else{
+            i64 value;
+            CH_ASSERT(heap_remove(h, handles[i], &value) == 0);
+            CH_ASSERT(value == values[i]);
+            CH_ASSERT(heap_get(h, handles[i]) == NULL);
+            CH_ASSERT(heap_remove(h, handles[i], NULL) == -1);
+            //The handle may be given out again, so forget it
+            handles[i] = -1;
+            live[i] = 0;
+        }
+
+        CH_ASSERT(!live[i] || *(i64*)heap_get(h, handles[i]) == values[i]);
+        if(step % 250 == 0){
+            CH_ASSERT(check_heap(h));
+        }
+    }
+
+    //The top is always the smallest live value
+    ch_word count = 0;
+    for(ch_word i = 0; i < 500; i++){
+        count += live[i];
+    }
+    CH_ASSERT(h->count == count && check_heap(h));
+    while(h->count){
+        i64 min = -1;
+        ch_word min_i = -1;
+        for(ch_word i = 0; i < 500; i++){
+            if(live[i] && (min_i < 0 || values[i] < min)){
+                min = values[i];
+                min_i = i;
+            }
+        }
+        i64 value;
+        CH_ASSERT(heap_pop(h, &value) == 0 && value == min);
+        live[min_i] = 0;
+    }
+
+    heap_delete(h);
+    return result;
+}
+
+
+//Heapify from a C array
+static ch_word test3()
+{
+    ch_word result = 1;
+
+    ch_heap_t* h = ch_heap_new(2, sizeof(kv_t), cmp_kv);
+    CH_ASSERT(heap_heapify(h, NULL, 0) == 0 && h->count == 0);
+
+    const kv_t one = { 5, 0 };
+    CH_ASSERT(heap_heapify(h, &one, 1) == 0 && h->count == 1);
+    CH_ASSERT(((kv_t*)heap_peek(h))->key == 5);
+
+    kv_t data[1000];
+    for(ch_word i = 0; i < 1000; i++){
+        data[i].key = (i * 7919) % 1000;
+        data[i].id = i;
+    }
+    heap_push(h, &one);
+    CH_ASSERT(heap_heapify(h, data, 1000) == 0);
+    CH_ASSERT(h->count == 1000 && check_heap(h));
+
+    //carray[i] has handle i
+    for(ch_word i = 0; i < 1000; i++){
+        CH_ASSERT(((kv_t*)heap_get(h, i))->id == i);
+    }
+
+    for(ch_word i = 0; i < 1000; i++){
+        kv_t kv;
+        CH_ASSERT(heap_pop(h, &kv) == 0 && kv.key == i);
+    }
+
+    //Handles are reused after a clear
+    heap_clear(h);
+    CH_ASSERT(h->count == 0 && heap_push(h, &one) == 0);
+
+    heap_delete(h);
+    return result;
+}
+
+
+//Typed heap
+static ch_word test4()
+{
+    ch_word result = 1;
+
+    CH_HEAP(i64)* h = CH_HEAP_NEW(i64, 8, CH_HEAP_CMP(i64));
+    CH_ASSERT(h != NULL && h->count == 0 && h->peek(h) == NULL);
+
+    const i64 data[10] = {8,5,1,3,4,6,7,9,7,1};
+    for(ch_word i = 0; i < 10; i++){
+        CH_ASSERT(h->push(h, data[i]) == i);
+    }
+    CH_ASSERT(h->count == 10 && *h->peek(h) == 1);
+
+    CH_ASSERT(h->decrease_key(h, 0, -3) == 0 && *h->peek(h) == -3);
+    CH_ASSERT(h->update(h, 0, 100) == 0 && *h->get(h, 0) == 100);
+    i64 value;
+    CH_ASSERT(h->remove(h, 7, &value) == 0 && value == 9 && h->count == 9);
+
+    const i64 expected[9] = {1,1,3,4,5,6,7,7,100};
+    for(ch_word i = 0; i < 9; i++){
+        CH_ASSERT(h->pop(h, &value) == 0 && value == expected[i]);
+    }
+    CH_ASSERT(h->count == 0 && h->pop(h, &value) == -1);
+
+    CH_ASSERT(h->heapify(h, data, 10) == 0 && h->count == 10);
+    CH_ASSERT(ch_heap_i64_pop(h, NULL) == 0 && *ch_heap_i64_peek(h) == 1);
+    h->clear(h);
+    CH_ASSERT(h->count == 0);
+
+    h->delete(h);
+    return result;
+}
+
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    ch_word test_pass = 0;
+    printf("CH Data Structures: Heap Test 01: ");  printf("%s", (test_pass = test1()) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Heap Test 02: ");  printf("%s", (test_pass = test2()) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Heap Test 03: ");  printf("%s", (test_pass = test3()) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Heap Test 04: ");  printf("%s", (test_pass = test4()) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+
+    return 0;
+}
@@ -0,0 +1,96 @@
+// CamIO 2: test_ilist.c
+// Copyright (C) 2013: Matthew P. Grosvenor (matthew.grosvenor@cl.cam.ac.uk)
+// Licensed under BSD 3 Clause, please see LICENSE for more details.
+
+#include "../data_structs/linked_list/intrusive_list.h"
+#include "../utils/util.h"
+
+#include <stdio.h>
+
+typedef struct {
+    ch_word id;
+    ch_llist_node_t by_id; //On one list
+    ch_word weight;
+    ch_llist_node_t odd; //And maybe on another
+} obj_t;
+
+
+//Objects are linked in place, in the order asked for, and can be on two lists at once
+static ch_word test1(void)
+{
+    ch_word result = 1;
+
+    obj_t objs[100];
+    ch_ilist_t all, odd;
+    ilist_init(&all);
+    ilist_init(&odd);
+    CH_ASSERT(ilist_first(&all) == NULL && ilist_pop_front(&all) == NULL && ilist_pop_back(&all) == NULL);
+
+    for(ch_word i = 0; i < 100; i++){
+        objs[i].id = i;
+        objs[i].weight = 0;
+        ilist_push_back(&all, &objs[i].by_id);
+        if(i & 1){
+            ilist_push_front(&odd, &objs[i].odd);
+        }
+    }
+    CH_ASSERT(all.count == 100 && odd.count == 50);
+    CH_ASSERT(CH_ILIST_ENTRY(ilist_first(&all), obj_t, by_id) == &objs[0]);
+    CH_ASSERT(CH_ILIST_ENTRY(ilist_last(&odd), obj_t, odd) == &objs[1]);
+
+    ch_word expected = 0;
+    CH_ILIST_FOREACH(&all, obj_t, by_id, it){
+        CH_ASSERT(it->id == expected);
+        it->weight++;
+        expected++;
+    }
+    CH_ASSERT(expected == 100);
+
+    expected = 99;
+    CH_ILIST_FOREACH(&odd, obj_t, odd, it){
+        CH_ASSERT(it->id == expected);
+        it->weight++;
+        expected -= 2;
+    }
+    CH_ASSERT(objs[98].weight == 1 && objs[99].weight == 2);
+
+    //Remove every odd object from the first list while walking the second
+    CH_ILIST_FOREACH_SAFE(&odd, obj_t, odd, it){
+        ilist_remove(&all, &it->by_id);
+        ilist_remove(&odd, &it->odd);
+    }
+    CH_ASSERT(odd.count == 0 && ilist_first(&odd) == NULL && ilist_last(&odd) == NULL);
+    CH_ASSERT(all.count == 50);
+    expected = 0;
+    CH_ILIST_FOREACH(&all, obj_t, by_id, it){
+        CH_ASSERT(it->id == expected);
+        expected += 2;
+    }
+
+    //Put 1 back in its place, and 99 at the end
+    ilist_insert_after(&all, &objs[0].by_id, &objs[1].by_id);
+    ilist_insert_before(&all, NULL, &objs[99].by_id);
+    ilist_insert_before(&all, &objs[0].by_id, &objs[97].by_id);
+    CH_ASSERT(all.count == 53);
+    CH_ASSERT(ilist_pop_front(&all) == &objs[97].by_id);
+    CH_ASSERT(ilist_pop_back(&all) == &objs[99].by_id);
+    CH_ASSERT(objs[0].by_id.next == &objs[1].by_id && objs[2].by_id.prev == &objs[1].by_id);
+
+    while(ilist_pop_back(&all)){
+    }
+    CH_ASSERT(all.count == 0 && ilist_first(&all) == NULL);
+
+    return result;
+}
+
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    ch_word test_pass = 0;
+    printf("CH Data Structures: Intrusive List Test 01: ");  printf("%s", (test_pass = test1()) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+
+    return 0;
+}
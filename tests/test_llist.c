@@ -478,6 +478,151 @@ static ch_word test8_i64(i64* test_data)
 }
 
 
+//Lists that take their nodes from a pool, shared or private
+static ch_word test9_i64(i64* test_data)
+{
+    ch_word result = 1;
+
+    ch_pool_t* pool = llist_pool_new(sizeof(i64));
+    CH_ASSERT(pool != NULL && pool->count == 0 && pool->slabs == 0);
+    CH_ASSERT(ch_llist_new_pooled(sizeof(i64) * 8, cmp_i64, pool) == NULL);
+
+    ch_llist_t* ll1 = ch_llist_new_pooled(sizeof(i64), cmp_i64, pool);
+    ch_llist_t* ll2 = ch_llist_new_pooled(sizeof(i64), cmp_i64, pool);
+    for(ch_word i = 0; i < 10000; i++){
+        const i64 value = test_data[i % 15];
+        CH_ASSERT(*(i64*)llist_push_back(ll1, &value).value == value);
+        CH_ASSERT(*(i64*)llist_push_front(ll2, &i).value == i);
+    }
+    CH_ASSERT(pool->count == 20000 && pool->slabs > 1);
+
+    //Freed nodes are reused before any more slabs are taken
+    const ch_word slabs = pool->slabs;
+    for(ch_word i = 0; i < 5000; i++){
+        llist_pop_front(ll1);
+    }
+    for(ch_word i = 0; i < 5000; i++){
+        llist_push_back(ll2, &i);
+    }
+    CH_ASSERT(pool->count == 20000 && pool->slabs == slabs);
+    CH_ASSERT(ll1->count == 5000 && ll2->count == 15000);
+    CH_ASSERT(*(i64*)llist_first(ll2).value == 9999 && *(i64*)llist_last(ll2).value == 4999);
+
+    llist_pop_all(ll1);
+    CH_ASSERT(ll1->count == 0 && llist_first(ll1).value == NULL && pool->count == 15000);
+    llist_delete(ll1);
+    llist_delete(ll2);
+    CH_ASSERT(pool->count == 0);
+    pool_delete(pool);
+
+    //A private pool is cleared in one go
+    ch_llist_t* ll3 = ch_llist_new_pooled(sizeof(i64), cmp_i64, NULL);
+    llist_push_back_carray(ll3, test_data, 15);
+    CH_ASSERT(ll3->count == 15 && ll3->_own_pool && ll3->_pool->count == 15);
+    llist_pop_all(ll3);
+    CH_ASSERT(ll3->count == 0 && ll3->_pool->count == 0 && ll3->_pool->slabs == 1);
+    llist_push_back_carray(ll3, test_data, 15);
+    CH_ASSERT(*(i64*)llist_last(ll3).value == test_data[14]);
+    llist_delete(ll3);
+
+    //A list on the stack can't own a pool, since nothing would delete it
+    ch_llist_t ll4;
+    CH_ASSERT(ch_llist_init_pooled(&ll4, sizeof(i64), cmp_i64, NULL) == NULL);
+    pool = llist_pool_new(sizeof(i64));
+    CH_ASSERT(ch_llist_init_pooled(&ll4, sizeof(i64), cmp_i64, pool) == &ll4 && !ll4._own_pool);
+    llist_push_back_carray(&ll4, test_data, 15);
+    CH_ASSERT(ll4.count == 15 && pool->count == 15);
+    llist_pop_all(&ll4);
+    CH_ASSERT(ll4.count == 0 && pool->count == 0);
+    pool_delete(pool);
+
+    return result;
+}
+
+
+typedef struct {
+    i64 key;
+    i64 seq;
+} keyed_t;
+
+static int cmp_keyed(const void* lhs, const void* rhs)
+{
+    return cmp_i64(&((const keyed_t*)lhs)->key, &((const keyed_t*)rhs)->key);
+}
+
+//Sorting, and sorted inserts
+static ch_word test10_i64(i64* test_data)
+{
+    ch_word result = 1;
+
+    //Empty and single element lists are fine
+    ch_llist_t* ll1 = ch_llist_new(sizeof(i64),cmp_i64);
+    llist_sort(ll1);
+    CH_ASSERT(ll1->count == 0 && llist_first(ll1).value == NULL);
+    llist_push_back(ll1, &test_data[0]);
+    llist_sort(ll1);
+    CH_ASSERT(*(i64*)llist_first(ll1).value == test_data[0] && llist_first(ll1)._node == llist_last(ll1)._node);
+
+    //Sorting relinks the nodes, so element addresses don't change
+    llist_pop_all(ll1);
+    llist_push_back_carray(ll1, test_data, 15);
+    void* addresses[15];
+    ch_word i = 0;
+    for(ch_llist_it it = llist_first(ll1); it.value; llist_next(ll1, &it)){
+        addresses[i++] = it.value;
+    }
+    llist_sort(ll1);
+    i64 sorted[15] = {0,1,1,1,1,3,4,5,6,6,6,7,7,8,9};
+    i = 0;
+    for(ch_llist_it it = llist_first(ll1); it.value; llist_next(ll1, &it)){
+        CH_ASSERT(*(i64*)it.value == sorted[i]);
+        i++;
+    }
+    CH_ASSERT(i == 15 && ll1->count == 15);
+    CH_ASSERT(llist_first(ll1).value == addresses[12] && llist_last(ll1).value == addresses[7]);
+
+    //The prev links are right too
+    i = 14;
+    for(ch_llist_it it = llist_last(ll1); it._node; it._node = it._node->prev){
+        CH_ASSERT(*(i64*)NODE_DATAP(it._node) == sorted[i]);
+        i--;
+    }
+    CH_ASSERT(i == -1);
+
+    //Merge more in, before any existing equal elements
+    llist_insert_carray_ordered(ll1, test_data, 15);
+    CH_ASSERT(ll1->count == 30);
+    i = 0;
+    for(ch_llist_it it = llist_first(ll1); it.value; llist_next(ll1, &it)){
+        CH_ASSERT(*(i64*)it.value == sorted[i / 2]);
+        i++;
+    }
+    CH_ASSERT(llist_last(ll1).value == addresses[7]);
+    llist_delete(ll1);
+
+    //Big, and stable
+    ch_llist_t* ll2 = ch_llist_new(sizeof(keyed_t),cmp_keyed);
+    for(i = 0; i < 10007; i++){
+        const keyed_t value = { .key = (i * 7919) % 101, .seq = i };
+        llist_push_back(ll2, &value);
+    }
+    llist_sort(ll2);
+    CH_ASSERT(ll2->count == 10007);
+    keyed_t* prev = NULL;
+    for(ch_llist_it it = llist_first(ll2); it.value; llist_next(ll2, &it)){
+        keyed_t* value = it.value;
+        if(prev){
+            CH_ASSERT(prev->key < value->key || (prev->key == value->key && prev->seq < value->seq));
+        }
+        prev = value;
+    }
+    CH_ASSERT(llist_last(ll2).value == prev);
+    llist_delete(ll2);
+
+    return result;
+}
+
+
 
 int main(int argc, char** argv)
 {
@@ -497,8 +642,8 @@ int main(int argc, char** argv)
     printf("CH Data Structures: Generic Linked List Test 06: ");  printf("%s", (test_result = test6_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_result) return 1;
     printf("CH Data Structures: Generic Linked List Test 07: ");  printf("%s", (test_result = test7_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_result) return 1;
     printf("CH Data Structures: Generic Linked List Test 08: ");  printf("%s", (test_result = test8_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_result) return 1;
-//    printf("CH Data Structures: Generic Linked List Test 09: ");  printf("%s", (test_result = test9_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_result) return 1;
-//    printf("CH Data Structures: Generic Linked List Test 10: ");  printf("%s", (test_result = test10_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_result) return 1;
+    printf("CH Data Structures: Generic Linked List Test 09: ");  printf("%s", (test_result = test9_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_result) return 1;
+    printf("CH Data Structures: Generic Linked List Test 10: ");  printf("%s", (test_result = test10_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_result) return 1;
 //    printf("CH Data Structures: Generic Linked List Test 11: ");  printf("%s", (test_result = test11_i64(test_array, test_array_sorted)) ? "PASS\n" : "FAIL\n"); if(!test_result) return 1;
 //    printf("CH Data Structures: Generic Linked List Test 12: ");  printf("%s", (test_result = test12_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_result) return 1;
 //    printf("CH Data Structures: Generic Linked List Test 13: ");  printf("%s", (test_result = test13_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_result) return 1;
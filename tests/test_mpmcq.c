@@ -0,0 +1,198 @@
+// CamIO 2: test_mpmcq.c
+// Copyright (C) 2013: Matthew P. Grosvenor (matthew.grosvenor@cl.cam.ac.uk)
+// Licensed under BSD 3 Clause, please see LICENSE for more details.
+
+#include "../data_structs/mpmc_queue/mpmc_queue.h"
+#include "../utils/util.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+typedef struct {
+    i64 producer;
+    i64 seq;
+    char pad[3]; //Odd sized elements
+} msg_t;
+
+
+//Single and batch pushes and pops from one thread, around the ring a few times
+static ch_word test1()
+{
+    ch_word result = 1;
+
+    CH_ASSERT(ch_mpmcq_new(0, sizeof(msg_t)) == NULL);
+    CH_ASSERT(ch_mpmcq_new(8, 0) == NULL);
+
+    ch_mpmcq_t* q = ch_mpmcq_new(6, sizeof(msg_t));
+    CH_ASSERT(q != NULL && q->size == 8 && mpmcq_count(q) == 0);
+
+    msg_t msg = {0};
+    CH_ASSERT(mpmcq_try_pop(q, &msg) == -1);
+    CH_ASSERT(mpmcq_try_pop_carray(q, &msg, 4) == 0);
+
+    i64 pushed = 0;
+    i64 popped = 0;
+    for(ch_word lap = 0; lap < 5; lap++){
+        //Fill it with a mix of single and batch pushes
+        msg_t batch[16];
+        for(ch_word i = 0; i < 16; i++){
+            batch[i].producer = 0;
+            batch[i].seq = pushed + 1 + i;
+        }
+        msg.seq = pushed;
+        CH_ASSERT(mpmcq_try_push(q, &msg) == 0);
+        pushed++;
+        CH_ASSERT(mpmcq_try_push_carray(q, batch, 16) == 7);
+        pushed += 7;
+        CH_ASSERT(mpmcq_count(q) == 8);
+        CH_ASSERT(mpmcq_try_push(q, &msg) == -1);
+        CH_ASSERT(mpmcq_try_push_carray(q, batch, 2) == 0);
+
+        //Empty it in order
+        CH_ASSERT(mpmcq_try_pop(q, &msg) == 0 && msg.seq == popped);
+        popped++;
+        CH_ASSERT(mpmcq_try_pop_carray(q, batch, 3) == 3);
+        for(ch_word i = 0; i < 3; i++){
+            CH_ASSERT(batch[i].seq == popped++);
+        }
+        CH_ASSERT(mpmcq_try_pop_carray(q, batch, 16) == 4);
+        for(ch_word i = 0; i < 4; i++){
+            CH_ASSERT(batch[i].seq == popped++);
+        }
+        CH_ASSERT(mpmcq_count(q) == 0 && mpmcq_try_pop(q, &msg) == -1);
+
+        //Leave it part full, so the next lap starts somewhere else in the ring
+        msg.seq = pushed++;
+        CH_ASSERT(mpmcq_try_push(q, &msg) == 0);
+        CH_ASSERT(mpmcq_try_pop(q, &msg) == 0 && msg.seq == popped++);
+    }
+
+    mpmcq_delete(q);
+    return result;
+}
+
+
+#define PRODUCERS 4
+#define CONSUMERS 3
+#define MESSAGES  (200 * 1000)
+
+static ch_mpmcq_t* queue;
+static i64 consumed_sum[CONSUMERS];
+static ch_word consumed_count[CONSUMERS];
+static ch_word order_errors[CONSUMERS];
+static ch_word remaining = PRODUCERS * MESSAGES;
+
+static void* producer(void* arg)
+{
+    const i64 id = (i64)(intptr_t)arg;
+    msg_t batch[8] = {{0}};
+    for(i64 seq = 0; seq < MESSAGES; ){
+        //Odd producers push in batches
+        ch_word pushed;
+        if(id & 1){
+            const ch_word len = MIN(8, MESSAGES - seq);
+            for(ch_word i = 0; i < len; i++){
+                batch[i].producer = id;
+                batch[i].seq = seq + i;
+            }
+            pushed = mpmcq_try_push_carray(queue, batch, len);
+        }
+        else{
+            batch[0].producer = id;
+            batch[0].seq = seq;
+            pushed = mpmcq_try_push(queue, batch) == 0;
+        }
+
+        seq += pushed;
+        if(!pushed){
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+//Each consumer checks that it sees each producer's messages in order
+static void* consumer(void* arg)
+{
+    const ch_word id = (ch_word)(intptr_t)arg;
+    i64 last[PRODUCERS];
+    for(ch_word i = 0; i < PRODUCERS; i++){
+        last[i] = -1;
+    }
+
+    msg_t batch[4];
+    while(__atomic_load_n(&remaining, __ATOMIC_RELAXED) > 0){
+        const ch_word popped = id & 1 ? mpmcq_try_pop_carray(queue, batch, 4) : mpmcq_try_pop(queue, batch) == 0;
+        if(!popped){
+            sched_yield();
+            continue;
+        }
+
+        for(ch_word i = 0; i < popped; i++){
+            order_errors[id] += batch[i].seq <= last[batch[i].producer];
+            last[batch[i].producer] = batch[i].seq;
+            consumed_sum[id] += batch[i].seq;
+        }
+        consumed_count[id] += popped;
+        __atomic_sub_fetch(&remaining, popped, __ATOMIC_RELAXED);
+    }
+
+    return NULL;
+}
+
+//Several producers and consumers, through a small queue
+static ch_word test2()
+{
+    ch_word result = 1;
+
+    queue = ch_mpmcq_new(64, sizeof(msg_t));
+    pthread_t producers[PRODUCERS];
+    pthread_t consumers[CONSUMERS];
+    for(ch_word i = 0; i < CONSUMERS; i++){
+        CH_ASSERT(pthread_create(&consumers[i], NULL, consumer, (void*)(intptr_t)i) == 0);
+    }
+    for(ch_word i = 0; i < PRODUCERS; i++){
+        CH_ASSERT(pthread_create(&producers[i], NULL, producer, (void*)(intptr_t)i) == 0);
+    }
+    for(ch_word i = 0; i < PRODUCERS; i++){
+        pthread_join(producers[i], NULL);
+    }
+    for(ch_word i = 0; i < CONSUMERS; i++){
+        pthread_join(consumers[i], NULL);
+    }
+
+    i64 sum = 0;
+    ch_word count = 0;
+    ch_word errors = 0;
+    for(ch_word i = 0; i < CONSUMERS; i++){
+        sum += consumed_sum[i];
+        count += consumed_count[i];
+        errors += order_errors[i];
+    }
+    const i64 expected = (i64)PRODUCERS * MESSAGES * (MESSAGES - 1) / 2;
+    CH_ASSERT(count == PRODUCERS * MESSAGES);
+    CH_ASSERT(sum == expected);
+    CH_ASSERT(errors == 0);
+    CH_ASSERT(mpmcq_count(queue) == 0);
+
+    mpmcq_delete(queue);
+    return result;
+}
+
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    ch_word test_pass = 0;
+    printf("CH Data Structures: MPMC Queue Test 01: ");  printf("%s", (test_pass = test1()) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: MPMC Queue Test 02: ");  printf("%s", (test_pass = test2()) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+
+    return 0;
+}
@@ -0,0 +1,205 @@
+// CamIO 2: test_skip_list.c
+// Copyright (C) 2013: Matthew P. Grosvenor (matthew.grosvenor@cl.cam.ac.uk)
+// Licensed under BSD 3 Clause, please see LICENSE for more details.
+
+#include "../data_structs/skip_list/skip_list.h"
+#include "../utils/util.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+typedef struct {
+    i64 key;
+    i64 seq;
+} kv_t;
+
+//Order by key only, so that the seq shows the order of equal elements
+static int cmp_kv(const void* lhs, const void* rhs)
+{
+    const i64 l = ((const kv_t*)lhs)->key, r = ((const kv_t*)rhs)->key;
+    return l < r ? -1 : l > r;
+}
+
+static int cmp_i64(const void* lhs, const void* rhs)
+{
+    const i64 l = *(const i64*)lhs, r = *(const i64*)rhs;
+    return l < r ? -1 : l > r;
+}
+
+
+//Ordered inserts, duplicates, searches and ranges
+static ch_word test1(i64* test_data)
+{
+    ch_word result = 1;
+
+    CH_ASSERT(ch_skip_list_new(sizeof(kv_t), NULL) == NULL);
+
+    ch_skip_list_t* sl = ch_skip_list_new(sizeof(kv_t), cmp_kv);
+    CH_ASSERT(sl != NULL && sl->count == 0);
+    CH_ASSERT(skip_list_first(sl).value == NULL && skip_list_last(sl).value == NULL);
+
+    for(ch_word i = 0; i < 15; i++){
+        const kv_t kv = { test_data[i], i };
+        const ch_skip_list_it it = skip_list_insert(sl, &kv);
+        CH_ASSERT(it.value && ((kv_t*)it.value)->seq == i);
+    }
+    CH_ASSERT(sl->count == 15);
+
+    //Sorted by key, and equal keys in insertion order
+    const kv_t* prev = NULL;
+    CH_SKIP_LIST_FOREACH(sl, it){
+        const kv_t* kv = it.value;
+        CH_ASSERT(!prev || prev->key < kv->key || (prev->key == kv->key && prev->seq < kv->seq));
+        prev = kv;
+    }
+    CH_ASSERT(prev && prev->key == 9);
+    CH_ASSERT(((kv_t*)skip_list_first(sl).value)->key == 0);
+    CH_ASSERT(((kv_t*)skip_list_last(sl).value)->key == 9);
+
+    kv_t probe = { 1, 0 };
+    ch_skip_list_it it = skip_list_find(sl, &probe);
+    CH_ASSERT(it.value && ((kv_t*)it.value)->seq == 2);
+    it = skip_list_upper_bound(sl, &probe);
+    CH_ASSERT(it.value && ((kv_t*)it.value)->key == 3);
+    probe.key = 2;
+    CH_ASSERT(skip_list_find(sl, &probe).value == NULL);
+    it = skip_list_lower_bound(sl, &probe);
+    CH_ASSERT(it.value && ((kv_t*)it.value)->key == 3);
+    probe.key = 10;
+    CH_ASSERT(skip_list_lower_bound(sl, &probe).value == NULL);
+
+    //[1, 7) holds the four 1s, 3, 4, 5 and the three 6s
+    const kv_t lo = { 1, 0 }, hi = { 7, 0 };
+    ch_skip_list_it begin, end;
+    CH_ASSERT(skip_list_range(sl, &lo, &hi, &begin, &end) == 10);
+    CH_ASSERT(((kv_t*)begin.value)->key == 1 && ((kv_t*)end.value)->key == 7);
+    CH_ASSERT(skip_list_range(sl, &hi, &lo, &begin, &end) == 0 && begin._node == end._node);
+
+    //Removing by value takes out the first of the equal elements
+    probe.key = 6;
+    CH_ASSERT(skip_list_remove(sl, &probe) == 1);
+    CH_ASSERT(((kv_t*)skip_list_find(sl, &probe).value)->seq == 10);
+    probe.key = 2;
+    CH_ASSERT(skip_list_remove(sl, &probe) == 0);
+    CH_ASSERT(sl->count == 14);
+
+    //Removing by iterator can take any of them
+    probe.key = 1;
+    it = skip_list_find(sl, &probe);
+    skip_list_next(sl, &it);
+    skip_list_next(sl, &it);
+    CH_ASSERT(((kv_t*)it.value)->seq == 11);
+    it = skip_list_remove_it(sl, &it);
+    CH_ASSERT(((kv_t*)it.value)->seq == 13);
+    it = skip_list_find(sl, &probe);
+    CH_ASSERT(((kv_t*)it.value)->seq == 2);
+    skip_list_next(sl, &it);
+    CH_ASSERT(((kv_t*)it.value)->seq == 9);
+
+    //Walk backwards
+    ch_word count = 0;
+    prev = NULL;
+    for(it = skip_list_last(sl); it.value; skip_list_prev(sl, &it)){
+        const kv_t* kv = it.value;
+        CH_ASSERT(!prev || prev->key >= kv->key);
+        prev = kv;
+        count++;
+    }
+    CH_ASSERT(count == sl->count && count == 13);
+
+    skip_list_pop_all(sl);
+    CH_ASSERT(sl->count == 0 && skip_list_first(sl).value == NULL && skip_list_last(sl).value == NULL);
+    probe.key = 1;
+    CH_ASSERT(skip_list_find(sl, &probe).value == NULL);
+
+    skip_list_delete(sl);
+    return result;
+}
+
+
+//Random inserts and removes, against a sorted array
+static ch_word test2(void)
+{
+    ch_word result = 1;
+
+    ch_skip_list_t* sl = ch_skip_list_new(sizeof(i64), cmp_i64);
+    static i64 model[8192];
+    ch_word model_count = 0;
+    u64 seed = 42;
+
+    for(ch_word step = 0; step < 30000; step++){
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        const ch_word r = (ch_word)(seed >> 33);
+        const i64 value = (r >> 3) & 0x3ff;
+
+        if(model_count < 4000 && (r & 0x3) != 0){
+            const ch_skip_list_it it = skip_list_insert(sl, &value);
+            CH_ASSERT(it.value && *(i64*)it.value == value);
+
+            ch_word pos = model_count;
+            while(pos > 0 && model[pos - 1] > value){
+                pos--;
+            }
+            memmove(&model[pos + 1], &model[pos], (model_count - pos) * sizeof(i64));
+            model[pos] = value;
+            model_count++;
+        }
+        else{
+            ch_word pos = 0;
+            while(pos < model_count && model[pos] < value){
+                pos++;
+            }
+            const ch_bool found = pos < model_count && model[pos] == value;
+            CH_ASSERT(skip_list_remove(sl, &value) == (found ? 1 : 0));
+            if(found){
+                memmove(&model[pos], &model[pos + 1], (model_count - pos - 1) * sizeof(i64));
+                model_count--;
+            }
+        }
+
+        if(step % 1000 == 0){
+            ch_word i = 0;
+            CH_SKIP_LIST_FOREACH(sl, it){
+                CH_ASSERT(*(i64*)it.value == model[i]);
+                i++;
+            }
+            CH_ASSERT(i == model_count && sl->count == model_count);
+
+            const i64 lo = 100, hi = 200;
+            ch_word expected = 0;
+            for(i = 0; i < model_count; i++){
+                expected += model[i] >= lo && model[i] < hi;
+            }
+            ch_skip_list_it begin, end;
+            CH_ASSERT(skip_list_range(sl, &lo, &hi, &begin, &end) == expected);
+        }
+    }
+
+    //Drain it from the back with remove_it
+    for(ch_skip_list_it it = skip_list_last(sl); it.value; it = skip_list_last(sl)){
+        CH_ASSERT(*(i64*)it.value == model[model_count - 1]);
+        CH_ASSERT(skip_list_remove_it(sl, &it).value == NULL);
+        model_count--;
+    }
+    CH_ASSERT(model_count == 0 && sl->count == 0 && sl->_level == 0);
+
+    skip_list_delete(sl);
+    return result;
+}
+
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    i64 test_array[15] = {8,5,1,3,4,6,7,9,7,1,6,1,0,1,6};
+
+    ch_word test_pass = 0;
+    printf("CH Data Structures: Skip List Test 01: ");  printf("%s", (test_pass = test1(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Skip List Test 02: ");  printf("%s", (test_pass = test2()) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+
+    return 0;
+}
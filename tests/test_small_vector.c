@@ -0,0 +1,191 @@
+// CamIO 2: test_small_vector.c
+// Copyright (C) 2013: Matthew P. Grosvenor (matthew.grosvenor@cl.cam.ac.uk)
+// Licensed under BSD 3 Clause, please see LICENSE for more details.
+
+#include "../data_structs/small_vector/small_vector_typed_define_template.h"
+#include "../utils/util.h"
+
+#include <stdio.h>
+
+declare_ch_small_vector(i64, i64, 4)
+define_ch_small_vector(i64, i64, 4)
+
+//With the order inlined, and radix sorting
+declare_ch_small_vector(i64s, i64, 8)
+declare_ch_small_vector_cmp(i64s, i64)
+define_ch_small_vector_cmp(i64s, i64)
+define_ch_small_vector_std_radix(i64s, i64, 8, CH_SORT_LT, u64, CH_RADIX_KEY_SIGNED, CH_FIND_EQ_INT)
+
+
+static ch_word cmp_i64(i64* lhs, i64* rhs)
+{
+    return *lhs < *rhs ? -1 : *lhs > *rhs;
+}
+
+
+//Stays inline up to N elements, then spills to the heap and keeps its contents
+static ch_word test1(i64* test_data)
+{
+    ch_word result = 1;
+
+    CH_SMALL_VECTOR(i64)* v = CH_SMALL_VECTOR_NEW(i64, 0, cmp_i64);
+    CH_ASSERT(v != NULL && v->size == 4 && v->count == 0);
+    CH_ASSERT(v->first == v->end && v->first == v->_inline);
+
+    for(ch_word i = 0; i < 4; i++){
+        CH_ASSERT(*v->push_back(v, test_data[i]) == test_data[i]);
+    }
+    CH_ASSERT(v->_heap == NULL && v->first == v->_inline && v->last == v->first + 3);
+
+    for(ch_word i = 4; i < 15; i++){
+        CH_ASSERT(*ch_small_vector_i64_push_back(v, test_data[i]) == test_data[i]);
+    }
+    CH_ASSERT(v->_heap != NULL && v->first == v->_heap && v->count == 15 && v->size >= 15);
+    for(ch_word i = 0; i < 15; i++){
+        CH_ASSERT(*v->off(v, i) == test_data[i]);
+        CH_ASSERT(*ch_small_vector_i64_off(v, i) == test_data[i]);
+    }
+    CH_ASSERT(*v->off(v, -1) == test_data[14]);
+    CH_ASSERT(*ch_small_vector_i64_off(v, -1) == test_data[14] && *ch_small_vector_i64_off(v, -15) == test_data[0]);
+
+    //Shrinking back to N moves back inline
+    v->resize(v, 2);
+    CH_ASSERT(v->_heap == NULL && v->first == v->_inline && v->count == 4 && v->size == 4);
+    CH_ASSERT(*v->last == test_data[3]);
+
+    ch_small_vector_i64_pop_back(v);
+    v->pop_back(v);
+    CH_ASSERT(v->count == 2 && *v->last == test_data[1]);
+    v->clear(v);
+    CH_ASSERT(v->count == 0 && v->first == v->end);
+    v->pop_back(v);
+    CH_ASSERT(v->count == 0);
+
+    v->delete(v);
+    return result;
+}
+
+
+//Inserts, removes and the comparator functions
+static ch_word test2(i64* test_data)
+{
+    ch_word result = 1;
+
+    CH_SMALL_VECTOR(i64)* v = CH_SMALL_VECTOR_NEW(i64, 10, cmp_i64);
+    CH_ASSERT(v->size == 10 && v->_heap != NULL);
+    v->push_back_carray(v, test_data, 15);
+    CH_ASSERT(v->count == 15 && *v->last == test_data[14]);
+
+    v->push_front(v, -1);
+    v->insert_after(v, v->first, -2);
+    v->insert_before(v, v->end, -3);
+    CH_ASSERT(v->count == 18 && v->first[0] == -1 && v->first[1] == -2 && *v->last == -3);
+
+    CH_ASSERT(*v->remove(v, v->first + 1) == test_data[0]);
+    CH_ASSERT(v->remove(v, v->last) == NULL);
+    v->pop_front(v);
+    CH_ASSERT(v->count == 15 && *v->first == test_data[0]);
+
+    CH_ASSERT(v->find(v, v->first, v->end, 9) == v->first + 7);
+    CH_ASSERT(v->find(v, v->first, v->end, 100) == NULL);
+    CH_ASSERT(v->get_idx(v, v->first + 7) == 7);
+
+    v->sort(v);
+    for(i64* i = v->first; i < v->last; i = v->next(v, i)){
+        CH_ASSERT(*i <= *(i + 1));
+    }
+
+    //A second vector, on the stack this time
+    CH_SMALL_VECTOR(i64) w;
+    CH_ASSERT(ch_small_vector_i64_init(&w, 0, cmp_i64) == &w);
+    CH_ASSERT(!w.eq(&w, v));
+    for(i64* i = v->first; i < v->end; i++){
+        w.push_back(&w, *i);
+    }
+    CH_ASSERT(w.eq(&w, v) && v->eq(v, &w));
+    w.delete(&w);
+
+    v->delete(v);
+    return result;
+}
+
+
+static ch_bool is_odd(i64* value, void* arg)
+{
+    (void)arg;
+    return *value & 1;
+}
+
+#define IS_ODD(value, arg) ((value) & 1)
+define_ch_small_vector_remove_if(small_odd, i64s, i64, IS_ODD)
+
+//The rest of the typed vector API: searches, sorts and bulk removals
+static ch_word test3(i64* test_data)
+{
+    ch_word result = 1;
+
+    //The generic version has no radix sort, but searches with the comparator
+    CH_SMALL_VECTOR(i64)* g = CH_SMALL_VECTOR_NEW(i64, 0, cmp_i64);
+    CH_ASSERT(g->sort_radix == NULL);
+    g->push_back_carray(g, test_data, 15);
+    g->sort_parallel(g, 2);
+    CH_ASSERT(*g->first == 0 && *g->last == 9);
+    CH_ASSERT(g->lower_bound(g, 1) == g->first + 1 && g->upper_bound(g, 1) == g->first + 5);
+    g->delete(g);
+
+    CH_SMALL_VECTOR(i64s)* v = CH_SMALL_VECTOR_NEW(i64s, 0, CH_SMALL_VECTOR_CMP(i64s));
+    CH_ASSERT(v->sort_radix != NULL);
+    for(ch_word i = 0; i < 1000; i++){
+        ch_small_vector_i64s_push_back(v, test_data[i % 15] * 1000 - i);
+    }
+    CH_ASSERT(v->find(v, v->first, v->end, 8000) == v->first);
+    CH_ASSERT(v->find(v, v->first, v->end, 8001) == NULL);
+
+    v->sort_radix(v);
+    for(i64* i = v->first; i < v->last; i = ch_small_vector_i64s_next(v, i)){
+        CH_ASSERT(*i <= *(i + 1));
+    }
+    CH_ASSERT(ch_small_vector_i64s_back(v, v->end, 1000) == v->first && ch_small_vector_i64s_prev(v, v->end) == v->last);
+
+    //Equal runs come back from each search
+    v->clear(v);
+    for(ch_word i = 0; i < 15; i++){
+        v->push_back(v, test_data[i]);
+    }
+    v->sort_parallel(v, 0);
+    i64* lower;
+    i64* upper;
+    v->equal_range(v, 1, &lower, &upper);
+    CH_ASSERT(lower == v->first + 1 && upper == v->first + 5);
+    CH_ASSERT(v->lower_bound(v, 2) == v->first + 5 && v->upper_bound(v, 9) == v->end);
+    v->sort(v);
+    CH_ASSERT(v->lower_bound(v, 6) == v->first + 8);
+
+    //0 1 1 1 1 3 4 5 6 6 6 7 7 8 9
+    CH_ASSERT(v->remove_if(v, is_odd, NULL) == 9 && v->count == 6 && *v->last == 8);
+    CH_ASSERT(*v->erase_range(v, v->first + 1, v->first + 4) == 6 && v->count == 3);
+    CH_ASSERT(v->erase_range(v, v->first + 2, v->first + 1) == NULL);
+    const ch_byte mask[3] = {0, 1, 1};
+    CH_ASSERT(v->compact(v, mask) == 1 && v->count == 2 && *v->first == 6 && *v->last == 8);
+    v->push_back(v, 3);
+    CH_ASSERT(small_odd_remove_if(v, NULL) == 1 && v->count == 2 && *v->last == 8);
+    v->delete(v);
+
+    return result;
+}
+
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    i64 test_array[15] = {8,5,1,3,4,6,7,9,7,1,6,1,0,1,6};
+
+    ch_word test_pass = 0;
+    printf("CH Data Structures: Small Vector Test 01: ");  printf("%s", (test_pass = test1(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Small Vector Test 02: ");  printf("%s", (test_pass = test2(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Small Vector Test 03: ");  printf("%s", (test_pass = test3(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+// CamIO 2: test_soa_vector.c
+// Copyright (C) 2013: Matthew P. Grosvenor (matthew.grosvenor@cl.cam.ac.uk)
+// Licensed under BSD 3 Clause, please see LICENSE for more details.
+
+#include "../data_structs/soa_vector/soa_vector_typed_define_template.h"
+#include "../utils/util.h"
+
+#include <stdio.h>
+#include <stdint.h>
+
+declare_ch_soa_vector(trade, (u64, time), (ch_float, price), (u32, qty), (i8, side))
+define_ch_soa_vector(trade, (u64, time), (ch_float, price), (u32, qty), (i8, side))
+
+
+static int cmp_u64(const void* lhs, const void* rhs)
+{
+    const u64 l = *(const u64*)lhs, r = *(const u64*)rhs;
+    return l < r ? -1 : l > r;
+}
+
+static int cmp_i8(const void* lhs, const void* rhs)
+{
+    return *(const i8*)lhs - *(const i8*)rhs;
+}
+
+
+//Rows go in whole and come out whole, with every column aligned
+static ch_word test1(void)
+{
+    ch_word result = 1;
+
+    ch_soa_vector_trade_t* v = ch_soa_vector_trade_new(0);
+    CH_ASSERT(v != NULL && v->count == 0);
+
+    for(ch_word i = 0; i < 1000; i++){
+        const ch_soa_trade_row_t row = { .time = 1000 - i, .price = i * 0.5, .qty = i * 3, .side = (i8)(i % 2) };
+        CH_ASSERT(v->push_back(v, row) == i);
+    }
+    CH_ASSERT(v->count == 1000 && v->size >= 1000);
+
+    const ch_word time_misalignment  = (ch_word)((uintptr_t)v->time % CH_SOA_ALIGN);
+    const ch_word price_misalignment = (ch_word)((uintptr_t)v->price % CH_SOA_ALIGN);
+    const ch_word side_misalignment  = (ch_word)((uintptr_t)v->side % CH_SOA_ALIGN);
+    CH_ASSERT(time_misalignment == 0 && price_misalignment == 0 && side_misalignment == 0);
+
+    //Column access
+    u64 qty_total = 0;
+    for(ch_word i = 0; i < v->count; i++){
+        qty_total += v->qty[i];
+    }
+    CH_ASSERT(qty_total == 3 * 999 * 1000 / 2);
+
+    const ch_soa_trade_row_t row = v->get(v, 10);
+    CH_ASSERT(row.time == 990 && row.price == 5.0 && row.qty == 30 && row.side == 0);
+    v->set(v, 10, (ch_soa_trade_row_t){ .time = 1, .price = 2, .qty = 3, .side = 4 });
+    CH_ASSERT(v->time[10] == 1 && v->price[10] == 2 && v->qty[10] == 3 && v->side[10] == 4);
+
+    v->pop_back(v);
+    CH_ASSERT(v->count == 999);
+    v->clear(v);
+    CH_ASSERT(v->count == 0);
+
+    v->delete(v);
+    return result;
+}
+
+
+//Sorting by one column moves every column with it, and is stable
+static ch_word test2(void)
+{
+    ch_word result = 1;
+
+    ch_soa_vector_trade_t* v = ch_soa_vector_trade_new(16);
+    for(ch_word i = 0; i < 500; i++){
+        const u64 time = (i * 7919) % 500;
+        v->push_back(v, (ch_soa_trade_row_t){ .time = time, .price = time * 2.0, .qty = (u32)i, .side = (i8)(time % 3) });
+    }
+
+    CH_ASSERT(v->sort(v, CH_SOA_COL(trade, time), cmp_u64) == 0);
+    for(ch_word i = 0; i < v->count; i++){
+        CH_ASSERT(v->time[i] == (u64)i);
+        CH_ASSERT(v->price[i] == i * 2.0);
+    }
+
+    //Stable, so rows with the same side stay in time order
+    CH_ASSERT(v->sort(v, CH_SOA_COL(trade, side), cmp_i8) == 0);
+    for(ch_word i = 1; i < v->count; i++){
+        CH_ASSERT(v->side[i - 1] <= v->side[i]);
+        if(v->side[i - 1] == v->side[i]){
+            CH_ASSERT(v->time[i - 1] < v->time[i]);
+        }
+        const i8 expected_side = (i8)(v->time[i] % 3);
+        CH_ASSERT(v->side[i] == expected_side);
+    }
+
+    //A permutation can be computed without moving anything, then applied
+    ch_word perm[500];
+    CH_ASSERT(v->sort_perm(v, CH_SOA_COL(trade, time), cmp_u64, perm) == 0);
+    CH_ASSERT(v->time[perm[0]] == 0 && v->time[perm[499]] == 499);
+    CH_ASSERT(v->permute(v, perm) == 0);
+    CH_ASSERT(v->time[0] == 0 && v->time[499] == 499 && v->price[499] == 998.0);
+
+    v->delete(v);
+    return result;
+}
+
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    ch_word test_pass = 0;
+    printf("CH Data Structures: SoA Vector Test 01: ");  printf("%s", (test_pass = test1()) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: SoA Vector Test 02: ");  printf("%s", (test_pass = test2()) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+
+    return 0;
+}
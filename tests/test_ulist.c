@@ -0,0 +1,167 @@
+// CamIO 2: test_ulist.c
+// Copyright (C) 2013: Matthew P. Grosvenor (matthew.grosvenor@cl.cam.ac.uk)
+// Licensed under BSD 3 Clause, please see LICENSE for more details.
+
+#include "../data_structs/unrolled_list/unrolled_list.h"
+#include "../utils/util.h"
+
+#include <stdio.h>
+#include <string.h>
+
+
+static int cmp_i64(const void* lhs, const void* rhs)
+{
+    const i64 l = *(const i64*)lhs, r = *(const i64*)rhs;
+    return l < r ? -1 : l > r;
+}
+
+
+//Pushes, pops, iteration and random access across many nodes
+static ch_word test1(i64* test_data)
+{
+    ch_word result = 1;
+
+    ch_ulist_t* ul = ch_ulist_new(sizeof(i64), cmp_i64);
+    CH_ASSERT(ul != NULL && ul->count == 0 && ul->_node_capacity >= CH_ULIST_NODE_MIN);
+    CH_ASSERT(ulist_first(ul).value == NULL && ulist_last(ul).value == NULL);
+    CH_ASSERT(ulist_pop_front(ul).value == NULL && ulist_pop_back(ul).value == NULL);
+
+    for(i64 i = 0; i < 1000; i++){
+        CH_ASSERT(*(i64*)ulist_push_back(ul, &i).value == i);
+        const i64 value = -1 - i;
+        CH_ASSERT(*(i64*)ulist_push_front(ul, &value).value == value);
+    }
+    CH_ASSERT(ul->count == 2000);
+
+    i64 expected = -1000;
+    CH_ULIST_FOREACH(ul, it){
+        CH_ASSERT(*(i64*)it.value == expected);
+        expected++;
+    }
+    CH_ASSERT(expected == 1000);
+
+    expected = 999;
+    for(ch_ulist_it it = ulist_last(ul); it.value; ulist_prev(ul, &it)){
+        CH_ASSERT(*(i64*)it.value == expected);
+        expected--;
+    }
+    CH_ASSERT(expected == -1001);
+
+    for(ch_word i = 0; i < 2000; i += 7){
+        CH_ASSERT(*(i64*)ulist_off(ul, i).value == i - 1000);
+    }
+    CH_ASSERT(*(i64*)ulist_off(ul, -1).value == 999);
+    CH_ASSERT(ulist_off(ul, 2000).value == NULL);
+
+    ch_ulist_it it = ulist_first(ul);
+    ulist_forward(ul, &it, 1234);
+    CH_ASSERT(*(i64*)it.value == 234);
+    ulist_back(ul, &it, 1000);
+    CH_ASSERT(*(i64*)it.value == -766);
+    ulist_forward(ul, &it, 2000);
+    CH_ASSERT(it.value == NULL);
+
+    CH_ASSERT(*(i64*)ulist_find_first(ul, &test_data[0]).value == test_data[0]);
+    i64 missing = 5000;
+    CH_ASSERT(ulist_find_first(ul, &missing).value == NULL);
+
+    for(ch_word i = 0; i < 1000; i++){
+        CH_ASSERT(*(i64*)ulist_first(ul).value == i - 1000);
+        ulist_pop_front(ul);
+        CH_ASSERT(*(i64*)ulist_last(ul).value == 999 - i);
+        CH_ASSERT(ulist_pop_back(ul).value == NULL);
+    }
+    CH_ASSERT(ul->count == 0 && ul->_first == NULL && ul->_last == NULL && ul->_pool->count == 0);
+
+    ch_ulist_t* ul2 = ch_ulist_new(sizeof(i64), cmp_i64);
+    ulist_push_back_carray(ul, test_data, 15);
+    ulist_push_back_carray(ul2, test_data, 15);
+    CH_ASSERT(ulist_eq(ul, ul2) && ulist_eq(ul2, ul));
+    ulist_pop_back(ul2);
+    CH_ASSERT(!ulist_eq(ul, ul2));
+
+    ulist_pop_all(ul);
+    CH_ASSERT(ul->count == 0 && ulist_first(ul).value == NULL);
+
+    ulist_delete(ul2);
+    ulist_delete(ul);
+    return result;
+}
+
+
+//Inserts and removes in the middle, against a plain array
+static ch_word test2(void)
+{
+    ch_word result = 1;
+
+    ch_ulist_t* ul = ch_ulist_new(sizeof(i64), cmp_i64);
+    static i64 model[4096];
+    ch_word model_count = 0;
+    u64 seed = 42;
+
+    for(ch_word step = 0; step < 20000; step++){
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        const ch_word r = (ch_word)(seed >> 33);
+        const ch_word pos = model_count ? r % (model_count + 1) : 0;
+
+        if(model_count < 2000 && (r & 0x3) != 0){
+            const i64 value = step;
+            ch_ulist_it it = pos < model_count ? ulist_off(ul, pos) : ulist_end(ul);
+            if((r & 0x4) && pos > 0){
+                it = ulist_off(ul, pos - 1);
+                ulist_insert_after(ul, &it, &value);
+            }
+            else{
+                ulist_insert_before(ul, &it, &value);
+            }
+            CH_ASSERT(it.value && *(i64*)it.value == value);
+            memmove(&model[pos + 1], &model[pos], (model_count - pos) * sizeof(i64));
+            model[pos] = value;
+            model_count++;
+        }
+        else if(model_count){
+            const ch_word idx = pos < model_count ? pos : model_count - 1;
+            ch_ulist_it it = ulist_off(ul, idx);
+            it = ulist_remove_it(ul, &it);
+            memmove(&model[idx], &model[idx + 1], (model_count - idx - 1) * sizeof(i64));
+            model_count--;
+            CH_ASSERT(idx < model_count ? *(i64*)it.value == model[idx] : it.value == NULL);
+        }
+
+        if(step % 1000 == 0){
+            ch_word i = 0;
+            CH_ULIST_FOREACH(ul, it2){
+                CH_ASSERT(*(i64*)it2.value == model[i]);
+                i++;
+            }
+            CH_ASSERT(i == model_count && ul->count == model_count);
+        }
+    }
+
+    //Nodes stay reasonably full
+    ch_word nodes = 0;
+    for(ch_ulist_node_t* node = ul->_first; node; node = node->next){
+        CH_ASSERT(node->count > 0 && node->count <= ul->_node_capacity);
+        nodes++;
+    }
+    CH_ASSERT(nodes == ul->_pool->count);
+    CH_ASSERT(nodes * ul->_node_capacity <= 4 * ul->count + ul->_node_capacity);
+
+    ulist_delete(ul);
+    return result;
+}
+
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    i64 test_array[15] = {8,5,1,3,4,6,7,9,7,1,6,1,0,1,6};
+
+    ch_word test_pass = 0;
+    printf("CH Data Structures: Unrolled List Test 01: ");  printf("%s", (test_pass = test1(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+    printf("CH Data Structures: Unrolled List Test 02: ");  printf("%s", (test_pass = test2()) ? "PASS\n" : "FAIL\n"); if(!test_pass) return 1;
+
+    return 0;
+}
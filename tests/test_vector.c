@@ -6,6 +6,8 @@
 #include "../utils/util.h"
 
 #include <stdio.h>
+#include <stddef.h>
+#include <string.h>
 
 
 static ch_word cmp_i64(i64* lhs, i64* rhs)
@@ -580,6 +582,347 @@ static i64 test18_i64(i64* test_data)
     return result;
 }
 
+/* Sorting with the standard comparator uses the inlined introsort, it must agree with qsort */
+static i64 test19_i64(i64* test_data)
+{
+    i64 result = 1;
+    (void)test_data;
+
+    ch_vector_i64_t* v1 = ch_vector_i64_new(0,CH_VECTOR_CMP(i64));
+    ch_vector_i64_t* v2 = ch_vector_i64_new(0,cmp_i64);
+
+    u64 x = 88172645463325252ULL;
+    for(ch_word i = 0; i < 100 * 1000; i++){
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        const i64 value = (i64)(x % 5000) - 2500;
+        v1->push_back(v1,value);
+        v2->push_back(v2,value);
+    }
+
+    v1->sort(v1);
+    v2->sort(v2);
+
+    CH_ASSERT(v1->eq(v1,v2));
+    for(i64* i = v1->first; i < v1->last; i++){
+        CH_ASSERT(*i <= *(i+1));
+    }
+
+    v1->delete(v1);
+    v2->delete(v2);
+
+    return result;
+}
+
+//Key plus payload radix sort must order by the key and keep equal keys in their original order
+typedef struct {
+    ch_word seq;
+    i32 key;
+    char payload[20];
+} keyed_t;
+
+static i64 test20_i64(i64* test_data)
+{
+    i64 result = 1;
+    (void)test_data;
+
+    ch_vector_t* v = ch_vector_new(16, sizeof(keyed_t), NULL);
+
+    u64 x = 88172645463325252ULL;
+    for(ch_word i = 0; i < 10 * 1000; i++){
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        keyed_t item = { .seq = i, .key = (i32)(x % 2000) - 1000 };
+        snprintf(item.payload, sizeof(item.payload), "%lli", i);
+        vector_push_back(v, &item);
+    }
+
+    CH_ASSERT(vector_sort_radix(v, offsetof(keyed_t, key), sizeof(i32), CH_RADIX_SIGNED) == 0);
+
+    for(keyed_t* i = v->first; i < (keyed_t*)v->last; i++){
+        CH_ASSERT(i->key < (i+1)->key || (i->key == (i+1)->key && i->seq < (i+1)->seq));
+    }
+    for(keyed_t* i = v->first; i <= (keyed_t*)v->last; i++){
+        char expected[20];
+        snprintf(expected, sizeof(expected), "%lli", i->seq);
+        CH_ASSERT(strcmp(i->payload, expected) == 0);
+    }
+
+    //Bad key descriptions are rejected
+    CH_ASSERT(vector_sort_radix(v, offsetof(keyed_t, key), 3, CH_RADIX_SIGNED) == -1);
+    CH_ASSERT(vector_sort_radix(v, offsetof(keyed_t, key), 2, CH_RADIX_FLOAT) == -1);
+    CH_ASSERT(vector_sort_radix(v, sizeof(keyed_t) - 4, 8, CH_RADIX_UNSIGNED) == -1);
+
+    vector_delete(v);
+
+    ch_vector_u64_t* vu = ch_vector_u64_new(0,CH_VECTOR_CMP(u64));
+    for(ch_word i = 0; i < 1000; i++){
+        vu->push_back(vu, (u64)(i * 2654435761ULL) << (i % 40));
+    }
+    vu->sort_radix(vu);
+    for(u64* i = vu->first; i < vu->last; i++){
+        CH_ASSERT(*i <= *(i+1));
+    }
+    vu->delete(vu);
+
+    return result;
+}
+
+//Parallel sorting must agree with the single threaded sort for every worker count, with and without the typed chunk sort
+static i64 test21_i64(i64* test_data)
+{
+    i64 result = 1;
+    (void)test_data;
+
+    const ch_word count = 5 * CH_PARALLEL_SORT_MIN_CHUNK + 12345;
+    ch_vector_i64_t* expected = ch_vector_i64_new(count,CH_VECTOR_CMP(i64));
+    ch_vector_i64_t* v1 = ch_vector_i64_new(count,CH_VECTOR_CMP(i64));
+    ch_vector_i64_t* v2 = ch_vector_i64_new(count,cmp_i64);
+
+    u64 x = 88172645463325252ULL;
+    for(ch_word i = 0; i < count; i++){
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        expected->push_back(expected, (i64)(x % 100000) - 50000);
+    }
+    expected->sort(expected);
+
+    const ch_word workers[] = { 0, 1, 2, 3, 4, 5, 6, 64 };
+    for(ch_word w = 0; w < (ch_word)(sizeof(workers) / sizeof(workers[0])); w++){
+        v1->clear(v1);
+        v2->clear(v2);
+        x = 88172645463325252ULL;
+        for(ch_word i = 0; i < count; i++){
+            x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+            v1->push_back(v1, (i64)(x % 100000) - 50000);
+            v2->push_back(v2, (i64)(x % 100000) - 50000);
+        }
+
+        v1->sort_parallel(v1, workers[w]);
+        v2->sort_parallel(v2, workers[w]);
+        CH_ASSERT(v1->count == count);
+        CH_ASSERT(v1->eq(v1,expected));
+        CH_ASSERT(v2->eq(v2,expected));
+    }
+
+    //Small vectors take the single threaded path
+    ch_vector_i64_t* small = ch_vector_i64_new(0,CH_VECTOR_CMP(i64));
+    for(ch_word i = 0; i < 100; i++){
+        small->push_back(small, 100 - i);
+    }
+    small->sort_parallel(small, 8);
+    for(i64* i = small->first; i < small->last; i++){
+        CH_ASSERT(*i <= *(i+1));
+    }
+
+    small->delete(small);
+    expected->delete(expected);
+    v1->delete(v1);
+    v2->delete(v2);
+
+    return result;
+}
+
+//SIMD searching of pointer vectors must match the comparator
+static i64 test22_i64(i64* test_data)
+{
+    i64 result = 1;
+
+    ch_vector_voidp_t* v = ch_vector_voidp_new(0,CH_VECTOR_CMP(voidp));
+    for(ch_word i = 0; i < 100; i++){
+        v->push_back(v, &test_data[i % 15]);
+    }
+
+    for(ch_word i = 0; i < 15; i++){
+        CH_ASSERT(v->find(v, v->first, v->end, &test_data[i]) == v->off(v,i));
+        CH_ASSERT(v->find(v, v->off(v,i) + 1, v->end, &test_data[i]) == v->off(v,i + 15));
+    }
+    CH_ASSERT(v->find(v, v->first, v->end, NULL) == NULL);
+
+    v->delete(v);
+
+    return result;
+}
+
+//Binary searches only look at the elements in the vector, not the spare capacity
+static i64 test23_i64(i64* test_data)
+{
+    i64 result = 1;
+    (void)test_data;
+
+    ch_vector_i64_t* v1 = ch_vector_i64_new(64,CH_VECTOR_CMP(i64));
+    ch_vector_i64_t* v2 = ch_vector_i64_new(64,cmp_i64);
+    for(i64 i = 0; i < 10; i++){
+        v1->push_back(v1, i * 10);
+        v2->push_back(v2, i * 10);
+    }
+
+    CH_ASSERT(v1->lower_bound(v1, 45) == v1->off(v1,5));
+    CH_ASSERT(v1->upper_bound(v1, 50) == v1->off(v1,6));
+    CH_ASSERT(v1->lower_bound(v1, 1000) == v1->end);
+    CH_ASSERT(v2->lower_bound(v2, -5) == v2->first);
+    CH_ASSERT(v2->upper_bound(v2, 90) == v2->end);
+
+    i64* lower = NULL;
+    i64* upper = NULL;
+    v2->equal_range(v2, 30, &lower, &upper);
+    CH_ASSERT(lower == v2->off(v2,3) && upper == v2->off(v2,4));
+    v1->equal_range(v1, 31, &lower, &upper);
+    CH_ASSERT(lower == upper && lower == v1->off(v1,4));
+
+    v1->delete(v1);
+    v2->delete(v2);
+
+    return result;
+}
+
+//Reserved vectors grow in place, and vectors too big for the heap are grown by remapping
+static i64 test24_i64(i64* test_data)
+{
+    i64 result = 1;
+    (void)test_data;
+
+    ch_vector_i64_t* v1 = ch_vector_i64_new_reserved(0, 100000, CH_VECTOR_CMP(i64));
+    CH_ASSERT(v1 != NULL);
+    v1->push_back(v1, 0);
+    i64* const first = v1->first;
+    for(i64 i = 1; i < 100000; i++){
+        v1->push_back(v1, i);
+    }
+    CH_ASSERT(v1->first == first);
+    CH_ASSERT(v1->count == 100000 && v1->size >= 100000);
+
+    //Beyond the reservation, the vector keeps growing
+    for(i64 i = 100000; i < 150000; i++){
+        v1->push_back(v1, i);
+    }
+    CH_ASSERT(v1->count == 150000);
+    for(i64 i = 0; i < 150000; i++){
+        CH_ASSERT(*v1->off(v1,i) == i);
+    }
+
+    v1->resize(v1, 0);
+    CH_ASSERT(v1->count == 0);
+    v1->push_back(v1, 7);
+    CH_ASSERT(*v1->first == 7);
+    v1->delete(v1);
+
+    //Cross the mmap threshold, then grow again
+    const ch_word small = CH_ARRAY_MMAP_THRESHOLD / sizeof(i64) / 2;
+    ch_vector_i64_t* v2 = ch_vector_i64_new(small, CH_VECTOR_CMP(i64));
+    v2->push_back(v2, -1);
+    v2->resize(v2, small * 4);
+    v2->push_back(v2, -2);
+    v2->resize(v2, small * 8);
+    CH_ASSERT(v2->count == 2 && v2->size == small * 8);
+    CH_ASSERT(*v2->off(v2,0) == -1 && *v2->off(v2,1) == -2);
+    CH_ASSERT(v2->_vector->_array->_backing_type == CH_ARRAY_BACKING_MMAP);
+    v2->delete(v2);
+
+    return result;
+}
+
+
+//The static inline API and the function pointers see the same vector
+static i64 test25_i64(i64* test_data)
+{
+    i64 result = 1;
+
+    ch_vector_i64_t* v1 = ch_vector_i64_new(0,CH_VECTOR_CMP(i64));
+    for(ch_word i = 0; i < 100; i++){
+        const i64 value = test_data[i % 10] + i;
+        CH_ASSERT(*ch_vector_i64_push_back(v1, value) == value);
+        CH_ASSERT(v1->count == i + 1 && v1->last == v1->end - 1);
+    }
+    CH_ASSERT(v1->_vector->count == 100);
+
+    for(ch_word i = 0; i < 100; i++){
+        CH_ASSERT(ch_vector_i64_off(v1, i) == v1->off(v1, i));
+    }
+    CH_ASSERT(ch_vector_i64_next(v1, v1->first) == v1->first + 1);
+    CH_ASSERT(ch_vector_i64_prev(v1, v1->last) == v1->last - 1);
+    CH_ASSERT(ch_vector_i64_forward(v1, v1->first, 100) == v1->end);
+    CH_ASSERT(ch_vector_i64_back(v1, v1->end, 100) == v1->first);
+
+    for(ch_word i = 0; i < 99; i++){
+        ch_vector_i64_pop_back(v1);
+    }
+    CH_ASSERT(v1->count == 1 && v1->first == v1->last && *v1->first == test_data[0]);
+    v1->push_back(v1, 5);
+    CH_ASSERT(*ch_vector_i64_off(v1, 1) == 5);
+    CH_ASSERT(*ch_vector_i64_off(v1, -1) == 5 && *ch_vector_i64_off(v1, -2) == test_data[0]);
+    ch_vector_i64_pop_back(v1);
+    ch_vector_i64_pop_back(v1);
+    ch_vector_i64_pop_back(v1);
+    CH_ASSERT(v1->count == 0 && v1->first == v1->end);
+
+    ch_vector_i64_push_back(v1, 1);
+    ch_vector_i64_clear(v1);
+    CH_ASSERT(v1->count == 0 && v1->first == v1->end);
+
+    v1->delete(v1);
+    return result;
+}
+
+
+static ch_bool is_odd(i64* value, void* arg)
+{
+    (void)arg;
+    return *value & 1;
+}
+
+#define IS_ABOVE(value, arg) ((value) > *(i64*)(arg))
+define_ch_vector_remove_if(above, i64, i64, IS_ABOVE)
+
+//Bulk removes
+static i64 test26_i64(i64* test_data)
+{
+    i64 result = 1;
+
+    ch_vector_i64_t* v1 = ch_vector_i64_new(0,CH_VECTOR_CMP(i64));
+    for(ch_word i = 0; i < 1000; i++){
+        v1->push_back(v1, i);
+    }
+
+    CH_ASSERT(v1->remove_if(v1, is_odd, NULL) == 500);
+    CH_ASSERT(v1->count == 500 && v1->end == v1->first + 500 && *v1->last == 998);
+    for(ch_word i = 0; i < v1->count; i++){
+        CH_ASSERT(v1->first[i] == 2 * i);
+    }
+    CH_ASSERT(v1->remove_if(v1, is_odd, NULL) == 0 && v1->count == 500);
+
+    //Remove [100, 200), which is 200..398
+    CH_ASSERT(v1->erase_range(v1, v1->first + 100, v1->first + 200) == v1->first + 100);
+    CH_ASSERT(v1->count == 400 && v1->first[99] == 198 && v1->first[100] == 400 && *v1->last == 998);
+    CH_ASSERT(v1->erase_range(v1, v1->first + 10, v1->first + 10) == v1->first + 10 && v1->count == 400);
+    CH_ASSERT(v1->erase_range(v1, v1->first + 10, v1->end + 1) == NULL && v1->count == 400);
+
+    //Keep every third element
+    ch_byte mask[400];
+    for(ch_word i = 0; i < 400; i++){
+        mask[i] = i % 3 == 0;
+    }
+    CH_ASSERT(v1->compact(v1, mask) == 266);
+    CH_ASSERT(v1->count == 134 && v1->first[0] == 0 && v1->first[33] == 198 && v1->first[34] == 404);
+
+    i64 limit = 500;
+    CH_ASSERT(above_remove_if(v1, &limit) == 83);
+    CH_ASSERT(v1->count == 51 && *v1->last == 500 && v1->last == v1->first + 50);
+    for(i64* i = v1->first; i < v1->end; i++){
+        CH_ASSERT(*i <= 500);
+    }
+
+    limit = -1;
+    CH_ASSERT(above_remove_if(v1, &limit) == 51);
+    CH_ASSERT(v1->count == 0 && v1->first == v1->end);
+    CH_ASSERT(v1->remove_if(v1, is_odd, NULL) == 0);
+
+    //Everything goes to the end of the vector
+    v1->push_back_carray(v1, test_data, 15);
+    CH_ASSERT(v1->erase_range(v1, v1->first, v1->end) == v1->first && v1->count == 0);
+
+    v1->delete(v1);
+    return result;
+}
+
+
 int main(int argc, char** argv)
 {
     (void)argc;
@@ -608,6 +951,14 @@ int main(int argc, char** argv)
     printf("CH Data Structures: Vector Test 16: ");  printf("%s", (test_result = test16_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_result) return 1;
     printf("CH Data Structures: Vector Test 17: ");  printf("%s", (test_result = test17_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_result) return 1;
     printf("CH Data Structures: Vector Test 17: ");  printf("%s", (test_result = test18_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_result) return 1;
+    printf("CH Data Structures: Vector Test 19: ");  printf("%s", (test_result = test19_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_result) return 1;
+    printf("CH Data Structures: Vector Test 20: ");  printf("%s", (test_result = test20_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_result) return 1;
+    printf("CH Data Structures: Vector Test 21: ");  printf("%s", (test_result = test21_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_result) return 1;
+    printf("CH Data Structures: Vector Test 22: ");  printf("%s", (test_result = test22_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_result) return 1;
+    printf("CH Data Structures: Vector Test 23: ");  printf("%s", (test_result = test23_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_result) return 1;
+    printf("CH Data Structures: Vector Test 24: ");  printf("%s", (test_result = test24_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_result) return 1;
+    printf("CH Data Structures: Vector Test 25: ");  printf("%s", (test_result = test25_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_result) return 1;
+    printf("CH Data Structures: Vector Test 26: ");  printf("%s", (test_result = test26_i64(test_array)) ? "PASS\n" : "FAIL\n"); if(!test_result) return 1;
 
     return 0;
 }
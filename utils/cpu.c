@@ -0,0 +1,78 @@
+/*
+ * cpu.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#include "cpu.h"
+#include "util.h"
+
+#ifdef CH_ARCH_X86
+#include <cpuid.h>
+#endif
+
+//-1 means "not probed yet". Probing is idempotent, so racing threads will all store the same value.
+static ch_word cpu_features = -1;
+
+#ifdef CH_ARCH_X86
+//AVX state must be enabled by the OS as well as supported by the CPU, otherwise AVX instructions will fault
+static ch_bool os_saves_avx_state(void)
+{
+    u32 eax, edx;
+    __asm__ __volatile__ ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    (void)edx;
+    return (eax & 0x6) == 0x6; //XMM and YMM state
+}
+#endif
+
+static ch_word probe_cpu_features(void)
+{
+    ch_word result = 0;
+
+#ifdef CH_ARCH_X86
+    u32 eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx)){
+        return result;
+    }
+
+    result |= edx & (1 << 26) ? CH_CPU_SSE2   : 0;
+    result |= ecx & (1 << 20) ? CH_CPU_SSE42  : 0;
+    result |= ecx & (1 << 23) ? CH_CPU_POPCNT : 0;
+    result |= ecx & (1 << 25) ? CH_CPU_AES    : 0;
+
+    const ch_bool avx_usable = (ecx & (1 << 27)) && (ecx & (1 << 28)) && os_saves_avx_state();
+    result |= avx_usable ? CH_CPU_AVX : 0;
+
+    if(__get_cpuid_max(0, NULL) >= 7){
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        result |= avx_usable && (ebx & (1 << 5)) ? CH_CPU_AVX2 : 0;
+        result |= ebx & (1 << 3) ? CH_CPU_BMI1 : 0;
+        result |= ebx & (1 << 8) ? CH_CPU_BMI2 : 0;
+    }
+#endif
+
+#ifdef CH_ARCH_NEON
+    result |= CH_CPU_NEON;
+#endif
+
+    return result;
+}
+
+
+ch_word ch_cpu_features(void)
+{
+    ch_word result = __atomic_load_n(&cpu_features, __ATOMIC_RELAXED);
+    if(unlikely(result < 0)){
+        result = probe_cpu_features();
+        __atomic_store_n(&cpu_features, result, __ATOMIC_RELAXED);
+    }
+
+    return result;
+}
+
+
+ch_bool ch_cpu_has(ch_word features)
+{
+    return (ch_cpu_features() & features) == features;
+}
@@ -0,0 +1,51 @@
+/*
+ * cpu.h
+ *
+ * Runtime detection of optional CPU instruction set extensions. The feature set is probed once (via CPUID on x86) and
+ * cached, so that code with multiple implementations (hardware CRC, AES, AVX2 etc) can pick the best one at runtime
+ * while still building a single portable binary.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: mgrosvenor
+ */
+
+#ifndef CH_CPU_H_
+#define CH_CPU_H_
+
+#include "../types/types.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+    #define CH_ARCH_X86 1
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define CH_ARCH_NEON 1
+#endif
+
+//Tell the compiler that a function may use instructions beyond the baseline. Only call these functions after checking
+//with ch_cpu_has() that the CPU actually supports the instructions
+#if defined(CH_ARCH_X86) && defined(__GNUC__)
+    #define CH_TARGET(isa) __attribute__((target(isa)))
+#else
+    #define CH_TARGET(isa)
+#endif
+
+typedef enum {
+    CH_CPU_SSE2     = (1 << 0),
+    CH_CPU_SSE42    = (1 << 1),
+    CH_CPU_POPCNT   = (1 << 2),
+    CH_CPU_AES      = (1 << 3),
+    CH_CPU_AVX      = (1 << 4),
+    CH_CPU_AVX2     = (1 << 5),
+    CH_CPU_BMI1     = (1 << 6),
+    CH_CPU_BMI2     = (1 << 7),
+    CH_CPU_NEON     = (1 << 8),
+} ch_cpu_feature_e;
+
+//Return non-zero if the CPU we are running on supports the given feature(s)
+ch_bool ch_cpu_has(ch_word features);
+
+//Return the full (cached) feature bit mask
+ch_word ch_cpu_features(void);
+
+#endif /* CH_CPU_H_ */
@@ -53,6 +53,14 @@ ch_word next_pow2(ch_word v);
 
 #define CH_ASSERT(p) do { if(!(p)) { fprintf(stdout, "Error in %s: failed assertion \""#p"\" on line %u\n", __FUNCTION__, __LINE__); result = 0; } } while(0)
 
+//Bounds checks for the inline typed container functions. If cond fails, print the message and return fail. Compiled
+//out altogether when NDEBUG is defined, as it is for release builds.
+#ifndef NDEBUG
+    #define CH_BOUNDS_CHECK(cond, fail, /*format, args*/...) do { if(unlikely(!(cond))){ printf(__VA_ARGS__); return fail; } } while(0)
+#else
+    #define CH_BOUNDS_CHECK(cond, fail, /*format, args*/...) do { } while(0)
+#endif
+
 //Uses integer division to round up
 #define round_up( value, nearest) ((( value + nearest -1) / nearest ) * nearest )
 